@@ -0,0 +1,44 @@
+#include <plugin.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+
+using namespace plugin;
+
+// any version dependent address will do, it's never dereferenced
+#ifdef GTASA
+#define BENCH_ADDRESS_DYN GetGlobalAddress(by_version_dyn(0x53E230, 0x53E750, 0x551C80, 0x551CA0, 0x5530A0, 0x553060))
+#define BENCH_ADDRESS_TABLE GLOBAL_ADDRESS_BY_VERSION(0x53E230, 0x53E750, 0x551C80, 0x551CA0, 0x5530A0, 0x553060)
+#define BENCH_OFFSET_DYN by_version_dyn(0x46C, 0x46C, 0x46C, 0x46C, 0x474, 0x474)
+#define BENCH_OFFSET_TABLE ADDRESS_BY_VERSION(0x46C, 0x46C, 0x46C, 0x46C, 0x474, 0x474)
+#else
+#define BENCH_ADDRESS_DYN GetGlobalAddress(by_version_dyn(0x48E0F0, 0x48E1B0, 0x48E140))
+#define BENCH_ADDRESS_TABLE GLOBAL_ADDRESS_BY_VERSION(0x48E0F0, 0x48E1B0, 0x48E140)
+#define BENCH_OFFSET_DYN by_version_dyn(0x1F8, 0x1F8, 0x1FC)
+#define BENCH_OFFSET_TABLE ADDRESS_BY_VERSION(0x1F8, 0x1F8, 0x1FC)
+#endif
+
+struct Main
+{
+    static constexpr int CALLS = 10000000;
+
+    Main()
+    {
+        benchmark::Report f("AddressTableBenchmark.txt");
+        if (!f)
+            return;
+
+        uintptr_t sumDyn = 0, sumTable = 0;
+        double addressDyn = benchmark::Measure(CALLS, [&] { sumDyn += BENCH_ADDRESS_DYN; });
+        double addressTable = benchmark::Measure(CALLS, [&] { sumTable += BENCH_ADDRESS_TABLE; });
+        double offsetDyn = benchmark::Measure(CALLS, [&] { sumDyn += BENCH_OFFSET_DYN; });
+        double offsetTable = benchmark::Measure(CALLS, [&] { sumTable += BENCH_OFFSET_TABLE; });
+
+        fprintf(f, "%s, %d lookups, nanoseconds per lookup, %u table entries\n", GetGameVersionName(), CALLS, AddressTable::Count());
+        fprintf(f, "GetGlobalAddress(by_version_dyn): %6.2f\n", addressDyn);
+        fprintf(f, "GLOBAL_ADDRESS_BY_VERSION:        %6.2f\n", addressTable);
+        fprintf(f, "by_version_dyn:                   %6.2f\n", offsetDyn);
+        fprintf(f, "ADDRESS_BY_VERSION:               %6.2f\n", offsetTable);
+        if (sumDyn != sumTable)
+            fprintf(f, "MISMATCH\n");
+    }
+} gInstance;
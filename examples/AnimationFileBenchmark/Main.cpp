@@ -0,0 +1,172 @@
+#include <plugin.h>
+#include <AnimationFile.h>
+#include <extensions/Benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    static constexpr uint32_t ANIMATIONS = 200;
+    static constexpr uint32_t BONES = 32;
+    static constexpr uint32_t KEYS = 60;    // a second at the game's 1/60 s steps
+    static constexpr size_t SAMPLES = 1000; // times each animation is sampled at
+
+    Main()
+    {
+        benchmark::Report f("AnimationFileBenchmark.txt");
+        if (!f)
+            return;
+
+        std::vector<uint8_t> data = MakeFile();
+        AnimationFile file;
+        double load = benchmark::Measure(1, [&] { file.Load(data); });
+
+        std::vector<float> out[7];
+        for (auto& component : out)
+            component.resize(BONES);
+        float checksum = 0.0f;
+        double batched = benchmark::Measure(1, [&] {
+            for (uint32_t a = 0; a < ANIMATIONS; a++) {
+                float duration = file.GetAnimation(a).duration;
+                for (size_t s = 0; s < SAMPLES; s++) {
+                    file.SampleAnimation(a, duration * s / SAMPLES, out[0].data(), out[1].data(), out[2].data(), out[3].data(),
+                        out[4].data(), out[5].data(), out[6].data());
+                    checksum += out[3][s % BONES];
+                }
+            }
+        }) / ((double)ANIMATIONS * SAMPLES * BONES);
+
+        // one bone at a time, searching keys from the start and with the C runtime's acos and sin
+        float scalarChecksum = 0.0f;
+        auto const& keys = file.GetKeys();
+        double scalar = benchmark::Measure(1, [&] {
+            for (uint32_t a = 0; a < ANIMATIONS; a++) {
+                auto const& animation = file.GetAnimation(a);
+                for (size_t s = 0; s < SAMPLES; s++) {
+                    float time = animation.duration * s / SAMPLES;
+                    for (uint32_t b = 0; b < animation.numSequences; b++) {
+                        auto const& sequence = file.GetSequence(animation.firstSequence + b);
+                        uint32_t k = sequence.firstKey;
+                        while (k + 2 < sequence.firstKey + sequence.numKeys && keys.time[k + 1] <= time)
+                            k++;
+                        float t = (std::min)(1.0f, (time - keys.time[k]) / (keys.time[k + 1] - keys.time[k]));
+                        float q0[4] = { keys.rotX[k], keys.rotY[k], keys.rotZ[k], keys.rotW[k] };
+                        float q1[4] = { keys.rotX[k + 1], keys.rotY[k + 1], keys.rotZ[k + 1], keys.rotW[k + 1] };
+                        float rotation[4];
+                        Slerp(q0, q1, t, rotation);
+                        if (b == s % BONES)
+                            scalarChecksum += rotation[3];
+                    }
+                }
+            }
+        }) / ((double)ANIMATIONS * SAMPLES * BONES);
+
+        // the compressed keys of the whole file, back and forth
+        size_t numKeys = keys.time.size();
+        std::vector<uint8_t> compressed(numKeys * AnimationFile::COMPRESSED_ROOT_KEY_SIZE);
+        AnimationFile::Keys decompressed = keys;
+        double compress = benchmark::Measure(1, [&] {
+            AnimationFile::CompressKeys(keys.time.data(), keys.rotX.data(), keys.rotY.data(), keys.rotZ.data(), keys.rotW.data(),
+                keys.posX.data(), keys.posY.data(), keys.posZ.data(), numKeys, true, compressed.data());
+        }) / numKeys;
+        double decompress = benchmark::Measure(1, [&] {
+            AnimationFile::DecompressKeys(compressed.data(), numKeys, true, decompressed.time.data(), decompressed.rotX.data(),
+                decompressed.rotY.data(), decompressed.rotZ.data(), decompressed.rotW.data(), decompressed.posX.data(),
+                decompressed.posY.data(), decompressed.posZ.data());
+        }) / numKeys;
+
+        AnimationFile ped;
+        std::string pedPath = paths::GetGameDirRelativePathA("anim\\ped.ifp");
+        double loadPed = benchmark::Measure(1, [&] { ped.Load(pedPath); });
+
+        fprintf(f, "%u animations of %u bones, %u keys each (%.3f %.3f)\n", ANIMATIONS, BONES, KEYS, checksum, scalarChecksum);
+        fprintf(f, "Load (ms):                        %10.3f\n", load / 1000000.0);
+        fprintf(f, "SampleAnimation (ns per bone):    %10.2f\n", batched);
+        fprintf(f, "one bone at a time:               %10.2f\n", scalar);
+        fprintf(f, "CompressKeys (ns per key):        %10.2f\n", compress);
+        fprintf(f, "DecompressKeys:                   %10.2f\n", decompress);
+        fprintf(f, "anim\\ped.ifp, %u animations (ms): %10.3f\n", (unsigned)ped.GetNumAnimations(), loadPed / 1000000.0);
+    }
+
+    template<typename T>
+    static void Put(std::vector<uint8_t>& out, T value)
+    {
+        uint8_t bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void PutName(std::vector<uint8_t>& out, const char* name)
+    {
+        char padded[24] = {};
+        memcpy(padded, name, (std::min)(strlen(name), size_t(23)));
+        out.insert(out.end(), padded, padded + 24);
+    }
+
+    // ANP3 with a root bone and child bones turning around different axes
+    static std::vector<uint8_t> MakeFile()
+    {
+        std::vector<uint8_t> out;
+        out.insert(out.end(), { 'A', 'N', 'P', '3' });
+        Put<uint32_t>(out, 0);
+        PutName(out, "benchmark");
+        Put<uint32_t>(out, ANIMATIONS);
+        for (uint32_t a = 0; a < ANIMATIONS; a++) {
+            char name[24];
+            snprintf(name, sizeof(name), "anim%u", a);
+            PutName(out, name);
+            Put<uint32_t>(out, BONES);
+            Put<uint32_t>(out, KEYS * (AnimationFile::COMPRESSED_ROOT_KEY_SIZE + (BONES - 1) * AnimationFile::COMPRESSED_KEY_SIZE));
+            Put<uint32_t>(out, 1);
+            for (uint32_t b = 0; b < BONES; b++) {
+                PutName(out, "bone");
+                Put<uint32_t>(out, b == 0 ? 2 : 1);
+                Put<uint32_t>(out, KEYS);
+                Put<int32_t>(out, b);
+                for (uint32_t k = 0; k < KEYS; k++) {
+                    float angle = (float)(k * (b + 1) + a) * 0.05f;
+                    float axis[3] = { std::sin((float)b), std::cos((float)b), 0.5f };
+                    float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+                    for (float value : axis)
+                        Put<int16_t>(out, (int16_t)(value / length * std::sin(angle) * 4096.0f));
+                    Put<int16_t>(out, (int16_t)(std::cos(angle) * 4096.0f));
+                    Put<int16_t>(out, (int16_t)k);
+                    if (b == 0) {
+                        Put<int16_t>(out, (int16_t)(k * 16));
+                        Put<int16_t>(out, 0);
+                        Put<int16_t>(out, 1024);
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // CQuaternion::Slerp
+    static void Slerp(float const* a, float const* b, float t, float* out)
+    {
+        float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        float theta = std::acos((std::max)(-1.0f, (std::min)(1.0f, dot)));
+        float w1 = 1.0f - t, w2 = t;
+        if (theta != 0.0f) {
+            float invSin = 1.0f / std::sin(theta);
+            if (theta > 1.5707964f) {
+                theta = 3.1415927f - theta;
+                w1 = std::sin((1.0f - t) * theta) * invSin;
+                w2 = -std::sin(t * theta) * invSin;
+            }
+            else {
+                w1 = std::sin((1.0f - t) * theta) * invSin;
+                w2 = std::sin(t * theta) * invSin;
+            }
+        }
+        for (int i = 0; i < 4; i++)
+            out[i] = w1 * a[i] + w2 * b[i];
+    }
+} gInstance;
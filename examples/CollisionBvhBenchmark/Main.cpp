@@ -0,0 +1,105 @@
+#include <plugin.h>
+#include <CollisionBvh.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    static constexpr int32_t SIZE = 128;    // quads along each side, two triangles each
+    static constexpr size_t SEGMENTS = 100000;
+    static constexpr size_t BRUTE_FORCE_SEGMENTS = 200; // every triangle for each, too slow for more
+
+    Main()
+    {
+        benchmark::Report f("CollisionBvhBenchmark.txt");
+        if (!f)
+            return;
+
+        random::Pcg32 gen(1);
+        std::vector<float> x, y, z;
+        std::vector<uint16_t> indices;
+        for (int32_t j = 0; j <= SIZE; j++) {
+            for (int32_t i = 0; i <= SIZE; i++) {
+                x.push_back((float)i);
+                y.push_back((float)j);
+                z.push_back(random::InRange(gen, 0.0f, 4.0f));
+            }
+        }
+        for (int32_t j = 0; j < SIZE; j++) {
+            for (int32_t i = 0; i < SIZE; i++) {
+                uint16_t a = (uint16_t)(j * (SIZE + 1) + i), b = a + 1, c = a + SIZE + 1, d = c + 1;
+                uint16_t quad[] = { a, b, d, a, d, c };
+                indices.insert(indices.end(), quad, quad + 6);
+            }
+        }
+
+        // line of sight checks a few metres above the ground
+        std::vector<CollisionBvh::Segment> segments(SEGMENTS);
+        for (auto& s : segments) {
+            for (int32_t a = 0; a < 2; a++) {
+                s.start[a] = random::InRange(gen, 0.0f, (float)SIZE);
+                s.end[a] = (std::min)((float)SIZE, (std::max)(0.0f, s.start[a] + random::InRange(gen, -30.0f, 30.0f)));
+            }
+            s.start[2] = random::InRange(gen, 2.0f, 6.0f);
+            s.end[2] = random::InRange(gen, 2.0f, 6.0f);
+        }
+        std::vector<CollisionBvh::Hit> hits(SEGMENTS);
+
+        CollisionBvh bvh;
+        double build = benchmark::Measure(1, [&] {
+            bvh.Build(x.data(), y.data(), z.data(), x.size(), indices.data(), nullptr, nullptr, indices.size() / 3);
+        });
+
+        // one node holding every triangle: the same triangle test without the hierarchy
+        size_t bruteHits = 0;
+        double bruteForce = benchmark::Measure(1, [&] {
+            for (size_t i = 0; i < BRUTE_FORCE_SEGMENTS; i++)
+                bruteHits += BruteForce(segments[i], x, y, z, indices);
+        }) / BRUTE_FORCE_SEGMENTS;
+        size_t serialHits = 0, parallelHits = 0, blocked = 0;
+        double serial = benchmark::Measure(1, [&] { serialHits = bvh.Intersect(segments.data(), SEGMENTS, hits.data()); }) / SEGMENTS;
+        double parallel = benchmark::Measure(1, [&] { parallelHits = bvh.IntersectParallel(segments.data(), SEGMENTS, hits.data()); }) / SEGMENTS;
+        double any = benchmark::Measure(1, [&] {
+            for (auto& s : segments)
+                blocked += bvh.IsBlocked(s);
+        }) / SEGMENTS;
+
+        fprintf(f, "%u triangles, %u nodes, %u segments (%u %u %u %u)\n", (unsigned)bvh.GetNumTriangles(), (unsigned)bvh.GetNumNodes(),
+            (unsigned)SEGMENTS, (unsigned)bruteHits, (unsigned)serialHits, (unsigned)parallelHits, (unsigned)blocked);
+        fprintf(f, "build (ms):                      %10.3f\n", build / 1000000.0);
+        fprintf(f, "every triangle (ns per segment): %10.1f\n", bruteForce);
+        fprintf(f, "Intersect (ns per segment):      %10.1f\n", serial);
+        fprintf(f, "IntersectParallel:               %10.1f\n", parallel);
+        fprintf(f, "IsBlocked:                       %10.1f\n", any);
+    }
+
+    static bool BruteForce(CollisionBvh::Segment const& s, std::vector<float> const& x, std::vector<float> const& y,
+        std::vector<float> const& z, std::vector<uint16_t> const& indices)
+    {
+        float d[3] = { s.end[0] - s.start[0], s.end[1] - s.start[1], s.end[2] - s.start[2] };
+        float best = 1.0f;
+        bool hit = false;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            uint16_t i0 = indices[t], i1 = indices[t + 1], i2 = indices[t + 2];
+            float e1[3] = { x[i1] - x[i0], y[i1] - y[i0], z[i1] - z[i0] };
+            float e2[3] = { x[i2] - x[i0], y[i2] - y[i0], z[i2] - z[i0] };
+            float o[3] = { s.start[0] - x[i0], s.start[1] - y[i0], s.start[2] - z[i0] };
+            float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+            float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+            if (det == 0.0f)
+                continue;
+            float u = (o[0] * p[0] + o[1] * p[1] + o[2] * p[2]) / det;
+            float q[3] = { o[1] * e1[2] - o[2] * e1[1], o[2] * e1[0] - o[0] * e1[2], o[0] * e1[1] - o[1] * e1[0] };
+            float v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+            float distance = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && distance >= 0.0f && distance < best) {
+                best = distance;
+                hit = true;
+            }
+        }
+        return hit;
+    }
+} gInstance;
@@ -0,0 +1,93 @@
+#include <plugin.h>
+#include <CollisionFile.h>
+#include <ImgArchive.h>
+#include <ThreadPool.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    Main()
+    {
+        benchmark::Report f("CollisionFileBenchmark.txt");
+        if (!f)
+            return;
+
+        // every .col of the game: models\coll and the ones in gta3.img
+        std::vector<std::vector<uint8_t>> files;
+        std::error_code error;
+        for (auto& it : std::filesystem::directory_iterator("models\\coll", error)) {
+            if (_stricmp(it.path().extension().string().c_str(), ".col") == 0) {
+                std::ifstream file(it.path(), std::ios::binary);
+                files.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+        }
+        ImgArchive img;
+        if (img.Open("models\\gta3.img")) {
+            for (size_t i = 0; i < img.GetNumEntries(); i++) {
+                const char* extension = strrchr(img.GetEntry(i).name, '.');
+                if (extension && _stricmp(extension, ".col") == 0) {
+                    auto view = img.GetData(i);
+                    auto data = view.Span();
+                    files.emplace_back(data.begin(), data.end());
+                }
+            }
+        }
+
+        size_t models = 0, vertices = 0, failed = 0, mismatched = 0;
+        auto loadAll = [&] {
+            models = vertices = failed = 0;
+            for (auto& data : files) {
+                CollisionFile file;
+                if (!file.Load(data)) {
+                    failed++;
+                    continue;
+                }
+                models += file.GetNumModels();
+                vertices += file.GetVertices().x.size();
+            }
+        };
+        unsigned threads = GetWorkerThreads();
+        SetWorkerThreads(1);
+        double serial = benchmark::Measure(1, loadAll);
+        SetWorkerThreads(threads);
+        double parallel = benchmark::Measure(1, loadAll);
+
+        for (auto& data : files) {
+            CollisionFile file, again;
+            if (file.Load(data) && (!again.Load(file.Write()) || again.Write() != file.Write()))
+                mismatched++;
+        }
+
+        // CompressedVector one at a time against the kernel
+        const size_t count = 1000000;
+        std::vector<int16_t> compressed(count * 3);
+        for (size_t i = 0; i < compressed.size(); i++)
+            compressed[i] = (int16_t)(i * 2654435761u);
+        std::vector<float> x(count), y(count), z(count);
+        double naive = benchmark::Measure(1, [&] {
+            for (size_t i = 0; i < count; i++) {
+                x[i] = compressed[i * 3] / 128.0f;
+                y[i] = compressed[i * 3 + 1] / 128.0f;
+                z[i] = compressed[i * 3 + 2] / 128.0f;
+            }
+        }) / count;
+        double kernel = benchmark::Measure(1, [&] {
+            CollisionFile::DecompressVertices(compressed.data(), count, x.data(), y.data(), z.data());
+        }) / count;
+
+        fprintf(f, "%u files, %u models, %u vertices, %u failed to load, %u differ after a round trip (%f)\n",
+            (unsigned)files.size(), (unsigned)models, (unsigned)vertices, (unsigned)failed, (unsigned)mismatched, x[1] + y[2] + z[3]);
+        fprintf(f, "load all, one thread (ms):      %10.3f\n", serial / 1000000.0);
+        fprintf(f, "load all, scan threads (ms):    %10.3f\n", parallel / 1000000.0);
+        fprintf(f, "decompress vertex, loop (ns):   %10.3f\n", naive);
+        fprintf(f, "decompress vertex, kernel (ns): %10.3f\n", kernel);
+    }
+} gInstance;
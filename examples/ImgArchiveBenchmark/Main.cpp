@@ -0,0 +1,111 @@
+#include <plugin.h>
+#include <ImgArchive.h>
+#include <extensions/Benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    static constexpr uint32_t ENTRIES = 10000;
+    static constexpr uint32_t ENTRY_SECTORS = 4;
+
+    Main()
+    {
+        benchmark::Report f("ImgArchiveBenchmark.txt");
+        if (!f)
+            return;
+
+        std::vector<std::string> names;
+        for (uint32_t i = 0; i < ENTRIES; i++)
+            names.push_back("model" + std::to_string(i) + (i % 2 ? ".dff" : ".txd"));
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "ImgArchiveBenchmark.img";
+        WriteArchive(path, names);
+
+        ImgArchive archive;
+        double open = benchmark::Measure(1, [&] { archive.Open(path.string()); });
+        if (!archive.IsOpen())
+            return;
+
+        // what CDirectory::FindItem does: strcmp through every entry
+        int64_t sum = 0;
+        double linear = benchmark::Measure(1, [&] {
+            for (auto& name : names) {
+                for (size_t i = 0; i < archive.GetNumEntries(); i++) {
+                    if (_stricmp(archive.GetEntry(i).name, name.c_str()) == 0) {
+                        sum += i;
+                        break;
+                    }
+                }
+            }
+        }) / ENTRIES;
+        double hashed = benchmark::Measure(1, [&] {
+            for (auto& name : names)
+                sum += archive.Find(name);
+        }) / ENTRIES;
+
+        std::atomic<uint64_t> checksum(0);
+        double serial = benchmark::Measure(1, [&] {
+            for (size_t i = 0; i < archive.GetNumEntries(); i++) {
+                uint64_t value = 0;
+                auto view = archive.GetData(i);
+                for (uint8_t byte : view.Span())
+                    value += byte;
+                checksum += value;
+            }
+        });
+        double parallel = benchmark::Measure(1, [&] {
+            archive.ForEachParallel([&](size_t, std::span<const uint8_t> data) {
+                uint64_t value = 0;
+                for (uint8_t byte : data)
+                    value += byte;
+                checksum += value;
+            });
+        });
+
+        fprintf(f, "%u entries, %u KB each (%lld, %llu)\n", ENTRIES, ENTRY_SECTORS * ImgArchive::SECTOR_SIZE / 1024,
+            (long long)sum, (unsigned long long)checksum.load());
+        fprintf(f, "open and index (ms):           %10.3f\n", open / 1000000.0);
+        fprintf(f, "linear name lookup (ns):       %10.2f\n", linear);
+        fprintf(f, "hashed name lookup (ns):       %10.2f\n", hashed);
+        fprintf(f, "checksum all entries (ms):     %10.3f\n", serial / 1000000.0);
+        fprintf(f, "checksum in parallel (ms):     %10.3f\n", parallel / 1000000.0);
+
+        archive.Close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+    static void WriteArchive(std::filesystem::path const& path, std::vector<std::string> const& names)
+    {
+        uint32_t count = (uint32_t)names.size();
+        uint32_t firstSector = (8 + count * 32 + ImgArchive::SECTOR_SIZE - 1) / ImgArchive::SECTOR_SIZE;
+
+        std::vector<uint8_t> header(firstSector * ImgArchive::SECTOR_SIZE, 0);
+        memcpy(header.data(), "VER2", 4);
+        memcpy(header.data() + 4, &count, 4);
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t* entry = header.data() + 8 + i * 32;
+            uint32_t offset = firstSector + i * ENTRY_SECTORS;
+            uint16_t size = ENTRY_SECTORS;
+            memcpy(entry, &offset, 4);
+            memcpy(entry + 4, &size, 2);
+            memcpy(entry + 8, names[i].c_str(), (std::min)(names[i].size(), size_t(23)));
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(header.data()), header.size());
+        std::vector<char> sectors(ENTRY_SECTORS * ImgArchive::SECTOR_SIZE);
+        for (uint32_t i = 0; i < count; i++) {
+            memset(sectors.data(), (int)(i & 0xFF), sectors.size());
+            file.write(sectors.data(), sectors.size());
+        }
+    }
+} gInstance;
@@ -0,0 +1,112 @@
+#include <plugin.h>
+#include <MapDataFile.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    static constexpr int32_t INSTANCES = 50000;
+
+    Main()
+    {
+        benchmark::Report f("MapDataFileBenchmark.txt");
+        if (!f)
+            return;
+
+        std::filesystem::path dir = std::filesystem::temp_directory_path();
+        std::string text = (dir / "MapDataFileBenchmark.ipl").string();
+        std::string binary = (dir / "MapDataFileBenchmark_stream0.ipl").string();
+        WriteFiles(text, binary);
+
+        // what CFileLoader does: a line at a time into a buffer, then sscanf
+        size_t sscanfCount = 0;
+        double sscanfTime = benchmark::Measure(1, [&] {
+            FILE* file = nullptr;
+            if (fopen_s(&file, text.c_str(), "r") != 0 || !file)
+                return;
+            char line[512];
+            bool inInst = false;
+            while (fgets(line, sizeof(line), file)) {
+                if (!inInst) {
+                    inInst = strncmp(line, "inst", 4) == 0;
+                    continue;
+                }
+                if (strncmp(line, "end", 3) == 0) {
+                    inInst = false;
+                    continue;
+                }
+                for (char* c = line; *c; c++) {
+                    if (*c == ',')
+                        *c = ' ';
+                }
+                int32_t id, interior, lod;
+                char name[24];
+                float px, py, pz, rx, ry, rz, rw;
+                if (sscanf_s(line, "%d %23s %d %f %f %f %f %f %f %f %d", &id, name, (unsigned)sizeof(name), &interior, &px, &py, &pz, &rx, &ry, &rz, &rw, &lod) == 11)
+                    sscanfCount++;
+            }
+            fclose(file);
+        });
+
+        MapDataFile file;
+        size_t textCount = 0, binaryCount = 0;
+        double textTime = benchmark::Measure(1, [&] {
+            file.Load(text);
+            textCount = file.GetInstances().size();
+        });
+        double binaryTime = benchmark::Measure(1, [&] {
+            file.Load(binary);
+            binaryCount = file.GetInstances().size();
+        });
+        file.Clear();
+
+        fprintf(f, "%d instances (%u %u %u)\n", INSTANCES, (unsigned)sscanfCount, (unsigned)textCount, (unsigned)binaryCount);
+        fprintf(f, "text, fgets and sscanf (ms):   %10.3f\n", sscanfTime / 1000000.0);
+        fprintf(f, "text, MapDataFile (ms):        %10.3f\n", textTime / 1000000.0);
+        fprintf(f, "binary, MapDataFile (ms):      %10.3f\n", binaryTime / 1000000.0);
+
+        std::error_code error;
+        std::filesystem::remove(text, error);
+        std::filesystem::remove(binary, error);
+    }
+
+    static void WriteFiles(std::string const& text, std::string const& binary)
+    {
+        std::vector<MapDataFile::Instance> instances(INSTANCES);
+        std::string lines = "# generated\ninst\n";
+        char line[256];
+        for (int32_t i = 0; i < INSTANCES; i++) {
+            MapDataFile::Instance& inst = instances[i];
+            inst = { { i * 0.25f, -i * 0.5f, 10.0f + (i % 100) }, { 0.0f, 0.0f, -0.7071068f, 0.7071068f }, 600 + i % 18000, (uint32_t)(i % 19), i % 7 ? -1 : i + 1 };
+            snprintf(line, sizeof(line), "%d, model%d, %u, %.6f, %.6f, %.6f, %.7f, %.7f, %.7f, %.7f, %d\n", inst.modelId, inst.modelId, inst.flags,
+                inst.position[0], inst.position[1], inst.position[2], inst.rotation[0], inst.rotation[1], inst.rotation[2], inst.rotation[3], inst.lod);
+            lines += line;
+        }
+        lines += "end\n";
+        FILE* file = nullptr;
+        if (fopen_s(&file, text.c_str(), "wb") == 0 && file) {
+            fwrite(lines.data(), 1, lines.size(), file);
+            fclose(file);
+        }
+
+        uint8_t header[0x4C] = {};
+        int32_t count = INSTANCES;
+        uint32_t offset = sizeof(header);
+        uint32_t end = offset + INSTANCES * sizeof(MapDataFile::Instance);
+        memcpy(header, "bnry", 4);
+        memcpy(header + 0x04, &count, 4);
+        memcpy(header + 0x1C, &offset, 4);
+        memcpy(header + 0x3C, &end, 4);
+        if (fopen_s(&file, binary.c_str(), "wb") == 0 && file) {
+            fwrite(header, 1, sizeof(header), file);
+            fwrite(instances.data(), sizeof(MapDataFile::Instance), instances.size(), file);
+            fclose(file);
+        }
+    }
+} gInstance;
@@ -0,0 +1,110 @@
+#include <plugin.h>
+#include <Hooking.Patterns.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace plugin;
+
+struct Main
+{
+    static constexpr size_t BUFFER_SIZE = 32 << 20;
+    static constexpr int RUNS = 5;
+
+    // x is a byte taken from the buffer, ? a wildcard
+    struct Shape {
+        const char* name;
+        const char* layout;
+    };
+
+    Main()
+    {
+        benchmark::Report f("PatternScanBenchmark.txt");
+        if (!f)
+            return;
+
+        std::vector<uint8_t> buffer = MakeBuffer(BUFFER_SIZE);
+        uintptr_t begin = reinterpret_cast<uintptr_t>(buffer.data()), end = begin + buffer.size();
+
+        const Shape shapes[] = {
+            { "4 bytes", "xxxx" },
+            { "16 bytes", "xxxxxxxxxxxxxxxx" },
+            { "call rel32", "x????xxxxx" },
+            { "wildcard first", "??xxxxxxxx" },
+            { "sparse", "x?x?x?x?x?x?" },
+        };
+        const hook::scan_simd_level levels[] = { hook::scan_simd_level::none, hook::scan_simd_level::sse2, hook::scan_simd_level::avx2 };
+
+        unsigned threads = hook::get_scan_threads();
+        hook::scan_simd_level best = hook::get_scan_simd_level();
+
+        fprintf(f, "%zu MB of code-like bytes, best of %d runs, MB/s\n", BUFFER_SIZE >> 20, RUNS);
+        fprintf(f, "%-16s %10s %10s %10s %10s %8s\n", "pattern", "scalar", "sse2", "avx2", "threads", "matches");
+        for (size_t i = 0; i < std::size(shapes); i++) {
+            std::string pattern = MakePattern(buffer, (i + 1) * 7919 * 4099 % (BUFFER_SIZE - 64), shapes[i].layout);
+            size_t expected = 0;
+            bool ok = true;
+
+            fprintf(f, "%-16s", shapes[i].name);
+            hook::set_scan_threads(1);
+            for (auto level : levels) {
+                hook::set_scan_simd_level(level);
+                // the CPU doesn't have it, the scan would fall back to a lower one
+                if (hook::get_scan_simd_level() != level) {
+                    fprintf(f, " %10s", "n/a");
+                    continue;
+                }
+                size_t matches = 0;
+                double time = benchmark::MeasureBest(RUNS, [&] { matches = hook::range_pattern(begin, end, pattern).size(); });
+                if (level == hook::scan_simd_level::none)
+                    expected = matches;
+                else if (matches != expected)
+                    ok = false;
+                fprintf(f, " %10.1f", Throughput(time));
+            }
+
+            hook::set_scan_simd_level(best);
+            hook::set_scan_threads(threads);
+            size_t matches = 0;
+            double time = benchmark::MeasureBest(RUNS, [&] { matches = hook::range_pattern(begin, end, pattern).size(); });
+            if (matches != expected)
+                ok = false;
+            fprintf(f, " %10.1f %8zu%s\n", Throughput(time), expected, ok ? "" : " MISMATCH");
+        }
+        fprintf(f, "%u scan threads\n", threads);
+    }
+
+    // mostly small values and zeroes, first bytes of patterns show up often as in real code
+    static std::vector<uint8_t> MakeBuffer(size_t size)
+    {
+        std::vector<uint8_t> buffer(size);
+        uint32_t state = 12345;
+        for (auto& value : buffer) {
+            state = state * 1664525u + 1013904223u;
+            value = (state >> 24) % 4 == 0 ? 0 : (uint8_t)((state >> 8) % 64);
+        }
+        return buffer;
+    }
+
+    static std::string MakePattern(std::vector<uint8_t> const& buffer, size_t offset, const char* layout)
+    {
+        std::string pattern;
+        char byte[4];
+        for (size_t i = 0; layout[i]; i++) {
+            if (layout[i] == '?')
+                pattern += "? ";
+            else {
+                snprintf(byte, sizeof(byte), "%02X ", buffer[offset + i]);
+                pattern += byte;
+            }
+        }
+        return pattern;
+    }
+
+    static double Throughput(double nanoseconds)
+    {
+        return BUFFER_SIZE / (1024.0 * 1024.0) / (nanoseconds / 1000000000.0);
+    }
+} gInstance;
@@ -0,0 +1,87 @@
+#include <plugin.h>
+#include <CPool.h>
+#include <extensions/Benchmark.h>
+#include <atomic>
+#include <cstdio>
+#include <random>
+
+using namespace plugin;
+
+struct BenchObject {
+    int value;
+    char padding[60];
+};
+
+struct Main
+{
+    static constexpr int POOL_SIZE = 16384;
+    static constexpr int RUNS = 200;
+
+    Main()
+    {
+        benchmark::Report f("PoolIteratorBenchmark.txt");
+        if (!f)
+            return;
+
+        fprintf(f, "%d slots, average of %d runs, microseconds\n", POOL_SIZE, RUNS);
+        fprintf(f, "%-8s %10s %10s %10s %10s\n", "density", "used", "bytewise", "iterator", "parallel");
+        for (int density : { 1, 10, 50, 90, 100 })
+            Run(f, density);
+    }
+
+    // the per-slot loop PoolIterator used before
+    static long long SumBytewise(CPool<BenchObject>& pool)
+    {
+        long long sum = 0;
+        for (int i = 0; i < pool.m_nSize; ++i) {
+            if (!pool.IsFreeSlotAtIndex(i))
+                sum += pool.m_pObjects[i].value;
+        }
+        return sum;
+    }
+
+    static long long SumIterator(CPool<BenchObject>& pool)
+    {
+        long long sum = 0;
+        for (auto obj : pool)
+            sum += obj->value;
+        return sum;
+    }
+
+    static long long SumParallel(CPool<BenchObject>& pool)
+    {
+        std::atomic<long long> sum{ 0 };
+        ForEachParallel(pool, [&sum](BenchObject* obj) { sum += obj->value; });
+        return sum;
+    }
+
+    template<typename Fn>
+    static double Measure(CPool<BenchObject>& pool, Fn fn, long long expected, bool& ok)
+    {
+        return benchmark::Measure(RUNS, [&] {
+            if (fn(pool) != expected)
+                ok = false;
+        }) / 1000.0;
+    }
+
+    void Run(FILE* f, int density)
+    {
+        CPool<BenchObject> pool(POOL_SIZE, "Benchmark");
+        std::mt19937 rng(density);
+        for (int i = 0; i < POOL_SIZE; ++i) {
+            if (static_cast<int>(rng() % 100) < density) {
+                pool.SetFreeAt(i, false);
+                pool.m_pObjects[i].value = i;
+            }
+        }
+
+        long long expected = SumBytewise(pool);
+        bool ok = true;
+        double bytewise = Measure(pool, SumBytewise, expected, ok);
+        double iterator = Measure(pool, SumIterator, expected, ok);
+        double parallel = Measure(pool, SumParallel, expected, ok);
+
+        fprintf(f, "%-7d%% %10u %10.2f %10.2f %10.2f%s\n", density, pool.GetNoOfUsedSpaces(),
+            bytewise, iterator, parallel, ok ? "" : " MISMATCH");
+    }
+} gInstance;
@@ -0,0 +1,61 @@
+#include <plugin.h>
+#include <extensions/Benchmark.h>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace plugin;
+
+// RandomNumberInRange as it was: a random_device and a fresh mt19937 on every call
+template<typename T>
+static T OldRandomNumberInRange(T min, T max) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    if constexpr (std::is_integral<T>::value) {
+        std::uniform_int_distribution<T> dis(min, max);
+        return dis(gen);
+    }
+    else {
+        std::uniform_real_distribution<T> dis(min, max);
+        return dis(gen);
+    }
+}
+
+struct Main
+{
+    static constexpr int CALLS = 1000000;
+    static constexpr int OLD_CALLS = 20000; // it's too slow for more
+
+    Main()
+    {
+        benchmark::Report f("RandomBenchmark.txt");
+        if (!f)
+            return;
+
+        int64_t sum = 0;
+        double old = benchmark::Measure(OLD_CALLS, [&] { sum += OldRandomNumberInRange(0, 999); });
+        double current = benchmark::Measure(CALLS, [&] { sum += RandomNumberInRange(0, 999); });
+        double pcg = 0.0;
+        {
+            random::Pcg32 gen(1);
+            pcg = benchmark::Measure(CALLS, [&] { sum += random::InRange(gen, 0, 999); });
+        }
+
+        std::vector<int32_t> ints(CALLS);
+        std::vector<float> floats(CALLS);
+        double fillInts = benchmark::Measure(1, [&] { random::FillInRange(ints.data(), ints.size(), 0, 999); }) / CALLS;
+        double fillFloats = benchmark::Measure(1, [&] { random::FillInRange(floats.data(), floats.size(), -1.0f, 1.0f); }) / CALLS;
+        double oldFloat = benchmark::Measure(OLD_CALLS, [&] { sum += (int64_t)OldRandomNumberInRange(0.0f, 1.0f); });
+        double currentFloat = benchmark::Measure(CALLS, [&] { sum += (int64_t)RandomNumberInRange(0.0f, 1.0f); });
+
+        fprintf(f, "nanoseconds per number (%lld)\n", (long long)(sum + ints[0] + (int64_t)floats[0]));
+        fprintf(f, "old RandomNumberInRange(0, 999):      %10.2f\n", old);
+        fprintf(f, "RandomNumberInRange(0, 999):          %10.2f\n", current);
+        fprintf(f, "random::InRange(Pcg32, 0, 999):       %10.2f\n", pcg);
+        fprintf(f, "random::FillInRange int, 0..999:      %10.2f\n", fillInts);
+        fprintf(f, "old RandomNumberInRange(0.0f, 1.0f):  %10.2f\n", oldFloat);
+        fprintf(f, "RandomNumberInRange(0.0f, 1.0f):      %10.2f\n", currentFloat);
+        fprintf(f, "random::FillInRange float, -1..1:     %10.2f\n", fillFloats);
+    }
+} gInstance;
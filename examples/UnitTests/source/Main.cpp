@@ -2,6 +2,27 @@
 #include "utest.h"
 //#include "Test_CVector.h"
 #include "Test_PluginSA_CMatrix.h"
+#include "Test_HintCache.h"
+#include "Test_PatternBatch.h"
+#include "Test_AddressTable.h"
+#include "Test_ThreadPool.h"
+#include "Test_PoolSlots.h"
+#include "Test_Extender.h"
+#include "Test_EventList.h"
+#include "Test_PatchTransaction.h"
+#include "Test_EventProfiler.h"
+#include "Test_Config.h"
+#include "Test_ConfigWatcher.h"
+#include "Test_TextLoader.h"
+#include "Test_SpriteDecoder.h"
+#include "Test_TextureCompressor.h"
+#include "Test_VoiceScheduler.h"
+#include "Test_Random.h"
+#include "Test_ImgArchive.h"
+#include "Test_CollisionFile.h"
+#include "Test_CollisionBvh.h"
+#include "Test_MapDataFile.h"
+#include "Test_AnimationFile.h"
 
 using namespace plugin;
 
@@ -0,0 +1,37 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+
+#if defined(GTASA) || defined(GTA3) || defined(GTAVC)
+UTEST(AddressTable, MatchesByVersionDyn)
+{
+    // values only used by this test, so the entries are added here
+#ifdef GTASA
+    uintptr_t address = GLOBAL_ADDRESS_BY_VERSION(0x123450, 0x123460, 0x123470, 0x123480, 0x123490, 0x1234A0);
+    int offset = ADDRESS_BY_VERSION(-8, -8, -8, -8, -12, -12);
+    EXPECT_EQ(address, plugin::GetGlobalAddress(plugin::by_version_dyn(0x123450, 0x123460, 0x123470, 0x123480, 0x123490, 0x1234A0)));
+    EXPECT_EQ(offset, plugin::by_version_dyn(-8, -8, -8, -8, -12, -12));
+#else
+    uintptr_t address = GLOBAL_ADDRESS_BY_VERSION(0x123450, 0x123460, 0x123470);
+    int offset = ADDRESS_BY_VERSION(-8, -8, -12);
+    EXPECT_EQ(address, plugin::GetGlobalAddress(plugin::by_version_dyn(0x123450, 0x123460, 0x123470)));
+    EXPECT_EQ(offset, plugin::by_version_dyn(-8, -8, -12));
+#endif
+}
+
+UTEST(AddressTable, OneEntryPerValues)
+{
+    unsigned int count = plugin::AddressTable::Count();
+    for (int i = 0; i < 3; i++) {
+#ifdef GTASA
+        GLOBAL_ADDRESS_BY_VERSION(0x234560, 0x234570, 0x234580, 0x234590, 0x2345A0, 0x2345B0);
+        ADDRESS_BY_VERSION(0x234560, 0x234570, 0x234580, 0x234590, 0x2345A0, 0x2345B0);
+#else
+        GLOBAL_ADDRESS_BY_VERSION(0x234560, 0x234570, 0x234580);
+        ADDRESS_BY_VERSION(0x234560, 0x234570, 0x234580);
+#endif
+    }
+    // the same values as an address and as an offset are two entries
+    EXPECT_EQ(plugin::AddressTable::Count(), count + 2);
+}
+#endif
@@ -0,0 +1,286 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <AnimationFile.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace AnimationFileTest {
+    template<typename T>
+    void Put(std::vector<uint8_t>& out, T value) {
+        uint8_t bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void PutName(std::vector<uint8_t>& out, const char* name, size_t size) {
+        std::vector<char> padded(size);
+        memcpy(padded.data(), name, (std::min)(strlen(name), size - 1));
+        out.insert(out.end(), padded.begin(), padded.end());
+    }
+
+    static void PutChunk(std::vector<uint8_t>& out, const char* fourcc, uint32_t size) {
+        out.insert(out.end(), fourcc, fourcc + 4);
+        Put(out, size);
+    }
+
+    // ANP3: "walk" with a root bone of 2 keys and a child bone of 5 keys
+    static void PutAnp3(std::vector<uint8_t>& out) {
+        out.insert(out.end(), { 'A', 'N', 'P', '3' });
+        Put<uint32_t>(out, 0);
+        PutName(out, "ped", 24);
+        Put<uint32_t>(out, 1);
+        PutName(out, "walk", 24);
+        Put<uint32_t>(out, 2);
+        Put<uint32_t>(out, 2 * 16 + 5 * 10);
+        Put<uint32_t>(out, 1);
+        PutName(out, "Root", 24);
+        Put<uint32_t>(out, 2);
+        Put<uint32_t>(out, 2);
+        Put<int32_t>(out, 0);
+        for (int16_t value : { 0, 0, 0, 4096, 0, 1024, -2048, 512, 0, 0, 4096, 0, 60, 3072, 0, -1024 })
+            Put(out, value);
+        PutName(out, "Pelvis", 24);
+        Put<uint32_t>(out, 1);
+        Put<uint32_t>(out, 5);
+        Put<int32_t>(out, 1);
+        for (int16_t i = 0; i < 5; i++) {
+            for (int16_t value : { 0, 0, 0, 4096 })
+                Put(out, value);
+            Put<int16_t>(out, i * 15);
+        }
+    }
+
+    // ANPK: "idle" with one KRT0 bone of 2 keys and an empty one
+    static void PutAnpk(std::vector<uint8_t>& out) {
+        PutChunk(out, "ANPK", 0);
+        PutChunk(out, "INFO", 10);
+        Put<uint32_t>(out, 1);
+        PutName(out, "ped", 8);
+        PutChunk(out, "NAME", 5);
+        PutName(out, "idle", 8);
+        PutChunk(out, "DGAN", 0);
+        PutChunk(out, "INFO", 8);
+        Put<uint32_t>(out, 2);
+        Put<uint32_t>(out, 0);
+        PutChunk(out, "CPAN", 0);
+        PutChunk(out, "ANIM", 44);
+        PutName(out, "Root", 28);
+        Put<uint32_t>(out, 2);
+        Put<uint32_t>(out, 0);
+        Put<int32_t>(out, -1);
+        Put<int32_t>(out, 7);
+        PutChunk(out, "KRT0", 64);
+        for (float value : { 0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 5.0f, 0.5f })
+            Put(out, value);
+        PutChunk(out, "CPAN", 0);
+        PutChunk(out, "ANIM", 40);
+        PutName(out, "Head", 28);
+        Put<uint32_t>(out, 0);
+        Put<uint32_t>(out, 0);
+        Put<int32_t>(out, -1);
+    }
+
+    static void ReferenceSlerp(float const* a, float const* b, float t, float* out) {
+        // CQuaternion::Slerp(from, to, theta, invSin, t) with theta = acos(dot)
+        float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        float theta = std::acos(dot > 1.0f ? 1.0f : dot < -1.0f ? -1.0f : dot);
+        float invSin = 1.0f / std::sin(theta);
+        float w1, w2;
+        if (theta > 3.14159265f / 2.0f) {
+            theta = 3.14159265f - theta;
+            w1 = std::sin((1.0f - t) * theta) * invSin;
+            w2 = -std::sin(t * theta) * invSin;
+        }
+        else {
+            w1 = std::sin((1.0f - t) * theta) * invSin;
+            w2 = std::sin(t * theta) * invSin;
+        }
+        for (int i = 0; i < 4; i++)
+            out[i] = w1 * a[i] + w2 * b[i];
+    }
+}
+
+UTEST(AnimationFile, LoadAnp3) {
+    using namespace AnimationFileTest;
+    std::vector<uint8_t> data;
+    PutAnp3(data);
+    plugin::AnimationFile file;
+    ASSERT_TRUE(file.Load(data));
+    EXPECT_STREQ(file.GetName().c_str(), "ped");
+    ASSERT_EQ(file.GetNumAnimations(), 1u);
+    ASSERT_EQ(file.GetNumSequences(), 2u);
+    EXPECT_EQ(file.FindAnimation("WALK"), 0);
+    EXPECT_EQ(file.FindAnimation("run"), -1);
+
+    auto const& animation = file.GetAnimation(0);
+    EXPECT_EQ(animation.numSequences, 2u);
+    EXPECT_NEAR(animation.duration, 1.0f, 1e-6f);
+
+    auto const& root = file.GetSequence(0);
+    auto const& pelvis = file.GetSequence(1);
+    EXPECT_STREQ(root.name.c_str(), "Root");
+    EXPECT_TRUE(root.hasTranslation);
+    EXPECT_EQ(root.numKeys, 2u);
+    EXPECT_FALSE(pelvis.hasTranslation);
+    EXPECT_EQ(pelvis.boneId, 1);
+    EXPECT_EQ(pelvis.firstKey, 2u);
+    EXPECT_EQ(pelvis.numKeys, 5u);
+
+    auto const& keys = file.GetKeys();
+    EXPECT_EQ(keys.rotW[0], 1.0f);
+    EXPECT_EQ(keys.posX[0], 1.0f);
+    EXPECT_EQ(keys.posY[0], -2.0f);
+    EXPECT_EQ(keys.posZ[0], 0.5f);
+    EXPECT_EQ(keys.time[1], 1.0f);
+    EXPECT_EQ(keys.rotZ[1], 1.0f);
+    EXPECT_EQ(keys.posX[1], 3.0f);
+    EXPECT_EQ(keys.posZ[1], -1.0f);
+    EXPECT_NEAR(keys.time[6], 1.0f, 1e-6f);
+    EXPECT_EQ(keys.posX[6], 0.0f);
+
+    data.resize(data.size() - 1);
+    EXPECT_FALSE(file.Load(data));
+    EXPECT_EQ(file.GetNumAnimations(), 0u);
+}
+
+UTEST(AnimationFile, LoadAnpk) {
+    using namespace AnimationFileTest;
+    std::vector<uint8_t> data;
+    PutAnpk(data);
+    plugin::AnimationFile file;
+    ASSERT_TRUE(file.Load(data));
+    ASSERT_EQ(file.GetNumAnimations(), 1u);
+    EXPECT_STREQ(file.GetAnimation(0).name.c_str(), "idle");
+    EXPECT_NEAR(file.GetAnimation(0).duration, 0.5f, 1e-6f);
+    ASSERT_EQ(file.GetNumSequences(), 2u);
+    EXPECT_EQ(file.GetSequence(0).boneId, 7);
+    EXPECT_TRUE(file.GetSequence(0).hasTranslation);
+    EXPECT_EQ(file.GetSequence(1).boneId, -1);
+    EXPECT_EQ(file.GetSequence(1).numKeys, 0u);
+
+    // conjugated like the game does
+    auto const& keys = file.GetKeys();
+    EXPECT_EQ(keys.rotX[0], -0.5f);
+    EXPECT_EQ(keys.rotW[0], 0.5f);
+    EXPECT_EQ(keys.posZ[1], 5.0f);
+    EXPECT_EQ(keys.time[1], 0.5f);
+
+    // the empty sequence samples to no rotation
+    float out[7][2];
+    file.SampleAnimation(0, 0.25f, out[0], out[1], out[2], out[3], out[4], out[5], out[6]);
+    EXPECT_EQ(out[3][1], 1.0f);
+    EXPECT_EQ(out[4][1], 0.0f);
+    EXPECT_NEAR(out[6][0], 4.0f, 1e-5f);
+}
+
+UTEST(AnimationFile, CompressKeys) {
+    constexpr size_t count = 11;
+    float time[count], rot[4][count], pos[3][count];
+    for (size_t i = 0; i < count; i++) {
+        time[i] = i * 0.1f;
+        for (size_t c = 0; c < 4; c++)
+            rot[c][i] = std::sin(float(i * 4 + c)) * (c == 3 ? 9.0f : 1.0f);
+        for (size_t c = 0; c < 3; c++)
+            pos[c][i] = (float(i) - 5.0f) * (c + 1) * 0.9f;
+    }
+    for (bool root : { false, true }) {
+        std::vector<int16_t> compressed(count * 8);
+        plugin::AnimationFile::CompressKeys(time, rot[0], rot[1], rot[2], rot[3], pos[0], pos[1], pos[2], count, root, compressed.data());
+        size_t stride = root ? 8 : 5;
+        for (size_t i = 0; i < count; i++) {
+            int16_t const* key = &compressed[i * stride];
+            for (size_t c = 0; c < 3; c++)
+                EXPECT_EQ(key[c], (int16_t)(rot[c][i] * 4096.0f));
+            EXPECT_EQ(key[3], rot[3][i] * 4096.0f > 32767.0f ? 32767 : rot[3][i] * 4096.0f < -32768.0f ? -32768 : (int16_t)(rot[3][i] * 4096.0f));
+            EXPECT_EQ(key[4], (int16_t)(time[i] * 60.0f + 0.5f));
+            if (root) {
+                for (size_t c = 0; c < 3; c++)
+                    EXPECT_EQ(key[5 + c], (int16_t)(pos[c][i] * 1024.0f));
+            }
+        }
+
+        float outTime[count], outRot[4][count], outPos[3][count] = {};
+        plugin::AnimationFile::DecompressKeys(compressed.data(), count, root, outTime,
+            outRot[0], outRot[1], outRot[2], outRot[3], outPos[0], outPos[1], outPos[2]);
+        for (size_t i = 0; i < count; i++) {
+            int16_t const* key = &compressed[i * stride];
+            for (size_t c = 0; c < 4; c++)
+                EXPECT_EQ(outRot[c][i], key[c] / 4096.0f);
+            EXPECT_NEAR(outTime[i], key[4] / 60.0f, 1e-6f);
+            for (size_t c = 0; c < 3; c++)
+                EXPECT_EQ(outPos[c][i], root ? key[5 + c] / 1024.0f : 0.0f);
+        }
+    }
+}
+
+UTEST(AnimationFile, SampleMatchesSlerp) {
+    using namespace AnimationFileTest;
+    // one sequence per pair of keys, with rotations far apart, on opposite sides and nearly the same
+    constexpr uint32_t count = 13;
+    std::vector<uint8_t> data;
+    data.insert(data.end(), { 'A', 'N', 'P', '3' });
+    Put<uint32_t>(data, 0);
+    PutName(data, "test", 24);
+    Put<uint32_t>(data, 1);
+    PutName(data, "sample", 24);
+    Put<uint32_t>(data, count);
+    Put<uint32_t>(data, count * 2 * 10);
+    Put<uint32_t>(data, 1);
+    std::vector<float> expected[4];
+    for (uint32_t s = 0; s < count; s++) {
+        PutName(data, "bone", 24);
+        Put<uint32_t>(data, 1);
+        Put<uint32_t>(data, 2);
+        Put<int32_t>(data, s);
+        float a[4], b[4];
+        float length = 0.0f;
+        for (int c = 0; c < 4; c++) {
+            a[c] = std::cos(float(s * 3 + c));
+            length += a[c] * a[c];
+        }
+        for (int c = 0; c < 4; c++)
+            a[c] /= std::sqrt(length);
+        for (int c = 0; c < 4; c++)
+            b[c] = s % 3 == 0 ? -a[c] : s % 3 == 1 ? a[c] : a[(c + s) % 4] * (c % 2 ? -1.0f : 1.0f);
+        int16_t keys[2][4];
+        for (int c = 0; c < 4; c++) {
+            keys[0][c] = (int16_t)(a[c] * 4096.0f);
+            keys[1][c] = (int16_t)(b[c] * 4096.0f);
+            a[c] = keys[0][c] / 4096.0f;
+            b[c] = keys[1][c] / 4096.0f;
+        }
+        if (s % 3 == 1)
+            keys[1][0] += 3;
+        b[0] = keys[1][0] / 4096.0f;
+        for (int k = 0; k < 2; k++) {
+            for (int c = 0; c < 4; c++)
+                Put(data, keys[k][c]);
+            Put<int16_t>(data, k * 60);
+        }
+        float t = 0.3f;
+        float rotation[4];
+        ReferenceSlerp(a, b, t, rotation);
+        for (int c = 0; c < 4; c++)
+            expected[c].push_back(rotation[c]);
+    }
+    plugin::AnimationFile file;
+    ASSERT_TRUE(file.Load(data));
+
+    float out[7][count];
+    file.SampleAnimation(0, 0.3f, out[0], out[1], out[2], out[3], out[4], out[5], out[6]);
+    for (uint32_t s = 0; s < count; s++) {
+        for (int c = 0; c < 4; c++)
+            EXPECT_NEAR(out[c][s], expected[c][s], 1e-4f);
+    }
+
+    // held at the ends
+    uint32_t indices[] = { 2, 2 };
+    float before[7][2];
+    file.Sample(indices, 2, -1.0f, before[0], before[1], before[2], before[3], before[4], before[5], before[6]);
+    EXPECT_NEAR(before[0][0], file.GetKeys().rotX[4], 1e-6f);
+    file.Sample(indices, 2, 5.0f, before[0], before[1], before[2], before[3], before[4], before[5], before[6]);
+    EXPECT_NEAR(before[3][1], file.GetKeys().rotW[5], 1e-6f);
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <CollisionBvh.h>
+#include <Random.h>
+#include <cmath>
+#include <vector>
+
+namespace CollisionBvhTest {
+    // size x size quads of two triangles each, bumpy
+    struct Terrain {
+        std::vector<float> x, y, z;
+        std::vector<uint16_t> indices;
+        std::vector<uint8_t> material;
+
+        explicit Terrain(int32_t size) {
+            plugin::random::Pcg32 gen(7);
+            for (int32_t j = 0; j <= size; j++) {
+                for (int32_t i = 0; i <= size; i++) {
+                    x.push_back((float)i);
+                    y.push_back((float)j);
+                    z.push_back(plugin::random::InRange(gen, 0.0f, 2.0f));
+                }
+            }
+            for (int32_t j = 0; j < size; j++) {
+                for (int32_t i = 0; i < size; i++) {
+                    uint16_t a = (uint16_t)(j * (size + 1) + i), b = a + 1, c = a + size + 1, d = c + 1;
+                    uint16_t quad[] = { a, b, d, a, d, c };
+                    indices.insert(indices.end(), quad, quad + 6);
+                    material.push_back((uint8_t)i);
+                    material.push_back((uint8_t)j);
+                }
+            }
+        }
+
+        // every triangle, the same test as the hierarchy
+        float BruteForce(plugin::CollisionBvh::Segment const& s, uint32_t& triangle) const {
+            float best = 1.0f;
+            triangle = plugin::CollisionBvh::NO_HIT;
+            float d[3] = { s.end[0] - s.start[0], s.end[1] - s.start[1], s.end[2] - s.start[2] };
+            for (size_t t = 0; t < indices.size() / 3; t++) {
+                float v[3][3];
+                for (int k = 0; k < 3; k++) {
+                    uint16_t i = indices[t * 3 + k];
+                    v[k][0] = x[i]; v[k][1] = y[i]; v[k][2] = z[i];
+                }
+                float e1[3], e2[3], o[3];
+                for (int a = 0; a < 3; a++) {
+                    e1[a] = v[1][a] - v[0][a];
+                    e2[a] = v[2][a] - v[0][a];
+                    o[a] = s.start[a] - v[0][a];
+                }
+                float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+                float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+                if (det == 0.0f)
+                    continue;
+                float u = (o[0] * p[0] + o[1] * p[1] + o[2] * p[2]) / det;
+                float q[3] = { o[1] * e1[2] - o[2] * e1[1], o[2] * e1[0] - o[0] * e1[2], o[0] * e1[1] - o[1] * e1[0] };
+                float w = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+                float dist = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+                if (u >= 0.0f && w >= 0.0f && u + w <= 1.0f && dist >= 0.0f && dist < best) {
+                    best = dist;
+                    triangle = (uint32_t)t;
+                }
+            }
+            return best;
+        }
+    };
+}
+
+UTEST(CollisionBvh, StraightDown)
+{
+    CollisionBvhTest::Terrain terrain(4);
+    plugin::CollisionBvh bvh;
+    bvh.Build(terrain.x.data(), terrain.y.data(), terrain.z.data(), terrain.x.size(),
+        terrain.indices.data(), terrain.material.data(), nullptr, terrain.indices.size() / 3);
+    EXPECT_EQ(bvh.GetNumTriangles(), 32u);
+
+    plugin::CollisionBvh::Segment segments[] = {
+        { { 1.75f, 2.25f, 10.0f }, { 1.75f, 2.25f, -10.0f } },
+        { { 1.75f, 2.25f, 10.0f }, { 1.75f, 2.25f, 5.0f } },  // stops above
+        { { 9.0f, 9.0f, 10.0f }, { 9.0f, 9.0f, -10.0f } },    // outside
+    };
+    plugin::CollisionBvh::Hit hits[3];
+    EXPECT_EQ(bvh.Intersect(segments, 3, hits), 1u);
+
+    // the lower right triangle of quad 1, 2
+    EXPECT_EQ(hits[0].triangle, (uint32_t)((2 * 4 + 1) * 2));
+    EXPECT_EQ(hits[0].material, 1);
+    EXPECT_NEAR(hits[0].point[0], 1.75f, 1e-5f);
+    EXPECT_TRUE(hits[0].distance > 0.4f && hits[0].distance < 0.5f);
+    EXPECT_NEAR(hits[0].normal[0] * hits[0].normal[0] + hits[0].normal[1] * hits[0].normal[1] + hits[0].normal[2] * hits[0].normal[2], 1.0f, 1e-5f);
+    EXPECT_EQ(hits[1].triangle, plugin::CollisionBvh::NO_HIT);
+    EXPECT_EQ(hits[2].distance, 1.0f);
+    EXPECT_TRUE(bvh.IsBlocked(segments[0]));
+    EXPECT_FALSE(bvh.IsBlocked(segments[2]));
+}
+
+UTEST(CollisionBvh, MatchesBruteForce)
+{
+    CollisionBvhTest::Terrain terrain(40);
+    plugin::CollisionBvh bvh;
+    bvh.Build(terrain.x.data(), terrain.y.data(), terrain.z.data(), terrain.x.size(),
+        terrain.indices.data(), terrain.material.data(), nullptr, terrain.indices.size() / 3);
+    ASSERT_EQ(bvh.GetNumTriangles(), 3200u);
+    EXPECT_TRUE(bvh.GetNumNodes() < 3200u / 2);
+
+    plugin::random::Pcg32 gen(11);
+    std::vector<plugin::CollisionBvh::Segment> segments(2000);
+    for (auto& s : segments) {
+        for (int a = 0; a < 3; a++) {
+            s.start[a] = plugin::random::InRange(gen, -5.0f, 45.0f);
+            s.end[a] = plugin::random::InRange(gen, -5.0f, 45.0f);
+        }
+        s.start[2] = plugin::random::InRange(gen, -1.0f, 4.0f);
+        s.end[2] = plugin::random::InRange(gen, -1.0f, 4.0f);
+    }
+    std::vector<plugin::CollisionBvh::Hit> hits(segments.size());
+    size_t numHits = bvh.IntersectParallel(segments.data(), segments.size(), hits.data());
+    EXPECT_TRUE(numHits > 100);
+
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < segments.size(); i++) {
+        uint32_t triangle;
+        float distance = terrain.BruteForce(segments[i], triangle);
+        if (triangle != plugin::CollisionBvh::NO_HIT)
+            expectedHits++;
+        EXPECT_EQ(hits[i].triangle, triangle);
+        EXPECT_NEAR(hits[i].distance, distance, 1e-5f);
+        EXPECT_EQ(bvh.IsBlocked(segments[i]), triangle != plugin::CollisionBvh::NO_HIT);
+    }
+    EXPECT_EQ(numHits, expectedHits);
+}
+
+UTEST(CollisionBvh, DeepTree)
+{
+    // walls further and further apart: the splits cut off a few at a time, the tree gets as deep as it can
+    std::vector<float> x, y, z;
+    std::vector<uint16_t> indices;
+    float position = 1.0f;
+    for (uint16_t i = 0; i < 3000; i++, position *= 1.01f) {
+        float corners[3][3] = { { position, 0.0f, 0.0f }, { position, 1.0f, 0.0f }, { position, 0.0f, 1.0f } };
+        for (auto& corner : corners) {
+            x.push_back(corner[0]);
+            y.push_back(corner[1]);
+            z.push_back(corner[2]);
+        }
+        uint16_t triangle[] = { (uint16_t)(i * 3), (uint16_t)(i * 3 + 1), (uint16_t)(i * 3 + 2) };
+        indices.insert(indices.end(), triangle, triangle + 3);
+    }
+    plugin::CollisionBvh bvh;
+    bvh.Build(x.data(), y.data(), z.data(), x.size(), indices.data(), nullptr, nullptr, indices.size() / 3);
+
+    // through the box of every wall, but past the triangles
+    plugin::CollisionBvh::Segment through = { { 0.0f, 0.9f, 0.9f }, { position, 0.9f, 0.9f } };
+    plugin::CollisionBvh::Hit hit;
+    EXPECT_EQ(bvh.Intersect(&through, 1, &hit), 0u);
+    EXPECT_FALSE(bvh.IsBlocked(through));
+
+    plugin::CollisionBvh::Segment across = { { position, 0.25f, 0.25f }, { 0.0f, 0.25f, 0.25f } };
+    ASSERT_EQ(bvh.Intersect(&across, 1, &hit), 1u);
+    EXPECT_EQ(hit.triangle, 2999u);
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <CollisionFile.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace CollisionFileTest {
+    template<typename T>
+    void Put(std::vector<uint8_t>& out, T value) {
+        uint8_t bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void PutHeader(std::vector<uint8_t>& out, const char* fourcc, uint32_t size, const char* name, uint16_t id) {
+        out.insert(out.end(), fourcc, fourcc + 4);
+        Put(out, size);
+        char padded[22] = {};
+        memcpy(padded, name, (std::min)(strlen(name), size_t(21)));
+        out.insert(out.end(), padded, padded + 22);
+        Put(out, id);
+    }
+
+    static void PutFloats(std::vector<uint8_t>& out, std::vector<float> const& values) {
+        for (float value : values)
+            Put(out, value);
+    }
+
+    // COLL: a sphere, three vertices and a triangle
+    static void PutVer1(std::vector<uint8_t>& out) {
+        PutHeader(out, "COLL", 156, "barrel", 1337);
+        PutFloats(out, { 2.0f, 0.0f, 0.0f, 1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 2.0f });
+        Put<uint32_t>(out, 1);
+        PutFloats(out, { 1.0f, 0.0f, 0.0f, 1.0f });
+        Put<uint32_t>(out, 0x01020304); // surface
+        Put<uint32_t>(out, 0); // lines
+        Put<uint32_t>(out, 0); // boxes
+        Put<uint32_t>(out, 3);
+        PutFloats(out, { 0.25f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f });
+        Put<uint32_t>(out, 1);
+        Put<uint32_t>(out, 0);
+        Put<uint32_t>(out, 1);
+        Put<uint32_t>(out, 2);
+        Put<uint32_t>(out, 0x09000007); // material 7, light 9
+    }
+
+    // COL3: a sphere, a box, two triangles with a face group and a shadow triangle
+    static void PutVer3(std::vector<uint8_t>& out) {
+        PutHeader(out, "COL3", 260, "lamppost", 42);
+        PutFloats(out, { -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 5.0f, 0.0f, 0.0f, 2.5f, 3.0f });
+        Put<uint16_t>(out, 1);
+        Put<uint16_t>(out, 1);
+        Put<uint16_t>(out, 2);
+        Put<uint16_t>(out, 0);
+        Put<uint32_t>(out, 2 | 8 | 16);
+        for (uint32_t offset : { 116, 136, 164, 164, 220, 0, 1, 236, 256 })
+            Put(out, offset);
+
+        PutFloats(out, { 0.0f, 0.0f, 4.0f, 0.5f });
+        Put<uint32_t>(out, 0x00000005);
+        PutFloats(out, { -0.25f, -0.25f, 0.0f, 0.25f, 0.25f, 4.0f });
+        Put<uint32_t>(out, 0x00000006);
+        for (int16_t value : { -128, -64, 0, 128, 0, 0, 0, 128, 640, 32767, -32768, 1 })
+            Put(out, value);
+        PutFloats(out, { -1.0f, -0.5f, 0.0f, 256.0f, 1.0f, 5.0f });
+        Put<uint16_t>(out, 0);
+        Put<uint16_t>(out, 1);
+        Put<uint32_t>(out, 1);
+        for (uint16_t value : { 0, 1, 2 })
+            Put(out, value);
+        Put<uint16_t>(out, 0x0203);
+        for (uint16_t value : { 1, 2, 3 })
+            Put(out, value);
+        Put<uint16_t>(out, 0x0405);
+        for (int16_t value : { 0, 0, 0, 128, 0, 0, 0, 128, 0, 0 })
+            Put(out, value);
+        for (uint16_t value : { 2, 1, 0 })
+            Put(out, value);
+        Put<uint16_t>(out, 0);
+    }
+}
+
+UTEST(CollisionFile, Load)
+{
+    using namespace CollisionFileTest;
+    std::vector<uint8_t> data;
+    PutVer1(data);
+    PutVer3(data);
+    ASSERT_EQ(data.size(), 164u + 268u);
+    data.resize(data.size() + 16, 0); // padding after the last model
+
+    plugin::CollisionFile file;
+    ASSERT_TRUE(file.Load(data));
+    ASSERT_EQ(file.GetNumModels(), 2u);
+    EXPECT_EQ(file.FindModel("LAMPPOST"), 1);
+    EXPECT_EQ(file.FindModel("lamp"), -1);
+
+    auto& barrel = file.GetModel(0);
+    EXPECT_EQ(barrel.version, plugin::CollisionFile::COL_VERSION_1);
+    EXPECT_EQ(barrel.modelId, 1337);
+    EXPECT_EQ(barrel.radius, 2.0f);
+    EXPECT_EQ(barrel.max[2], 2.0f);
+    EXPECT_EQ(barrel.vertices.count, 3u);
+    EXPECT_EQ(file.GetVertices().x[0], 0.25f);
+    EXPECT_EQ(file.GetSpheres().radius[0], 1.0f);
+    EXPECT_EQ(file.GetSpheres().surface[0].material, 4);
+    EXPECT_EQ(file.GetTriangles().indices[2], 2);
+    EXPECT_EQ(file.GetTriangles().material[0], 7);
+    EXPECT_EQ(file.GetTriangles().light[0], 9);
+
+    auto& lamppost = file.GetModel(1);
+    EXPECT_EQ(lamppost.version, plugin::CollisionFile::COL_VERSION_3);
+    EXPECT_EQ(lamppost.radius, 3.0f);
+    EXPECT_EQ(lamppost.spheres.first, 1u);
+    EXPECT_EQ(file.GetSpheres().z[1], 4.0f);
+    EXPECT_EQ(file.GetSpheres().radius[1], 0.5f);
+    EXPECT_EQ(file.GetBoxes().maxZ[0], 4.0f);
+    EXPECT_EQ(file.GetBoxes().surface[0].material, 6);
+    EXPECT_EQ(lamppost.vertices.first, 3u);
+    EXPECT_EQ(lamppost.vertices.count, 4u);
+    EXPECT_EQ(file.GetVertices().x[3], -1.0f);
+    EXPECT_EQ(file.GetVertices().y[3], -0.5f);
+    EXPECT_EQ(file.GetVertices().z[5], 5.0f);
+    EXPECT_EQ(file.GetVertices().x[6], 32767.0f / 128.0f);
+    EXPECT_EQ(file.GetVertices().y[6], -256.0f);
+    EXPECT_EQ(lamppost.triangles.count, 2u);
+    EXPECT_EQ(file.GetTriangles().indices[6], 1);
+    EXPECT_EQ(file.GetTriangles().material[2], 5);
+    EXPECT_EQ(file.GetTriangles().light[2], 4);
+    EXPECT_EQ(lamppost.faceGroups.count, 1u);
+    EXPECT_EQ(file.GetFaceGroups().maxX[0], 256.0f);
+    EXPECT_EQ(file.GetFaceGroups().last[0], 1);
+    EXPECT_EQ(lamppost.shadowVertices.count, 3u);
+    EXPECT_EQ(file.GetShadowVertices().y[2], 1.0f);
+    EXPECT_EQ(file.GetShadowTriangles().indices[0], 2);
+
+    // cut short
+    data.resize(100);
+    EXPECT_FALSE(file.Load(data));
+    EXPECT_EQ(file.GetNumModels(), 0u);
+}
+
+UTEST(CollisionFile, WriteRoundTrip)
+{
+    using namespace CollisionFileTest;
+    std::vector<uint8_t> data;
+    PutVer3(data);
+    PutVer1(data);
+
+    plugin::CollisionFile file;
+    ASSERT_TRUE(file.Load(data));
+    std::vector<uint8_t> written = file.Write();
+    plugin::CollisionFile again;
+    ASSERT_TRUE(again.Load(written));
+    ASSERT_EQ(again.GetNumModels(), 2u);
+    EXPECT_TRUE(again.Write() == written);
+
+    EXPECT_TRUE(again.GetVertices().x == file.GetVertices().x);
+    EXPECT_TRUE(again.GetVertices().z == file.GetVertices().z);
+    EXPECT_TRUE(again.GetTriangles().indices == file.GetTriangles().indices);
+    EXPECT_TRUE(again.GetFaceGroups().minY == file.GetFaceGroups().minY);
+    EXPECT_TRUE(again.GetShadowVertices().y == file.GetShadowVertices().y);
+    EXPECT_EQ(again.GetModel(0).flags, file.GetModel(0).flags);
+    EXPECT_EQ(again.GetModel(1).center[2], 1.0f);
+}
+
+UTEST(CollisionFile, DecompressVertices)
+{
+    std::vector<int16_t> compressed;
+    for (int i = 0; i < 19 * 3; i++)
+        compressed.push_back((int16_t)(i * 1237 - 30000));
+
+    // unaligned, like in a file
+    std::vector<uint8_t> bytes(compressed.size() * 2 + 1);
+    memcpy(bytes.data() + 1, compressed.data(), compressed.size() * 2);
+    float x[19], y[19], z[19];
+    plugin::CollisionFile::DecompressVertices(bytes.data() + 1, 19, x, y, z);
+    for (int i = 0; i < 19; i++) {
+        EXPECT_EQ(x[i], compressed[i * 3] / 128.0f);
+        EXPECT_EQ(y[i], compressed[i * 3 + 1] / 128.0f);
+        EXPECT_EQ(z[i], compressed[i * 3 + 2] / 128.0f);
+    }
+
+    std::vector<int16_t> back(compressed.size());
+    plugin::CollisionFile::CompressVertices(x, y, z, 19, back.data());
+    EXPECT_TRUE(back == compressed);
+}
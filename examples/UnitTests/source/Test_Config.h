@@ -0,0 +1,109 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <extensions/Config.h>
+#include <filesystem>
+
+// Config written to a temporary file, read back through plugin::config_file
+struct TestConfigFile {
+    std::string path;
+
+    TestConfigFile(const char *text) {
+        static int counter = 0;
+        path = (std::filesystem::temp_directory_path() / ("plugin_sdk_config_" + std::to_string(counter++) + ".ini")).string();
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+
+    ~TestConfigFile() {
+        std::filesystem::remove(path);
+    }
+
+    std::string Read() {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+UTEST(config_file, values)
+{
+    TestConfigFile file("# header\r\nIntValue 42 ; comment\r\nFloatValue\t-1.5f\r\nVec 1.0f 2.5 +3\r\nColor 255 128 0\r\nText \"hello world\"\r\nFlag no\r\n\r\nBroken abc\r\n");
+    plugin::config_file config(file.path);
+
+    EXPECT_EQ(config["IntValue"].asInt(), 42u);
+    EXPECT_EQ(config["IntValue"].asInt(7), 42u);
+    EXPECT_EQ(config["FloatValue"].asFloat(), -1.5f);
+    CVector vec = config["Vec"].asVec3d();
+    EXPECT_EQ(vec.x, 1.0f);
+    EXPECT_EQ(vec.y, 2.5f);
+    EXPECT_EQ(vec.z, 3.0f);
+    CRGBA color = config["Color"].asRGBA();
+    EXPECT_EQ(color.r, 255);
+    EXPECT_EQ(color.g, 128);
+    EXPECT_EQ(color.b, 0);
+    EXPECT_EQ(color.a, 255);
+    EXPECT_STREQ(config["Text"].asString().c_str(), "hello world");
+    EXPECT_FALSE(config["Flag"].asBool(true));
+    EXPECT_EQ(config["Broken"].asInt(7), 7u);
+    EXPECT_EQ(config["Broken"].asFloat(2.0f), 2.0f);
+    EXPECT_TRUE(config["Missing"].isEmpty());
+    EXPECT_EQ(config["Missing"].asInt(5), 5u);
+}
+
+UTEST(config_file, assignment_resets_cached_value)
+{
+    TestConfigFile file("Value 1\n");
+    plugin::config_file config(file.path);
+
+    EXPECT_EQ(config["Value"].asInt(), 1u);
+    config["Value"] = 2;
+    EXPECT_EQ(config["Value"].asInt(), 2u);
+    config["Value"] = 0.5f;
+    EXPECT_EQ(config["Value"].asFloat(), 0.5f);
+}
+
+UTEST(config_file, direct_value_change_resets_cached_value)
+{
+    TestConfigFile file("Value 1 2\n");
+    plugin::config_file config(file.path);
+
+    EXPECT_EQ(config["Value"].asInt(), 1u);
+    EXPECT_EQ(config["Value"].asRGBA().g, 2);
+    // written without going through operator=
+    config["Value"]._value = "3 4";
+    EXPECT_EQ(config["Value"].asInt(), 3u);
+    EXPECT_EQ(config["Value"].asRGBA().g, 4);
+    EXPECT_EQ(config["Value"].asFloat(), 3.0f);
+}
+
+UTEST(config_file, sections)
+{
+    TestConfigFile file("Global 1\n[First]\nValue 2\n[ Second ] ; tuned\nValue 3\nOther 4\n");
+    plugin::config_file config(file.path);
+
+    // without a section the first line with the name is found
+    EXPECT_EQ(config["Value"].asInt(), 2u);
+    EXPECT_EQ(config("", "Global").asInt(), 1u);
+    EXPECT_EQ(config("First", "Value").asInt(), 2u);
+    EXPECT_EQ(config("Second", "Value").asInt(), 3u);
+    EXPECT_TRUE(config("First", "Other").isEmpty());
+
+    config("First", "Added") = 5;
+    config("Third", "Value") = 6;
+    config.save();
+    std::string written = file.Read();
+    EXPECT_STREQ(written.c_str(), "Global 1\n[First]\nValue  2\nAdded  5\n[ Second ] ; tuned\nValue  3\nOther  4\n[Third]\nValue  6\n");
+}
+
+UTEST(config_file, write_keeps_comments_and_alignment)
+{
+    TestConfigFile file("Short = 1 # first\nLongerName = 2\n");
+    plugin::config_file config(file.path);
+
+    config["Short"] = 3;
+    config.save();
+    std::string written = file.Read();
+    EXPECT_STREQ(written.c_str(), "# first\nShort      = 3\nLongerName = 2\n");
+}
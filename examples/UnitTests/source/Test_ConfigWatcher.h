@@ -0,0 +1,100 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <extensions/ConfigWatcher.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+static void WriteTestConfig(std::filesystem::path const &path, const char *text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+UTEST(config_watcher, reload_fires_changed_keys)
+{
+    auto path = std::filesystem::temp_directory_path() / "plugin_sdk_config_watcher_reload.ini";
+    WriteTestConfig(path, "Speed 1.5\nCount 3\n[Colors]\nMain 255 0 0\n");
+    {
+        plugin::config_watcher config(path);
+        EXPECT_EQ(config["Speed"].asFloat(), 1.5f);
+
+        int speedCalls = 0, countCalls = 0, mainCalls = 0;
+        float speed = 0.0f;
+        config.onChange("Speed", [&](plugin::config_parameter &param) { speedCalls++; speed = param.asFloat(); });
+        config.onChange("Count", [&](plugin::config_parameter &) { countCalls++; });
+        config.onChange("Colors", "Main", [&](plugin::config_parameter &param) { mainCalls++; EXPECT_TRUE(param.isEmpty()); });
+
+        EXPECT_FALSE(config.update());
+
+        auto before = config.snapshot();
+        WriteTestConfig(path, "Speed 2.5\nCount 3\n");
+        config.reload();
+        EXPECT_TRUE(config.isReloadPending());
+        // readers keep the old snapshot until the game thread swaps it in
+        EXPECT_EQ(config["Speed"].asFloat(), 1.5f);
+        EXPECT_TRUE(config.update());
+
+        EXPECT_EQ(speedCalls, 1);
+        EXPECT_EQ(speed, 2.5f);
+        EXPECT_EQ(countCalls, 0);
+        EXPECT_EQ(mainCalls, 1);
+        EXPECT_EQ(config["Speed"].asFloat(), 2.5f);
+        // values of a shared snapshot are read from a copy
+        auto *oldSpeed = before->find("Speed");
+        ASSERT_TRUE(oldSpeed);
+        EXPECT_EQ(plugin::config_parameter(*oldSpeed).asFloat(), 1.5f);
+        EXPECT_EQ(config.snapshot()->find("Colors", "Main"), nullptr);
+    }
+    std::filesystem::remove(path);
+}
+
+UTEST(config_watcher, game_thread_lookups_leave_the_snapshot_alone)
+{
+    auto path = std::filesystem::temp_directory_path() / "plugin_sdk_config_watcher_shared.ini";
+    WriteTestConfig(path, "Speed 1.5\n");
+    {
+        plugin::config_watcher config(path);
+        auto shared = config.snapshot();
+        EXPECT_TRUE(config["Missing"].isEmpty());
+        EXPECT_EQ(config["Speed"].asFloat(), 1.5f);
+        // the key added on the game thread's copy isn't in the shared one
+        EXPECT_NE(config.get().find("Missing"), nullptr);
+        EXPECT_EQ(shared->find("Missing"), nullptr);
+        EXPECT_EQ(shared->paramLines.size(), 1u);
+        EXPECT_EQ(config.snapshot(), shared);
+    }
+    std::filesystem::remove(path);
+}
+
+UTEST(config_watcher, file_change_is_noticed)
+{
+    auto path = std::filesystem::temp_directory_path() / "plugin_sdk_config_watcher_notify.ini";
+    WriteTestConfig(path, "Value 1\n");
+    {
+        plugin::config_watcher config(path);
+        ASSERT_TRUE(config.isWatched());
+        // the watch is set up right away, but give the thread a moment to start polling
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        WriteTestConfig(path, "Value 2\n");
+
+        bool reloaded = false;
+        for (int i = 0; i < 100 && !reloaded; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            reloaded = config.update();
+        }
+        EXPECT_TRUE(reloaded);
+        EXPECT_EQ(config["Value"].asInt(), 2u);
+    }
+    std::filesystem::remove(path);
+}
+
+UTEST(config_watcher, missing_directory_is_not_watched)
+{
+    auto path = std::filesystem::temp_directory_path() / "plugin_sdk_config_watcher_missing" / "settings.ini";
+    plugin::config_watcher config(path);
+    EXPECT_FALSE(config.isWatched());
+    EXPECT_TRUE(config["Value"].isEmpty());
+    EXPECT_FALSE(config.update());
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <string>
+
+// An event without addresses: adding subscribers patches nothing, Call runs what a hooked call would
+using TestEventList = plugin::BaseEventI<injector::function_hooker, plugin::RefList<>, plugin::DefaultArgs, void(int)>;
+
+static std::string eventListLog;
+
+static void EventListA(int) { eventListLog += 'a'; }
+static void EventListB(int) { eventListLog += 'b'; }
+static void EventListC(int) { eventListLog += 'c'; }
+
+static void *EventListOriginal(int) {
+    eventListLog += 'o';
+    return nullptr;
+}
+
+UTEST(EventList, Order)
+{
+    TestEventList event;
+    eventListLog.clear();
+    event.AddBefore(EventListA, 0, plugin::ORDER_DEFAULT);
+    event.AddBefore(EventListB, 0, plugin::ORDER_FIRST);
+    event.AddBefore(EventListC, 0, plugin::ORDER_LATE);
+    event.AddBefore([](int) { eventListLog += 'd'; }, 0, plugin::ORDER_DEFAULT);
+    event.AddAfter(EventListA, 0, plugin::ORDER_DEFAULT);
+    event.Call(EventListOriginal, 0);
+    // same order: the one added first runs first
+    EXPECT_STREQ(eventListLog.c_str(), "badcoa");
+}
+
+UTEST(EventList, Duplicates)
+{
+    TestEventList event;
+    eventListLog.clear();
+    event.AddBefore(EventListA, 0, plugin::ORDER_DEFAULT);
+    event.AddBefore(EventListA, 0, plugin::ORDER_FIRST);
+    event.AddBefore([](int) { eventListLog += 'x'; }, 7, plugin::ORDER_DEFAULT);
+    event.AddBefore([](int) { eventListLog += 'y'; }, 7, plugin::ORDER_DEFAULT);
+    event.Call(EventListOriginal, 0);
+    EXPECT_STREQ(eventListLog.c_str(), "axo");
+
+    eventListLog.clear();
+    event.RemoveBefore(EventListA);
+    event.RemoveBeforeById(7);
+    event.Call(EventListOriginal, 0);
+    EXPECT_STREQ(eventListLog.c_str(), "o");
+}
+
+UTEST(EventList, ChangesDuringDispatch)
+{
+    TestEventList event;
+    eventListLog.clear();
+    // removes itself and a later subscriber, adds a new one
+    event.AddBefore([&event](int) {
+        eventListLog += 'r';
+        event.RemoveBeforeById(1);
+        event.RemoveBefore(EventListB);
+        event.AddBefore(EventListC, 0, plugin::ORDER_DEFAULT);
+    }, 1, plugin::ORDER_FIRST);
+    event.AddBefore(EventListA, 0, plugin::ORDER_DEFAULT);
+    event.AddBefore(EventListB, 0, plugin::ORDER_LAST);
+
+    // the removed one doesn't run anymore, the new one waits for the next call
+    event.Call(EventListOriginal, 0);
+    EXPECT_STREQ(eventListLog.c_str(), "rao");
+
+    eventListLog.clear();
+    event.Call(EventListOriginal, 0);
+    EXPECT_STREQ(eventListLog.c_str(), "aco");
+}
+
+UTEST(EventList, NestedCalls)
+{
+    TestEventList event;
+    eventListLog.clear();
+    event.AddBefore([&event](int depth) {
+        eventListLog += 'n';
+        if (depth == 0) {
+            event.Call(EventListOriginal, 1);
+            event.AddBefore(EventListA, 0, plugin::ORDER_DEFAULT);
+        }
+    }, 0, plugin::ORDER_DEFAULT);
+    event.Call(EventListOriginal, 0);
+    EXPECT_STREQ(eventListLog.c_str(), "nnoo");
+
+    // added while the outer call still ran
+    eventListLog.clear();
+    event.Call(EventListOriginal, 1);
+    EXPECT_STREQ(eventListLog.c_str(), "nao");
+}
+
+UTEST(EventList, SkipOriginal)
+{
+    TestEventList event;
+    eventListLog.clear();
+    static int skipped = 42;
+    event.AddBefore([&event](int) { event.SkipOriginal(&skipped); }, 0, plugin::ORDER_DEFAULT);
+    event.AddAfter([&event](int) { eventListLog += event.IsOriginalSkipped() ? 's' : '-'; }, 0, plugin::ORDER_DEFAULT);
+    EXPECT_EQ(event.Call(EventListOriginal, 0), (void *)&skipped);
+    EXPECT_STREQ(eventListLog.c_str(), "s");
+    EXPECT_FALSE(event.IsOriginalSkipped());
+}
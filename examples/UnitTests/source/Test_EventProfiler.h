@@ -0,0 +1,102 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <EventProfiler.h>
+#include <string>
+#include <vector>
+
+UTEST(EventProfiler, Buckets)
+{
+    using Histogram = plugin::EventProfiler::Histogram;
+    for (uint64_t ticks = 0; ticks < 4; ticks++)
+        EXPECT_EQ(Histogram::Bucket(ticks), (uint32_t)ticks);
+    EXPECT_EQ(Histogram::Bucket(4), 8u);
+    EXPECT_EQ(Histogram::Bucket(UINT64_MAX), Histogram::SIZE - 1);
+
+    // every duration lands in a bucket that holds it and is less than a quarter wider than it
+    uint32_t previous = 0;
+    for (uint64_t ticks = 1; ticks < 100000; ticks += ticks / 64 + 1) {
+        uint32_t bucket = Histogram::Bucket(ticks);
+        ASSERT_GE(bucket, previous);
+        ASSERT_GE(Histogram::BucketTop(bucket), ticks);
+        ASSERT_LE(Histogram::BucketTop(bucket), ticks + ticks / 4);
+        previous = bucket;
+    }
+}
+
+UTEST(EventProfiler, Percentiles)
+{
+    plugin::EventProfiler::Histogram histogram;
+    for (uint64_t ticks = 1000; ticks >= 1; ticks--)
+        histogram.Add(ticks);
+    EXPECT_EQ(histogram.calls, 1000u);
+    EXPECT_EQ(histogram.total, 500500u);
+    EXPECT_EQ(histogram.min, 1u);
+    EXPECT_EQ(histogram.max, 1000u);
+
+    uint64_t p50 = histogram.Percentile(0.5), p99 = histogram.Percentile(0.99);
+    EXPECT_GE(p50, 500u);
+    EXPECT_LE(p50, 625u);
+    EXPECT_GE(p99, 990u);
+    EXPECT_LE(p99, 1000u); // capped at the slowest call
+    EXPECT_EQ(histogram.Percentile(1.0), 1000u);
+
+    plugin::EventProfiler::Histogram single;
+    single.Add(37);
+    EXPECT_EQ(single.Percentile(0.99), 37u);
+}
+
+UTEST(EventProfiler, Csv)
+{
+    std::vector<plugin::EventProfiler::Stats> stats = {
+        { "0x53E230", plugin::EventProfiler::ORIGINAL_FUNCTION, 3, 1.5, 0.25, 1.0, 1.0 },
+        { "drawing", 0x1234, 1, 0.5, 0.5, 0.5, 0.5 },
+    };
+    std::string csv = plugin::EventProfiler::ToCsv(stats);
+    EXPECT_STREQ(csv.c_str(),
+        "event,subscriber,calls,total_ms,min_ms,max_ms,p99_ms\n"
+        "0x53E230,original,3,1.500000,0.250000,1.000000,1.000000\n"
+        "drawing,0x1234,1,0.500000,0.500000,0.500000,0.500000\n");
+    csv = plugin::EventProfiler::ToCsv({});
+    EXPECT_STREQ(csv.c_str(), "event,subscriber,calls,total_ms,min_ms,max_ms,p99_ms\n");
+}
+
+UTEST(EventProfiler, Json)
+{
+    std::vector<plugin::EventProfiler::Stats> stats = {
+        { "say \"hi\"", 0x10, 2, 0.75, 0.25, 0.5, 0.5 },
+        { "0x53E230", plugin::EventProfiler::ORIGINAL_FUNCTION, 1, 2.0, 2.0, 2.0, 2.0 },
+    };
+    std::string json = plugin::EventProfiler::ToJson(stats);
+    EXPECT_STREQ(json.c_str(),
+        "[\n"
+        "{\"event\":\"say \\\"hi\\\"\",\"subscriber\":\"0x10\",\"calls\":2,\"total_ms\":0.750000,\"min_ms\":0.250000,\"max_ms\":0.500000,\"p99_ms\":0.500000},\n"
+        "{\"event\":\"0x53E230\",\"subscriber\":\"original\",\"calls\":1,\"total_ms\":2.000000,\"min_ms\":2.000000,\"max_ms\":2.000000,\"p99_ms\":2.000000}\n"
+        "]\n");
+    json = plugin::EventProfiler::ToJson({});
+    EXPECT_STREQ(json.c_str(), "[\n]\n");
+}
+
+UTEST(EventProfiler, SnapshotAndReset)
+{
+    plugin::EventProfiler::Reset();
+    uint32_t event = plugin::EventProfiler::RegisterEvent("test event");
+    EXPECT_EQ(plugin::EventProfiler::RegisterEvent("test event"), event);
+
+    // more than a ring holds, the full ring is folded in on the way
+    for (int i = 0; i < 5000; i++)
+        plugin::EventProfiler::Record(event, 7, 100);
+    plugin::EventProfiler::Record(event, plugin::EventProfiler::ORIGINAL_FUNCTION, 400);
+
+    auto stats = plugin::EventProfiler::Snapshot();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_STREQ(stats[0].event.c_str(), "test event");
+    EXPECT_EQ(stats[0].subscriber, (uintptr_t)7); // the most time first
+    EXPECT_EQ(stats[0].calls, 5000u);
+    EXPECT_EQ(stats[1].subscriber, plugin::EventProfiler::ORIGINAL_FUNCTION);
+    EXPECT_EQ(stats[1].calls, 1u);
+    EXPECT_NEAR(stats[1].maxMs, stats[0].maxMs * 4.0, stats[0].maxMs * 0.01);
+
+    plugin::EventProfiler::Reset();
+    EXPECT_TRUE(plugin::EventProfiler::Snapshot().empty());
+}
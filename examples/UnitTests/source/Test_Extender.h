@@ -0,0 +1,63 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <Extender.h>
+#include <CPool.h>
+
+namespace ExtenderTest {
+    struct Data {
+        int value = 0;
+    };
+}
+
+UTEST(Extender, FindRefAfterSlotReuse)
+{
+    CPool<int> pool(4, "ExtenderTest");
+    plugin::ExtendedDataBlocks<ExtenderTest::Data, int, plugin::ExtendedDataSlots> blocks;
+    blocks.Allocate(pool.m_nSize);
+
+    int *first = pool.New();
+    int index = pool.GetIndex(first);
+    blocks.Construct(index, pool.GetIdAt(index), first);
+    blocks.Get(index).value = 1;
+    int firstRef = pool.GetRef(first);
+    ASSERT_TRUE(blocks.FindRef(firstRef) != nullptr);
+    EXPECT_EQ(blocks.FindRef(firstRef)->value, 1);
+
+    blocks.Destroy(index);
+    pool.Delete(first);
+    EXPECT_TRUE(blocks.FindRef(firstRef) == nullptr);
+
+    // the slot goes to a new object, which gets data of its own
+    int *second = pool.New(firstRef);
+    ASSERT_EQ(second, first);
+    blocks.Construct(index, pool.GetIdAt(index), second);
+    blocks.Get(index).value = 2;
+    int secondRef = pool.GetRef(second);
+    EXPECT_NE(secondRef, firstRef);
+    EXPECT_TRUE(blocks.FindRef(firstRef) == nullptr);
+    ASSERT_TRUE(blocks.FindRef(secondRef) != nullptr);
+    EXPECT_EQ(blocks.FindRef(secondRef)->value, 2);
+
+    // the slot's current id can't tell the two apart
+    EXPECT_EQ(blocks.Find(index, pool.GetIdAt(index))->value, 2);
+}
+
+UTEST(Extender, FindRefInvalid)
+{
+    CPool<int> pool(4, "ExtenderTest");
+    plugin::ExtendedDataBlocks<ExtenderTest::Data, int, plugin::ExtendedDataHeap> blocks;
+    blocks.Allocate(pool.m_nSize);
+
+    // slots without data, handles of free slots and out of the pool
+    EXPECT_TRUE(blocks.FindRef(0) == nullptr);
+    EXPECT_TRUE(blocks.FindRef(0x80) == nullptr);
+    EXPECT_TRUE(blocks.FindRef(-1) == nullptr);
+    EXPECT_TRUE(blocks.FindRef(pool.m_nSize << 8) == nullptr);
+
+    int *object = pool.New();
+    int index = pool.GetIndex(object);
+    blocks.Construct(index, pool.GetIdAt(index), object);
+    EXPECT_TRUE(blocks.FindRef(pool.GetRef(object)) != nullptr);
+    EXPECT_TRUE(blocks.FindRef(pool.GetRef(object) | 0x80) == nullptr);
+}
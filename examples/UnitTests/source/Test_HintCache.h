@@ -0,0 +1,105 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <Hooking.Patterns.h>
+#include <cstring>
+#include <vector>
+
+// image: a few bytes with "12 34 ? 56" at rva 4
+static const uint8_t hintCacheImage[] = { 0x90, 0x90, 0x90, 0x90, 0x12, 0x34, 0xAB, 0x56, 0xCC, 0xCC };
+static const uint8_t hintCacheBytes[] = { 0x12, 0x34, 0x00, 0x56 };
+static const uint8_t hintCacheMask[] = { 0xFF, 0xFF, 0x00, 0xFF };
+
+UTEST(HintCache, Validate)
+{
+    EXPECT_TRUE(hook::hint_cache::validate(hintCacheImage, sizeof(hintCacheImage), 4, hintCacheBytes, hintCacheMask, 4));
+    EXPECT_FALSE(hook::hint_cache::validate(hintCacheImage, sizeof(hintCacheImage), 3, hintCacheBytes, hintCacheMask, 4));
+
+    // must not read past the end of the image
+    EXPECT_FALSE(hook::hint_cache::validate(hintCacheImage, sizeof(hintCacheImage), 8, hintCacheBytes, hintCacheMask, 4));
+    EXPECT_FALSE(hook::hint_cache::validate(hintCacheImage, sizeof(hintCacheImage), 0x10000, hintCacheBytes, hintCacheMask, 4));
+}
+
+UTEST(HintCache, RoundTrip)
+{
+    uint64_t imageHash = hook::hint_cache::hash(hintCacheImage, sizeof(hintCacheImage));
+
+    hook::hint_cache cache(imageHash);
+    cache.add(0x1111, 4);
+    cache.add(0x2222, 8);
+    cache.add(0x1111, 4); // duplicate
+    EXPECT_EQ(cache.entries().size(), 2u);
+
+    auto data = cache.serialize();
+
+    hook::hint_cache loaded(imageHash);
+    ASSERT_TRUE(loaded.deserialize(data.data(), data.size()));
+    ASSERT_EQ(loaded.entries().size(), 2u);
+    EXPECT_EQ(loaded.entries()[0].pattern, 0x1111u);
+    EXPECT_EQ(loaded.entries()[0].rva, 4u);
+    EXPECT_EQ(loaded.entries()[1].pattern, 0x2222u);
+    EXPECT_EQ(loaded.entries()[1].rva, 8u);
+}
+
+UTEST(HintCache, RejectsOtherImage)
+{
+    hook::hint_cache cache(hook::hint_cache::hash(hintCacheImage, sizeof(hintCacheImage)));
+    cache.add(0x1111, 4);
+    auto data = cache.serialize();
+
+    uint8_t changedImage[sizeof(hintCacheImage)];
+    memcpy(changedImage, hintCacheImage, sizeof(changedImage));
+    changedImage[0] = 0xC3;
+
+    hook::hint_cache loaded(hook::hint_cache::hash(changedImage, sizeof(changedImage)));
+    EXPECT_FALSE(loaded.deserialize(data.data(), data.size()));
+    EXPECT_TRUE(loaded.entries().empty());
+}
+
+UTEST(HintCache, RejectsDamagedData)
+{
+    hook::hint_cache cache(1);
+    cache.add(0x1111, 4);
+    auto data = cache.serialize();
+
+    hook::hint_cache loaded(1);
+    EXPECT_FALSE(loaded.deserialize(data.data(), data.size() - 1));
+    EXPECT_FALSE(loaded.deserialize(data.data(), 3));
+
+    data[0] ^= 0xFF;
+    EXPECT_FALSE(loaded.deserialize(data.data(), data.size()));
+}
+
+UTEST(HintCache, CompleteFlag)
+{
+    hook::hint_cache cache(1);
+    cache.add(0x1111, 4, true);
+    cache.add(0x1111, 8, true);
+    cache.add(0x2222, 4);
+    auto data = cache.serialize();
+
+    hook::hint_cache loaded(1);
+    ASSERT_TRUE(loaded.deserialize(data.data(), data.size()));
+    ASSERT_EQ(loaded.entries().size(), 3u);
+    EXPECT_TRUE(loaded.entries()[0].complete);
+    EXPECT_TRUE(loaded.entries()[1].complete);
+    EXPECT_FALSE(loaded.entries()[2].complete);
+
+    // files of the first version don't say whether hints are complete, they're scanned again
+    data[4] = 1;
+    EXPECT_FALSE(loaded.deserialize(data.data(), data.size()));
+}
+
+UTEST(HintCache, MoreMatchesThanCounted)
+{
+    // "12 34 ? 56" three times
+    std::vector<uint8_t> buffer(64, 0x90);
+    for (size_t offset : { 4, 20, 40 })
+        memcpy(&buffer[offset], hintCacheImage + 4, 4);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(buffer.data());
+
+    auto pattern = hook::range_pattern(begin, begin + buffer.size(), "12 34 ? 56");
+    EXPECT_EQ(pattern.count_hint(1).get(0).get<uint8_t>(), &buffer[4]);
+    EXPECT_EQ(pattern.size(), 3u);
+    EXPECT_EQ(pattern.get(2).get<uint8_t>(), &buffer[40]);
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <ImgArchive.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+#include <vector>
+
+namespace ImgArchiveTest {
+    struct TestEntry {
+        uint32_t offset;
+        uint32_t size;
+        const char* name;
+    };
+
+    static void WriteEntry(std::vector<uint8_t>& out, uint32_t offset, uint32_t size, const char* name, bool ver2) {
+        uint8_t entry[32] = {};
+        memcpy(entry, &offset, 4);
+        if (ver2) {
+            uint16_t streamingSize = (uint16_t)size;
+            memcpy(entry + 4, &streamingSize, 2);
+        }
+        else
+            memcpy(entry + 4, &size, 4);
+        memcpy(entry + 8, name, (std::min)(strlen(name), size_t(23)));
+        out.insert(out.end(), entry, entry + 32);
+    }
+
+    // Every sector of an entry is filled with the entry's index + 1
+    static std::vector<uint8_t> MakeImage(std::vector<TestEntry> const& entries, uint32_t sectors) {
+        std::vector<uint8_t> img(sectors * plugin::ImgArchive::SECTOR_SIZE, 0);
+        for (size_t i = 0; i < entries.size(); i++) {
+            uint64_t begin = (uint64_t)entries[i].offset * plugin::ImgArchive::SECTOR_SIZE;
+            uint64_t end = begin + (uint64_t)entries[i].size * plugin::ImgArchive::SECTOR_SIZE;
+            for (uint64_t p = begin; p < end && p < img.size(); p++)
+                img[(size_t)p] = (uint8_t)(i + 1);
+        }
+        return img;
+    }
+
+    static void WriteFile(std::filesystem::path const& path, std::vector<uint8_t> const& data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(data.data()), data.size());
+    }
+}
+
+UTEST(ImgArchive, Ver2)
+{
+    using namespace ImgArchiveTest;
+    std::vector<TestEntry> entries = {
+        { 1, 2, "infernus.dff" },
+        { 3, 1, "Infernus.txd" },
+        { 4, 1, "INFERNUS.DFF" }, // duplicate name, the first one is found
+        { 9, 4, "outside.dff" },  // past the end of the archive
+        { 4, 1, "overlap.txd" },
+    };
+    std::vector<uint8_t> img = MakeImage(entries, 5);
+    std::vector<uint8_t> header = { 'V', 'E', 'R', '2', (uint8_t)entries.size(), 0, 0, 0 };
+    for (auto& entry : entries)
+        WriteEntry(header, entry.offset, entry.size, entry.name, true);
+    memcpy(img.data(), header.data(), header.size());
+
+    auto path = std::filesystem::temp_directory_path() / "plugin_sdk_test_ver2.img";
+    WriteFile(path, img);
+
+    plugin::ImgArchive archive;
+    ASSERT_TRUE(archive.Open(path.string()));
+    EXPECT_EQ(archive.GetVersion(), 2u);
+    EXPECT_EQ(archive.GetNumEntries(), entries.size());
+
+    EXPECT_EQ(archive.Find("infernus.dff"), 0);
+    EXPECT_EQ(archive.Find("InFeRnUs.DfF"), 0);
+    EXPECT_EQ(archive.Find("infernus.txd"), 1);
+    EXPECT_EQ(archive.Find("infernus"), plugin::ImgArchive::NOT_FOUND);
+    EXPECT_EQ(archive.Find("cheetah.dff"), plugin::ImgArchive::NOT_FOUND);
+    EXPECT_EQ(plugin::ImgArchive::GetKey("infernus.dff"), plugin::ImgArchive::GetKey("INFERNUS.DFF"));
+
+    auto view = archive.GetData("infernus.txd");
+    auto data = view.Span();
+    ASSERT_EQ(data.size(), (size_t)plugin::ImgArchive::SECTOR_SIZE);
+    EXPECT_EQ(data[0], 2);
+    EXPECT_EQ(data[data.size() - 1], 2);
+    EXPECT_EQ(archive.GetData(0).Size(), (size_t)plugin::ImgArchive::SECTOR_SIZE * 2);
+    EXPECT_TRUE(archive.GetData(3).Empty());
+
+    std::vector<size_t> bad = archive.Verify();
+    EXPECT_TRUE(bad == std::vector<size_t>({ 2, 3, 4 }));
+
+    archive.Close();
+    std::filesystem::remove(path);
+}
+
+UTEST(ImgArchive, Version1)
+{
+    using namespace ImgArchiveTest;
+    std::vector<TestEntry> entries = {
+        { 0, 1, "banshee.dff" },
+        { 1, 2, "banshee.txd" },
+    };
+    std::vector<uint8_t> dir;
+    for (auto& entry : entries)
+        WriteEntry(dir, entry.offset, entry.size, entry.name, false);
+
+    auto img = std::filesystem::temp_directory_path() / "plugin_sdk_test_v1.img";
+    auto dirPath = std::filesystem::temp_directory_path() / "plugin_sdk_test_v1.dir";
+    WriteFile(img, MakeImage(entries, 3));
+    WriteFile(dirPath, dir);
+
+    plugin::ImgArchive archive;
+    ASSERT_TRUE(archive.Open(img.string()));
+    EXPECT_EQ(archive.GetVersion(), 1u);
+    EXPECT_EQ(archive.Find("BANSHEE.TXD"), 1);
+    auto view = archive.GetData(1);
+    EXPECT_EQ(view.Size(), (size_t)plugin::ImgArchive::SECTOR_SIZE * 2);
+    EXPECT_EQ(view.Data()[0], 2);
+    EXPECT_TRUE(archive.Verify().empty());
+
+    std::atomic<size_t> visited(0);
+    archive.ForEachParallel([&](size_t, std::span<const uint8_t> data) {
+        visited += data.size();
+    });
+    EXPECT_EQ(visited.load(), (size_t)plugin::ImgArchive::SECTOR_SIZE * 3);
+
+    auto extracted = std::filesystem::temp_directory_path() / "plugin_sdk_test_v1";
+    EXPECT_EQ(archive.ExtractAll(extracted.string()), 2u);
+    EXPECT_EQ(std::filesystem::file_size(extracted / "banshee.txd"), (uintmax_t)plugin::ImgArchive::SECTOR_SIZE * 2);
+
+    archive.Close();
+    std::filesystem::remove_all(extracted);
+    std::filesystem::remove(img);
+    std::filesystem::remove(dirPath);
+}
+
+UTEST(ImgArchive, ExtractAllNames)
+{
+    using namespace ImgArchiveTest;
+    std::vector<TestEntry> entries = {
+        { 1, 1, "plain.dff" },
+        { 2, 1, "../escape.dff" },
+        { 2, 1, "..\\escape.txd" },
+        { 2, 1, "C:escape.dff" },
+        { 2, 1, "sub/escape.dff" },
+        { 2, 1, "nul.txd" },
+        { 2, 1, ".." },
+        { 3, 1, "PLAIN.DFF" },    // the first entry of the name wins
+    };
+    std::vector<uint8_t> img = MakeImage(entries, 4);
+    std::vector<uint8_t> header = { 'V', 'E', 'R', '2', (uint8_t)entries.size(), 0, 0, 0 };
+    for (auto& entry : entries)
+        WriteEntry(header, entry.offset, entry.size, entry.name, true);
+    memcpy(img.data(), header.data(), header.size());
+
+    auto root = std::filesystem::temp_directory_path() / "plugin_sdk_test_extract";
+    std::filesystem::remove_all(root);
+    auto path = root / "archive.img";
+    std::filesystem::create_directories(root);
+    WriteFile(path, img);
+
+    plugin::ImgArchive archive;
+    ASSERT_TRUE(archive.Open(path.string()));
+    auto extracted = root / "out";
+    EXPECT_EQ(archive.ExtractAll(extracted.string()), 1u);
+
+    size_t files = 0;
+    for (auto& item : std::filesystem::recursive_directory_iterator(root))
+        files += item.is_regular_file();
+    EXPECT_EQ(files, 2u); // the archive and plain.dff
+
+    std::ifstream file(extracted / "plain.dff", std::ios::binary);
+    EXPECT_EQ(file.get(), 1);
+    file.close();
+
+    archive.Close();
+    std::filesystem::remove_all(root);
+}
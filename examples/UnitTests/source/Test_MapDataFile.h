@@ -0,0 +1,148 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <MapDataFile.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace MapDataFileTest {
+    static std::string Write(char const* name, void const* data, size_t size) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(data), size);
+        return path.string();
+    }
+}
+
+UTEST(MapDataFile, TextIpl)
+{
+    std::string text =
+        "# placement\r\n"
+        "inst\r\n"
+        "3546, vegasroad01, 0, 2030.5, 1010.25, 10.0, 0, 0, -0.7071068, 0.7071068, -1\r\n"
+        "  3547 vegasroad02 13 1.0 2.0 3.0 0 0 0 1 0 # comment\r\n"
+        "3548, broken, 0, abc, 1, 2, 0, 0, 0, 1, -1\r\n"
+        "end\r\n"
+        "zone\r\n"
+        "LVa, 0, 1, 2, 3, 4, 5, 6, 7\r\n"
+        "end\r\n"
+        "cars\r\n"
+        "100.0, 200.0, 10.0, 90.0, 411, -1, -1, 0, 0, 0, 0, 10000\r\n"
+        "end\r\n"
+        "inst\r\n"
+        "# VC\r\n"
+        "1000, lamp, 2, 1, 2, 3, 1, 1, 1, 0, 0, 0, 1\r\n"
+        "end";
+    std::string path = MapDataFileTest::Write("plugin_sdk_test.ipl", text.data(), text.size());
+
+    plugin::MapDataFile file;
+    ASSERT_TRUE(file.Load(path));
+    EXPECT_EQ(file.GetType(), plugin::MapDataFile::FILE_IPL);
+    ASSERT_EQ(file.GetInstances().size(), 3u);
+    auto& road = file.GetInstances()[0];
+    EXPECT_EQ(road.modelId, 3546);
+    EXPECT_EQ(road.position[0], 2030.5f);
+    EXPECT_EQ(road.position[1], 1010.25f);
+    EXPECT_EQ(road.rotation[2], -0.7071068f);
+    EXPECT_EQ(road.lod, -1);
+    EXPECT_EQ(file.GetInstances()[1].flags, 13u);
+    EXPECT_EQ(file.GetInstances()[1].lod, 0);
+    EXPECT_TRUE(file.GetInstanceNames()[1] == "vegasroad02");
+    auto& lamp = file.GetInstances()[2];
+    EXPECT_EQ(lamp.flags, 2u);
+    EXPECT_EQ(lamp.position[2], 3.0f);
+    EXPECT_EQ(lamp.rotation[3], 1.0f);
+
+    ASSERT_EQ(file.GetCarGenerators().size(), 1u);
+    EXPECT_EQ(file.GetCarGenerators()[0].modelId, 411);
+    EXPECT_EQ(file.GetCarGenerators()[0].color1, -1);
+    EXPECT_EQ(file.GetCarGenerators()[0].maxDelay, 10000);
+
+    ASSERT_EQ(file.GetBadLines().size(), 1u);
+    EXPECT_EQ(file.GetBadLines()[0], 5u);
+
+    file.Clear();
+    std::filesystem::remove(path);
+}
+
+UTEST(MapDataFile, TextIde)
+{
+    std::string text =
+        "objs\n"
+        "1337, cube, cubetxd, 100, 4\n"
+        "1338, cube2, cubetxd, 1, 150, 0\n"
+        "end\n"
+        "tobj\n"
+        "1339, night, nighttxd, 1, 200, 4, 20, 6\n"
+        "end\n"
+        "anim\n"
+        "1340, door, doortxd, door_anim, 50, 8\n"
+        "end\n";
+    std::string path = MapDataFileTest::Write("plugin_sdk_test.ide", text.data(), text.size());
+
+    plugin::MapDataFile file;
+    ASSERT_TRUE(file.Load(path));
+    EXPECT_EQ(file.GetType(), plugin::MapDataFile::FILE_IDE);
+    EXPECT_TRUE(file.GetBadLines().empty());
+    auto& objects = file.GetObjectDefinitions();
+    ASSERT_EQ(objects.size(), 4u);
+    EXPECT_EQ(objects[0].id, 1337);
+    EXPECT_TRUE(objects[0].txd == "cubetxd");
+    EXPECT_EQ(objects[0].drawDistance, 100.0f);
+    EXPECT_EQ(objects[0].flags, 4u);
+    EXPECT_EQ(objects[1].drawDistance, 150.0f);
+    EXPECT_EQ(objects[2].type, plugin::MapDataFile::OBJECT_TOBJ);
+    EXPECT_EQ(objects[2].drawDistance, 200.0f);
+    EXPECT_EQ(objects[2].timeOn, 20);
+    EXPECT_EQ(objects[2].timeOff, 6);
+    EXPECT_EQ(objects[3].type, plugin::MapDataFile::OBJECT_ANIM);
+    EXPECT_TRUE(objects[3].animation == "door_anim");
+    EXPECT_EQ(objects[3].drawDistance, 50.0f);
+
+    file.Clear();
+    std::filesystem::remove(path);
+}
+
+UTEST(MapDataFile, BinaryIpl)
+{
+    plugin::MapDataFile::Instance instances[2] = {
+        { { 1.0f, 2.0f, 3.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, 3546, 0, 1 },
+        { { 4.0f, 5.0f, 6.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, 3547, 13, -1 },
+    };
+    plugin::MapDataFile::CarGenerator car = { { 7.0f, 8.0f, 9.0f }, 180.0f, 411, -1, -1, 0, 0, 0, 0, 10000 };
+
+    std::vector<uint8_t> data(0x4C + sizeof(instances) + sizeof(car));
+    int32_t numInstances = 2, numCars = 1;
+    uint32_t instancesOffset = 0x4C, carsOffset = 0x4C + sizeof(instances);
+    memcpy(data.data(), "bnry", 4);
+    memcpy(data.data() + 0x04, &numInstances, 4);
+    memcpy(data.data() + 0x14, &numCars, 4);
+    memcpy(data.data() + 0x1C, &instancesOffset, 4);
+    memcpy(data.data() + 0x3C, &carsOffset, 4);
+    memcpy(data.data() + instancesOffset, instances, sizeof(instances));
+    memcpy(data.data() + carsOffset, &car, sizeof(car));
+    std::string path = MapDataFileTest::Write("plugin_sdk_test_stream0.ipl", data.data(), data.size());
+
+    plugin::MapDataFile file;
+    ASSERT_TRUE(file.Load(path));
+    EXPECT_EQ(file.GetType(), plugin::MapDataFile::FILE_BINARY_IPL);
+    ASSERT_EQ(file.GetInstances().size(), 2u);
+    EXPECT_EQ(file.GetInstances()[1].modelId, 3547);
+    EXPECT_EQ(file.GetInstances()[1].flags, 13u);
+    EXPECT_EQ(file.GetInstances()[0].lod, 1);
+    EXPECT_EQ(file.GetInstances()[1].rotation[2], 1.0f);
+    ASSERT_EQ(file.GetCarGenerators().size(), 1u);
+    EXPECT_EQ(file.GetCarGenerators()[0].angle, 180.0f);
+    EXPECT_TRUE(file.GetInstanceNames().empty());
+
+    // counts past the end of the file
+    numInstances = 100;
+    memcpy(data.data() + 0x04, &numInstances, 4);
+    MapDataFileTest::Write("plugin_sdk_test_stream0.ipl", data.data(), data.size());
+    file.Clear();
+    EXPECT_FALSE(file.Load(path));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <PatchTransaction.h>
+#include <map>
+
+// Protection over pages of its own, every call is counted. Failures can be injected.
+class TestMemoryProtection : public plugin::MemoryProtection {
+public:
+    static constexpr uint32_t READ_ONLY = 1;
+    static constexpr uint32_t READ_WRITE = 2;
+
+    uint8_t *memory = nullptr;
+    size_t pageSize = 0;
+    std::map<uintptr_t, uint32_t> protections;
+    int unprotectCalls = 0;
+    int protectCalls = 0;
+    int flushCalls = 0;
+    uintptr_t failUnprotectAt = 0;
+    int failUnprotectAfter = -1; // calls that succeed before all of them fail
+    bool failProtect = false;
+
+    TestMemoryProtection(size_t pages) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        pageSize = info.dwPageSize;
+        memory = static_cast<uint8_t *>(VirtualAlloc(nullptr, pageSize * pages, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        memset(memory, 0xCC, pageSize * pages);
+        for (size_t i = 0; i < pages; i++)
+            Apply(Page(i), pageSize, READ_ONLY);
+    }
+
+    ~TestMemoryProtection() {
+        VirtualFree(memory, 0, MEM_RELEASE);
+    }
+
+    uintptr_t Page(size_t index) {
+        return reinterpret_cast<uintptr_t>(memory) + index * pageSize;
+    }
+
+    size_t GetPageSize() override {
+        return pageSize;
+    }
+
+    bool Query(uintptr_t address, uint32_t &protection) override {
+        auto it = protections.find(address / pageSize * pageSize);
+        if (it == protections.end())
+            return false;
+        protection = it->second;
+        return true;
+    }
+
+    bool Unprotect(uintptr_t address, size_t size) override {
+        unprotectCalls++;
+        if (failUnprotectAfter >= 0 && unprotectCalls > failUnprotectAfter)
+            return false;
+        if (failUnprotectAt && address <= failUnprotectAt && failUnprotectAt < address + size)
+            return false;
+        return Apply(address, size, READ_WRITE);
+    }
+
+    bool Protect(uintptr_t address, size_t size, uint32_t protection) override {
+        protectCalls++;
+        if (failProtect)
+            return false;
+        return Apply(address, size, protection);
+    }
+
+    void FlushInstructionCache(uintptr_t, size_t) override {
+        flushCalls++;
+    }
+
+private:
+    bool Apply(uintptr_t address, size_t size, uint32_t protection) {
+        DWORD old;
+        if (!VirtualProtect(reinterpret_cast<void *>(address), size, protection == READ_ONLY ? PAGE_READONLY : PAGE_READWRITE, &old))
+            return false;
+        for (uintptr_t page = address; page < address + size; page += pageSize)
+            protections[page] = protection;
+        return true;
+    }
+};
+
+UTEST(PatchTransaction, GroupsPages)
+{
+    TestMemoryProtection mem(4);
+    plugin::PatchTransaction tx(mem);
+    // pages 0 and 1 (one write across their border), nothing on 2, page 3
+    for (int i = 0; i < 100; i++)
+        tx.Write<uint8_t>(mem.Page(0) + i * 8, uint8_t(i));
+    tx.Write<uint32_t>(mem.Page(1) - 2, 0x11223344);
+    tx.Write<uint16_t>(mem.Page(3) + 16, 0xBEEF);
+
+    ASSERT_TRUE(tx.Commit());
+    EXPECT_EQ(mem.unprotectCalls, 2);
+    EXPECT_EQ(mem.protectCalls, 2);
+    EXPECT_EQ(mem.flushCalls, 1);
+    EXPECT_EQ(mem.memory[8 * 5], 5);
+    uint32_t value;
+    memcpy(&value, reinterpret_cast<void *>(mem.Page(1) - 2), sizeof(value));
+    EXPECT_EQ(value, 0x11223344u);
+    uint32_t protection;
+    ASSERT_TRUE(mem.Query(mem.Page(1), protection));
+    EXPECT_EQ(protection, TestMemoryProtection::READ_ONLY);
+}
+
+UTEST(PatchTransaction, Rollback)
+{
+    TestMemoryProtection mem(2);
+    plugin::PatchTransaction tx(mem);
+    tx.Write<uint32_t>(mem.Page(0) + 4, 0x12345678);
+    tx.Fill(mem.Page(0) + 6, 0x90, 4); // overlaps the first write
+
+    ASSERT_TRUE(tx.Commit());
+    EXPECT_EQ(mem.memory[6], 0x90);
+    ASSERT_TRUE(tx.Rollback());
+    for (int i = 0; i < 16; i++)
+        EXPECT_EQ(mem.memory[i], 0xCC);
+    EXPECT_FALSE(tx.IsCommitted());
+}
+
+UTEST(PatchTransaction, FailedUnprotectChangesNothing)
+{
+    TestMemoryProtection mem(3);
+    plugin::PatchTransaction tx(mem);
+    tx.Write<uint8_t>(mem.Page(0), 1);
+    tx.Write<uint8_t>(mem.Page(2), 2);
+    mem.failUnprotectAt = mem.Page(2);
+
+    EXPECT_FALSE(tx.Commit());
+    EXPECT_EQ(mem.memory[0], 0xCC);
+    uint32_t protection;
+    ASSERT_TRUE(mem.Query(mem.Page(0), protection));
+    EXPECT_EQ(protection, TestMemoryProtection::READ_ONLY);
+}
+
+UTEST(PatchTransaction, FailedProtectRestores)
+{
+    TestMemoryProtection mem(1);
+    plugin::PatchTransaction tx(mem);
+    tx.Write<uint8_t>(mem.Page(0), 1);
+    mem.failProtect = true;
+
+    EXPECT_FALSE(tx.Commit());
+    EXPECT_EQ(mem.memory[0], 0xCC);
+    EXPECT_FALSE(tx.IsCommitted());
+    EXPECT_EQ(tx.GetNumApplied(), 0u);
+}
+
+UTEST(PatchTransaction, FailedRestoreKeepsWritesApplied)
+{
+    TestMemoryProtection mem(1);
+    plugin::PatchTransaction tx(mem);
+    tx.Write<uint8_t>(mem.Page(0), 1);
+    // protecting fails, and so does making the page writable again to put the old byte back
+    mem.failProtect = true;
+    mem.failUnprotectAfter = 1;
+
+    EXPECT_FALSE(tx.Commit());
+    EXPECT_EQ(mem.memory[0], 1);
+    EXPECT_EQ(tx.GetNumApplied(), 1u);
+
+    mem.failProtect = false;
+    mem.failUnprotectAfter = -1;
+    ASSERT_TRUE(tx.Rollback());
+    EXPECT_EQ(mem.memory[0], 0xCC);
+    EXPECT_EQ(tx.GetNumApplied(), 0u);
+}
+
+UTEST(PatchTransaction, WriteAfterCommit)
+{
+    TestMemoryProtection mem(2);
+    plugin::PatchTransaction tx(mem);
+    tx.Write<uint8_t>(mem.Page(0), 1);
+    ASSERT_TRUE(tx.Commit());
+
+    // queued after the commit: not applied until the next one, which leaves the first write alone
+    tx.Write<uint8_t>(mem.Page(1), 2);
+    EXPECT_FALSE(tx.IsCommitted());
+    EXPECT_EQ(mem.memory[mem.pageSize], 0xCC);
+    mem.unprotectCalls = 0;
+    ASSERT_TRUE(tx.Commit());
+    EXPECT_TRUE(tx.IsCommitted());
+    EXPECT_EQ(mem.unprotectCalls, 1);
+    EXPECT_EQ(mem.memory[0], 1);
+    EXPECT_EQ(mem.memory[mem.pageSize], 2);
+
+    // both commits are undone
+    ASSERT_TRUE(tx.Rollback());
+    EXPECT_EQ(mem.memory[0], 0xCC);
+    EXPECT_EQ(mem.memory[mem.pageSize], 0xCC);
+}
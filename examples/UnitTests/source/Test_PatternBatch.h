@@ -0,0 +1,99 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <Hooking.Patterns.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace PatternBatchTest {
+    // code-like bytes: a lot of zeroes and small values, so anchors and first bytes repeat often
+    static std::vector<uint8_t> MakeBuffer(size_t size) {
+        std::vector<uint8_t> buffer(size);
+        uint32_t state = 12345;
+        for (auto& value : buffer) {
+            state = state * 1664525u + 1013904223u;
+            value = (state >> 24) % 4 == 0 ? 0 : (uint8_t)((state >> 8) % 64);
+        }
+        return buffer;
+    }
+
+    // count patterns of 12 bytes taken from the buffer, with a wildcard now and then
+    static std::vector<std::string> MakePatterns(std::vector<uint8_t> const& buffer, size_t count) {
+        std::vector<std::string> patterns;
+        for (size_t i = 0; i < count; i++) {
+            size_t offset = (i * 2654435761u) % (buffer.size() - 12);
+            std::string pattern;
+            char byte[4];
+            for (size_t j = 0; j < 12; j++) {
+                if (j % 5 == 3)
+                    pattern += "? ";
+                else {
+                    snprintf(byte, sizeof(byte), "%02X ", buffer[offset + j]);
+                    pattern += byte;
+                }
+            }
+            patterns.push_back(pattern);
+        }
+        return patterns;
+    }
+
+    static bool SameMatches(std::vector<hook::pattern_match> const& a, hook::pattern& b) {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].get<void>() != b.get(i).get<void>())
+                return false;
+        }
+        return true;
+    }
+}
+
+UTEST(PatternBatch, SameAsSingleScans)
+{
+    auto buffer = PatternBatchTest::MakeBuffer(1 << 20);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(buffer.data()), end = begin + buffer.size();
+
+    // one pattern takes the single pattern scan, many the anchored pass
+    for (size_t count : { 1, 64 }) {
+        auto patterns = PatternBatchTest::MakePatterns(buffer, count);
+        hook::pattern_batch batch;
+        for (auto& pattern : patterns)
+            batch.add(pattern);
+        batch.scan(begin, end);
+
+        for (size_t i = 0; i < count; i++) {
+            auto single = hook::range_pattern(begin, end, patterns[i]);
+            EXPECT_GE(batch.matches(i).size(), 1u);
+            EXPECT_TRUE(PatternBatchTest::SameMatches(batch.matches(i), single));
+        }
+    }
+}
+
+UTEST(PatternBatch, FasterThanSingleScans)
+{
+    auto buffer = PatternBatchTest::MakeBuffer(4 << 20);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(buffer.data()), end = begin + buffer.size();
+    auto patterns = PatternBatchTest::MakePatterns(buffer, 64);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t singleMatches = 0;
+    for (auto& pattern : patterns)
+        singleMatches += hook::range_pattern(begin, end, pattern).size();
+    auto single = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    hook::pattern_batch batch;
+    for (auto& pattern : patterns)
+        batch.add(pattern);
+    batch.scan(begin, end);
+    auto batched = std::chrono::steady_clock::now() - start;
+
+    size_t batchMatches = 0;
+    for (size_t i = 0; i < batch.size(); i++)
+        batchMatches += batch.matches(i).size();
+
+    EXPECT_EQ(batchMatches, singleMatches);
+    EXPECT_LT(batched.count(), single.count());
+}
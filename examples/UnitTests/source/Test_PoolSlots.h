@@ -0,0 +1,53 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <PoolSlots.h>
+#include <CPool.h>
+
+UTEST(PoolSlots, NewDelete)
+{
+    CPool<int> pool(8, "PoolSlotsTest");
+    pool.SetFreeAt(2, false);
+
+    plugin::PoolSlots<CPool<int>> slots(pool);
+    EXPECT_EQ(slots.GetNoOfUsedSpaces(), 1u);
+    EXPECT_EQ(slots.GetHighWaterMark(), 3);
+
+    int *a = slots.New();
+    int *b = slots.New();
+    int *c = slots.New();
+    EXPECT_EQ(pool.GetIndex(a), 0);
+    EXPECT_EQ(pool.GetIndex(b), 1);
+    EXPECT_EQ(pool.GetIndex(c), 3);
+    EXPECT_EQ(slots.GetNoOfUsedSpaces(), pool.GetNoOfUsedSpaces());
+    EXPECT_EQ(slots.GetHighWaterMark(), 4);
+
+    // handles stay the game's
+    int ref = pool.GetRef(c);
+    EXPECT_EQ(pool.GetAtRef(ref), c);
+    slots.Delete(c);
+    EXPECT_EQ(pool.GetAtRef(ref), nullptr);
+    EXPECT_EQ(slots.GetHighWaterMark(), 3);
+    EXPECT_EQ(slots.New(), c);
+    EXPECT_NE(pool.GetRef(c), ref);
+}
+
+UTEST(PoolSlots, GameAllocations)
+{
+    CPool<int> pool(4, "PoolSlotsTest");
+    plugin::PoolSlots<CPool<int>> slots(pool);
+
+    // taken by the game while on the free list
+    pool.SetFreeAt(0, false);
+    EXPECT_EQ(pool.GetIndex(slots.New()), 1);
+    EXPECT_EQ(slots.GetNoOfUsedSpaces(), 2u);
+
+    slots.New();
+    slots.New();
+    EXPECT_EQ(slots.New(), nullptr);
+
+    // released by the game, found again once the list runs dry
+    pool.SetFreeAt(0, true);
+    EXPECT_EQ(pool.GetIndex(slots.New()), 0);
+    EXPECT_EQ(slots.GetNoOfUsedSpaces(), 4u);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <Random.h>
+#include <vector>
+
+UTEST(Random, Pcg32Reference)
+{
+    // pcg32_srandom(42, 54) of the reference implementation
+    plugin::random::Pcg32 gen(42, 54);
+    EXPECT_EQ(gen(), 0xA15C02B7u);
+    EXPECT_EQ(gen(), 0x7B47F409u);
+    EXPECT_EQ(gen(), 0xBA1D3330u);
+}
+
+UTEST(Random, Ranges)
+{
+    plugin::random::Xoshiro256 gen(1);
+    int counts[6] = {};
+    for (int i = 0; i < 60000; i++) {
+        int value = plugin::random::InRange(gen, -2, 3);
+        ASSERT_TRUE(value >= -2 && value <= 3);
+        counts[value + 2]++;
+    }
+    for (int count : counts)
+        EXPECT_TRUE(count > 9000 && count < 11000);
+
+    for (int i = 0; i < 1000; i++) {
+        float value = plugin::random::InRange(gen, 1.0f, 2.0f);
+        EXPECT_TRUE(value >= 1.0f && value < 2.0f);
+    }
+    EXPECT_EQ(plugin::random::InRange(gen, 5, 5), 5);
+    EXPECT_EQ(plugin::random::InRange(gen, 5, 1), 5);
+    // full range doesn't overflow
+    plugin::random::InRange(gen, INT32_MIN, INT32_MAX);
+    plugin::random::InRange(gen, INT64_MIN, INT64_MAX);
+
+    std::vector<int32_t> ints(1001);
+    plugin::random::FillInRange(ints.data(), ints.size(), 10, 12);
+    for (int32_t value : ints)
+        EXPECT_TRUE(value >= 10 && value <= 12);
+    std::vector<float> floats(1001);
+    plugin::random::FillUnit(floats.data(), floats.size());
+    for (float value : floats)
+        EXPECT_TRUE(value >= 0.0f && value < 1.0f);
+}
+
+UTEST(Random, ReplaySeed)
+{
+    plugin::random::SetSeed(1234);
+    EXPECT_TRUE(plugin::random::IsSeeded());
+    uint64_t first = plugin::random::Next64();
+    int32_t ranged = plugin::RandomNumberInRange(0, 1000000);
+    uint32_t bulk[7];
+    plugin::random::Fill(bulk, 7);
+
+    plugin::random::SetSeed(1234);
+    EXPECT_EQ(plugin::random::Next64(), first);
+    EXPECT_EQ(plugin::RandomNumberInRange(0, 1000000), ranged);
+    uint32_t again[7];
+    plugin::random::Fill(again, 7);
+    for (int i = 0; i < 7; i++)
+        EXPECT_EQ(again[i], bulk[i]);
+
+    plugin::random::ClearSeed();
+    EXPECT_FALSE(plugin::random::IsSeeded());
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <SpriteDecoder.h>
+#include <chrono>
+
+UTEST(SpriteDecoder, SwizzleRGBA)
+{
+    std::vector<uint8_t> pixels;
+    for (int i = 0; i < 7; i++) { // vector part and the rest
+        pixels.push_back(uint8_t(i * 4 + 0));
+        pixels.push_back(uint8_t(i * 4 + 1));
+        pixels.push_back(uint8_t(i * 4 + 2));
+        pixels.push_back(uint8_t(i * 4 + 3));
+    }
+    plugin::SwizzleRGBA(pixels.data(), 7);
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(pixels[i * 4 + 0], i * 4 + 2);
+        EXPECT_EQ(pixels[i * 4 + 1], i * 4 + 1);
+        EXPECT_EQ(pixels[i * 4 + 2], i * 4 + 0);
+        EXPECT_EQ(pixels[i * 4 + 3], i * 4 + 3);
+    }
+}
+
+UTEST(SpriteDecoder, MipChain)
+{
+    uint32_t numLevels;
+    EXPECT_EQ(plugin::GetMipChainSize(4, 2, numLevels), size_t((8 + 2 + 1) * 4));
+    EXPECT_EQ(numLevels, 3u);
+
+    // 3x1: the odd column is repeated
+    uint8_t src[3 * 4] = { 0, 0, 0, 0, 100, 100, 100, 100, 50, 50, 50, 50 };
+    uint8_t dst[1 * 4];
+    plugin::DownsampleLevel(src, 3, 1, dst);
+    EXPECT_EQ(dst[0], 50);
+    EXPECT_EQ(dst[3], 50);
+}
+
+UTEST(SpriteDecoder, DecodesOnWorkers)
+{
+    // solid red images of the size given by the file name
+    auto decode = [](std::string const& file, std::vector<uint8_t>& rgba, int32_t& width, int32_t& height) {
+        if (file == "broken")
+            return false;
+        width = std::stoi(file);
+        height = width;
+        rgba.clear();
+        for (int32_t i = 0; i < width * height; i++)
+            rgba.insert(rgba.end(), { 255, 0, 0, 255 });
+        return true;
+    };
+
+    plugin::SpriteDecoder decoder(decode, 2);
+    for (uint32_t i = 0; i < 20; i++)
+        decoder.Enqueue(std::to_string(i + 1), "sprite" + std::to_string(i), i, i % 2 == 0);
+    decoder.Enqueue("broken", "broken", 20, false);
+
+    std::vector<plugin::DecodedSprite> sprites;
+    auto start = std::chrono::steady_clock::now();
+    while (sprites.size() < 21 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        decoder.Collect(sprites, 4);
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(sprites.size(), size_t(21));
+    EXPECT_EQ(decoder.GetNumPending(), size_t(0));
+
+    for (auto& sprite : sprites) {
+        if (sprite.id == 20) {
+            EXPECT_FALSE(sprite.ok);
+            continue;
+        }
+        EXPECT_TRUE(sprite.ok);
+        EXPECT_EQ(sprite.width, int32_t(sprite.id + 1));
+        uint32_t numLevels;
+        size_t size = plugin::GetMipChainSize(sprite.width, sprite.height, numLevels);
+        if (sprite.id % 2 == 0) {
+            EXPECT_EQ(sprite.numLevels, numLevels);
+            EXPECT_EQ(sprite.pixels.size(), size);
+        }
+        else
+            EXPECT_EQ(sprite.numLevels, 1u);
+        // BGRA, the last level too
+        EXPECT_EQ(sprite.pixels[2], 255);
+        EXPECT_EQ(sprite.pixels[0], 0);
+        EXPECT_EQ(sprite.pixels[sprite.pixels.size() - 2], 255);
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <TextLoader.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#if defined(GTASA)
+#include <CKeyGen.h>
+#endif
+
+namespace TextLoaderTest {
+    static std::string TempPath(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // numbered entries [KEYn] with the value "Text n"
+    static std::string WriteSource(size_t count) {
+        std::string path = TempPath("TextLoaderTest.txt");
+        std::ofstream file(path, std::ios::trunc);
+        for (size_t i = 0; i < count; i++)
+            file << "[KEY" << i << "]\n" << "Text " << i << "\n";
+        return path;
+    }
+
+    static plugin::string_t Expected(size_t i) {
+        std::string text = "Text " + std::to_string(i);
+        return plugin::string_t(text.begin(), text.end());
+    }
+
+    static std::vector<char> ReadFile(std::string const& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    static void WriteFile(std::string const& path, std::vector<char> const& data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+
+    // numSlots and count in the cache header: magic, version, charSize, tableHash, sourceSize, sourceTime
+    static constexpr size_t NUM_SLOTS_OFFSET = 32;
+    static constexpr size_t COUNT_OFFSET = 36;
+}
+
+UTEST(TextLoader, Hash)
+{
+    // CRC32 of the check string without the final xor
+    EXPECT_EQ(plugin::TextLoader::Hash("123456789"), 0x340BC6D9u);
+    EXPECT_EQ(plugin::TextLoader::Hash(""), 0xFFFFFFFFu);
+    static_assert(plugin::TextLoader::Hash("FEM_OK") == plugin::TextLoader::Hash(std::string_view("FEM_OK_", 6)));
+#if defined(GTASA)
+    for (const char* key : { "FEM_OK", "FESZ_LA", "IE23", "CRASH1" })
+        EXPECT_EQ(plugin::TextLoader::Hash(key), CKeyGen::GetKey(key));
+#endif
+}
+
+UTEST(TextLoader, Table)
+{
+    std::string source = TextLoaderTest::WriteSource(1000);
+    plugin::TextLoader text;
+    ASSERT_TRUE(text.Load(source));
+    EXPECT_EQ(text.Count(), 1000u);
+
+    for (size_t i = 0; i < 1000; i++) {
+        std::string key = "KEY" + std::to_string(i);
+        const plugin::char_t* value = text.GetByHash(plugin::TextLoader::Hash(key));
+        ASSERT_TRUE(value != nullptr);
+        EXPECT_TRUE(value == TextLoaderTest::Expected(i));
+        EXPECT_TRUE(text.Get(std::string_view(key)) == value);
+    }
+    EXPECT_TRUE(text.GetByHash(plugin::TextLoader::Hash("KEY1000")) == nullptr);
+
+    // a later file replaces entries
+    std::string update = TextLoaderTest::TempPath("TextLoaderTestUpdate.txt");
+    {
+        std::ofstream file(update, std::ios::trunc);
+        file << "[KEY5]\nChanged\n";
+    }
+    ASSERT_TRUE(text.Load(update));
+    EXPECT_EQ(text.Count(), 1000u);
+    EXPECT_TRUE(text.Get("KEY5") == plugin::string_t({ 'C', 'h', 'a', 'n', 'g', 'e', 'd' }));
+
+    text.Clear();
+    EXPECT_EQ(text.Count(), 0u);
+    EXPECT_TRUE(text.GetByHash(plugin::TextLoader::Hash("KEY5")) == nullptr);
+    std::remove(source.c_str());
+    std::remove(update.c_str());
+}
+
+UTEST(TextLoader, CacheRoundTrip)
+{
+    std::string source = TextLoaderTest::WriteSource(100);
+    std::string cache = TextLoaderTest::TempPath("TextLoaderTest.cache");
+    std::remove(cache.c_str());
+
+    plugin::TextLoader parsed;
+    ASSERT_TRUE(parsed.Load(source, cache));
+    auto data = TextLoaderTest::ReadFile(cache);
+    ASSERT_GT(data.size(), TextLoaderTest::COUNT_OFFSET);
+
+    // taken from the cache: change the last value there, the source stays as it was
+    ASSERT_EQ(data[data.size() - 2 * sizeof(plugin::char_t)], '9');
+    data[data.size() - 2 * sizeof(plugin::char_t)] = '8';
+    TextLoaderTest::WriteFile(cache, data);
+
+    plugin::TextLoader cached;
+    ASSERT_TRUE(cached.Load(source, cache));
+    EXPECT_EQ(cached.Count(), 100u);
+    size_t changed = 0;
+    for (size_t i = 0; i < 100; i++) {
+        const plugin::char_t* value = cached.GetByHash(plugin::TextLoader::Hash("KEY" + std::to_string(i)));
+        ASSERT_TRUE(value != nullptr);
+        changed += value != TextLoaderTest::Expected(i);
+    }
+    EXPECT_EQ(changed, 1u);
+    std::remove(source.c_str());
+    std::remove(cache.c_str());
+}
+
+UTEST(TextLoader, DamagedCache)
+{
+    std::string source = TextLoaderTest::WriteSource(100);
+    std::string cache = TextLoaderTest::TempPath("TextLoaderTest.cache");
+    std::remove(cache.c_str());
+    plugin::TextLoader parsed;
+    ASSERT_TRUE(parsed.Load(source, cache));
+    auto good = TextLoaderTest::ReadFile(cache);
+    ASSERT_GT(good.size(), TextLoaderTest::COUNT_OFFSET + 4);
+
+    std::vector<std::vector<char>> damaged;
+    damaged.emplace_back(good.begin(), good.end() - 5);     // truncated
+    damaged.push_back(good);
+    damaged.back().push_back('\0');                          // trailing data
+    damaged.push_back(good);
+    damaged.back().back() = 'x';                             // values not terminated
+    damaged.push_back(good);
+    memset(&damaged.back()[TextLoaderTest::COUNT_OFFSET], 0x7F, 4); // full table
+    damaged.push_back(good);
+    memset(&damaged.back()[TextLoaderTest::NUM_SLOTS_OFFSET], 0x7F, 4); // not a power of two
+    // a slot pointing out of the arenas, the first occupied one after the header
+    damaged.push_back(good);
+    for (size_t offset = TextLoaderTest::COUNT_OFFSET + 12; offset + 12 <= good.size(); offset += 12) {
+        uint32_t value;
+        memcpy(&value, &good[offset + 8], 4);
+        if (value != 0xFFFFFFFF) {
+            memset(&damaged.back()[offset + 4], 0x7F, 4);
+            break;
+        }
+    }
+
+    // each one is parsed again and the cache rewritten
+    for (auto& data : damaged) {
+        TextLoaderTest::WriteFile(cache, data);
+        plugin::TextLoader text;
+        ASSERT_TRUE(text.Load(source, cache));
+        EXPECT_EQ(text.Count(), 100u);
+        const plugin::char_t* value = text.GetByHash(plugin::TextLoader::Hash("KEY99"));
+        ASSERT_TRUE(value != nullptr);
+        EXPECT_TRUE(value == TextLoaderTest::Expected(99));
+        EXPECT_TRUE(TextLoaderTest::ReadFile(cache) == good);
+    }
+    std::remove(source.c_str());
+    std::remove(cache.c_str());
+}
+
+#if !defined(GTAIV)
+UTEST(TextLoader, ApplyTable)
+{
+    // À becomes the game's 0x80 outside of ~tags~, other characters stay
+    plugin::string_t text = { 'a', static_cast<plugin::char_t>(0xC0), '~', static_cast<plugin::char_t>(0xC0), '~', static_cast<plugin::char_t>(0xC0) };
+    plugin::ApplyTable(text);
+    plugin::string_t expected = { 'a', static_cast<plugin::char_t>(0x80), '~', static_cast<plugin::char_t>(0xC0), '~', static_cast<plugin::char_t>(0x80) };
+    EXPECT_TRUE(text == expected);
+
+    // changes to the map take effect after UpdateTableLookup
+    plugin::table['a'] = 'b';
+    plugin::UpdateTableLookup();
+    text = { 'a' };
+    plugin::ApplyTable(text);
+    EXPECT_TRUE(text == plugin::string_t({ 'b' }));
+    plugin::table.erase('a');
+    plugin::UpdateTableLookup();
+}
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <TextureCompressor.h>
+#include <SpriteDecoder.h>
+#include <filesystem>
+#include <fstream>
+
+static std::vector<uint8_t> MakeTestGradient(int32_t width, int32_t height, bool alpha) {
+    // blue and green go opposite ways, so the endpoints have to be on the other diagonal
+    std::vector<uint8_t> bgra;
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            bgra.push_back(uint8_t(40 + x * 8));
+            bgra.push_back(uint8_t(255 - x * 8));
+            bgra.push_back(128);
+            bgra.push_back(alpha ? uint8_t(255 - y * 16) : 255);
+        }
+    }
+    return bgra;
+}
+
+UTEST(TextureCompressor, RoundTrip)
+{
+    for (auto format : { plugin::BLOCK_BC1, plugin::BLOCK_BC3 }) {
+        // 6x5 has partial blocks on both sides
+        for (auto [width, height] : { std::pair{ 16, 16 }, std::pair{ 6, 5 } }) {
+            auto src = MakeTestGradient(width, height, format == plugin::BLOCK_BC3);
+            EXPECT_EQ(plugin::HasTransparency(src.data(), src.size() / 4), format == plugin::BLOCK_BC3);
+
+            std::vector<uint8_t> blocks(plugin::GetBlockLevelSize(width, height, format));
+            plugin::CompressLevel(src.data(), width, height, format, blocks.data());
+            std::vector<uint8_t> dst(src.size());
+            plugin::DecompressLevel(blocks.data(), width, height, format, dst.data());
+
+            int maxError = 0;
+            for (size_t i = 0; i < src.size(); i++)
+                maxError = std::max(maxError, std::abs(int(src[i]) - int(dst[i])));
+            // smooth gradients stay within a few steps of the palette
+            EXPECT_LE(maxError, 12);
+        }
+    }
+    EXPECT_EQ(plugin::GetBlockLevelSize(1, 1, plugin::BLOCK_BC1), size_t(8));
+    EXPECT_EQ(plugin::GetBlockLevelSize(8, 5, plugin::BLOCK_BC3), size_t(4 * 16));
+}
+
+UTEST(TextureCompressor, CacheIsKeyedBySource)
+{
+    auto dir = std::filesystem::temp_directory_path() / "plugin_sdk_texture_cache";
+    std::filesystem::create_directories(dir);
+    auto source = (dir / "sprite.png").string();
+    {
+        std::ofstream out(source, std::ios::binary | std::ios::trunc);
+        out << "not really an image";
+    }
+
+    // any file decodes to a solid white 8x8 image
+    auto decode = [](std::string const&, std::vector<uint8_t>& rgba, int32_t& width, int32_t& height) {
+        width = height = 8;
+        rgba.assign(8 * 8 * 4, 255);
+        return true;
+    };
+
+    auto sprite = plugin::SpriteDecoder::Decode(decode, source, true, true, dir.string());
+    ASSERT_TRUE(sprite.ok);
+    EXPECT_TRUE(sprite.blockFormat == plugin::BLOCK_BC1);
+    EXPECT_EQ(sprite.numLevels, 4u);
+    EXPECT_EQ(sprite.pixels.size(), size_t(32 + 8 + 8 + 8));
+
+    plugin::TextureCache::SourceKey key;
+    ASSERT_TRUE(plugin::TextureCache::GetSourceKey(source, key));
+    auto cacheFile = plugin::TextureCache::GetCacheFileName(dir.string(), source);
+    plugin::TextureCache::Entry entry;
+    ASSERT_TRUE(plugin::TextureCache::Read(cacheFile, key, entry));
+    EXPECT_TRUE(entry.blocks == sprite.pixels);
+
+    // read back without decoding
+    auto failing = [](std::string const&, std::vector<uint8_t>&, int32_t&, int32_t&) { return false; };
+    auto cached = plugin::SpriteDecoder::Decode(failing, source, true, true, dir.string());
+    EXPECT_TRUE(cached.ok);
+    EXPECT_TRUE(cached.pixels == sprite.pixels);
+
+    // any change of the source drops the cache
+    key.hash ^= 1;
+    EXPECT_FALSE(plugin::TextureCache::Read(cacheFile, key, entry));
+
+    std::filesystem::remove_all(dir);
+}
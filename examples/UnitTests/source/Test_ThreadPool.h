@@ -0,0 +1,57 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <ThreadPool.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+UTEST(ThreadPool, RunsEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> calls(1000);
+    plugin::ThreadPool::Get().Run(calls.size(), 4, [&](size_t i) { calls[i]++; });
+    for (auto& count : calls)
+        EXPECT_EQ(count.load(), 1);
+
+    // one thread: everything on the caller
+    std::atomic<int> sum{ 0 };
+    plugin::ThreadPool::Get().Run(10, 1, [&](size_t i) { sum += (int)i; });
+    EXPECT_EQ(sum.load(), 45);
+}
+
+UTEST(ThreadPool, ParallelForThreadCount)
+{
+    unsigned threads = plugin::GetWorkerThreads();
+    EXPECT_GE(threads, 1u);
+
+    plugin::SetWorkerThreads(3);
+    EXPECT_EQ(plugin::GetWorkerThreads(), 3u);
+    std::atomic<size_t> sum{ 0 };
+    plugin::ParallelFor(100, [&](size_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), size_t(4950));
+    plugin::SetWorkerThreads(0);
+    EXPECT_EQ(plugin::GetWorkerThreads(), threads);
+}
+
+UTEST(ThreadPool, ThrowingCallIsRethrown)
+{
+    std::atomic<int> calls{ 0 };
+    bool thrown = false;
+    try {
+        plugin::ThreadPool::Get().Run(100, 4, [&](size_t i) {
+            calls++;
+            if (i % 10 == 3)
+                throw std::runtime_error("task failed");
+        });
+    }
+    catch (std::runtime_error const&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(calls.load(), 100);
+
+    // the pool still works afterwards
+    std::atomic<int> sum{ 0 };
+    plugin::ThreadPool::Get().Run(10, 4, [&](size_t i) { sum += (int)i; });
+    EXPECT_EQ(sum.load(), 45);
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <plugin.h>
+#include "utest.h"
+#include <VoiceScheduler.h>
+
+static plugin::VoiceParams MakeTestVoice(float distance, int32_t priority = 0) {
+    plugin::VoiceParams params;
+    params.sample = 0;
+    params.loop = true;
+    params.x = distance;
+    params.priority = priority;
+    return params;
+}
+
+UTEST(VoiceScheduler, MostAudibleGetChannels)
+{
+    plugin::NullVoiceBackend backend(2, { 10.0f });
+    plugin::VoiceScheduler scheduler(backend);
+
+    auto far = scheduler.Play(MakeTestVoice(80.0f));
+    auto nearest = scheduler.Play(MakeTestVoice(5.0f));
+    auto near = scheduler.Play(MakeTestVoice(20.0f));
+    auto silent = scheduler.Play(MakeTestVoice(150.0f));
+    auto important = scheduler.Play(MakeTestVoice(90.0f, 1));
+    scheduler.Update(0.0f);
+
+    EXPECT_EQ(scheduler.GetNumVoices(), size_t(5));
+    EXPECT_EQ(scheduler.GetNumReal(), size_t(2));
+    EXPECT_FALSE(scheduler.IsVirtual(important));
+    EXPECT_FALSE(scheduler.IsVirtual(nearest));
+    EXPECT_TRUE(scheduler.IsVirtual(near));
+    EXPECT_TRUE(scheduler.IsVirtual(far));
+    EXPECT_TRUE(scheduler.IsVirtual(silent));
+
+    // gone voices give their channel to the next one
+    scheduler.Stop(important);
+    EXPECT_FALSE(scheduler.IsPlaying(important));
+    scheduler.Update(0.0f);
+    EXPECT_FALSE(scheduler.IsVirtual(near));
+    EXPECT_EQ(backend.numStarts, 3u);
+}
+
+UTEST(VoiceScheduler, VirtualVoicesKeepTheirPlace)
+{
+    plugin::NullVoiceBackend backend(1, { 10.0f, 1.0f });
+    plugin::VoiceScheduler scheduler(backend);
+
+    auto music = scheduler.Play(MakeTestVoice(0.0f));
+    scheduler.Update(0.0f);
+    backend.Advance(2.0f);
+    scheduler.Update(2.0f);
+    EXPECT_NEAR(scheduler.GetOffset(music), 2.0f, 0.001f);
+
+    // a louder voice takes the channel for a while
+    auto loud = MakeTestVoice(0.0f, 1);
+    loud.sample = 1;
+    loud.loop = false;
+    scheduler.Play(loud);
+    scheduler.Update(0.0f);
+    EXPECT_TRUE(scheduler.IsVirtual(music));
+
+    scheduler.Update(0.5f);
+    backend.Advance(0.5f);
+    scheduler.Update(0.5f);
+    backend.Advance(0.5f);
+    // the short one has finished, music continues where it would be by now
+    scheduler.Update(0.5f);
+    EXPECT_EQ(scheduler.GetNumVoices(), size_t(1));
+    EXPECT_FALSE(scheduler.IsVirtual(music));
+    EXPECT_NEAR(backend.channels[0].offset, 3.5f, 0.001f);
+
+    // virtual one-shots end on time as well
+    plugin::VoiceParams oneShot = MakeTestVoice(200.0f);
+    oneShot.sample = 1;
+    oneShot.loop = false;
+    auto shot = scheduler.Play(oneShot);
+    scheduler.Update(0.6f);
+    EXPECT_TRUE(scheduler.IsPlaying(shot));
+    scheduler.Update(0.6f);
+    EXPECT_FALSE(scheduler.IsPlaying(shot));
+}
+
+UTEST(VoiceScheduler, StaleHandles)
+{
+    plugin::NullVoiceBackend backend(4, { 1.0f });
+    plugin::VoiceScheduler scheduler(backend);
+
+    auto first = scheduler.Play(MakeTestVoice(0.0f));
+    scheduler.Stop(first);
+    auto second = scheduler.Play(MakeTestVoice(0.0f));
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(scheduler.IsPlaying(first));
+    EXPECT_TRUE(scheduler.IsPlaying(second));
+    scheduler.Stop(first);
+    EXPECT_TRUE(scheduler.IsPlaying(second));
+    EXPECT_FALSE(scheduler.IsPlaying(plugin::VoiceScheduler::INVALID_HANDLE));
+}
+
+UTEST(VoiceScheduler, NewSampleStartsOver)
+{
+    plugin::NullVoiceBackend backend(1, { 10.0f, 10.0f });
+    plugin::VoiceScheduler scheduler(backend);
+
+    auto voice = scheduler.Play(MakeTestVoice(0.0f));
+    scheduler.Update(0.0f);
+    backend.Advance(3.0f);
+
+    plugin::VoiceParams params = MakeTestVoice(0.0f);
+    params.sample = 1;
+    scheduler.SetParams(voice, params);
+    EXPECT_NEAR(scheduler.GetOffset(voice), 0.0f, 0.001f);
+    scheduler.Update(0.0f);
+    EXPECT_EQ(backend.channels[0].params.sample, 1);
+    EXPECT_NEAR(backend.channels[0].offset, 0.0f, 0.001f);
+}
+
+UTEST(VoiceScheduler, LoopPoints)
+{
+    plugin::NullVoiceBackend backend(1, { 10.0f });
+    plugin::VoiceScheduler scheduler(backend);
+
+    // plays from the start up to 6, then loops 2-6
+    plugin::VoiceParams params = MakeTestVoice(0.0f);
+    params.loopStart = 2.0f;
+    params.loopEnd = 6.0f;
+    auto voice = scheduler.Play(params);
+    scheduler.Update(0.0f);
+    EXPECT_NEAR(backend.channels[0].params.loopStart, 2.0f, 0.001f);
+    backend.Advance(7.0f);
+    scheduler.Update(7.0f);
+    EXPECT_NEAR(scheduler.GetOffset(voice), 3.0f, 0.001f);
+
+    // the same while virtual
+    auto loud = MakeTestVoice(0.0f, 1);
+    scheduler.Play(loud);
+    scheduler.Update(0.0f);
+    EXPECT_TRUE(scheduler.IsVirtual(voice));
+    scheduler.Update(4.5f);
+    EXPECT_NEAR(scheduler.GetOffset(voice), 3.5f, 0.001f);
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the CitizenFX project - http://citizen.re/
+ *
+ * See LICENSE and MENTIONS in the root of the source tree for information
+ * regarding licensing.
+ */
+
+#include "Hooking.Patterns.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace hook
+{
+
+// file layout, all fields little-endian:
+// magic, version, image hash, entry count, then (pattern hash, rva, flags) per entry
+static constexpr uint32_t hintCacheMagic = 0x31434850; // "PHC1"
+static constexpr uint32_t hintCacheVersion = 2;
+static constexpr size_t hintCacheHeaderSize = 4 + 4 + 8 + 4;
+static constexpr size_t hintCacheEntrySize = 8 + 4 + 4;
+static constexpr uint32_t hintCacheEntryComplete = 1;
+
+template<typename T>
+static void Write(std::vector<uint8_t>& out, T value)
+{
+	uint8_t bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	out.insert(out.end(), std::begin(bytes), std::end(bytes));
+}
+
+template<typename T>
+static T Read(const uint8_t* data)
+{
+	T value;
+	memcpy(&value, data, sizeof(T));
+	return value;
+}
+
+uint64_t hint_cache::hash(const void* data, size_t size)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	uint64_t hash = 14695981039346656037u;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211u;
+	}
+
+	return hash;
+}
+
+bool hint_cache::validate(const uint8_t* base, size_t size, uintptr_t rva, const uint8_t* bytes, const uint8_t* mask, size_t length)
+{
+	if (rva > size || size - rva < length)
+	{
+		return false;
+	}
+
+	const uint8_t* ptr = base + rva;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		if (bytes[i] != (ptr[i] & mask[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void hint_cache::add(uint64_t pattern, uint32_t rva, bool complete)
+{
+	if (!m_seen.insert({ pattern, rva }).second)
+	{
+		return;
+	}
+
+	m_entries.push_back({ pattern, rva, complete });
+}
+
+void hint_cache::clear()
+{
+	m_entries.clear();
+	m_seen.clear();
+}
+
+std::vector<uint8_t> hint_cache::serialize() const
+{
+	std::vector<uint8_t> out;
+	out.reserve(hintCacheHeaderSize + m_entries.size() * hintCacheEntrySize);
+
+	Write<uint32_t>(out, hintCacheMagic);
+	Write<uint32_t>(out, hintCacheVersion);
+	Write<uint64_t>(out, m_imageHash);
+	Write<uint32_t>(out, static_cast<uint32_t>(m_entries.size()));
+
+	for (auto& e : m_entries)
+	{
+		Write<uint64_t>(out, e.pattern);
+		Write<uint32_t>(out, e.rva);
+		Write<uint32_t>(out, e.complete ? hintCacheEntryComplete : 0);
+	}
+
+	return out;
+}
+
+bool hint_cache::deserialize(const uint8_t* data, size_t size)
+{
+	clear();
+
+	if (size < hintCacheHeaderSize ||
+		Read<uint32_t>(data) != hintCacheMagic ||
+		Read<uint32_t>(data + 4) != hintCacheVersion ||
+		Read<uint64_t>(data + 8) != m_imageHash)
+	{
+		return false;
+	}
+
+	uint32_t count = Read<uint32_t>(data + 16);
+
+	if ((size - hintCacheHeaderSize) / hintCacheEntrySize < count)
+	{
+		return false;
+	}
+
+	m_entries.reserve(count);
+
+	for (const uint8_t* ptr = data + hintCacheHeaderSize; count != 0; count--, ptr += hintCacheEntrySize)
+	{
+		add(Read<uint64_t>(ptr), Read<uint32_t>(ptr + 8), (Read<uint32_t>(ptr + 12) & hintCacheEntryComplete) != 0);
+	}
+
+	return true;
+}
+
+bool hint_cache::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		clear();
+		return false;
+	}
+
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return deserialize(data.data(), data.size());
+}
+
+bool hint_cache::save(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	auto data = serialize();
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return file.good();
+}
+
+}
@@ -10,14 +10,27 @@
 #endif
 
 #include "Hooking.Patterns.h"
+#include "../shared/ThreadPool.h"
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
 
 #if PATTERNS_USE_HINTS
 #include <map>
+#include <set>
+#endif
+
+#if !defined(PATTERNS_DISABLE_SIMD) && (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__))
+#define PATTERNS_USE_SIMD 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 #endif
 
 
@@ -56,12 +69,195 @@ ptrdiff_t details::get_process_base()
 }
 
 
+#if PATTERNS_USE_HINT_CACHE
+// Mirrors the in-memory hints of the process image into a cache file next to this module.
+// The file is keyed by a hash of the image headers (link timestamp, checksum, section layout);
+// the code itself may already be patched by other modules when we get loaded.
+class hint_cache_file
+{
+private:
+	std::multimap<uint64_t, uintptr_t>& m_hints;
+	std::set<uint64_t>& m_complete;
+	std::string m_path;
+	uint64_t m_imageHash = 0;
+
+public:
+	uintptr_t imageBegin = 0;
+	size_t imageSize = 0;
+	bool changed = false;
+
+	hint_cache_file(std::multimap<uint64_t, uintptr_t>& hints, std::set<uint64_t>& complete)
+		: m_hints(hints), m_complete(complete)
+	{
+		HMODULE module = nullptr;
+		char path[MAX_PATH];
+
+		if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, reinterpret_cast<LPCSTR>(&details::get_process_base), &module) ||
+			GetModuleFileNameA(module, path, MAX_PATH) == 0)
+		{
+			return;
+		}
+
+		m_path = path;
+		auto dot = m_path.find_last_of('.');
+		if (dot != std::string::npos && dot > m_path.find_last_of("\\/"))
+		{
+			m_path.erase(dot);
+		}
+		m_path += ".hints";
+
+		imageBegin = details::get_process_base();
+		auto dosHeader = reinterpret_cast<PIMAGE_DOS_HEADER>(imageBegin);
+		auto ntHeader = reinterpret_cast<PIMAGE_NT_HEADERS>(imageBegin + dosHeader->e_lfanew);
+		imageSize = ntHeader->OptionalHeader.SizeOfImage;
+		m_imageHash = hint_cache::hash(reinterpret_cast<const void*>(imageBegin), ntHeader->OptionalHeader.SizeOfHeaders);
+
+		hint_cache cache(m_imageHash);
+
+		if (cache.load(m_path))
+		{
+			for (auto& e : cache.entries())
+			{
+				m_hints.emplace(e.pattern, imageBegin + e.rva);
+
+				if (e.complete)
+				{
+					m_complete.insert(e.pattern);
+				}
+			}
+		}
+		else
+		{
+			// missing, damaged or taken from another executable: write a fresh one
+			changed = true;
+		}
+	}
+
+	// only when asked to, never from a destructor: that would run at unload, under the loader lock
+	void save()
+	{
+		if (!changed || m_path.empty())
+		{
+			return;
+		}
+
+		hint_cache cache(m_imageHash);
+
+		for (auto& hint : m_hints)
+		{
+			if (hint.second >= imageBegin && hint.second - imageBegin < imageSize)
+			{
+				cache.add(hint.first, static_cast<uint32_t>(hint.second - imageBegin), m_complete.count(hint.first) != 0);
+			}
+		}
+
+		if (cache.save(m_path))
+		{
+			changed = false;
+		}
+	}
+};
+#endif
+
 #if PATTERNS_USE_HINTS
 static auto& getHints()
 {
 	static std::multimap<uint64_t, uintptr_t> hints;
 	return hints;
 }
+
+// patterns whose hints are all of their matches. Hints of a count(n) scan that stopped early
+// are only enough for a later count(n) of the same pattern.
+static std::set<uint64_t>& getCompleteHints()
+{
+	static std::set<uint64_t> complete;
+	return complete;
+}
+
+#if PATTERNS_USE_HINT_CACHE
+static hint_cache_file& getHintCache()
+{
+	static hint_cache_file cache(getHints(), getCompleteHints());
+	return cache;
+}
+
+void save_hint_cache()
+{
+	getHintCache().save();
+}
+#endif
+
+static void addHint(uint64_t hash, uintptr_t address)
+{
+	getHints().emplace(hash, address);
+
+#if PATTERNS_USE_HINT_CACHE
+	getHintCache().changed = true;
+#endif
+}
+
+// drops the hints of a pattern before they're replaced by a new scan
+static void eraseHints(uint64_t hash)
+{
+	getHints().erase(hash);
+	getCompleteHints().erase(hash);
+
+#if PATTERNS_USE_HINT_CACHE
+	getHintCache().changed = true;
+#endif
+}
+
+static void setHintsComplete(uint64_t hash)
+{
+	if (getCompleteHints().insert(hash).second)
+	{
+#if PATTERNS_USE_HINT_CACHE
+		getHintCache().changed = true;
+#endif
+	}
+}
+
+// checks a hint against the pattern, hints are only trusted as-is if they can't be serialized
+static bool validateHint(uintptr_t address, const uint8_t* pattern, const uint8_t* mask, size_t size)
+{
+#if PATTERNS_USE_HINT_CACHE
+	auto& cache = getHintCache();
+	return hint_cache::validate(reinterpret_cast<const uint8_t*>(cache.imageBegin), cache.imageSize, address - cache.imageBegin, pattern, mask, size);
+#elif PATTERNS_CAN_SERIALIZE_HINTS
+	const uint8_t* ptr = reinterpret_cast<const uint8_t*>(address);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		if (pattern[i] != (ptr[i] & mask[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+#else
+	(void)address; (void)pattern; (void)mask; (void)size;
+	return true;
+#endif
+}
+
+// hints are taken from and kept for the process image only, unless they can't be saved anyway
+static bool hintsApply(uintptr_t rangeStart)
+{
+#if PATTERNS_CAN_SERIALIZE_HINTS
+	return rangeStart == reinterpret_cast<uintptr_t>(GetModuleHandle(nullptr));
+#else
+	(void)rangeStart;
+	return true;
+#endif
+}
+
+static std::multimap<uint64_t, uintptr_t>& getLoadedHints()
+{
+#if PATTERNS_USE_HINT_CACHE
+	getHintCache();
+#endif
+	return getHints();
+}
 #endif
 
 static void TransformPattern(std::string_view pattern, std::basic_string<uint8_t>& data, std::basic_string<uint8_t>& mask) 
@@ -181,74 +377,283 @@ public:
 	inline uintptr_t end() const   { return m_end; }
 };
 
-namespace details
+// rough rarity of a byte in x86/x64 code, opcodes and operands that show up everywhere rank worst
+static int ByteCost(uint8_t b)
 {
+	switch (b)
+	{
+	case 0x00: case 0xFF: case 0xCC: case 0x90:
+		return 2;
+	case 0x0F: case 0x24: case 0x44: case 0x48: case 0x4C:
+	case 0x83: case 0x89: case 0x8B: case 0x8D: case 0xE8:
+		return 1;
+	}
+	return 0;
+}
 
-void basic_pattern_impl::Initialize(std::string_view pattern)
+#if PATTERNS_USE_SIMD
+
+#ifdef _MSC_VER
+#define PATTERNS_TARGET_SSE2
+#define PATTERNS_TARGET_AVX2
+#else
+#define PATTERNS_TARGET_SSE2 __attribute__((target("sse2")))
+#define PATTERNS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using simd_level = scan_simd_level;
+
+static std::atomic<simd_level> maxSimdLevel{ simd_level::avx2 };
+
+static simd_level GetSimdLevel()
 {
-	// get the hash for the base pattern
-#if PATTERNS_USE_HINTS
-	m_hash = fnv_1()(pattern);
+	static const simd_level level = []
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		if ((info[3] & (1 << 26)) == 0)
+		{
+			return simd_level::none;
+		}
+
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+			{
+				return simd_level::avx2;
+			}
+		}
+		return simd_level::sse2;
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return simd_level::avx2;
+		}
+		return __builtin_cpu_supports("sse2") ? simd_level::sse2 : simd_level::none;
 #endif
+	}();
 
-	// transform the base pattern from IDA format to canonical format
-	TransformPattern(pattern, m_bytes, m_mask);
+	return std::min(level, maxSimdLevel.load());
+}
 
-#if PATTERNS_USE_HINTS
-	// if there's hints, try those first
-#if PATTERNS_CAN_SERIALIZE_HINTS
-	if (m_rangeStart == reinterpret_cast<uintptr_t>(GetModuleHandle(nullptr)))
+static inline unsigned CountTrailingZeros(uint32_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return index;
+#else
+	return __builtin_ctz(value);
 #endif
+}
+
+// Pattern prepared for the vector kernels: two fixed bytes are compared across a whole
+// block of candidate positions at once, only the positions where both hit get the full check.
+struct simd_pattern
+{
+	const uint8_t* bytes;
+	const uint8_t* mask;
+	size_t size;
+
+	size_t rareOffset;
+	size_t otherOffset;
+
+	// bytes/mask padded with wildcards to a multiple of 16 for the vector verification
+	uint8_t paddedBytes[256];
+	uint8_t paddedMask[256];
+	size_t paddedSize;
+};
+
+static bool PrepareSimdPattern(const uint8_t* pattern, const uint8_t* mask, size_t maskSize, simd_pattern& out)
+{
+	size_t rare = SIZE_MAX, other = SIZE_MAX;
+
+	for (size_t i = 0; i < maskSize; i++)
+	{
+		if (mask[i] == 0xFF && (rare == SIZE_MAX || ByteCost(pattern[i]) < ByteCost(pattern[rare])))
+		{
+			rare = i;
+		}
+	}
+
+	if (rare == SIZE_MAX)
 	{
-		auto range = getHints().equal_range(m_hash);
+		return false;
+	}
 
-		if (range.first != range.second)
+	// the second byte is the fixed one furthest away from the first, neighbouring bytes tend to correlate
+	for (size_t i = 0; i < maskSize; i++)
+	{
+		if (mask[i] == 0xFF && i != rare && (other == SIZE_MAX || (i > rare ? i - rare : rare - i) > (other > rare ? other - rare : rare - other)))
+		{
+			other = i;
+		}
+	}
+
+	out.bytes = pattern;
+	out.mask = mask;
+	out.size = maskSize;
+	out.rareOffset = rare;
+	out.otherOffset = other == SIZE_MAX ? rare : other;
+	out.paddedSize = (maskSize + 15) & ~size_t(15);
+
+	if (out.paddedSize > sizeof(out.paddedBytes))
+	{
+		out.paddedSize = 0;
+		return true;
+	}
+
+	std::fill(std::begin(out.paddedBytes), std::end(out.paddedBytes), uint8_t(0));
+	std::fill(std::begin(out.paddedMask), std::end(out.paddedMask), uint8_t(0));
+	std::copy(pattern, pattern + maskSize, out.paddedBytes);
+	std::copy(mask, mask + maskSize, out.paddedMask);
+	return true;
+}
+
+PATTERNS_TARGET_SSE2 static bool VerifySimd(const uint8_t* ptr, const uint8_t* end, const simd_pattern& p)
+{
+	if (p.paddedSize != 0 && ptr + p.paddedSize <= end)
+	{
+		for (size_t k = 0; k < p.paddedSize; k += 16)
 		{
-			std::for_each(range.first, range.second, [&] (const auto& hint)
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + k));
+			__m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.paddedMask + k));
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.paddedBytes + k));
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(data, mask), bytes)) != 0xFFFF)
 			{
-				ConsiderHint(hint.second);
-			});
+				return false;
+			}
+		}
+		return true;
+	}
 
-			// if the hints succeeded, we don't need to do anything more
-			if (!m_matches.empty())
+	for (size_t k = 0; k < p.size; k++)
+	{
+		if (p.bytes[k] != (ptr[k] & p.mask[k]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// candidate start positions are [begin, begin + count)
+PATTERNS_TARGET_SSE2 static void ScanSSE2(const uint8_t* begin, size_t count, const uint8_t* end, const simd_pattern& p, uint32_t maxCount, std::vector<pattern_match>& matches)
+{
+	const __m128i rare = _mm_set1_epi8(static_cast<char>(p.bytes[p.rareOffset]));
+	const __m128i other = _mm_set1_epi8(static_cast<char>(p.bytes[p.otherOffset]));
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i + p.rareOffset));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i + p.otherOffset));
+		uint32_t hits = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, rare), _mm_cmpeq_epi8(b, other)));
+
+		while (hits)
+		{
+			const uint8_t* ptr = begin + i + CountTrailingZeros(hits);
+			hits &= hits - 1;
+
+			if (VerifySimd(ptr, end, p))
+			{
+				matches.emplace_back(const_cast<uint8_t*>(ptr));
+				if (matches.size() == maxCount)
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	for (; i < count; i++)
+	{
+		if (VerifySimd(begin + i, end, p))
+		{
+			matches.emplace_back(const_cast<uint8_t*>(begin + i));
+			if (matches.size() == maxCount)
 			{
-				m_matched = true;
 				return;
 			}
 		}
 	}
-#endif
 }
 
-void basic_pattern_impl::EnsureMatches(uint32_t maxCount)
+PATTERNS_TARGET_AVX2 static void ScanAVX2(const uint8_t* begin, size_t count, const uint8_t* end, const simd_pattern& p, uint32_t maxCount, std::vector<pattern_match>& matches)
 {
-	if (m_matched || (!m_rangeStart && !m_rangeEnd))
+	const __m256i rare = _mm256_set1_epi8(static_cast<char>(p.bytes[p.rareOffset]));
+	const __m256i other = _mm256_set1_epi8(static_cast<char>(p.bytes[p.otherOffset]));
+
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32)
 	{
-		return;
-	}
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i + p.rareOffset));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i + p.otherOffset));
+		uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, rare), _mm256_cmpeq_epi8(b, other))));
 
-	// scan the executable for code
-	executable_meta executable = m_rangeStart != 0 && m_rangeEnd != 0 ? executable_meta(m_rangeStart, m_rangeEnd) : executable_meta(m_rangeStart);
+		// VerifySimd is SSE code, with the upper halves still in use every instruction of it would
+		// pay for the switch between AVX and SSE state
+		if (hits)
+		{
+			_mm256_zeroupper();
+		}
+
+		while (hits)
+		{
+			const uint8_t* ptr = begin + i + CountTrailingZeros(hits);
+			hits &= hits - 1;
+
+			if (VerifySimd(ptr, end, p))
+			{
+				matches.emplace_back(const_cast<uint8_t*>(ptr));
+				if (matches.size() == maxCount)
+				{
+					return;
+				}
+			}
+		}
+	}
 
-	auto matchSuccess = [&] (uintptr_t address)
+	if (i < count)
 	{
-#if PATTERNS_USE_HINTS
-		getHints().emplace(m_hash, address);
-#else
-		(void)address;
+		ScanSSE2(begin + i, count - i, end, p, maxCount, matches);
+	}
+}
+
 #endif
 
-		return (m_matches.size() == maxCount);
-	};
+// Boyer-Moore-Horspool scan of [begin, end) for a single masked pattern,
+// vectorized when the CPU allows it and the pattern has a fixed byte to look for
+static void ScanRangeSerial(uintptr_t begin, uintptr_t end, const uint8_t* pattern, const uint8_t* mask, size_t maskSize, uint32_t maxCount, std::vector<pattern_match>& matches)
+{
+	if (maskSize == 0 || end < begin || end - begin < maskSize)
+	{
+		return;
+	}
+
+	ptrdiff_t lastWild = -1;
 
-	const uint8_t* pattern = m_bytes.data();
-	const uint8_t* mask = m_mask.data();
-	const size_t maskSize = m_mask.size();
-	const size_t lastWild = m_mask.find_last_not_of(uint8_t(0xFF));
+	for (size_t i = 0; i < maskSize; i++)
+	{
+		if (mask[i] != 0xFF)
+		{
+			lastWild = static_cast<ptrdiff_t>(i);
+		}
+	}
 
 	ptrdiff_t Last[256];
 
-	std::fill(std::begin(Last), std::end(Last), lastWild == std::string::npos ? -1 : static_cast<ptrdiff_t>(lastWild) );
+	std::fill(std::begin(Last), std::end(Last), lastWild);
 
 	for ( ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(maskSize); ++i )
 	{
@@ -258,11 +663,43 @@ void basic_pattern_impl::EnsureMatches(uint32_t maxCount)
 		}
 	}
 
+#if PATTERNS_USE_SIMD
+	simd_level level = GetSimdLevel();
+	simd_pattern simdPattern;
+
+	if (level != simd_level::none && PrepareSimdPattern(pattern, mask, maskSize, simdPattern))
+	{
+		const uint8_t* first = reinterpret_cast<const uint8_t*>(begin);
+		const uint8_t* last = reinterpret_cast<const uint8_t*>(end);
+		size_t count = (end - begin) - maskSize + 1;
+
+		#ifdef _MSC_VER
+		__try
+		{
+		#endif
+			if (level == simd_level::avx2)
+			{
+				ScanAVX2(first, count, last, simdPattern, maxCount, matches);
+			}
+			else
+			{
+				ScanSSE2(first, count, last, simdPattern, maxCount, matches);
+			}
+		#ifdef _MSC_VER
+		}
+		__except ((GetExceptionCode() == EXCEPTION_ACCESS_VIOLATION) ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+		{
+		}
+		#endif
+		return;
+	}
+#endif
+
 	#ifdef _MSC_VER
 	__try
 	{
 	#endif
-		for (uintptr_t i = executable.begin(), end = executable.end() - maskSize; i <= end;)
+		for (uintptr_t i = begin, last = end - maskSize; i <= last;)
 		{
 			uint8_t* ptr = reinterpret_cast<uint8_t*>(i);
 			ptrdiff_t j = maskSize - 1;
@@ -271,9 +708,9 @@ void basic_pattern_impl::EnsureMatches(uint32_t maxCount)
 
 			if (j < 0)
 			{
-				m_matches.emplace_back(ptr);
+				matches.emplace_back(ptr);
 
-				if (matchSuccess(i))
+				if (matches.size() == maxCount)
 				{
 					break;
 				}
@@ -287,27 +724,227 @@ void basic_pattern_impl::EnsureMatches(uint32_t maxCount)
 	{
 	}
 	#endif
+}
 
-	m_matched = true;
+void set_scan_simd_level(scan_simd_level maxLevel)
+{
+#if PATTERNS_USE_SIMD
+	maxSimdLevel = maxLevel;
+#else
+	(void)maxLevel;
+#endif
 }
 
-bool basic_pattern_impl::ConsiderHint(uintptr_t offset)
+scan_simd_level get_scan_simd_level()
 {
-	uint8_t* ptr = reinterpret_cast<uint8_t*>(offset);
+#if PATTERNS_USE_SIMD
+	return GetSimdLevel();
+#else
+	return scan_simd_level::none;
+#endif
+}
 
-#if PATTERNS_CAN_SERIALIZE_HINTS
-	const uint8_t* pattern = m_bytes.data();
-	const uint8_t* mask = m_mask.data();
+static std::atomic<unsigned> scanThreads{ 0 };
 
-	for (size_t i = 0, j = m_mask.size(); i < j; i++)
-	{
-		if (pattern[i] != (ptr[i] & mask[i]))
-		{
-			return false;
+void set_scan_threads(unsigned count)
+{
+	scanThreads = count;
+}
+
+unsigned get_scan_threads()
+{
+	unsigned count = scanThreads;
+
+	if (count == 0)
+	{
+		count = std::min(std::max(std::thread::hardware_concurrency(), 1u), 8u);
+	}
+
+	return count;
+}
+
+// ranges below two chunks are scanned serially
+static constexpr size_t scanChunkSize = 1024 * 1024;
+
+static size_t GetScanChunkCount(uintptr_t begin, uintptr_t end)
+{
+	unsigned threads = get_scan_threads();
+	size_t size = end - begin;
+
+	if (threads <= 1 || end < begin || size < 2 * scanChunkSize)
+	{
+		return 1;
+	}
+
+	// a few chunks per thread even out sections of uneven density
+	return std::min<size_t>(size_t(threads) * 4, size / scanChunkSize);
+}
+
+static uintptr_t GetScanChunkBound(uintptr_t begin, uintptr_t end, size_t chunks, size_t index)
+{
+	return begin + static_cast<uintptr_t>(uint64_t(end - begin) * index / chunks);
+}
+
+static void ScanRange(uintptr_t begin, uintptr_t end, const uint8_t* pattern, const uint8_t* mask, size_t maskSize, uint32_t maxCount, std::vector<pattern_match>& matches)
+{
+	size_t chunks = GetScanChunkCount(begin, end);
+
+	if (chunks <= 1 || maskSize == 0)
+	{
+		ScanRangeSerial(begin, end, pattern, mask, maskSize, maxCount, matches);
+		return;
+	}
+
+	std::vector<std::vector<pattern_match>> results(chunks);
+	std::atomic<size_t> firstFull{ SIZE_MAX };
+
+	plugin::ThreadPool::Get().Run(chunks, get_scan_threads(), [&](size_t index)
+	{
+		// once a chunk found enough matches, the ones after it can't contribute anymore
+		if (index > firstFull)
+		{
+			return;
+		}
+
+		uintptr_t chunkBegin = GetScanChunkBound(begin, end, chunks, index);
+		uintptr_t chunkEnd = GetScanChunkBound(begin, end, chunks, index + 1);
+
+		// chunks overlap by the pattern size - 1, so matches crossing a chunk bound are found once
+		chunkEnd = end - chunkEnd < maskSize - 1 ? end : chunkEnd + maskSize - 1;
+
+		ScanRangeSerial(chunkBegin, chunkEnd, pattern, mask, maskSize, maxCount, results[index]);
+
+		if (results[index].size() == maxCount)
+		{
+			size_t current = firstFull;
+			while (index < current && !firstFull.compare_exchange_weak(current, index));
+		}
+	});
+
+	// merged in address order, so get_first stays deterministic
+	for (auto& result : results)
+	{
+		for (auto& match : result)
+		{
+			if (matches.size() == maxCount)
+			{
+				return;
+			}
+			matches.push_back(match);
+		}
+	}
+}
+
+namespace details
+{
+
+void basic_pattern_impl::Initialize(std::string_view pattern)
+{
+	// get the hash for the base pattern
+#if PATTERNS_USE_HINTS
+	m_hash = fnv_1()(pattern);
+#endif
+
+	// transform the base pattern from IDA format to canonical format
+	TransformPattern(pattern, m_bytes, m_mask);
+
+#if PATTERNS_USE_HINTS
+	// if there's hints, try those first
+	if (hintsApply(m_rangeStart))
+	{
+		auto& hints = getLoadedHints();
+		auto range = hints.equal_range(m_hash);
+
+		if (range.first != range.second)
+		{
+			for (auto it = range.first; it != range.second;)
+			{
+				if (ConsiderHint(it->second))
+				{
+					++it;
+					continue;
+				}
+
+				// stale hint, don't keep it around, the others aren't all matches anymore
+				it = hints.erase(it);
+				getCompleteHints().erase(m_hash);
+#if PATTERNS_USE_HINT_CACHE
+				getHintCache().changed = true;
+#endif
+			}
+
+			// if the hints succeeded, we don't need to do anything more unless more matches are asked for
+			if (!m_matches.empty())
+			{
+				m_matched = true;
+				m_complete = getCompleteHints().count(m_hash) != 0;
+				return;
+			}
+		}
+	}
+#endif
+}
+
+void basic_pattern_impl::EnsureMatches(uint32_t maxCount)
+{
+	if (!m_rangeStart && !m_rangeEnd)
+	{
+		return;
+	}
+
+	// matches of a scan or hints that stopped at a lower count aren't enough
+	if (m_matched && (m_complete || m_matches.size() >= maxCount))
+	{
+		// a count() gets the first matches only, as it would from a scan
+		if (m_matches.size() > maxCount)
+		{
+			m_matches.erase(m_matches.begin() + maxCount, m_matches.end());
+			m_complete = false;
+		}
+
+		return;
+	}
+
+	// scan the executable for code
+	executable_meta executable = m_rangeStart != 0 && m_rangeEnd != 0 ? executable_meta(m_rangeStart, m_rangeEnd) : executable_meta(m_rangeStart);
+
+	m_matches.clear();
+
+	ScanRange(executable.begin(), executable.end(), m_bytes.data(), m_mask.data(), m_mask.size(), maxCount, m_matches);
+
+	m_complete = maxCount == UINT32_MAX || m_matches.size() < maxCount;
+
+#if PATTERNS_USE_HINTS
+	if (hintsApply(m_rangeStart))
+	{
+		eraseHints(m_hash);
+
+		for (auto& match : m_matches)
+		{
+			addHint(m_hash, reinterpret_cast<uintptr_t>(match.get<void>()));
+		}
+
+		if (m_complete)
+		{
+			setHintsComplete(m_hash);
 		}
 	}
 #endif
 
+	m_matched = true;
+}
+
+bool basic_pattern_impl::ConsiderHint(uintptr_t offset)
+{
+	uint8_t* ptr = reinterpret_cast<uint8_t*>(offset);
+
+#if PATTERNS_USE_HINTS
+	if (!validateHint(offset, m_bytes.data(), m_mask.data(), m_mask.size()))
+	{
+		return false;
+	}
+#endif
+
 	m_matches.emplace_back(ptr);
 
 	return true;
@@ -316,7 +953,7 @@ bool basic_pattern_impl::ConsiderHint(uintptr_t offset)
 #if PATTERNS_USE_HINTS && PATTERNS_CAN_SERIALIZE_HINTS
 void basic_pattern_impl::hint(uint64_t hash, uintptr_t address)
 {
-	auto& hints = getHints();
+	auto& hints = getLoadedHints();
 
 	auto range = hints.equal_range(hash);
 
@@ -328,9 +965,314 @@ void basic_pattern_impl::hint(uint64_t hash, uintptr_t address)
 		}
 	}
 
-	hints.emplace(hash, address);
+	addHint(hash, address);
+}
+#endif
+
+}
+
+// pairs of consecutive fixed bytes that are cheapest to use as a batch anchor
+static int AnchorPairCost(uint8_t first, uint8_t second)
+{
+	return ByteCost(first) + ByteCost(second);
+}
+
+size_t pattern_batch::add(std::string_view pattern)
+{
+	entry& e = m_entries.emplace_back();
+	TransformPattern(pattern, e.bytes, e.mask);
+
+#if PATTERNS_USE_HINTS
+	e.hash = fnv_1()(pattern);
+	e.hinted = false;
+#endif
+
+	e.anchor = std::string::npos;
+	int bestCost = INT_MAX;
+
+	for (size_t i = 0; i + 1 < e.mask.size(); i++)
+	{
+		if (e.mask[i] == 0xFF && e.mask[i + 1] == 0xFF)
+		{
+			int cost = AnchorPairCost(e.bytes[i], e.bytes[i + 1]);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				e.anchor = i;
+			}
+		}
+	}
+
+	return m_entries.size() - 1;
+}
+
+void pattern_batch::scan()
+{
+	scan(reinterpret_cast<void*>(details::get_process_base()));
+}
+
+void pattern_batch::scan(void* module)
+{
+	executable_meta executable(reinterpret_cast<uintptr_t>(module));
+
+#if PATTERNS_USE_HINTS
+	bool useHints = reinterpret_cast<uintptr_t>(module) == reinterpret_cast<uintptr_t>(GetModuleHandle(nullptr));
+
+	for (auto& e : m_entries)
+	{
+		e.matches.clear();
+		e.hinted = false;
+
+		if (!useHints)
+		{
+			continue;
+		}
+
+		// same as basic_pattern_impl::Initialize, patterns with valid hints don't take part in the scan.
+		// The batch finds every match, so hints that may be only the first few aren't used.
+		auto& hints = getLoadedHints();
+
+		if (getCompleteHints().count(e.hash) == 0)
+		{
+			continue;
+		}
+
+		auto range = hints.equal_range(e.hash);
+
+		for (auto it = range.first; it != range.second;)
+		{
+			if (validateHint(it->second, e.bytes.data(), e.mask.data(), e.mask.size()))
+			{
+				e.matches.emplace_back(reinterpret_cast<void*>(it->second));
+				++it;
+				continue;
+			}
+
+			it = hints.erase(it);
+			getCompleteHints().erase(e.hash);
+#if PATTERNS_USE_HINT_CACHE
+			getHintCache().changed = true;
+#endif
+		}
+
+		// some were stale, the rest are scanned for again
+		if (getCompleteHints().count(e.hash) == 0)
+		{
+			e.matches.clear();
+		}
+
+		e.hinted = !e.matches.empty();
+	}
+
+	scan_pending(executable.begin(), executable.end());
+
+	if (useHints)
+	{
+		for (auto& e : m_entries)
+		{
+			if (!e.hinted)
+			{
+				eraseHints(e.hash);
+
+				for (auto& match : e.matches)
+				{
+					addHint(e.hash, reinterpret_cast<uintptr_t>(match.get<void>()));
+				}
+
+				setHintsComplete(e.hash);
+			}
+		}
+	}
+#else
+	scan(executable.begin(), executable.end());
+#endif
+}
+
+void pattern_batch::scan(uintptr_t begin, uintptr_t end)
+{
+	for (auto& e : m_entries)
+	{
+		e.matches.clear();
+#if PATTERNS_USE_HINTS
+		e.hinted = false;
+#endif
+	}
+
+	scan_pending(begin, end);
 }
+
+// below this many patterns a pass of the vectorized single pattern scan per pattern is faster than the anchored pass
+static constexpr size_t BATCH_MIN_PATTERNS = 4;
+
+void pattern_batch::scan_pending(uintptr_t begin, uintptr_t end)
+{
+	size_t pending = 0;
+
+	for (auto& e : m_entries)
+	{
+#if PATTERNS_USE_HINTS
+		if (e.hinted)
+		{
+			continue;
+		}
+#endif
+		pending++;
+	}
+
+	if (pending < BATCH_MIN_PATTERNS)
+	{
+		for (auto& e : m_entries)
+		{
+#if PATTERNS_USE_HINTS
+			if (e.hinted)
+			{
+				continue;
+			}
+#endif
+			ScanRange(begin, end, e.bytes.data(), e.mask.data(), e.mask.size(), UINT32_MAX, e.matches);
+		}
+		return;
+	}
+
+	// bucket the anchored patterns by their anchor pair, CSR style
+	std::vector<uint32_t> present(0x10000 / 32, 0);
+	std::vector<uint32_t> bucketStart(0x10000 + 1, 0);
+	std::vector<uint32_t> bucketItems;
+
+	for (auto& e : m_entries)
+	{
+#if PATTERNS_USE_HINTS
+		if (e.hinted)
+		{
+			continue;
+		}
 #endif
 
+		if (e.anchor == std::string::npos)
+		{
+			// nothing to anchor on, such patterns get a scan of their own
+			ScanRange(begin, end, e.bytes.data(), e.mask.data(), e.mask.size(), UINT32_MAX, e.matches);
+			continue;
+		}
+
+		uint16_t key = e.bytes[e.anchor] | (e.bytes[e.anchor + 1] << 8);
+		present[key / 32] |= 1u << (key % 32);
+		bucketStart[key + 1]++;
+	}
+
+	for (size_t i = 1; i < bucketStart.size(); i++)
+	{
+		bucketStart[i] += bucketStart[i - 1];
+	}
+
+	if (bucketStart.back() == 0)
+	{
+		return;
+	}
+
+	bucketItems.resize(bucketStart.back());
+	std::vector<uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+
+	for (uint32_t i = 0; i < m_entries.size(); i++)
+	{
+		const entry& e = m_entries[i];
+
+#if PATTERNS_USE_HINTS
+		if (e.hinted)
+		{
+			continue;
+		}
+#endif
+
+		if (e.anchor != std::string::npos)
+		{
+			uint16_t key = e.bytes[e.anchor] | (e.bytes[e.anchor + 1] << 8);
+			bucketItems[cursor[key]++] = i;
+		}
+	}
+
+	size_t chunks = GetScanChunkCount(begin, end);
+
+	if (chunks <= 1)
+	{
+		std::vector<std::vector<pattern_match>> results(m_entries.size());
+		scan_anchored(begin, end, begin, end, present.data(), bucketStart.data(), bucketItems.data(), results.data());
+
+		for (size_t i = 0; i < m_entries.size(); i++)
+		{
+			m_entries[i].matches.insert(m_entries[i].matches.end(), results[i].begin(), results[i].end());
+		}
+		return;
+	}
+
+	// every anchor position belongs to exactly one chunk, so there's no overlap to deduplicate
+	std::vector<std::vector<std::vector<pattern_match>>> results(chunks, std::vector<std::vector<pattern_match>>(m_entries.size()));
+
+	plugin::ThreadPool::Get().Run(chunks, get_scan_threads(), [&](size_t index)
+	{
+		scan_anchored(begin, end, GetScanChunkBound(begin, end, chunks, index), GetScanChunkBound(begin, end, chunks, index + 1),
+			present.data(), bucketStart.data(), bucketItems.data(), results[index].data());
+	});
+
+	for (auto& result : results)
+	{
+		for (size_t i = 0; i < m_entries.size(); i++)
+		{
+			m_entries[i].matches.insert(m_entries[i].matches.end(), result[i].begin(), result[i].end());
+		}
+	}
+}
+
+void pattern_batch::scan_anchored(uintptr_t begin, uintptr_t end, uintptr_t scanBegin, uintptr_t scanEnd, const uint32_t* present, const uint32_t* bucketStart, const uint32_t* bucketItems, std::vector<pattern_match>* results)
+{
+	if (end < begin || end - begin < 2)
+	{
+		return;
+	}
+
+	scanEnd = std::min(scanEnd, end - 1);
+
+	#ifdef _MSC_VER
+	__try
+	{
+	#endif
+		for (uintptr_t i = scanBegin; i < scanEnd; i++)
+		{
+			const uint8_t* ptr = reinterpret_cast<const uint8_t*>(i);
+			uint16_t key = ptr[0] | (ptr[1] << 8);
+
+			if ((present[key / 32] & (1u << (key % 32))) == 0)
+			{
+				continue;
+			}
+
+			for (uint32_t k = bucketStart[key]; k < bucketStart[key + 1]; k++)
+			{
+				const entry& e = m_entries[bucketItems[k]];
+
+				if (i - begin < e.anchor || end - (i - e.anchor) < e.mask.size())
+				{
+					continue;
+				}
+
+				uint8_t* start = reinterpret_cast<uint8_t*>(i - e.anchor);
+				const uint8_t* pattern = e.bytes.data();
+				const uint8_t* mask = e.mask.data();
+				size_t j = 0;
+
+				while (j < e.mask.size() && pattern[j] == (start[j] & mask[j])) j++;
+
+				if (j == e.mask.size())
+				{
+					results[bucketItems[k]].emplace_back(start);
+				}
+			}
+		}
+	#ifdef _MSC_VER
+	}
+	__except ((GetExceptionCode() == EXCEPTION_ACCESS_VIOLATION) ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+	{
+	}
+	#endif
 }
 }
@@ -12,6 +12,20 @@
 #include <string_view>
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <set>
+#include <utility>
+
+// Define PATTERNS_USE_HINT_CACHE to keep the hints found in the process image between runs, in a
+// cache file next to the module using the patterns. The file is written by hook::save_hint_cache.
+#if PATTERNS_USE_HINT_CACHE
+#ifndef PATTERNS_USE_HINTS
+#define PATTERNS_USE_HINTS 1
+#endif
+#ifndef PATTERNS_CAN_SERIALIZE_HINTS
+#define PATTERNS_CAN_SERIALIZE_HINTS 1
+#endif
+#endif
 
 #if defined(_CPPUNWIND) && !defined(PATTERNS_SUPPRESS_EXCEPTIONS)
 #define PATTERNS_ENABLE_EXCEPTIONS
@@ -61,6 +75,24 @@ namespace hook
 		}
 	};
 
+	// Number of threads scanning one range, the calling thread included. 0 picks one per
+	// hardware thread (the default), 1 scans serially. Small ranges are always scanned serially.
+	// The threads are those of plugin::ThreadPool.
+	void set_scan_threads(unsigned count);
+	unsigned get_scan_threads();
+
+	enum class scan_simd_level
+	{
+		none,
+		sse2,
+		avx2
+	};
+
+	// Highest instruction set the single pattern scan may use, avx2 (the default) takes the best
+	// the CPU has. Lower it to compare the kernels, get_scan_simd_level is the one that's used.
+	void set_scan_simd_level(scan_simd_level maxLevel);
+	scan_simd_level get_scan_simd_level();
+
 	namespace details
 	{
 		ptrdiff_t get_process_base();
@@ -78,6 +110,8 @@ namespace hook
 			std::vector<pattern_match> m_matches;
 
 			bool m_matched = false;
+			// m_matches are all matches in the range, not only the first ones of a count()
+			bool m_complete = false;
 
 			uintptr_t m_rangeStart;
 			uintptr_t m_rangeEnd;
@@ -170,6 +204,7 @@ namespace hook
 
 			m_matches.clear();
 			m_matched = false;
+			m_complete = false;
 			return std::forward<basic_pattern>(*this);
 		}
 
@@ -224,6 +259,114 @@ namespace hook
 
 	using pattern = basic_pattern<assert_err_policy>;
 
+	// Resolves many patterns with a single pass over the scanned range.
+	// Every pattern is indexed by a pair of fixed bytes (its anchor), so the pass
+	// costs one table probe per byte no matter how many patterns were added.
+	// Batches of only a few patterns are scanned one pattern at a time, which is faster for them.
+	class pattern_batch
+	{
+	private:
+		struct entry
+		{
+			std::basic_string<uint8_t> bytes;
+			std::basic_string<uint8_t> mask;
+			size_t anchor;
+
+#if PATTERNS_USE_HINTS
+			uint64_t hash;
+			bool hinted;
+#endif
+
+			std::vector<pattern_match> matches;
+		};
+
+		std::vector<entry> m_entries;
+
+		void scan_pending(uintptr_t begin, uintptr_t end);
+		void scan_anchored(uintptr_t begin, uintptr_t end, uintptr_t scanBegin, uintptr_t scanEnd, const uint32_t* present, const uint32_t* bucketStart, const uint32_t* bucketItems, std::vector<pattern_match>* results);
+
+	public:
+		// returns the index of the pattern in the batch
+		size_t add(std::string_view pattern);
+
+		// scans the executable section of the process / module / given range, all previous results are discarded
+		void scan();
+		void scan(void* module);
+		void scan(uintptr_t begin, uintptr_t end);
+
+		inline size_t size() const
+		{
+			return m_entries.size();
+		}
+
+		// matches of the pattern at the given index, in address order
+		inline const std::vector<pattern_match>& matches(size_t index) const
+		{
+			return m_entries[index].matches;
+		}
+	};
+
+	// Pattern hints of one image kept between runs: pattern hash -> RVA of its match.
+	// Holds only the file format and the validation, so it works on any byte buffer.
+	class hint_cache
+	{
+	public:
+		struct entry
+		{
+			uint64_t pattern;
+			uint32_t rva;
+			// the pattern's entries are all of its matches, not just the first few a count() asked for
+			bool complete;
+		};
+
+	private:
+		uint64_t m_imageHash;
+		std::vector<entry> m_entries;
+		std::set<std::pair<uint64_t, uint32_t>> m_seen;
+
+	public:
+		explicit hint_cache(uint64_t imageHash = 0)
+			: m_imageHash(imageHash)
+		{
+		}
+
+		// 64-bit FNV-1a, identifies the image the hints were taken from
+		static uint64_t hash(const void* data, size_t size);
+
+		// checks that the masked pattern matches at rva and lies within the [base, base + size) image
+		static bool validate(const uint8_t* base, size_t size, uintptr_t rva, const uint8_t* bytes, const uint8_t* mask, size_t length);
+
+		inline uint64_t image_hash() const
+		{
+			return m_imageHash;
+		}
+
+		inline const std::vector<entry>& entries() const
+		{
+			return m_entries;
+		}
+
+		// an entry that is already there is not added again
+		void add(uint64_t pattern, uint32_t rva, bool complete = false);
+
+		void clear();
+
+		std::vector<uint8_t> serialize() const;
+
+		// fails and leaves the cache empty when the data is damaged or was written for another image
+		bool deserialize(const uint8_t* data, size_t size);
+
+		bool load(const std::string& path);
+
+		bool save(const std::string& path) const;
+	};
+
+#if PATTERNS_USE_HINT_CACHE
+	// Writes the hints found since the cache file was loaded or last written, does nothing if there are none.
+	// plugin::pattern calls it after each batch, call it yourself after patterns were scanned for otherwise.
+	void save_hint_cache();
+#endif
+
 	inline auto make_module_pattern(void* module, std::string_view bytes)
 	{
 		return pattern(module, std::move(bytes));
@@ -7,5 +7,5 @@
 #include "CBike.h"
 
 CBike::CBike(uint8_t createdBy) : CVehicle(createdBy) {
-    plugin::CallMethodDyn(gpattern("53 56 57 FF 74 24 10 8B F9"), this, createdBy);
+    plugin::CallMethodDynGlobal(gpatternaddr("53 56 57 FF 74 24 10 8B F9"), this, createdBy);
 }
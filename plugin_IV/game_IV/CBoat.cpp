@@ -7,5 +7,5 @@
 #include "CBoat.h"
 
 CBoat::CBoat(uint8_t createdBy) : CVehicle(createdBy) {
-    plugin::CallMethodDyn(gpattern("56 57 FF 74 24 0C 8B F9 E8 ? ? ? ? 8D 8F"), this, createdBy);
+    plugin::CallMethodDynGlobal(gpatternaddr("56 57 FF 74 24 0C 8B F9 E8 ? ? ? ? 8D 8F"), this, createdBy);
 }
@@ -7,6 +7,6 @@
 #include "CCamIdle.h"
 
 void CCamIdle::ResetStats(bool unused) {
-    plugin::CallMethodDyn(gpattern("C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? 80 A1 ? ? ? ? ? 8B 81"), this, unused);
+    plugin::CallMethodDynGlobal(gpatternaddr("C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? C7 81 ? ? ? ? ? ? ? ? 80 A1 ? ? ? ? ? 8B 81"), this, unused);
 }
 
@@ -11,5 +11,5 @@ CCamera& TheCamera = *gpatternt(CCamera, "B9 ? ? ? ? E8 ? ? ? ? 8B 10 8B C8 A3",
 bool& CCamera::m_bCameraControlsDisabled = *gpatternt(bool, "A2 ? ? ? ? C3 CC CC CC CC CC CC CC 80 79 08 00", 1);
 
 CCam* CCamera::CreateCamMode(eCamMode mode, CCam* arg2, CCam* arg3) {
-    return plugin::CallMethodAndReturnDyn<CCam*>(gpattern("53 8B D9 56 33 F6 83 3B 3C"), this, mode, arg2, arg3);
+    return plugin::CallMethodAndReturnDynGlobal<CCam*>(gpatternaddr("53 8B D9 56 33 F6 83 3B 3C"), this, mode, arg2, arg3);
 }
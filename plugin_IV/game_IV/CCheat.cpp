@@ -14,41 +14,41 @@ bool* CCheat::m_aCheatsActive = gpatternt(bool, "80 BE ? ? ? ? ? B9 ? ? ? ? 74 0
 bool& CCheat::m_bHasPlayerCheated = *gpatternt(bool, "C6 05 ? ? ? ? ? 85 C0 74 04", 2);
 
 void CCheat::AddToCheatString(wchar_t lastPressedKey) {
-    plugin::CallDyn(gpattern("83 EC 24 A1 ? ? ? ? 33 C4 89 44 24 20 BA"), lastPressedKey);
+    plugin::CallDynGlobal(gpatternaddr("83 EC 24 A1 ? ? ? ? 33 C4 89 44 24 20 BA"), lastPressedKey);
 }
 
 CVehicle* CCheat::VehicleCheat(int32_t vehicleId) {
-    return plugin::CallAndReturnDyn<CVehicle*>(gpattern("55 8B EC 83 E4 F0 81 EC ? ? ? ? 56 57 8B 7D 08 85 FF 79 08"), vehicleId);
+    return plugin::CallAndReturnDynGlobal<CVehicle*>(gpatternaddr("55 8B EC 83 E4 F0 81 EC ? ? ? ? 56 57 8B 7D 08 85 FF 79 08"), vehicleId);
 }
 
 void CCheat::ActivateCheat(uint32_t id) {
-    plugin::CallDyn(gpattern("56 57 8B 7C 24 0C 8B 04 BD"), id);
+    plugin::CallDynGlobal(gpatternaddr("56 57 8B 7C 24 0C 8B 04 BD"), id);
 }
 
 void CCheat::WeaponCheat1() {
-    plugin::CallDyn(gpattern("E8 ? ? ? ? 6A 02 FF 35 ? ? ? ? 6A 03 E8 ? ? ? ? 83 C4 04 8B C8 E8 ? ? ? ? 50 E8 ? ? ? ? 83 C4 0C 6A 02 FF 35 ? ? ? ? 6A 05"));
+    plugin::CallDynGlobal(gpatternaddr("E8 ? ? ? ? 6A 02 FF 35 ? ? ? ? 6A 03 E8 ? ? ? ? 83 C4 04 8B C8 E8 ? ? ? ? 50 E8 ? ? ? ? 83 C4 0C 6A 02 FF 35 ? ? ? ? 6A 05"));
 }
 
 void CCheat::WeaponCheat2() {
-    plugin::CallDyn(gpattern("56 E8 ? ? ? ? 83 3D ? ? ? ? ? 6A 02"));
+    plugin::CallDynGlobal(gpatternaddr("56 E8 ? ? ? ? 83 3D ? ? ? ? ? 6A 02"));
 }
 
 void CCheat::HealthArmourAmmoCheat() {
-    plugin::CallDyn(gpattern("56 E8 ? ? ? ? 6A 00 E8 ? ? ? ? 6A 00"));
+    plugin::CallDynGlobal(gpatternaddr("56 E8 ? ? ? ? 6A 00 E8 ? ? ? ? 6A 00"));
 }
 
 void CCheat::IncreaseWantedLevelCheat() {
-    plugin::CallDyn(gpattern("E8 ? ? ? ? 6A 00 E8 ? ? ? ? 8B 88 ? ? ? ? 83 C4 04"));
+    plugin::CallDynGlobal(gpatternaddr("E8 ? ? ? ? 6A 00 E8 ? ? ? ? 8B 88 ? ? ? ? 83 C4 04"));
 }
 
 void CCheat::ClearWantedLevelCheat() {
-    plugin::CallDyn(gpattern("A1 ? ? ? ? 6A 04 A3"));
+    plugin::CallDynGlobal(gpatternaddr("A1 ? ? ? ? 6A 04 A3"));
 }
 
 void CCheat::ChangeWeatherCheat() {
-    plugin::CallDyn(gpattern("E8 ? ? ? ? E8 ? ? ? ? A1 ? ? ? ? 6A 06"));
+    plugin::CallDynGlobal(gpatternaddr("E8 ? ? ? ? E8 ? ? ? ? A1 ? ? ? ? 6A 06"));
 }
 
 void CCheat::SpawnAnnihilator() {
-    plugin::CallDyn(gpattern("80 3D ? ? ? ? ? 75 40 E8 ? ? ? ? F6 80 ? ? ? ? ? 74 13 8B 80 ? ? ? ? 85 C0 74 09 83 B8 ? ? ? ? ? 74 1F FF 35 ? ? ? ? E8 ? ? ? ? A1 ? ? ? ? 6A 07"));
+    plugin::CallDynGlobal(gpatternaddr("80 3D ? ? ? ? ? 75 40 E8 ? ? ? ? F6 80 ? ? ? ? ? 74 13 8B 80 ? ? ? ? 85 C0 74 09 83 B8 ? ? ? ? ? 74 1F FF 35 ? ? ? ? E8 ? ? ? ? A1 ? ? ? ? 6A 07"));
 }
@@ -12,5 +12,5 @@ int32_t& CFileTypeMgr::IndexOfType_WPL = *gpatternt(int32_t, "A3 ? ? ? ? E8 ? ?
 int32_t& CFileTypeMgr::IndexOfType_SCO = *gpatternt(int32_t, "A3 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC 83 EC 44", 1);
 
 CFileTypeMgr* CFileTypeMgr::GetManager() {
-    return plugin::CallAndReturnDyn<CFileTypeMgr*>(gpattern("B8 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC CC 83 EC 24"));
+    return plugin::CallAndReturnDynGlobal<CFileTypeMgr*>(gpatternaddr("B8 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC CC 83 EC 24"));
 }
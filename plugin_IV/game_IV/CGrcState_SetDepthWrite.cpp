@@ -7,5 +7,5 @@
 #include "CGrcState_SetDepthWrite.h"
 
 CGrcState_SetDepthWrite::CGrcState_SetDepthWrite(int32_t mode) {
-    plugin::CallMethodDyn<CGrcState_SetDepthWrite*>(gpattern("8B 41 04 C7 01 ? ? ? ? 33 05 ? ? ? ? 25 ? ? ? ? 31 41 04 8A 44 24 04"), this, mode);
+    plugin::CallMethodDynGlobal<CGrcState_SetDepthWrite*>(gpatternaddr("8B 41 04 C7 01 ? ? ? ? 33 05 ? ? ? ? 25 ? ? ? ? 31 41 04 8A 44 24 04"), this, mode);
 }
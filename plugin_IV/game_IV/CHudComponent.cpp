@@ -10,5 +10,5 @@ CHudComponentInfo* aHudComponentInfo = gpatternt(CHudComponentInfo, "BE ? ? ? ?
 int32_t& MaxComponentInfo = *gpatternt(int32_t, "81 FE ? ? ? ? 7C D6 8B 0D ? ? ? ? 6A 00 8B 0C 8D ? ? ? ? 6A 00", 2);
 
 bool CHudComponent::IsDisplaying() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("80 79 11 00 0F 95 C0"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("80 79 11 00 0F 95 C0"), this);
 }
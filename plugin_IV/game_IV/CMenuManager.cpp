@@ -34,25 +34,25 @@ uint8_t& CMenuManager::m_DefaultFrontend = *gpatternt(uint8_t, "C6 05 ? ? ? ? ?
 uint8_t& CMenuManager::m_Refresh = *gpatternt(uint8_t, "C6 05 ? ? ? ? ? 5F C3 3B 87", 2);
 
 void CMenuManager::SwitchMenuScreen(int32_t arg1, int32_t screen, int32_t option) {
-    plugin::CallDyn(gpattern("8B 44 24 08 83 EC 10 A3"), arg1, screen, option);
+    plugin::CallDynGlobal(gpatternaddr("8B 44 24 08 83 EC 10 A3"), arg1, screen, option);
 }
 
 void CMenuManager::DrawMouseCursor() {
-    plugin::CallDyn(gpattern("83 EC 2C 53 55 56 57 6A 01"));
+    plugin::CallDynGlobal(gpatternaddr("83 EC 2C 53 55 56 57 6A 01"));
 }
 
 void CMenuManager::SetHideMenuBar(uint8_t off) {
-    plugin::CallDyn(gpattern("80 3D ? ? ? ? ? 75 48 80 3D ? ? ? ? ? 75 3F"));
+    plugin::CallDynGlobal(gpatternaddr("80 3D ? ? ? ? ? 75 48 80 3D ? ? ? ? ? 75 3F"));
 }
 
 int32_t CMenuManager::GetCurrentOption(int32_t index) {
-    return plugin::CallAndReturnDyn<int32_t>(gpattern("8B 44 24 04 83 F8 A6 74 1B 8B 0C 85 ? ? ? ? 85 C9 74 10 80 B8 ? ? ? ? ? 74 07 8B 81 ? ? ? ? C3 33 C0 C3 CC CC CC CC CC CC CC CC CC 8B 44 24 04 83 F8 A6 74 12"), index);
+    return plugin::CallAndReturnDynGlobal<int32_t>(gpatternaddr("8B 44 24 04 83 F8 A6 74 1B 8B 0C 85 ? ? ? ? 85 C9 74 10 80 B8 ? ? ? ? ? 74 07 8B 81 ? ? ? ? C3 33 C0 C3 CC CC CC CC CC CC CC CC CC 8B 44 24 04 83 F8 A6 74 12"), index);
 }
 
 void CMenuManager::DrawHelpText() {
-    plugin::CallDyn(gpattern("55 8B EC 83 E4 F8 81 EC ? ? ? ? 53 56 8B 35 ? ? ? ? 57 85 F6"));
+    plugin::CallDynGlobal(gpatternaddr("55 8B EC 83 E4 F8 81 EC ? ? ? ? 53 56 8B 35 ? ? ? ? 57 85 F6"));
 }
 
 void CMenuManager::SetHelpText(const char* right, const char* left, uint8_t arg3) {
-    plugin::CallDyn(gpattern("8B 4C 24 08 56 57 8B 3D ? ? ? ? 8B F7"), right, left, arg3);
+    plugin::CallDynGlobal(gpatternaddr("8B 4C 24 08 56 57 8B 3D ? ? ? ? 8B F7"), right, left, arg3);
 }
\ No newline at end of file
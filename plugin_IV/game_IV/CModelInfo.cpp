@@ -10,5 +10,5 @@ CModelInfo* ModelInfo = gpatternt(CModelInfo, "A3 ? ? ? ? E8 ? ? ? ? 8B C8 E8 ?
 CBaseModelInfo** CModelInfo::ms_modelInfoPtrs = gpatternt(CBaseModelInfo*, "68 ? ? ? ? E8 ? ? ? ? 83 C4 0C C7 05 ? ? ? ? ? ? ? ? E9", 1); // [31000]
 
 CBaseModelInfo* CModelInfo::GetModelByHash(int32_t hash, uint32_t* indexOut) {
-    return plugin::CallAndReturnDyn<CBaseModelInfo*>(gpattern("8B 44 24 04 89 44 24 04 66 A1 ? ? ? ? 66 85 C0 74 3F"), hash, indexOut);
+    return plugin::CallAndReturnDynGlobal<CBaseModelInfo*>(gpatternaddr("8B 44 24 04 89 44 24 04 66 A1 ? ? ? ? 66 85 C0 74 3F"), hash, indexOut);
 }
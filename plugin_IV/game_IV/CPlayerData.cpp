@@ -7,5 +7,5 @@
 #include "CPlayerData.h"
 
 int32_t CPlayerData::GetWantedLevel() {
-    return plugin::CallMethodAndReturnDyn<int32_t>(gpattern("8B 81 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC 83 B9"), this);
+    return plugin::CallMethodAndReturnDynGlobal<int32_t>(gpatternaddr("8B 81 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC 83 B9"), this);
 }
@@ -14,17 +14,17 @@ CPlayerComponents& CPlayerInfo::ms_PlayerComponents = *gpatternt(CPlayerComponen
 bool& CPlayerInfo::ms_bDisplayingPhone = *gpatternt(bool, "80 3D ? ? ? ? ? 0F 85 ? ? ? ? 8B 0D ? ? ? ? 8B 0C 8D ? ? ? ? E8 ? ? ? ? 84 C0 0F 85", 2);
 
 CPlayerInfo::CPlayerInfo() {
-    plugin::CallMethodDyn<CPlayerInfo*>(gpattern("56 8B F1 E8 ? ? ? ? 8D 4E 70"), this);
+    plugin::CallMethodDynGlobal<CPlayerInfo*>(gpatternaddr("56 8B F1 E8 ? ? ? ? 8D 4E 70"), this);
 }
 
 const char* CPlayerInfo::GetPlayerName() {
-    return plugin::CallMethodAndReturnDyn<const char*>(gpattern("8D 41 5C C3"), this);
+    return plugin::CallMethodAndReturnDynGlobal<const char*>(gpatternaddr("8D 41 5C C3"), this);
 }
 
 void CPlayerInfo::MakePlayerSafe(bool arg1, bool safe, float radius, bool arg4, bool arg5) {
-    plugin::CallMethodDyn<CPlayerInfo*>(gpattern("55 8B EC 83 E4 F0 83 EC 1C 80 7D 08 00"), this, arg1, safe, radius, arg4, arg5);
+    plugin::CallMethodDynGlobal<CPlayerInfo*>(gpatternaddr("55 8B EC 83 E4 F0 83 EC 1C 80 7D 08 00"), this, arg1, safe, radius, arg4, arg5);
 }
 
 bool CPlayerInfo::IsPlayerOnline() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("55 8B EC 83 E4 F8 83 EC 0C 56 8B F1 E8 ? ? ? ? 84 C0 74 0C"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("55 8B EC 83 E4 F8 83 EC 0C 56 8B F1 E8 ? ? ? ? 84 C0 74 0C"), this);
 }
@@ -17,10 +17,10 @@ float& CRadar::m_radarRange = *gpatternt(float, "F3 0F 11 0D ? ? ? ? 7C", 4);
 float& CRadar::m_radarScale = *gpatternt(float, "C7 05 ? ? ? ? ? ? ? ? C6 05 ? ? ? ? ? C6 05 ? ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C6 05", 2);
 
 bool CRadar::IsRenderPhaseTime() {
-    return plugin::CallAndReturnDyn<bool>(gpattern("80 3D ? ? ? ? ? 75 74 80 3D"));
+    return plugin::CallAndReturnDynGlobal<bool>(gpatternaddr("80 3D ? ? ? ? ? 75 74 80 3D"));
 }
 
 int32_t CRadar::GetActualBlipArrayIndex(int32_t blipIndex) {
-    return plugin::CallAndReturnDyn<int32_t>(gpattern("8B 4C 24 04 83 F9 FF 74 1D"), blipIndex);
+    return plugin::CallAndReturnDynGlobal<int32_t>(gpatternaddr("8B 4C 24 04 83 F9 FF 74 1D"), blipIndex);
 }
 
@@ -7,6 +7,6 @@
 #include "CSimpleTransform.h"
 
 void CSimpleTransform::UpdateMatrix(rage::Matrix44* matrix) {
-    plugin::CallMethodDyn(gpattern("56 8B F1 57 8B 7C 24 0C F3 0F 10 46"), this, matrix);
+    plugin::CallMethodDynGlobal(gpatternaddr("56 8B F1 57 8B 7C 24 0C F3 0F 10 46"), this, matrix);
 }
 
@@ -7,6 +7,6 @@
 #include "CTaskComplexAimAndThrowProjectile.h"
 
 CPed* CTaskComplexAimAndThrowProjectile::GetAt() {
-    return plugin::CallMethodAndReturnDyn<CPed*, CTaskComplexAimAndThrowProjectile*>(gpattern("8B 41 14 C3 CC CC CC CC CC CC CC CC CC CC CC CC"), this);
+    return plugin::CallMethodAndReturnDynGlobal<CPed*, CTaskComplexAimAndThrowProjectile*>(gpatternaddr("8B 41 14 C3 CC CC CC CC CC CC CC CC CC CC CC CC"), this);
 }
 
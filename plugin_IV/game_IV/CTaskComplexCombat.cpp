@@ -7,5 +7,5 @@
 #include "CTaskComplexCombat.h"
 
 CTaskComplexCombat::CTaskComplexCombat(CPed* target, int32_t unk) {
-    plugin::CallMethodDyn(gpattern("53 56 57 8B F1 E8 ? ? ? ? 8B 44 24 ? F3 0F 10 44 24"), this, target, unk);
+    plugin::CallMethodDynGlobal(gpatternaddr("53 56 57 8B F1 E8 ? ? ? ? 8B 44 24 ? F3 0F 10 44 24"), this, target, unk);
 }
@@ -7,6 +7,6 @@
 #include "CTaskManager.h"
 
 CTask* CTaskManager::FindActiveTaskByType(int32_t index) {
-    return plugin::CallMethodAndReturnDyn<CTask*, CTaskManager*>(gpattern("53 55 56 33 F6 57 8B E9"), this, index);
+    return plugin::CallMethodAndReturnDynGlobal<CTask*, CTaskManager*>(gpatternaddr("53 55 56 33 F6 57 8B E9"), this, index);
 }
 
@@ -7,5 +7,5 @@
 #include "CTaskSimpleAimGun.h"
 
 CEntity* CTaskSimpleAimGun::GetAt(void* out, bool arg2) {
-    return plugin::CallMethodAndReturnDyn<CEntity*, CTaskSimpleAimGun*>(gpattern("8B 54 24 04 85 D2 74 05"), this, out, arg2);
+    return plugin::CallMethodAndReturnDynGlobal<CEntity*, CTaskSimpleAimGun*>(gpatternaddr("8B 54 24 04 85 D2 74 05"), this, out, arg2);
 }
@@ -17,6 +17,6 @@ const wchar_t* CText::Get(uint32_t hash, const char* key) {
 }
 
 void AsciiToUnicode(const char* src, wchar_t* dst) {
-    return plugin::CallDyn(gpattern("8B 44 24 04 85 C0 74 22 80 38 00"), src, dst);
+    return plugin::CallDynGlobal(gpatternaddr("8B 44 24 04 85 C0 74 22 80 38 00"), src, dst);
 }
 
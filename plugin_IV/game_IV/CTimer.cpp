@@ -17,5 +17,5 @@ bool& CTimer::m_UserPause = *gpatternt(bool, "0A 05 ? ? ? ? 0A 05 ? ? ? ? 74 0D
 int32_t& CTimer::m_FrameCounter = *gpatternt(int32_t, "FF 05 ? ? ? ? F3 0F 2C C0", 2);
 
 void CTimer::SetTimeScale(float scale) {
-    plugin::CallDyn(gpattern("F3 0F 10 44 24 ? F3 0F 11 05 ? ? ? ? F3 0F 11 05 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC 55"), scale);
+    plugin::CallDynGlobal(gpatternaddr("F3 0F 10 44 24 ? F3 0F 11 05 ? ? ? ? F3 0F 11 05 ? ? ? ? C3 CC CC CC CC CC CC CC CC CC 55"), scale);
 }
@@ -11,13 +11,13 @@ CStreetName& CUserDisplay::DisplayStreetName = *gpatternt(CStreetName, "B9 ? ? ?
 CVehicleName& CUserDisplay::DisplayVehicleName = *gpatternt(CVehicleName, "B9 ? ? ? ? E8 ? ? ? ? 84 C0 74 ? 8B 0D ? ? ? ? 68 ? ? ? ? 8B 0C 8D ? ? ? ? E8 ? ? ? ? A1 ? ? ? ? 6A ? 8B 04 85 ? ? ? ? 6A ? C7 40 ? ? ? ? ? A1 ? ? ? ? 8B 04 85 ? ? ? ? C7 40 ? ? ? ? ? 8B 0D ? ? ? ? 8B 0C 8D ? ? ? ? E8 ? ? ? ? 8B 0D ? ? ? ? 6A ? 8B 0C 8D ? ? ? ? 6A ? E8 ? ? ? ? 8B 0D", 1);
 
 bool CAreaName::Compare() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("56 57 8D B1 ? ? ? ? 8D 79 ? 56 57 E8 ? ? ? ? 83 C4 ? 84 C0 75 ? 6A ? 56 57 E8 ? ? ? ? 83 C4 ? B0 ? 5F 5E C3 5F 32 C0 5E C3 CC 56 57 8D B1 ? ? ? ? 8D B9"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("56 57 8D B1 ? ? ? ? 8D 79 ? 56 57 E8 ? ? ? ? 83 C4 ? 84 C0 75 ? 6A ? 56 57 E8 ? ? ? ? 83 C4 ? B0 ? 5F 5E C3 5F 32 C0 5E C3 CC 56 57 8D B1 ? ? ? ? 8D B9"), this);
 }
 
 bool CStreetName::Compare() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("56 57 8D B1 ? ? ? ? 8D B9"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("56 57 8D B1 ? ? ? ? 8D B9"), this);
 }
 
 bool CVehicleName::Compare() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("56 57 8D B1 ? ? ? ? 8D 79 ? 56 57 E8 ? ? ? ? 83 C4 ? 84 C0 75 ? 6A ? 56 57 E8 ? ? ? ? 83 C4 ? B0 ? 5F 5E C3 5F 32 C0 5E C3 CC 56 57 8D B1 ? ? ? ? 8D 79"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("56 57 8D B1 ? ? ? ? 8D 79 ? 56 57 E8 ? ? ? ? 83 C4 ? 84 C0 75 ? 6A ? 56 57 E8 ? ? ? ? 83 C4 ? B0 ? 5F 5E C3 5F 32 C0 5E C3 CC 56 57 8D B1 ? ? ? ? 8D 79"), this);
 }
@@ -7,13 +7,13 @@
 #include "CVehicle.h"
 
 CVehicle::CVehicle(uint8_t createdBy) {
-    plugin::CallMethodDyn(gpattern("53 55 56 57 8B F9 E8 ? ? ? ? 8D 8F"), this, createdBy);
+    plugin::CallMethodDynGlobal(gpatternaddr("53 55 56 57 8B F9 E8 ? ? ? ? 8D 8F"), this, createdBy);
 }
 
 void CVehicle::SetPosition(rage::Vector3 const& pos, bool arg2, bool arg3) {
-    plugin::CallMethodDyn(gpattern("55 8B EC 83 E4 F0 83 EC 48 8B 0D ? ? ? ? 56 57 8B 7D 08"), this, pos, arg2, arg3);
+    plugin::CallMethodDynGlobal(gpatternaddr("55 8B EC 83 E4 F0 83 EC 48 8B 0D ? ? ? ? 56 57 8B 7D 08"), this, pos, arg2, arg3);
 }
 
 void CVehicle::FlyingControl(int32_t flyingModel, float leftRightSkid, float steeringUpDown, float steeringLeftRight, float accelerationBreakStatus, float arg6, float arg7) {
-    plugin::CallMethodDyn(gpattern("55 8B EC 83 E4 F0 81 EC ? ? ? ? 56 57 8B F9 8B 87 ? ? ? ? 8B 80"), this, flyingModel, leftRightSkid, steeringUpDown, steeringLeftRight, accelerationBreakStatus, arg6, arg7);
+    plugin::CallMethodDynGlobal(gpatternaddr("55 8B EC 83 E4 F0 81 EC ? ? ? ? 56 57 8B F9 8B 87 ? ? ? ? 8B 80"), this, flyingModel, leftRightSkid, steeringUpDown, steeringLeftRight, accelerationBreakStatus, arg6, arg7);
 }
@@ -9,10 +9,10 @@
 CViewport& TheViewport = *gpatternt(CViewport, "B9 ? ? ? ? 6A 00 6A 00 C6 05", 1);
 
 float CViewport::FindAspectRatio(bool wide) {
-    return plugin::CallMethodAndReturnDyn<float, CViewport*>(gpattern("A1 ? ? ? ? 83 EC 14 57"), this, wide);
+    return plugin::CallMethodAndReturnDynGlobal<float, CViewport*>(gpatternaddr("A1 ? ? ? ? 83 EC 14 57"), this, wide);
 }
 
 void CViewport::SetWidescreenBorders(bool on, int32_t delay) {
-    plugin::CallMethodDyn(gpattern("56 8B F1 E8 ? ? ? ? 8B 4E 14"), this, on, delay);
+    plugin::CallMethodDynGlobal(gpatternaddr("56 8B F1 E8 ? ? ? ? 8B 4E 14"), this, on, delay);
 }
 
@@ -7,5 +7,5 @@
 #include "CWanted.h"
 
 void CWanted::SetMaximumWantedLevel(int32_t level) {
-    plugin::CallDyn(gpattern("8B 44 24 04 83 F8 06 0F 87 ? ? ? ? FF 24 85 ? ? ? ? C7 05"), level);
+    plugin::CallDynGlobal(gpatternaddr("8B 44 24 04 83 F8 06 0F 87 ? ? ? ? FF 24 85 ? ? ? ? C7 05"), level);
 }
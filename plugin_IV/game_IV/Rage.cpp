@@ -12,25 +12,25 @@ int32_t& s_Count = *gpatternt(int32_t, "89 3D ? ? ? ? 5F 89 35 ? ? ? ? A3", 2);
 rage::grcTexturePC*& s_CurrentTexture = *gpatternt(rage::grcTexturePC*, "A3 ? ? ? ? E8 ? ? ? ? C3 CC CC CC CC CC CC CC A1", 1);
 
 uint32_t rage::atStringHash(const char* str, uint32_t initValue) {
-    return plugin::CallAndReturnDyn<uint32_t>(gpattern("8B 54 24 08 53 56 8B 74 24 0C 80 3E 22"), str, initValue);
+    return plugin::CallAndReturnDynGlobal<uint32_t>(gpatternaddr("8B 54 24 08 53 56 8B 74 24 0C 80 3E 22"), str, initValue);
 }
 
 void rage::grcBindTexture(const rage::grcTexture* tex) {
-    plugin::CallDyn(gpattern("8B 44 24 04 85 C0 0F 44 05"), tex);
+    plugin::CallDynGlobal(gpatternaddr("8B 44 24 04 85 C0 0F 44 05"), tex);
 }
 
 void rage::grcBegin(rage::grcDrawMode dm, int32_t count) {
-    plugin::CallDyn(gpattern("83 3D ? ? ? ? ? 75 18 83 3D ? ? ? ? ? 75 0F 83 3D ? ? ? ? ? 0F 95 C1 E8 ? ? ? ? 56"), dm, count);
+    plugin::CallDynGlobal(gpatternaddr("83 3D ? ? ? ? ? 75 18 83 3D ? ? ? ? ? 75 0F 83 3D ? ? ? ? ? 0F 95 C1 E8 ? ? ? ? 56"), dm, count);
 }
 
 void rage::grcVertex(float x, float y, float z, float nx, float ny, float nz, rage::Color32 const& c, float s, float t) {
-    plugin::CallDyn(gpattern("83 3D ? ? ? ? ? 74 78"), x, y, z, nx, ny, nz, c, s, t);
+    plugin::CallDynGlobal(gpatternaddr("83 3D ? ? ? ? ? 74 78"), x, y, z, nx, ny, nz, c, s, t);
 }
 
 void rage::grcEnd() {
-    plugin::CallDyn(gpattern("83 3D ? ? ? ? ? 74 0F E8 ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C3"));
+    plugin::CallDynGlobal(gpatternaddr("83 3D ? ? ? ? ? 74 0F E8 ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C7 05 ? ? ? ? ? ? ? ? C3"));
 }
 
 void rage::grcWorldIdentity() {
-    plugin::CallDyn(gpattern("51 8B 0D ? ? ? ? 68 ? ? ? ? E8 ? ? ? ? 59"));
+    plugin::CallDynGlobal(gpatternaddr("51 8B 0D ? ? ? ? 68 ? ? ? ? E8 ? ? ? ? 59"));
 }
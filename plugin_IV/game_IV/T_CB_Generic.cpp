@@ -7,9 +7,9 @@
 #include "T_CB_Generic.h"
 
 T_CB_Generic_NoArgs::T_CB_Generic_NoArgs(void (*cb)()) {
-    plugin::CallMethodDyn<T_CB_Generic_NoArgs*>(gpattern("8B 15 ? ? ? ? 8B 41 04 33 C2 25 ? ? ? ? 31 41 04 8B 44 24 04 42"), this, cb);
+    plugin::CallMethodDynGlobal<T_CB_Generic_NoArgs*>(gpatternaddr("8B 15 ? ? ? ? 8B 41 04 33 C2 25 ? ? ? ? 31 41 04 8B 44 24 04 42"), this, cb);
 }
 
 void T_CB_Generic_NoArgs::Execute() {
-    plugin::CallMethodDyn<T_CB_Generic_NoArgs*>(gpattern("8B 41 08 FF E0"), this);
+    plugin::CallMethodDynGlobal<T_CB_Generic_NoArgs*>(gpatternaddr("8B 41 08 FF E0"), this);
 }
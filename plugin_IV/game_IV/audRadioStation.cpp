@@ -16,21 +16,21 @@ int32_t& audRadioStation::ms_nState = *gpatternt(int32_t, "C7 05 ? ? ? ? ? ? ? ?
 uint8_t& audRadioStation::ms_RadioOff = *gpatternt(uint8_t, "C6 05 ? ? ? ? ? C3 CC CC CC CC CC CC CC 81 EC", 2);
 
 audRadioStation* audRadioStation::FindStation(uint32_t hashName) {
-    return plugin::CallAndReturnDyn<audRadioStation*>(gpattern("56 0F B6 35 ? ? ? ? 32 C9"), hashName);
+    return plugin::CallAndReturnDynGlobal<audRadioStation*>(gpatternaddr("56 0F B6 35 ? ? ? ? 32 C9"), hashName);
 }
 
 audRadioStation* audRadioStation::FindStation(const char* name) {
-    return plugin::CallAndReturnDyn<audRadioStation*>(gpattern("6A 00 FF 74 24 08 E8 ? ? ? ? 83 C4 08 89 44 24 04 E9 ? ? ? ? CC CC CC CC CC CC CC CC CC 56"), name);
+    return plugin::CallAndReturnDynGlobal<audRadioStation*>(gpatternaddr("6A 00 FF 74 24 08 E8 ? ? ? ? 83 C4 08 89 44 24 04 E9 ? ? ? ? CC CC CC CC CC CC CC CC CC 56"), name);
 }
 
 const char* audRadioStation::GetName(uint32_t index, bool off) {
-    return plugin::CallAndReturnDyn<const char*>(gpattern("53 8A 5C 24 0C 56 8B 74 24 0C 84 DB"), index, off);
+    return plugin::CallAndReturnDynGlobal<const char*>(gpatternaddr("53 8A 5C 24 0C 56 8B 74 24 0C 84 DB"), index, off);
 }
 
 audRadioStation* audRadioStation::GetStation(uint32_t index) {
-    return plugin::CallAndReturnDyn<audRadioStation*>(gpattern("0F B6 05 ? ? ? ? 8B 4C 24 04"), index);
+    return plugin::CallAndReturnDynGlobal<audRadioStation*>(gpatternaddr("0F B6 05 ? ? ? ? 8B 4C 24 04"), index);
 }
 
 int32_t audRadioStation::GetNumStations() {
-    return plugin::CallAndReturnDyn<int32_t>(gpattern("E8 ? ? ? ? 39 05 ? ? ? ? 0F 42 05"));
+    return plugin::CallAndReturnDynGlobal<int32_t>(gpatternaddr("E8 ? ? ? ? 39 05 ? ? ? ? 0F 42 05"));
 }
@@ -7,9 +7,9 @@
 #include "cHandlingDataMgr.h"
 
 int32_t cHandlingDataMgr::GetHandlingId(const char* name) {
-    return plugin::CallAndReturnDyn<int32_t>(gpattern("53 56 33 F6 57 39 35 ? ? ? ? 7E 28"), name);
+    return plugin::CallAndReturnDynGlobal<int32_t>(gpatternaddr("53 56 33 F6 57 39 35 ? ? ? ? 7E 28"), name);
 }
 
 tHandlingData* cHandlingDataMgr::GetHandlingData(const char* name) {
-    return plugin::CallAndReturnDyn<tHandlingData*>(gpattern("FF 74 24 04 E8 ? ? ? ? 83 C4 04 83 F8 FF 7E 0C"), name);
+    return plugin::CallAndReturnDynGlobal<tHandlingData*>(gpatternaddr("FF 74 24 04 E8 ? ? ? ? 83 C4 04 83 F8 FF 7E 0C"), name);
 }
@@ -12,10 +12,10 @@ int32_t& gGameEpisode = *gpatternt(int32_t, "C7 05 ? ? ? ? ? ? ? ? C7 05 ? ? ? ?
 
 static uint32_t CPlayerPed__FindPlayerPedAddr;
 CPlayerPed* FindPlayerPed(int32_t id) {
-    return plugin::CallAndReturnDyn<CPlayerPed*>(gpattern("8B 44 24 04 85 C0 75 18 A1"), id);
+    return plugin::CallAndReturnDynGlobal<CPlayerPed*>(gpatternaddr("8B 44 24 04 85 C0 75 18 A1"), id);
 }
 
 static uint32_t CPlayerPed__FindPlayerVehicleAddr;
 CVehicle* FindPlayerVehicle(int32_t id) {
-    return plugin::CallAndReturnDyn<CVehicle*>(gpattern("8B 44 24 04 85 C0 75 15"), id);
+    return plugin::CallAndReturnDynGlobal<CVehicle*>(gpatternaddr("8B 44 24 04 85 C0 75 15"), id);
 }
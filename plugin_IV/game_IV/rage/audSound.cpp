@@ -7,5 +7,5 @@
 #include "audSound.h"
 
 void rage::audSound::PrepareAndPlay(rage::audWaveSlot* slot, bool allowLoad, int32_t timeLimit) {
-    plugin::CallMethodDyn(gpattern("56 8B F1 57 F6 46 39 01"), this, slot, allowLoad, timeLimit);
+    plugin::CallMethodDynGlobal(gpatternaddr("56 8B F1 57 F6 46 39 01"), this, slot, allowLoad, timeLimit);
 }
@@ -7,5 +7,5 @@
 #include "audWaveSlot.h"
 
 rage::audWaveSlot* rage::audWaveSlot::FindWaveSlot(const char* name) {
-    return plugin::CallAndReturnDyn<rage::audWaveSlot*>(gpattern("8D 44 24 04 50 B9 ? ? ? ? E8 ? ? ? ? 85 C0"), name);
+    return plugin::CallAndReturnDynGlobal<rage::audWaveSlot*>(gpatternaddr("8D 44 24 04 50 B9 ? ? ? ? E8 ? ? ? ? 85 C0"), name);
 }
@@ -7,5 +7,5 @@
 #include "fiDevice.h"
 
 rage::fiDevice* rage::fiDevice::GetDevice(char* filename, char readOnly) {
-    return plugin::CallMethodAndReturnDyn<rage::fiDevice*>(gpattern("51 57 8B 7C 24 0C 6A 07"), this, filename, readOnly);
+    return plugin::CallMethodAndReturnDynGlobal<rage::fiDevice*>(gpatternaddr("51 57 8B 7C 24 0C 6A 07"), this, filename, readOnly);
 }
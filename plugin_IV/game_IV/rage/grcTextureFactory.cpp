@@ -9,5 +9,5 @@
 rage::grcTextureFactoryPC*& rage::grcTextureFactoryPC::sm_Instance = *gpatternt(rage::grcTextureFactoryPC*, "A3 ? ? ? ? E8 ? ? ? ? 83 EC 0C", 1);
 
 rage::grcTextureFactoryPC::grcTextureFactoryPC() {
-    plugin::CallMethodDyn(gpattern("A1 ? ? ? ? 81 EC ? ? ? ? 40"), this);
+    plugin::CallMethodDynGlobal(gpatternaddr("A1 ? ? ? ? 81 EC ? ? ? ? 40"), this);
 }
@@ -9,5 +9,5 @@
 rage::grcViewport* rage::grcViewport::sm_Current = gpatternt(rage::grcViewport, "8B 35 ? ? ? ? 75 ? 6A", 2);
 
 void rage::grcViewport::SetCurrent(const rage::grcViewport* viewport, bool regenDevice) {
-    plugin::CallDyn(gpattern("83 3D ? ? ? ? ? 56 8B 35 ? ? ? ? 75 14"), viewport, regenDevice);
+    plugin::CallDynGlobal(gpatternaddr("83 3D ? ? ? ? ? 56 8B 35 ? ? ? ? 75 14"), viewport, regenDevice);
 }
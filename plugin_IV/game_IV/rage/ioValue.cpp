@@ -7,9 +7,9 @@
 #include "ioValue.h"
 
 bool rage::ioValue::IsPressed() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("8A 51 04 8A 41 06 32 C2 3C 7F 77 0C"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("8A 51 04 8A 41 06 32 C2 3C 7F 77 0C"), this);
 }
 
 bool rage::ioValue::IsDown() {
-    return plugin::CallMethodAndReturnDyn<bool>(gpattern("8A 51 04 8A 41 06 32 C2 3C 7F 76 0C"), this);
+    return plugin::CallMethodAndReturnDynGlobal<bool>(gpatternaddr("8A 51 04 8A 41 06 32 C2 3C 7F 76 0C"), this);
 }
@@ -11,5 +11,5 @@ template class rage::pgDictionary<rage::grcTexturePC>;
 
 template<typename T>
 T* rage::pgDictionary<T>::Get(int32_t hash) {
-    return plugin::CallMethodAndReturnDyn<T*>(gpattern("53 55 56 57 8B F9 85 FF 74 3F"), this, hash);
+    return plugin::CallMethodAndReturnDynGlobal<T*>(gpatternaddr("53 55 56 57 8B F9 85 FF 74 3F"), this, hash);
 }
@@ -7,5 +7,5 @@
 #include "scrProgram.h"
 
 int32_t rage::scrProgram::Release() {
-    return plugin::CallMethodAndReturnDyn<int32_t>(gpattern("FF 0D ? ? ? ? 56 8B F1 75 7A"), this);
+    return plugin::CallMethodAndReturnDynGlobal<int32_t>(gpatternaddr("FF 0D ? ? ? ? 56 8B F1 75 7A"), this);
 }
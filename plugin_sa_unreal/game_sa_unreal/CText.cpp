@@ -9,5 +9,5 @@
 CText TheText;
 
 const wchar_t* CText::Get(const char* str) {
-    return plugin::CallAndReturnDyn<const wchar_t*>(gpattern("40 57 48 83 EC 70 48 8B 05 ? ? ? ? 48 33 C4"), this, str);
+    return plugin::CallAndReturnDynGlobal<const wchar_t*>(gpatternaddr("40 57 48 83 EC 70 48 8B 05 ? ? ? ? 48 33 C4"), this, str);
 }
@@ -0,0 +1,80 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "AddressTable.h"
+#include "GameVersion.h"
+#include "DynAddress.h"
+#include <cassert>
+#include <mutex>
+
+namespace {
+
+std::mutex &GetMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+unsigned int count = 1;
+// position of the running game in the values of an entry, -1 if it's not one of them (the value is 0 then)
+int column = -1;
+// GetGlobalAddress(address) == relocation + address
+uintptr_t relocation = 0;
+
+// Same order as the by_version_dyn overloads behind GLOBAL_ADDRESS_BY_VERSION
+int GetColumn(unsigned int gameId) {
+    switch (gameId) {
+#ifdef GTASA
+    case GAME_10US_COMPACT:
+    case GAME_10US_HOODLUM:
+        return 0;
+    case GAME_10EU:
+        return 1;
+    case GAME_11US:
+        return 2;
+    case GAME_11EU:
+        return 3;
+    case GAME_STEAM:
+        return 4;
+    case GAME_STEAM_LV:
+        return 5;
+#elif defined(GTA3) || defined(GTAVC)
+    case GAME_10EN:
+        return 0;
+    case GAME_11EN:
+        return 1;
+    case GAME_STEAM:
+        return 2;
+#endif
+    }
+    return -1;
+}
+
+}
+
+void plugin::AddressTable::SetGameVersion(unsigned int gameId) {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    column = GetColumn(gameId);
+    relocation = GetBaseAddress() - STARTING_ADDRESS;
+}
+
+unsigned int plugin::AddressTable::Add(std::atomic<unsigned int> &index, int const *values, bool relocate) {
+    GetGameVersion(); // the first lookup detects the game
+    std::lock_guard<std::mutex> lock(GetMutex());
+    unsigned int i = index.load(std::memory_order_relaxed);
+    if (i) // another thread looked it up first
+        return i;
+    assert(count < CAPACITY);
+    i = count++;
+    uintptr_t value = column >= 0 ? static_cast<uintptr_t>(values[column]) : 0;
+    entries[i] = relocate ? relocation + value : value;
+    index.store(i, std::memory_order_release);
+    return i;
+}
+
+unsigned int plugin::AddressTable::Count() {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    return count - 1;
+}
@@ -0,0 +1,55 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace plugin {
+
+// Version dependent addresses and offsets (GLOBAL_ADDRESS_BY_VERSION / ADDRESS_BY_VERSION) in one flat array.
+// The game is detected once; GetGameVersion then calls SetGameVersion, which picks the version's column and
+// the relocation of the executable. Every distinct list of values gets a dense index on its first lookup and
+// its entry is filled from that column right away, so each lookup after that is a single load from the array
+// instead of a switch over the game version plus an out-of-line GetGlobalAddress.
+class AddressTable {
+public:
+    static constexpr unsigned int CAPACITY = 8192;
+
+    // Index of the entry for 'values' (one per game version, in by_version_dyn order), fills it and stores
+    // the index in 'index' for the next lookup. Index 0 is never handed out, a site uses it as "not yet".
+    static unsigned int Add(std::atomic<unsigned int> &index, int const *values, bool relocate);
+
+    static uintptr_t Get(unsigned int index) {
+        return entries[index];
+    }
+
+    // Number of entries looked up so far
+    static unsigned int Count();
+
+    // Called once with the detected game, before any entry is filled
+    static void SetGameVersion(unsigned int gameId);
+
+private:
+    static inline uintptr_t entries[CAPACITY];
+};
+
+// One table entry per distinct list of values, the list being the template arguments. Relocate turns the
+// value into an address in the running process (see GetGlobalAddress), offsets are stored as they are.
+template <bool Relocate, int... Values>
+struct address_site {
+    static constexpr int values[] = { Values... };
+    static inline std::atomic<unsigned int> index;
+
+    static uintptr_t Get() {
+        unsigned int i = index.load(std::memory_order_acquire);
+        if (!i)
+            i = AddressTable::Add(index, values, Relocate);
+        return AddressTable::Get(i);
+    }
+};
+
+}
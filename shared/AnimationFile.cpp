@@ -0,0 +1,552 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "AnimationFile.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_ANIMATIONFILE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+    namespace {
+        constexpr size_t CHUNK_HEADER_SIZE = 8;
+        // fourcc, size, name and animation count
+        constexpr size_t ANP3_HEADER_SIZE = 36;
+        // name, sequence count, frame data size and 1
+        constexpr size_t ANP3_ANIMATION_SIZE = 36;
+        // name, frame type, frame count and bone id
+        constexpr size_t ANP3_SEQUENCE_SIZE = 36;
+        constexpr uint32_t ANP3_FRAME_CHILD = 1;
+        constexpr uint32_t ANP3_FRAME_ROOT = 2;
+        constexpr size_t ANPK_ANIM_NAME_SIZE = 28;
+        // VC files have the bone id after the name, frame count and three more fields
+        constexpr size_t ANPK_ANIM_BONE_ID = 40;
+        constexpr size_t KR00_SIZE = 20;
+        constexpr size_t KRT0_SIZE = 32;
+        constexpr size_t KRTS_SIZE = 44;
+
+        constexpr float ROTATION_SCALE = 4096.0f;
+        constexpr float TIME_SCALE = 60.0f;
+        constexpr float TRANSLATION_SCALE = 1024.0f;
+        // below it slerp weights are taken as linear, sin(theta) can't be divided by
+        constexpr float SLERP_EPSILON = 1.0e-3f;
+        // sequences sampled together, the keys around the time are gathered for this many
+        constexpr size_t SAMPLE_BATCH = 64;
+
+        template<typename T>
+        T Read(uint8_t const* p) {
+            T value;
+            memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        std::string ReadName(uint8_t const* p, size_t size) {
+            char const* name = reinterpret_cast<char const*>(p);
+            return std::string(name, strnlen(name, size));
+        }
+
+        // Chunks of ANPK files, sizes are padded to 4 bytes
+        bool ReadChunk(std::span<const uint8_t> data, size_t offset, char const* fourcc, size_t& size) {
+            if (data.size() < CHUNK_HEADER_SIZE || offset > data.size() - CHUNK_HEADER_SIZE || memcmp(data.data() + offset, fourcc, 4))
+                return false;
+            size = Read<uint32_t>(data.data() + offset + 4);
+            return size <= data.size() - offset - CHUNK_HEADER_SIZE;
+        }
+
+        size_t RoundSize(size_t size) {
+            return (size + 3) & ~size_t(3);
+        }
+
+        int16_t Compress(float value, float scale, float bias) {
+            value = value * scale + bias;
+            if (value < -32768.0f)
+                value = -32768.0f;
+            else if (value > 32767.0f)
+                value = 32767.0f;
+            return (int16_t)value;
+        }
+
+        // CQuaternion::Slerp with theta and 1/sin(theta) of CAnimBlendNode: going the short way round, when
+        // the rotations are more than half a turn apart, is the same as negating the second weight
+        void Slerp(float const* a, float const* b, float t, float* out) {
+            float c = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+            float sign = 1.0f;
+            if (c < 0.0f) {
+                c = -c;
+                sign = -1.0f;
+            }
+            float theta = std::acos((std::min)(c, 1.0f));
+            float w1 = 1.0f - t, w2 = t;
+            if (theta >= SLERP_EPSILON) {
+                float invSin = 1.0f / std::sin(theta);
+                w1 = std::sin((1.0f - t) * theta) * invSin;
+                w2 = std::sin(t * theta) * invSin;
+            }
+            w2 *= sign;
+            for (size_t i = 0; i < 4; i++)
+                out[i] = w1 * a[i] + w2 * b[i];
+        }
+
+#ifdef PLUGIN_ANIMATIONFILE_SSE2
+        // acos on 0-1, Abramowitz and Stegun 4.4.46, error below 2e-8
+        __m128 Acos(__m128 x) {
+            __m128 p = _mm_set1_ps(-0.0012624911f);
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0066700901f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0170881256f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0308918810f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0501743046f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0889789874f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.2145988016f));
+            p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(1.5707963050f));
+            return _mm_mul_ps(p, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)));
+        }
+
+        // sin on 0-pi/2, Taylor series to x^11, error below 6e-8
+        __m128 Sin(__m128 x) {
+            __m128 x2 = _mm_mul_ps(x, x);
+            __m128 p = _mm_set1_ps(-1.0f / 39916800.0f);
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f / 362880.0f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.0f / 5040.0f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f / 120.0f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.0f / 6.0f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f));
+            return _mm_mul_ps(p, x);
+        }
+
+        __m128 Select(__m128 mask, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+#endif
+
+        // Keys around the time for a batch of sequences, one array per component
+        struct SampleBatch {
+            alignas(16) float a[4][SAMPLE_BATCH];
+            alignas(16) float b[4][SAMPLE_BATCH];
+            alignas(16) float posA[3][SAMPLE_BATCH];
+            alignas(16) float posB[3][SAMPLE_BATCH];
+            alignas(16) float t[SAMPLE_BATCH];
+        };
+
+        void Gather(AnimationFile::Keys const& keys, AnimationFile::Sequence const& sequence, float time, SampleBatch& batch, size_t j) {
+            if (!sequence.numKeys) {
+                for (size_t c = 0; c < 4; c++)
+                    batch.a[c][j] = batch.b[c][j] = c == 3 ? 1.0f : 0.0f;
+                for (size_t c = 0; c < 3; c++)
+                    batch.posA[c][j] = batch.posB[c][j] = 0.0f;
+                batch.t[j] = 0.0f;
+                return;
+            }
+            float const* times = keys.time.data() + sequence.firstKey;
+            size_t next = std::upper_bound(times, times + sequence.numKeys, time) - times;
+            size_t k0 = next ? next - 1 : 0;
+            size_t k1 = (std::min)(next, (size_t)sequence.numKeys - 1);
+            float t = 0.0f;
+            if (k0 != k1 && times[k1] > times[k0])
+                t = (time - times[k0]) / (times[k1] - times[k0]);
+            k0 += sequence.firstKey;
+            k1 += sequence.firstKey;
+            batch.a[0][j] = keys.rotX[k0]; batch.b[0][j] = keys.rotX[k1];
+            batch.a[1][j] = keys.rotY[k0]; batch.b[1][j] = keys.rotY[k1];
+            batch.a[2][j] = keys.rotZ[k0]; batch.b[2][j] = keys.rotZ[k1];
+            batch.a[3][j] = keys.rotW[k0]; batch.b[3][j] = keys.rotW[k1];
+            batch.posA[0][j] = keys.posX[k0]; batch.posB[0][j] = keys.posX[k1];
+            batch.posA[1][j] = keys.posY[k0]; batch.posB[1][j] = keys.posY[k1];
+            batch.posA[2][j] = keys.posZ[k0]; batch.posB[2][j] = keys.posZ[k1];
+            batch.t[j] = t;
+        }
+
+        void Interpolate(SampleBatch const& batch, size_t count, float* const* out) {
+            size_t i = 0;
+#ifdef PLUGIN_ANIMATIONFILE_SSE2
+            __m128 one = _mm_set1_ps(1.0f);
+            __m128 signBit = _mm_set1_ps(-0.0f);
+            for (; i + 4 <= count; i += 4) {
+                __m128 a[4], b[4];
+                for (size_t c = 0; c < 4; c++) {
+                    a[c] = _mm_load_ps(batch.a[c] + i);
+                    b[c] = _mm_load_ps(batch.b[c] + i);
+                }
+                __m128 t = _mm_load_ps(batch.t + i);
+                __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+                    _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+                __m128 sign = _mm_and_ps(dot, signBit);
+                __m128 theta = Acos(_mm_min_ps(_mm_andnot_ps(signBit, dot), one));
+                __m128 invSin = _mm_div_ps(one, Sin(theta));
+                __m128 w1 = _mm_mul_ps(Sin(_mm_mul_ps(_mm_sub_ps(one, t), theta)), invSin);
+                __m128 w2 = _mm_mul_ps(Sin(_mm_mul_ps(t, theta)), invSin);
+                __m128 linear = _mm_cmplt_ps(theta, _mm_set1_ps(SLERP_EPSILON));
+                w1 = Select(linear, _mm_sub_ps(one, t), w1);
+                w2 = _mm_xor_ps(Select(linear, t, w2), sign);
+                for (size_t c = 0; c < 4; c++)
+                    _mm_storeu_ps(out[c] + i, _mm_add_ps(_mm_mul_ps(w1, a[c]), _mm_mul_ps(w2, b[c])));
+                for (size_t c = 0; c < 3; c++) {
+                    __m128 p = _mm_load_ps(batch.posA[c] + i);
+                    __m128 d = _mm_sub_ps(_mm_load_ps(batch.posB[c] + i), p);
+                    _mm_storeu_ps(out[4 + c] + i, _mm_add_ps(p, _mm_mul_ps(d, t)));
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                float a[4] = { batch.a[0][i], batch.a[1][i], batch.a[2][i], batch.a[3][i] };
+                float b[4] = { batch.b[0][i], batch.b[1][i], batch.b[2][i], batch.b[3][i] };
+                float rotation[4];
+                Slerp(a, b, batch.t[i], rotation);
+                for (size_t c = 0; c < 4; c++)
+                    out[c][i] = rotation[c];
+                for (size_t c = 0; c < 3; c++)
+                    out[4 + c][i] = batch.posA[c][i] + (batch.posB[c][i] - batch.posA[c][i]) * batch.t[i];
+            }
+        }
+
+        template<typename GetSequence>
+        void SampleSequences(AnimationFile::Keys const& keys, GetSequence getSequence, size_t count, float time, float* const* out) {
+            SampleBatch batch;
+            for (size_t first = 0; first < count; first += SAMPLE_BATCH) {
+                size_t size = (std::min)(SAMPLE_BATCH, count - first);
+                for (size_t j = 0; j < size; j++)
+                    Gather(keys, getSequence(first + j), time, batch, j);
+                float* batchOut[7];
+                for (size_t c = 0; c < 7; c++)
+                    batchOut[c] = out[c] + first;
+                Interpolate(batch, size, batchOut);
+            }
+        }
+    }
+
+    bool AnimationFile::Load(std::string const& path) {
+        MappedFile file;
+        if (!file.Open(path)) {
+            Clear();
+            return false;
+        }
+        return Load(std::span<const uint8_t>(file.Data(), file.Size()));
+    }
+
+    bool AnimationFile::Load(std::span<const uint8_t> data) {
+        Clear();
+        bool loaded = false;
+        if (data.size() >= 4 && !memcmp(data.data(), "ANP3", 4))
+            loaded = LoadAnp3(data);
+        else if (data.size() >= 4 && !memcmp(data.data(), "ANPK", 4))
+            loaded = LoadAnpk(data);
+        if (!loaded) {
+            Clear();
+            return false;
+        }
+        for (Animation& animation : animations) {
+            animation.duration = 0.0f;
+            for (uint32_t i = 0; i < animation.numSequences; i++) {
+                Sequence const& sequence = sequences[animation.firstSequence + i];
+                if (sequence.numKeys)
+                    animation.duration = (std::max)(animation.duration, keys.time[sequence.firstKey + sequence.numKeys - 1]);
+            }
+        }
+        return true;
+    }
+
+    bool AnimationFile::LoadAnp3(std::span<const uint8_t> data) {
+        if (data.size() < ANP3_HEADER_SIZE)
+            return false;
+        uint8_t const* bytes = data.data();
+        name = ReadName(bytes + 8, 24);
+        uint32_t numAnimations = Read<uint32_t>(bytes + 32);
+        // as many keys as could fit, the arrays aren't grown for every sequence then
+        ReserveKeys(data.size() / COMPRESSED_KEY_SIZE);
+        size_t offset = ANP3_HEADER_SIZE;
+        for (uint32_t a = 0; a < numAnimations; a++) {
+            if (data.size() - offset < ANP3_ANIMATION_SIZE)
+                return false;
+            Animation animation;
+            animation.name = ReadName(bytes + offset, 24);
+            animation.firstSequence = (uint32_t)sequences.size();
+            animation.numSequences = Read<uint32_t>(bytes + offset + 24);
+            offset += ANP3_ANIMATION_SIZE;
+            for (uint32_t s = 0; s < animation.numSequences; s++) {
+                if (data.size() - offset < ANP3_SEQUENCE_SIZE)
+                    return false;
+                Sequence sequence;
+                sequence.name = ReadName(bytes + offset, 24);
+                uint32_t frameType = Read<uint32_t>(bytes + offset + 24);
+                sequence.numKeys = Read<uint32_t>(bytes + offset + 28);
+                sequence.boneId = Read<int32_t>(bytes + offset + 32);
+                offset += ANP3_SEQUENCE_SIZE;
+                if (frameType != ANP3_FRAME_CHILD && frameType != ANP3_FRAME_ROOT)
+                    return false;
+                sequence.hasTranslation = frameType == ANP3_FRAME_ROOT;
+                size_t keySize = sequence.hasTranslation ? COMPRESSED_ROOT_KEY_SIZE : COMPRESSED_KEY_SIZE;
+                if (sequence.numKeys > (data.size() - offset) / keySize)
+                    return false;
+                sequence.firstKey = (uint32_t)keys.time.size();
+                AddKeys(sequence.numKeys);
+                size_t k = sequence.firstKey;
+                DecompressKeys(bytes + offset, sequence.numKeys, sequence.hasTranslation, &keys.time[k],
+                    &keys.rotX[k], &keys.rotY[k], &keys.rotZ[k], &keys.rotW[k], &keys.posX[k], &keys.posY[k], &keys.posZ[k]);
+                offset += sequence.numKeys * keySize;
+                sequences.push_back(std::move(sequence));
+            }
+            animations.push_back(std::move(animation));
+        }
+        return true;
+    }
+
+    bool AnimationFile::LoadAnpk(std::span<const uint8_t> data) {
+        uint8_t const* bytes = data.data();
+        size_t size;
+        if (!ReadChunk(data, 0, "ANPK", size))
+            return false;
+        size_t offset = CHUNK_HEADER_SIZE;
+        if (!ReadChunk(data, offset, "INFO", size) || size < 4)
+            return false;
+        uint32_t numAnimations = Read<uint32_t>(bytes + offset + 8);
+        name = ReadName(bytes + offset + 12, size - 4);
+        offset += CHUNK_HEADER_SIZE + RoundSize(size);
+        ReserveKeys(data.size() / KR00_SIZE);
+        for (uint32_t a = 0; a < numAnimations; a++) {
+            Animation animation;
+            if (!ReadChunk(data, offset, "NAME", size))
+                return false;
+            animation.name = ReadName(bytes + offset + 8, size);
+            offset += CHUNK_HEADER_SIZE + RoundSize(size);
+            if (!ReadChunk(data, offset, "DGAN", size))
+                return false;
+            offset += CHUNK_HEADER_SIZE;
+            if (!ReadChunk(data, offset, "INFO", size) || size < 4)
+                return false;
+            animation.firstSequence = (uint32_t)sequences.size();
+            animation.numSequences = Read<uint32_t>(bytes + offset + 8);
+            offset += CHUNK_HEADER_SIZE + RoundSize(size);
+            for (uint32_t s = 0; s < animation.numSequences; s++) {
+                if (!ReadChunk(data, offset, "CPAN", size))
+                    return false;
+                offset += CHUNK_HEADER_SIZE;
+                if (!ReadChunk(data, offset, "ANIM", size) || size < ANPK_ANIM_NAME_SIZE + 4)
+                    return false;
+                Sequence sequence;
+                sequence.name = ReadName(bytes + offset + 8, ANPK_ANIM_NAME_SIZE);
+                sequence.numKeys = Read<uint32_t>(bytes + offset + 8 + ANPK_ANIM_NAME_SIZE);
+                sequence.boneId = size >= ANPK_ANIM_BONE_ID + 4 ? Read<int32_t>(bytes + offset + 8 + ANPK_ANIM_BONE_ID) : -1;
+                sequence.hasTranslation = false;
+                sequence.firstKey = (uint32_t)keys.time.size();
+                offset += CHUNK_HEADER_SIZE + RoundSize(size);
+                // the game doesn't read a key chunk for empty sequences
+                if (sequence.numKeys) {
+                    size_t keySize;
+                    if (ReadChunk(data, offset, "KR00", size))
+                        keySize = KR00_SIZE;
+                    else if (ReadChunk(data, offset, "KRT0", size))
+                        keySize = KRT0_SIZE;
+                    else if (ReadChunk(data, offset, "KRTS", size))
+                        keySize = KRTS_SIZE;
+                    else
+                        return false;
+                    if (sequence.numKeys > size / keySize)
+                        return false;
+                    sequence.hasTranslation = keySize != KR00_SIZE;
+                    AddKeys(sequence.numKeys);
+                    uint8_t const* p = bytes + offset + CHUNK_HEADER_SIZE;
+                    for (uint32_t i = 0; i < sequence.numKeys; i++, p += keySize) {
+                        size_t k = sequence.firstKey + i;
+                        // conjugated, CAnimManager::LoadAnimFile negates x, y and z
+                        keys.rotX[k] = -Read<float>(p);
+                        keys.rotY[k] = -Read<float>(p + 4);
+                        keys.rotZ[k] = -Read<float>(p + 8);
+                        keys.rotW[k] = Read<float>(p + 12);
+                        if (sequence.hasTranslation) {
+                            keys.posX[k] = Read<float>(p + 16);
+                            keys.posY[k] = Read<float>(p + 20);
+                            keys.posZ[k] = Read<float>(p + 24);
+                        }
+                        // the scale of KRTS keys isn't used by the game
+                        keys.time[k] = Read<float>(p + keySize - 4);
+                    }
+                    offset += CHUNK_HEADER_SIZE + RoundSize(size);
+                }
+                sequences.push_back(std::move(sequence));
+            }
+            animations.push_back(std::move(animation));
+        }
+        return true;
+    }
+
+    void AnimationFile::ReserveKeys(size_t count) {
+        keys.time.reserve(count);
+        keys.rotX.reserve(count);
+        keys.rotY.reserve(count);
+        keys.rotZ.reserve(count);
+        keys.rotW.reserve(count);
+        keys.posX.reserve(count);
+        keys.posY.reserve(count);
+        keys.posZ.reserve(count);
+    }
+
+    void AnimationFile::AddKeys(size_t count) {
+        size_t size = keys.time.size() + count;
+        keys.time.resize(size);
+        keys.rotX.resize(size);
+        keys.rotY.resize(size);
+        keys.rotZ.resize(size);
+        keys.rotW.resize(size);
+        keys.posX.resize(size);
+        keys.posY.resize(size);
+        keys.posZ.resize(size);
+    }
+
+    void AnimationFile::Clear() {
+        name.clear();
+        animations.clear();
+        sequences.clear();
+        keys = {};
+    }
+
+    int32_t AnimationFile::FindAnimation(std::string_view name) const {
+        for (size_t i = 0; i < animations.size(); i++) {
+            std::string const& animationName = animations[i].name;
+            if (animationName.size() != name.size())
+                continue;
+            bool equal = true;
+            for (size_t c = 0; c < name.size() && equal; c++)
+                equal = toupper((uint8_t)animationName[c]) == toupper((uint8_t)name[c]);
+            if (equal)
+                return (int32_t)i;
+        }
+        return -1;
+    }
+
+    void AnimationFile::Sample(uint32_t const* sequenceIndices, size_t count, float time,
+        float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ) const
+    {
+        float* out[7] = { rotX, rotY, rotZ, rotW, posX, posY, posZ };
+        SampleSequences(keys, [&](size_t i) -> Sequence const& { return sequences[sequenceIndices[i]]; }, count, time, out);
+    }
+
+    void AnimationFile::SampleAnimation(size_t index, float time,
+        float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ) const
+    {
+        Animation const& animation = animations[index];
+        float* out[7] = { rotX, rotY, rotZ, rotW, posX, posY, posZ };
+        SampleSequences(keys, [&](size_t i) -> Sequence const& { return sequences[animation.firstSequence + i]; },
+            animation.numSequences, time, out);
+    }
+
+    void AnimationFile::DecompressKeys(void const* compressed, size_t count, bool hasTranslation, float* time,
+        float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ)
+    {
+        uint8_t const* bytes = reinterpret_cast<uint8_t const*>(compressed);
+        size_t keySize = hasTranslation ? COMPRESSED_ROOT_KEY_SIZE : COMPRESSED_KEY_SIZE;
+        size_t i = 0;
+#ifdef PLUGIN_ANIMATIONFILE_SSE2
+        __m128 rotationScale = _mm_set1_ps(1.0f / ROTATION_SCALE);
+        // time and translation of root keys are in the same register
+        __m128 rootScale = _mm_setr_ps(1.0f / TIME_SCALE, 1.0f / TRANSLATION_SCALE, 1.0f / TRANSLATION_SCALE, 1.0f / TRANSLATION_SCALE);
+        // int16 in the high half of each int32, the arithmetic shift sign extends it
+        auto low = [](__m128i v, __m128 scale) { return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale); };
+        auto high = [](__m128i v, __m128 scale) { return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale); };
+        for (; i + 4 <= count; i += 4) {
+            uint8_t const* p = bytes + i * keySize;
+            __m128 r[4];
+            if (hasTranslation) {
+                __m128 t[4];
+                for (size_t j = 0; j < 4; j++) {
+                    __m128i key = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + j * keySize));
+                    r[j] = low(key, rotationScale);
+                    t[j] = high(key, rootScale);
+                }
+                _MM_TRANSPOSE4_PS(t[0], t[1], t[2], t[3]);
+                _mm_storeu_ps(time + i, t[0]);
+                _mm_storeu_ps(posX + i, t[1]);
+                _mm_storeu_ps(posY + i, t[2]);
+                _mm_storeu_ps(posZ + i, t[3]);
+            }
+            else {
+                for (size_t j = 0; j < 4; j++)
+                    r[j] = low(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(p + j * keySize)), rotationScale);
+                __m128 t = _mm_setr_ps(Read<int16_t>(p + 8), Read<int16_t>(p + keySize + 8),
+                    Read<int16_t>(p + keySize * 2 + 8), Read<int16_t>(p + keySize * 3 + 8));
+                _mm_storeu_ps(time + i, _mm_mul_ps(t, _mm_set1_ps(1.0f / TIME_SCALE)));
+            }
+            _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+            _mm_storeu_ps(rotX + i, r[0]);
+            _mm_storeu_ps(rotY + i, r[1]);
+            _mm_storeu_ps(rotZ + i, r[2]);
+            _mm_storeu_ps(rotW + i, r[3]);
+        }
+#endif
+        for (; i < count; i++) {
+            uint8_t const* p = bytes + i * keySize;
+            rotX[i] = (float)Read<int16_t>(p) * (1.0f / ROTATION_SCALE);
+            rotY[i] = (float)Read<int16_t>(p + 2) * (1.0f / ROTATION_SCALE);
+            rotZ[i] = (float)Read<int16_t>(p + 4) * (1.0f / ROTATION_SCALE);
+            rotW[i] = (float)Read<int16_t>(p + 6) * (1.0f / ROTATION_SCALE);
+            time[i] = (float)Read<int16_t>(p + 8) * (1.0f / TIME_SCALE);
+            if (hasTranslation) {
+                posX[i] = (float)Read<int16_t>(p + 10) * (1.0f / TRANSLATION_SCALE);
+                posY[i] = (float)Read<int16_t>(p + 12) * (1.0f / TRANSLATION_SCALE);
+                posZ[i] = (float)Read<int16_t>(p + 14) * (1.0f / TRANSLATION_SCALE);
+            }
+        }
+    }
+
+    void AnimationFile::CompressKeys(float const* time, float const* rotX, float const* rotY, float const* rotZ, float const* rotW,
+        float const* posX, float const* posY, float const* posZ, size_t count, bool hasTranslation, void* compressed)
+    {
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(compressed);
+        size_t keySize = hasTranslation ? COMPRESSED_ROOT_KEY_SIZE : COMPRESSED_KEY_SIZE;
+        size_t i = 0;
+#ifdef PLUGIN_ANIMATIONFILE_SSE2
+        __m128 lowest = _mm_set1_ps(-32768.0f);
+        __m128 highest = _mm_set1_ps(32767.0f);
+        // clamped before the conversion, out of range floats convert to 0x80000000
+        auto compress = [lowest, highest](__m128 v, __m128 scale, __m128 bias) {
+            v = _mm_add_ps(_mm_mul_ps(v, scale), bias);
+            return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, lowest), highest));
+        };
+        __m128 rotationScale = _mm_set1_ps(ROTATION_SCALE);
+        __m128 rootScale = _mm_setr_ps(TIME_SCALE, TRANSLATION_SCALE, TRANSLATION_SCALE, TRANSLATION_SCALE);
+        __m128 rootBias = _mm_setr_ps(0.5f, 0.0f, 0.0f, 0.0f);
+        __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            uint8_t* p = bytes + i * keySize;
+            __m128 r[4] = { _mm_loadu_ps(rotX + i), _mm_loadu_ps(rotY + i), _mm_loadu_ps(rotZ + i), _mm_loadu_ps(rotW + i) };
+            _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+            if (hasTranslation) {
+                __m128 t[4] = { _mm_loadu_ps(time + i), _mm_loadu_ps(posX + i), _mm_loadu_ps(posY + i), _mm_loadu_ps(posZ + i) };
+                _MM_TRANSPOSE4_PS(t[0], t[1], t[2], t[3]);
+                for (size_t j = 0; j < 4; j++) {
+                    __m128i key = _mm_packs_epi32(compress(r[j], rotationScale, zero), compress(t[j], rootScale, rootBias));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + j * keySize), key);
+                }
+            }
+            else {
+                for (size_t j = 0; j < 4; j++) {
+                    __m128i rotation = compress(r[j], rotationScale, zero);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(p + j * keySize), _mm_packs_epi32(rotation, rotation));
+                    int16_t t = Compress(time[i + j], TIME_SCALE, 0.5f);
+                    memcpy(p + j * keySize + 8, &t, sizeof(t));
+                }
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            int16_t key[8] = {
+                Compress(rotX[i], ROTATION_SCALE, 0.0f), Compress(rotY[i], ROTATION_SCALE, 0.0f),
+                Compress(rotZ[i], ROTATION_SCALE, 0.0f), Compress(rotW[i], ROTATION_SCALE, 0.0f),
+                Compress(time[i], TIME_SCALE, 0.5f)
+            };
+            if (hasTranslation) {
+                key[5] = Compress(posX[i], TRANSLATION_SCALE, 0.0f);
+                key[6] = Compress(posY[i], TRANSLATION_SCALE, 0.0f);
+                key[7] = Compress(posZ[i], TRANSLATION_SCALE, 0.0f);
+            }
+            memcpy(bytes + i * keySize, key, keySize);
+        }
+    }
+}
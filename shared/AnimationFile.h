@@ -0,0 +1,93 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+
+namespace plugin {
+    // Animation file (.ifp) read without the game: ANPK (III, VC) or ANP3 (SA). The keys of all sequences
+    // are decoded into arrays shared by the whole file, one per component, with the time in seconds from
+    // the start of the sequence. ANPK rotations are conjugated on load, as the game does, so both formats
+    // give rotations the way CAnimBlendSequence has them.
+    // http://www.gtamodding.com/wiki/IFP
+    class AnimationFile {
+    public:
+        // One bone of an animation, keys first..first+count-1
+        struct Sequence {
+            std::string name;
+            int32_t boneId;       // -1 if the file has none
+            bool hasTranslation;  // root bones, the others have 0 translation keys
+            uint32_t firstKey;
+            uint32_t numKeys;
+        };
+
+        struct Animation {
+            std::string name;
+            uint32_t firstSequence;
+            uint32_t numSequences;
+            float duration;       // the last key of the longest sequence
+        };
+
+        struct Keys {
+            std::vector<float> time;
+            std::vector<float> rotX, rotY, rotZ, rotW;
+            std::vector<float> posX, posY, posZ;
+        };
+
+        AnimationFile() {}
+
+        bool Load(std::span<const uint8_t> data);
+        bool Load(std::string const& path);
+        void Clear();
+
+        std::string const& GetName() const { return name; }
+        size_t GetNumAnimations() const { return animations.size(); }
+        Animation const& GetAnimation(size_t index) const { return animations[index]; }
+        // Case insensitive, -1 if there's none
+        int32_t FindAnimation(std::string_view name) const;
+        size_t GetNumSequences() const { return sequences.size(); }
+        Sequence const& GetSequence(size_t index) const { return sequences[index]; }
+        Keys const& GetKeys() const { return keys; }
+
+        // Samples sequences at time (seconds, held at the first and last key) into one array per
+        // component, count entries each. Rotations are interpolated like CQuaternion::Slerp, four
+        // bones at a time with SSE2, and translations linearly.
+        void Sample(uint32_t const* sequenceIndices, size_t count, float time,
+            float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ) const;
+        // Every sequence of an animation, GetAnimation(index).numSequences entries per array
+        void SampleAnimation(size_t index, float time,
+            float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ) const;
+
+        // The game's compressed keys (CAnimBlendKeyFrameCompressed, ANP3 frames): int16 rotation x, y, z, w
+        // in 1/4096, int16 time in 1/60 s, then with translation int16 x, y, z in 1/1024. Time is taken as
+        // it's stored, absolute in files and a delta in the game's sequences.
+        static constexpr size_t COMPRESSED_KEY_SIZE = 10;
+        static constexpr size_t COMPRESSED_ROOT_KEY_SIZE = 16;
+        // Four keys at a time with SSE2. pos can be null without translation.
+        static void DecompressKeys(void const* compressed, size_t count, bool hasTranslation, float* time,
+            float* rotX, float* rotY, float* rotZ, float* rotW, float* posX, float* posY, float* posZ);
+        // Like CAnimBlendSequence::CompressKeyframes: rotation and translation truncated, time rounded,
+        // all clamped to the int16 range
+        static void CompressKeys(float const* time, float const* rotX, float const* rotY, float const* rotZ, float const* rotW,
+            float const* posX, float const* posY, float const* posZ, size_t count, bool hasTranslation, void* compressed);
+
+    private:
+        std::string name;
+        std::vector<Animation> animations;
+        std::vector<Sequence> sequences;
+        Keys keys;
+
+        bool LoadAnp3(std::span<const uint8_t> data);
+        bool LoadAnpk(std::span<const uint8_t> data);
+        void ReserveKeys(size_t count);
+        void AddKeys(size_t count);
+    };
+}
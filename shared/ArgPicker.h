@@ -21,8 +21,8 @@ struct ArgPick<ArgTypes<Types...>, Indices...> {
     using CallbackType = std::function<void(Types...)>;
     using FnPtrType = void(*)(Types...);
     
-    template<typename Tuple>
-    void operator()(CallbackType fun, Tuple& t) const { fun(std::get<Indices>(t)...); }
+    template<typename Fn, typename Tuple>
+    void operator()(Fn const& fun, Tuple& t) const { fun(std::get<Indices>(t)...); }
 };
 
 struct DefaultArgs {};
@@ -32,13 +32,13 @@ struct DefaultArgPicker {
     using CallbackType = std::function<void(Types...)>;
     using FnPtrType = void(*)(Types...);
 
-    template<typename Tuple, size_t... Indices>
-    void call_it(CallbackType const &fun, Tuple& t, std::index_sequence<Indices...>) const {
+    template<typename Fn, typename Tuple, size_t... Indices>
+    void call_it(Fn const &fun, Tuple& t, std::index_sequence<Indices...>) const {
         fun(std::get<Indices>(t)...);
     }
 
-    template<typename Tuple>
-    void operator()(CallbackType fun, Tuple& t) const {
+    template<typename Fn, typename Tuple>
+    void operator()(Fn const &fun, Tuple& t) const {
         call_it(fun, t, std::make_index_sequence<std::tuple_size<Tuple>::value>{});
     }
 };
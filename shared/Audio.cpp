@@ -45,6 +45,7 @@ namespace plugin {
         s.isStream = true;
         s.streamFreq = freq;
         samples.push_back(s);
+        sampleIndex.insert({ s.name, s.sample });
 
         return s.sample;
     }
@@ -58,6 +59,7 @@ namespace plugin {
         s.loopStart = loopStart;
         s.loopEnd = loopEnd;
         samples.push_back(s);
+        sampleIndex.insert({ s.name, s.sample });
         return s.sample;
     }
 
@@ -69,22 +71,23 @@ namespace plugin {
     }
 
     BassSampleManager::BassSample* BassSampleManager::GetSample(std::string const& name) {
-        auto it = std::find_if(samples.begin(), samples.end(),
-                  [name](const BassSample& s) {
-            return s.name == name;
-        });
-
-        if (it != samples.end())
-            return it._Ptr;
+        // the first sample of a name wins, insert doesn't replace it
+        auto it = sampleIndex.find(name);
+        if (it != sampleIndex.end())
+            return &samples[it->second];
 
         return nullptr;
     }
 
     void BassSampleManager::ClearSamples() {
+        voices.StopAll();
+        queueVoices.clear();
+
         for (auto& it : samples) {
             BASS_SampleFree(it.handle);
         }
         samples = {};
+        sampleIndex.clear();
     }
 
     void BassSampleManager::SetChannelFrequency(uint32_t channel, int32_t freq) {
@@ -372,18 +375,20 @@ namespace plugin {
         listener.up = { up.x, up.y, up.z };
 #endif
 
-        for (auto& it : streams) {
-            if (it.channelId == 0)
-                continue;
 #ifdef GTA2
-            void* wnd = GetHWnd();
+        void* wnd = GetHWnd();
 #elif RW
-            void* wnd = RsGlobal.ps->window;
+        void* wnd = RsGlobal.ps->window;
 #elif RAGE
-            void* wnd = GetHWnd<void*>();
+        void* wnd = GetHWnd<void*>();
 #endif
+        bool minimized = IsIconic((HWND)wnd) != FALSE;
 
-            if (!IsIconic((HWND)wnd) && !settings.mute())
+        for (auto& it : streams) {
+            if (it.channelId == 0)
+                continue;
+
+            if (!minimized && !settings.mute())
                 BASS_ChannelSetAttribute(it.handle, BASS_ATTRIB_VOL, (it.volume / 127.0f) * (settings.masterVolume() / 127.0f));
             else
                 BASS_ChannelSetAttribute(it.handle, BASS_ATTRIB_VOL, 0.0f);
@@ -413,60 +418,80 @@ namespace plugin {
                 it.framesToPlay -= plugin::GetTimeStepFix();
         }
 
+        if (settings.stop()) {
+            voices.StopAll();
+            queueVoices.clear();
+        }
+        voices.SetPaused(!settings.playPause());
+
+        voices.SetListener(listener.pos.x, listener.pos.y, listener.pos.z);
+        voices.SetMasterVolume(minimized || settings.mute() ? 0.0f : settings.masterVolume() / 127.0f);
+
+        for (auto it = queueVoices.begin(); it != queueVoices.end();) {
+            it->second.framesToPlay -= plugin::GetTimeStepFix();
+            if (it->second.framesToPlay <= 0.0f || !voices.IsPlaying(it->second.handle)) {
+                voices.Stop(it->second.handle);
+                it = queueVoices.erase(it);
+            }
+            else
+                it++;
+        }
+
         if (settings.stop() || !settings.playPause())
             return;
 
-        for (auto&& it = queue.begin(); it != queue.end(); it++) {
-            if (!it->played) {
-                if (it->loopCount != 0) {
-                    uint32_t freq = it->freq;
-                    if (freq == 0)
-                        freq = GetSampleBaseFrequency(it->sample);
-
-                    uint32_t samplesPerFrame = freq / 50;
-                    if (samplesPerFrame == 0)
-                        continue;
-
-                    it->framesToPlay = (it->loopCount * GetSampleLength(it->sample)) / samplesPerFrame + 1.0f;
-                }
-
-                auto a = std::find_if(streams.begin(), streams.end(), [&](const BassStream& item) {
-                    return item.channelId != 0 && item.sampleId == it->sample;
-                });
-                
-                uint32_t channel = 0;
-
-                if (a != streams.end()) {
-                    channel = a->channelId;
-                    it->played = true;
-                }
-                else
-                    channel = FindAvailableChannel();
-
-                if (InitialiseChannel(channel, it->sample)) {
-                    SetChannelEmittingVolume(channel, it->volume);
-                    SetChannelFrequency(channel, it->freq);
-                    SetChannelLoopCount(channel, it->loopCount);
-                    SetChannelLoopPoints(channel, it->loopStart, it->loopEnd);
-                    SetChannelFramesToPlay(channel, it->framesToPlay);
-
-                    SetChannel3D(channel, it->is3d);
-                    SetChannel3DDistances(channel, 10.0f, 100.0f);
-                    if (it->is3d) {
-                        SetChannelReverbFlag(channel, it->reverb);
-                        SetChannel3DPosition(channel, it->pos.x, it->pos.y, it->pos.z);
-                    }
-                    else {
-                        SetChannel2DPositions(channel);
-                    }
-
-                    StartChannel(channel);
-
-                    it->played = true;
-                }
+        for (auto& it : queue) {
+            if (it.sample < 0 || it.sample >= (int32_t)samples.size())
+                continue;
+
+            uint32_t baseFreq = GetSampleBaseFrequency(it.sample);
+            uint32_t freq = it.freq;
+            if (freq == 0)
+                freq = baseFreq;
+
+            if (it.loopCount != 0) {
+                uint32_t samplesPerFrame = freq / 50;
+                if (samplesPerFrame == 0)
+                    continue;
+
+                it.framesToPlay = (it.loopCount * GetSampleLength(it.sample)) / samplesPerFrame + 1.0f;
             }
+
+            VoiceParams params;
+            params.sample = it.sample;
+            params.volume = std::min<uint8_t>(it.volume, 127) / 127.0f;
+            params.pitch = baseFreq ? (float)freq / baseFreq : 1.0f;
+            params.loop = it.loopCount == 0;
+            // loop points are in frames of the sample, -1 is its end
+            if (baseFreq) {
+                params.loopStart = (float)it.loopStart / baseFreq;
+                params.loopEnd = it.loopEnd >= 0 ? (float)it.loopEnd / baseFreq : 0.0f;
+            }
+            params.is3d = it.is3d;
+            params.x = it.pos.x;
+            params.y = it.pos.y;
+            params.z = it.pos.z;
+            params.minDistance = 10.0f;
+            params.maxDistance = 100.0f;
+
+            // a sample that's queued again keeps its voice, as long as it's queued it keeps going
+            auto voice = queueVoices.find(it.sample);
+            if (voice != queueVoices.end()) {
+                voices.SetParams(voice->second.handle, params);
+                voice->second.framesToPlay = it.framesToPlay;
+            }
+            else {
+                VoiceScheduler::Handle handle = voices.Play(params);
+                if (handle != VoiceScheduler::INVALID_HANDLE)
+                    queueVoices.insert({ it.sample, { handle, it.framesToPlay } });
+            }
+            it.played = true;
         }
         queue.clear();
+
+        voices.Update(plugin::GetTimeStepFix() / 30.0f);
+        BASS_Set3DPosition(&listener.pos, nullptr, &listener.forward, &listener.up);
+        BASS_Apply3D();
     }
 
     uint32_t BassSampleManager::FindAvailableChannel() {
@@ -486,5 +511,81 @@ namespace plugin {
         for (uint32_t i = 0; i < numChannels; i++)
             StopChannel(i);
     }
+
+    uint32_t BassSampleManager::BassVoiceBackend::GetNumChannels() {
+        return numVoiceChannels;
+    }
+
+    float BassSampleManager::BassVoiceBackend::GetSampleLength(int32_t sample) {
+        auto& s = owner.samples[sample];
+        // pushed streams go on as long as they're fed
+        if (s.isStream)
+            return 0.0f;
+
+        return (float)BASS_ChannelBytes2Seconds(s.handle, BASS_ChannelGetLength(s.handle, BASS_POS_BYTE));
+    }
+
+    bool BassSampleManager::BassVoiceBackend::Start(uint32_t channel, VoiceParams const& params, float volume, float offset) {
+        auto& s = owner.samples[params.sample];
+        HCHANNEL handle = s.isStream ? s.handle : BASS_SampleGetChannel(s.handle, FALSE);
+        if (!handle)
+            return false;
+
+        handles[channel] = handle;
+        sampleIds[channel] = params.sample;
+        BASS_ChannelFlags(handle, params.loop ? BASS_SAMPLE_LOOP : 0, BASS_SAMPLE_LOOP);
+        Update(channel, params, volume);
+
+        if (!s.isStream) {
+            // as SetChannelLoopPoints does for the channels played directly
+            if (params.loop && params.loopStart > 0.0f)
+                BASS_ChannelSetPosition(handle, BASS_ChannelSeconds2Bytes(handle, params.loopStart), BASS_POS_LOOP);
+            if (params.loop && params.loopEnd > 0.0f)
+                BASS_ChannelSetPosition(handle, BASS_ChannelSeconds2Bytes(handle, params.loopEnd), BASS_POS_END);
+
+            // a voice that was virtual carries on where it would be by now
+            if (offset > 0.0f)
+                BASS_ChannelSetPosition(handle, BASS_ChannelSeconds2Bytes(handle, offset), BASS_POS_BYTE);
+        }
+
+        return BASS_ChannelPlay(handle, FALSE) != FALSE;
+    }
+
+    void BassSampleManager::BassVoiceBackend::Stop(uint32_t channel) {
+        // a pushed stream would lose the data it has buffered
+        if (owner.samples[sampleIds[channel]].isStream)
+            BASS_ChannelPause(handles[channel]);
+        else
+            BASS_ChannelStop(handles[channel]);
+    }
+
+    void BassSampleManager::BassVoiceBackend::SetPaused(uint32_t channel, bool paused) {
+        if (paused)
+            BASS_ChannelPause(handles[channel]);
+        else
+            BASS_ChannelPlay(handles[channel], FALSE);
+    }
+
+    void BassSampleManager::BassVoiceBackend::Update(uint32_t channel, VoiceParams const& params, float volume) {
+        HCHANNEL handle = handles[channel];
+        BASS_ChannelSetAttribute(handle, BASS_ATTRIB_VOL, volume);
+        BASS_ChannelSetAttribute(handle, BASS_ATTRIB_FREQ, owner.GetSampleBaseFrequency(params.sample) * params.pitch);
+
+        if (params.is3d) {
+            BASS_3DVECTOR pos = { params.x, params.y, params.z };
+            BASS_ChannelSet3DAttributes(handle, BASS_3DMODE_NORMAL, params.minDistance, params.maxDistance, 360, 0, 0.0f);
+            BASS_ChannelSet3DPosition(handle, &pos, NULL, NULL);
+        }
+        else
+            BASS_ChannelSet3DAttributes(handle, BASS_3DMODE_OFF, params.minDistance, params.maxDistance, 360, -1, -1);
+    }
+
+    float BassSampleManager::BassVoiceBackend::GetOffset(uint32_t channel) {
+        HCHANNEL handle = handles[channel];
+        if (BASS_ChannelIsActive(handle) == BASS_ACTIVE_STOPPED)
+            return -1.0f;
+
+        return (float)BASS_ChannelBytes2Seconds(handle, BASS_ChannelGetPosition(handle, BASS_POS_BYTE));
+    }
 }
 #endif
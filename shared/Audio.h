@@ -8,7 +8,9 @@
 #if defined(GTA2) || defined(GTA3) || defined(GTAVC) || defined(GTASA) || defined(GTAIV)
 #include "PluginBase.h"
 #include "bass/bass.h"
+#include "VoiceScheduler.h"
 #include <string>
+#include <unordered_map>
 
 #ifndef GTA2
 #include "CMatrix.h"
@@ -18,6 +20,8 @@ namespace plugin {
     class BassSampleManager {
     public:
         static constexpr int32_t numChannels = 128;
+        // BASS channels the queued samples are played on, the rest wait as virtual voices
+        static constexpr int32_t numVoiceChannels = 64;
 
         struct BassQueue {
             uint8_t volume;
@@ -112,10 +116,41 @@ namespace plugin {
             }
         };
 
+        // Plays the scheduler's voices on channels of the samples
+        class BassVoiceBackend : public VoiceBackend {
+        public:
+            BassSampleManager& owner;
+            std::array<HCHANNEL, numVoiceChannels> handles;
+            std::array<int32_t, numVoiceChannels> sampleIds;
+
+            BassVoiceBackend(BassSampleManager& owner) : owner(owner) {
+                handles = {};
+                sampleIds = {};
+            }
+
+            uint32_t GetNumChannels() override;
+            float GetSampleLength(int32_t sample) override;
+            bool Start(uint32_t channel, VoiceParams const& params, float volume, float offset) override;
+            void Stop(uint32_t channel) override;
+            void SetPaused(uint32_t channel, bool paused) override;
+            void Update(uint32_t channel, VoiceParams const& params, float volume) override;
+            float GetOffset(uint32_t channel) override;
+        };
+
+        // Voice of a queued sample, kept while it's queued again before its frames run out
+        struct QueueVoice {
+            VoiceScheduler::Handle handle;
+            float framesToPlay;
+        };
+
         std::array<BassStream, numChannels> streams;
         std::vector<BassSample> samples;
+        std::unordered_map<std::string, uint32_t> sampleIndex;
         std::vector<BassQueue> queue;
         BassListener listener;
+        BassVoiceBackend voiceBackend;
+        VoiceScheduler voices;
+        std::unordered_map<int32_t, QueueVoice> queueVoices;
 
     public:
         struct {
@@ -133,7 +168,7 @@ namespace plugin {
         void PauseChannel(uint32_t channel);
 
     public:
-        inline BassSampleManager(uint32_t freq = 44100) {
+        inline BassSampleManager(uint32_t freq = 44100) : voiceBackend(*this), voices(voiceBackend) {
             BASS_SetConfig(BASS_CONFIG_BUFFER, 50);
             BASS_SetConfig(BASS_CONFIG_UPDATEPERIOD, 10);
             BASS_Init(-1, freq, BASS_DEVICE_3D | BASS_DEVICE_FREQ, NULL, NULL);
@@ -150,6 +185,8 @@ namespace plugin {
         }
 
         inline ~BassSampleManager() {
+            voices.StopAll();
+
             for (auto& it : samples)
                 BASS_SampleFree(it.handle);
 
@@ -190,6 +227,7 @@ namespace plugin {
         int32_t GetSampleLoopEndOffset(uint32_t sample);
         void SetChannel2DPositions(uint32_t channel);
 
+        // Updates the channels and plays the queued samples through the voice scheduler
         void Process();
 
         void ClearQueue();
@@ -197,6 +235,10 @@ namespace plugin {
         uint32_t FindAvailableChannel();
         void SetChannelReverbFlag(uint32_t channel, bool reverb);
         void StopAllChannels();
+
+        VoiceScheduler& GetVoices() {
+            return voices;
+        }
     };
 }
 #endif
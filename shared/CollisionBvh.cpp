@@ -0,0 +1,510 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "CollisionBvh.h"
+#include "CollisionFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+#ifdef GTASA
+#include "CCollisionData.h"
+#include "CColLine.h"
+#include "CColPoint.h"
+#endif
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_COLLISIONBVH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+    namespace {
+        constexpr uint32_t EMPTY_CHILD = 0xFFFFFFFF;
+        constexpr uint32_t NUM_BINS = 12;
+        constexpr uint32_t MAX_LEAF_SIZE = 4;
+        // a box test against a triangle test
+        constexpr float TRAVERSAL_COST = 1.0f;
+        // past this the splits are made in the middle, which keeps the traversal stack small
+        constexpr uint32_t MAX_SAH_DEPTH = 48;
+        // the middle splits halve the triangles, a 32 bit count can't be halved more often than this
+        constexpr uint32_t MAX_MEDIAN_DEPTH = 32;
+        // Every node of the four-wide tree takes at least one level of the binary one. Going down, each
+        // leaves at most three children on the stack for later.
+        constexpr uint32_t STACK_SIZE = (MAX_SAH_DEPTH + MAX_MEDIAN_DEPTH) * 3 + 1;
+
+        struct Box {
+            float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+            float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+            void Grow(float const* p) {
+                for (int32_t i = 0; i < 3; i++) {
+                    min[i] = (std::min)(min[i], p[i]);
+                    max[i] = (std::max)(max[i], p[i]);
+                }
+            }
+
+            void Grow(Box const& box) {
+                for (int32_t i = 0; i < 3; i++) {
+                    min[i] = (std::min)(min[i], box.min[i]);
+                    max[i] = (std::max)(max[i], box.max[i]);
+                }
+            }
+
+            float Area() const {
+                float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+                if (dx < 0.0f)
+                    return 0.0f;
+                return 2.0f * (dx * dy + dy * dz + dz * dx);
+            }
+        };
+
+        // Binary tree, flattened to four children per node afterwards
+        struct Builder {
+            struct BuildNode {
+                Box box;
+                uint32_t left, right;
+                uint32_t first, count; // count 0 for inner nodes
+            };
+
+            std::vector<Box> boxes;
+            std::vector<float> centroids; // three per triangle
+            std::vector<uint32_t> order;
+            std::vector<BuildNode> nodes;
+
+            uint32_t Build(uint32_t begin, uint32_t end, uint32_t depth) {
+                Box box, centroidBox;
+                for (uint32_t i = begin; i < end; i++) {
+                    box.Grow(boxes[order[i]]);
+                    centroidBox.Grow(&centroids[order[i] * 3]);
+                }
+
+                uint32_t count = end - begin;
+                uint32_t index = (uint32_t)nodes.size();
+                nodes.push_back({ box, 0, 0, begin, count });
+                if (count <= 1)
+                    return index;
+
+                float bestCost = FLT_MAX;
+                int32_t bestAxis = -1;
+                uint32_t bestSplit = 0;
+                for (int32_t axis = 0; axis < 3 && depth < MAX_SAH_DEPTH; axis++) {
+                    float extent = centroidBox.max[axis] - centroidBox.min[axis];
+                    if (extent <= 0.0f)
+                        continue;
+
+                    Box binBoxes[NUM_BINS];
+                    uint32_t binCounts[NUM_BINS] = {};
+                    float scale = NUM_BINS / extent;
+                    for (uint32_t i = begin; i < end; i++) {
+                        uint32_t bin = Bin(order[i], axis, centroidBox.min[axis], scale);
+                        binBoxes[bin].Grow(boxes[order[i]]);
+                        binCounts[bin]++;
+                    }
+
+                    // cost of splitting after each bin: area times triangle count on both sides
+                    float leftCost[NUM_BINS];
+                    Box left;
+                    uint32_t leftCount = 0;
+                    for (uint32_t b = 0; b < NUM_BINS - 1; b++) {
+                        left.Grow(binBoxes[b]);
+                        leftCount += binCounts[b];
+                        leftCost[b] = left.Area() * leftCount;
+                    }
+                    Box right;
+                    uint32_t rightCount = 0;
+                    for (uint32_t b = NUM_BINS - 1; b > 0; b--) {
+                        right.Grow(binBoxes[b]);
+                        rightCount += binCounts[b];
+                        float cost = leftCost[b - 1] + right.Area() * rightCount;
+                        if (cost < bestCost && rightCount != count && rightCount != 0) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestSplit = b;
+                        }
+                    }
+                }
+
+                // a split costs one more box test, worth it if it saves that many triangle tests
+                if (count <= MAX_LEAF_SIZE && (bestAxis < 0 || bestCost + box.Area() * TRAVERSAL_COST >= box.Area() * count))
+                    return index;
+
+                uint32_t middle;
+                if (bestAxis >= 0) {
+                    float min = centroidBox.min[bestAxis];
+                    float scale = NUM_BINS / (centroidBox.max[bestAxis] - min);
+                    middle = (uint32_t)(std::partition(order.begin() + begin, order.begin() + end, [&](uint32_t t) {
+                        return Bin(t, bestAxis, min, scale) < bestSplit;
+                    }) - order.begin());
+                }
+                else {
+                    // all centroids in one place or too deep, half and half along the longest axis
+                    int32_t axis = 0;
+                    for (int32_t a = 1; a < 3; a++) {
+                        if (box.max[a] - box.min[a] > box.max[axis] - box.min[axis])
+                            axis = a;
+                    }
+                    middle = begin + count / 2;
+                    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](uint32_t a, uint32_t b) {
+                        return centroids[a * 3 + axis] < centroids[b * 3 + axis];
+                    });
+                }
+
+                uint32_t leftNode = Build(begin, middle, depth + 1);
+                uint32_t rightNode = Build(middle, end, depth + 1);
+                nodes[index].left = leftNode;
+                nodes[index].right = rightNode;
+                nodes[index].count = 0;
+                return index;
+            }
+
+            uint32_t Bin(uint32_t triangle, int32_t axis, float min, float scale) const {
+                uint32_t bin = (uint32_t)((centroids[triangle * 3 + axis] - min) * scale);
+                return bin < NUM_BINS ? bin : NUM_BINS - 1;
+            }
+        };
+
+        void Cross(float const* a, float const* b, float* out) {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        float Dot(float const* a, float const* b) {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+    }
+
+    void CollisionBvh::Build(float const* x, float const* y, float const* z, size_t numVertices,
+        uint16_t const* indices, uint8_t const* material, uint8_t const* light, size_t numTriangles) {
+        Clear();
+
+        Builder builder;
+        std::vector<Triangle> source;
+        std::vector<uint32_t> sourceIndex;
+        for (size_t i = 0; i < numTriangles; i++) {
+            uint16_t const* tri = indices + i * 3;
+            if (tri[0] >= numVertices || tri[1] >= numVertices || tri[2] >= numVertices)
+                continue;
+
+            float v[3][3];
+            Box box;
+            for (int32_t k = 0; k < 3; k++) {
+                v[k][0] = x[tri[k]];
+                v[k][1] = y[tri[k]];
+                v[k][2] = z[tri[k]];
+                box.Grow(v[k]);
+            }
+            Triangle triangle;
+            for (int32_t a = 0; a < 3; a++) {
+                triangle.v0[a] = v[0][a];
+                triangle.e1[a] = v[1][a] - v[0][a];
+                triangle.e2[a] = v[2][a] - v[0][a];
+                builder.centroids.push_back((box.min[a] + box.max[a]) * 0.5f);
+            }
+            builder.boxes.push_back(box);
+            source.push_back(triangle);
+            sourceIndex.push_back((uint32_t)i);
+        }
+        if (source.empty())
+            return;
+
+        builder.order.resize(source.size());
+        for (uint32_t i = 0; i < builder.order.size(); i++)
+            builder.order[i] = i;
+        builder.nodes.reserve(source.size() * 2);
+        builder.Build(0, (uint32_t)source.size(), 0);
+
+        triangles.resize(source.size());
+        triangleIndex.resize(source.size());
+        materials.resize(source.size());
+        lights.resize(source.size());
+        for (size_t i = 0; i < source.size(); i++) {
+            uint32_t t = builder.order[i];
+            triangles[i] = source[t];
+            triangleIndex[i] = sourceIndex[t];
+            materials[i] = material ? material[sourceIndex[t]] : 0;
+            lights[i] = light ? light[sourceIndex[t]] : 0;
+        }
+
+        // each node takes up to four descendants of the binary tree, splitting the largest first
+        nodes.reserve(builder.nodes.size() / 2 + 1);
+        auto flatten = [&](auto& self, uint32_t binary) -> uint32_t {
+            uint32_t children[4];
+            uint32_t numChildren = 0;
+            auto const& node = builder.nodes[binary];
+            if (node.count) // a leaf at the root
+                children[numChildren++] = binary;
+            else {
+                children[numChildren++] = node.left;
+                children[numChildren++] = node.right;
+                while (numChildren < 4) {
+                    int32_t largest = -1;
+                    float largestArea = -1.0f;
+                    for (uint32_t i = 0; i < numChildren; i++) {
+                        auto const& child = builder.nodes[children[i]];
+                        if (child.count == 0 && child.box.Area() > largestArea) {
+                            largest = i;
+                            largestArea = child.box.Area();
+                        }
+                    }
+                    if (largest < 0)
+                        break;
+                    auto const& split = builder.nodes[children[largest]];
+                    children[largest] = split.left;
+                    children[numChildren++] = split.right;
+                }
+            }
+
+            uint32_t index = (uint32_t)nodes.size();
+            nodes.emplace_back();
+            Node flat = {};
+            for (uint32_t i = 0; i < 4; i++)
+                flat.child[i] = EMPTY_CHILD;
+            for (uint32_t i = 0; i < numChildren; i++) {
+                auto const& child = builder.nodes[children[i]];
+                flat.minX[i] = child.box.min[0];
+                flat.minY[i] = child.box.min[1];
+                flat.minZ[i] = child.box.min[2];
+                flat.maxX[i] = child.box.max[0];
+                flat.maxY[i] = child.box.max[1];
+                flat.maxZ[i] = child.box.max[2];
+                if (child.count) {
+                    flat.child[i] = child.first;
+                    flat.count[i] = child.count;
+                }
+                else
+                    flat.child[i] = self(self, children[i]);
+            }
+            nodes[index] = flat;
+            return index;
+        };
+        flatten(flatten, 0);
+    }
+
+    void CollisionBvh::Build(CollisionFile const& file, size_t model) {
+        auto const& m = file.GetModel(model);
+        auto const& vertices = file.GetVertices();
+        auto const& tris = file.GetTriangles();
+        uint32_t v = m.vertices.first, t = m.triangles.first;
+        if (m.triangles.count == 0) {
+            Clear();
+            return;
+        }
+        Build(vertices.x.data() + v, vertices.y.data() + v, vertices.z.data() + v, m.vertices.count,
+            tris.indices.data() + t * 3, tris.material.data() + t, tris.light.data() + t, m.triangles.count);
+    }
+
+    void CollisionBvh::Clear() {
+        nodes.clear();
+        triangles.clear();
+        triangleIndex.clear();
+        materials.clear();
+        lights.clear();
+    }
+
+    template<bool anyHit>
+    bool CollisionBvh::Trace(Segment const& segment, Hit* hit) const {
+        if (nodes.empty())
+            return false;
+
+        float const* origin = segment.start;
+        float dir[3] = { segment.end[0] - origin[0], segment.end[1] - origin[1], segment.end[2] - origin[2] };
+        // a zero component gives an infinite slab, which is what it should be
+        float inv[3] = { 1.0f / dir[0], 1.0f / dir[1], 1.0f / dir[2] };
+        float closest = 1.0f;
+        uint32_t closestTriangle = NO_HIT;
+
+#ifdef PLUGIN_COLLISIONBVH_SSE2
+        __m128 ox = _mm_set1_ps(origin[0]), oy = _mm_set1_ps(origin[1]), oz = _mm_set1_ps(origin[2]);
+        __m128 ix = _mm_set1_ps(inv[0]), iy = _mm_set1_ps(inv[1]), iz = _mm_set1_ps(inv[2]);
+#endif
+
+        uint32_t stack[STACK_SIZE];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize) {
+            Node const& node = nodes[stack[--stackSize]];
+
+            // distance to the four boxes, hit if entered before leaving and before the closest hit so far
+            alignas(16) float nearest[4];
+            int32_t mask = 0;
+#ifdef PLUGIN_COLLISIONBVH_SSE2
+            __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+            __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+            __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+            __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+            __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+            __m128 z2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+            __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)), _mm_max_ps(_mm_min_ps(z1, z2), _mm_setzero_ps()));
+            __m128 leave = _mm_min_ps(_mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)), _mm_min_ps(_mm_max_ps(z1, z2), _mm_set1_ps(closest)));
+            mask = _mm_movemask_ps(_mm_cmple_ps(enter, leave));
+            _mm_store_ps(nearest, enter);
+#else
+            for (int32_t i = 0; i < 4; i++) {
+                float x1 = (node.minX[i] - origin[0]) * inv[0], x2 = (node.maxX[i] - origin[0]) * inv[0];
+                float y1 = (node.minY[i] - origin[1]) * inv[1], y2 = (node.maxY[i] - origin[1]) * inv[1];
+                float z1 = (node.minZ[i] - origin[2]) * inv[2], z2 = (node.maxZ[i] - origin[2]) * inv[2];
+                float enter = (std::max)((std::max)((std::min)(x1, x2), (std::min)(y1, y2)), (std::max)((std::min)(z1, z2), 0.0f));
+                float leave = (std::min)((std::min)((std::max)(x1, x2), (std::max)(y1, y2)), (std::min)((std::max)(z1, z2), closest));
+                if (enter <= leave)
+                    mask |= 1 << i;
+                nearest[i] = enter;
+            }
+#endif
+
+            uint32_t inner[4];
+            uint32_t numInner = 0;
+            for (int32_t i = 0; i < 4; i++) {
+                if (!(mask & (1 << i)) || node.child[i] == EMPTY_CHILD)
+                    continue;
+                if (node.count[i] == 0) {
+                    inner[numInner++] = i;
+                    continue;
+                }
+
+                for (uint32_t t = node.child[i]; t < node.child[i] + node.count[i]; t++) {
+                    // Moller-Trumbore, both sides
+                    Triangle const& tri = triangles[t];
+                    float p[3], q[3], s[3];
+                    Cross(dir, tri.e2, p);
+                    float det = Dot(tri.e1, p);
+                    if (det == 0.0f)
+                        continue;
+                    float invDet = 1.0f / det;
+                    s[0] = origin[0] - tri.v0[0];
+                    s[1] = origin[1] - tri.v0[1];
+                    s[2] = origin[2] - tri.v0[2];
+                    float u = Dot(s, p) * invDet;
+                    if (u < 0.0f || u > 1.0f)
+                        continue;
+                    Cross(s, tri.e1, q);
+                    float v = Dot(dir, q) * invDet;
+                    if (v < 0.0f || u + v > 1.0f)
+                        continue;
+                    float distance = Dot(tri.e2, q) * invDet;
+                    if (distance < 0.0f || distance > closest)
+                        continue;
+                    if (anyHit)
+                        return true;
+                    closest = distance;
+                    closestTriangle = t;
+                }
+            }
+
+            // the nearest box is popped first
+            for (uint32_t a = 1; a < numInner; a++) {
+                for (uint32_t b = a; b > 0 && nearest[inner[b]] > nearest[inner[b - 1]]; b--)
+                    std::swap(inner[b], inner[b - 1]);
+            }
+            assert(stackSize + numInner <= STACK_SIZE);
+            for (uint32_t a = 0; a < numInner; a++)
+                stack[stackSize++] = node.child[inner[a]];
+        }
+
+        if (closestTriangle == NO_HIT)
+            return false;
+        if (hit) {
+            Triangle const& tri = triangles[closestTriangle];
+            for (int32_t a = 0; a < 3; a++)
+                hit->point[a] = origin[a] + dir[a] * closest;
+            Cross(tri.e1, tri.e2, hit->normal);
+            float length = std::sqrt(Dot(hit->normal, hit->normal));
+            if (length > 0.0f) {
+                for (int32_t a = 0; a < 3; a++)
+                    hit->normal[a] /= length;
+            }
+            hit->distance = closest;
+            hit->triangle = triangleIndex[closestTriangle];
+            hit->material = materials[closestTriangle];
+            hit->light = lights[closestTriangle];
+        }
+        return true;
+    }
+
+    size_t CollisionBvh::Intersect(Segment const* segments, size_t count, Hit* hits) const {
+        size_t numHits = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (Trace<false>(segments[i], &hits[i]))
+                numHits++;
+            else {
+                hits[i] = {};
+                hits[i].distance = 1.0f;
+                hits[i].triangle = NO_HIT;
+            }
+        }
+        return numHits;
+    }
+
+    size_t CollisionBvh::IntersectParallel(Segment const* segments, size_t count, Hit* hits) const {
+        constexpr size_t CHUNK_SIZE = 64;
+        std::atomic<size_t> numHits(0);
+        ParallelFor((count + CHUNK_SIZE - 1) / CHUNK_SIZE, [&](size_t chunk) {
+            size_t first = chunk * CHUNK_SIZE;
+            numHits += Intersect(segments + first, (std::min)(CHUNK_SIZE, count - first), hits + first);
+        });
+        return numHits;
+    }
+
+    bool CollisionBvh::IsBlocked(Segment const& segment) const {
+        return Trace<true>(segment, nullptr);
+    }
+
+#ifdef GTASA
+    void CollisionBvh::Build(CCollisionData const& data) {
+        uint32_t numVertices = 0;
+        std::vector<uint16_t> indices(data.m_nNumTriangles * 3);
+        std::vector<uint8_t> material(data.m_nNumTriangles), light(data.m_nNumTriangles);
+        for (size_t i = 0; i < data.m_nNumTriangles; i++) {
+            CColTriangle const& tri = data.m_pTriangles[i];
+            indices[i * 3] = tri.m_nVertA;
+            indices[i * 3 + 1] = tri.m_nVertB;
+            indices[i * 3 + 2] = tri.m_nVertC;
+            material[i] = tri.m_nMaterial;
+            light[i] = tri.m_nLight;
+            numVertices = (std::max)(numVertices, (uint32_t)(std::max)({ tri.m_nVertA, tri.m_nVertB, tri.m_nVertC }) + 1);
+        }
+
+        std::vector<float> x(numVertices), y(numVertices), z(numVertices);
+        CollisionFile::DecompressVertices(data.m_pVertices, numVertices, x.data(), y.data(), z.data());
+        Build(x.data(), y.data(), z.data(), numVertices, indices.data(), material.data(), light.data(), data.m_nNumTriangles);
+    }
+
+    size_t CollisionBvh::Intersect(CColLine const* lines, size_t count, CColPoint* points, float* distances) const {
+        size_t numHits = 0;
+        for (size_t i = 0; i < count; i++) {
+            Segment segment = { { lines[i].m_vecStart.x, lines[i].m_vecStart.y, lines[i].m_vecStart.z },
+                { lines[i].m_vecEnd.x, lines[i].m_vecEnd.y, lines[i].m_vecEnd.z } };
+            Hit hit;
+            bool hitSomething = Trace<false>(segment, &hit);
+            if (hitSomething) {
+                ToColPoint(hit, points[i]);
+                numHits++;
+            }
+            if (distances)
+                distances[i] = hitSomething ? hit.distance : 1.0f;
+        }
+        return numHits;
+    }
+
+    void CollisionBvh::ToColPoint(Hit const& hit, CColPoint& point) {
+        point.m_vecPoint = CVector(hit.point[0], hit.point[1], hit.point[2]);
+        point.m_vecNormal = CVector(hit.normal[0], hit.normal[1], hit.normal[2]);
+        point.m_nSurfaceTypeA = 0;
+        point.m_nPieceTypeA = 0;
+        point.m_nLightingA.day = 0;
+        point.m_nLightingA.night = 0;
+        point.m_nSurfaceTypeB = hit.material;
+        point.m_nPieceTypeB = 0;
+        point.m_nLightingB.day = hit.light & 0xF;
+        point.m_nLightingB.night = hit.light >> 4;
+        point.m_fDepth = 0.0f;
+    }
+#endif
+}
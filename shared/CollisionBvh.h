@@ -0,0 +1,98 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#ifdef GTASA
+class CCollisionData;
+class CColLine;
+class CColPoint;
+#endif
+
+namespace plugin {
+    class CollisionFile;
+
+    // Bounding volume hierarchy over the triangles of one collision model, for tracing many segments
+    // at once. Built with the surface area heuristic, then flattened to nodes of four children whose
+    // boxes are tested together with SSE2. Read-only after Build, so queries can run on any thread.
+    // Spheres and boxes of the model aren't included.
+    class CollisionBvh {
+    public:
+        static constexpr uint32_t NO_HIT = 0xFFFFFFFF;
+
+        // From start to end, in the model's space
+        struct Segment {
+            float start[3];
+            float end[3];
+        };
+
+        struct Hit {
+            float point[3];
+            float normal[3];   // unit length, on the side given by the triangle's winding
+            float distance;    // 0 at start, 1 at end
+            uint32_t triangle; // index in the model's triangles, NO_HIT if the segment hit nothing
+            uint8_t material;
+            uint8_t light;
+        };
+
+        CollisionBvh() {}
+
+        // indices are three per triangle, material and light can be null
+        void Build(float const* x, float const* y, float const* z, size_t numVertices,
+            uint16_t const* indices, uint8_t const* material, uint8_t const* light, size_t numTriangles);
+        void Build(CollisionFile const& file, size_t model);
+        void Clear();
+        bool IsEmpty() const { return nodes.empty(); }
+
+        size_t GetNumTriangles() const { return triangleIndex.size(); }
+        size_t GetNumNodes() const { return nodes.size(); }
+
+        // The closest hit of every segment, returns how many hit something
+        size_t Intersect(Segment const* segments, size_t count, Hit* hits) const;
+        // Same, the segments are shared out among the threads of SetWorkerThreads
+        size_t IntersectParallel(Segment const* segments, size_t count, Hit* hits) const;
+        // Whether anything is between start and end, stops at the first triangle found
+        bool IsBlocked(Segment const& segment) const;
+
+#ifdef GTASA
+        void Build(CCollisionData const& data);
+        // Lines in the model's space. A point is written for every line that hits, like
+        // CCollision::ProcessLineTriangle fills it, and distances (can be null) get 0-1 or 1.0f
+        // for no hit. Returns how many hit something.
+        size_t Intersect(CColLine const* lines, size_t count, CColPoint* points, float* distances) const;
+        static void ToColPoint(Hit const& hit, CColPoint& point);
+#endif
+
+    private:
+        // Children with count 0 are nodes, the others are triangles first..first+count-1.
+        // Unused children are 0xFFFFFFFF.
+        struct alignas(16) Node {
+            float minX[4], minY[4], minZ[4];
+            float maxX[4], maxY[4], maxZ[4];
+            uint32_t child[4];
+            uint32_t count[4];
+        };
+
+        // a vertex and two edges, for Moller-Trumbore
+        struct Triangle {
+            float v0[3];
+            float e1[3];
+            float e2[3];
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Triangle> triangles; // in leaf order
+        std::vector<uint32_t> triangleIndex;
+        std::vector<uint8_t> materials;
+        std::vector<uint8_t> lights;
+
+        template<bool anyHit>
+        bool Trace(Segment const& segment, Hit* hit) const;
+    };
+}
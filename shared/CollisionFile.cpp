@@ -0,0 +1,618 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "CollisionFile.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_COLLISIONFILE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+    namespace {
+        // fourcc, size, name and model id
+        constexpr size_t HEADER_SIZE = 32;
+        // + bounds, counts, flags and six offsets
+        constexpr size_t COL2_HEADER_SIZE = 108;
+        // + shadow face count and two offsets
+        constexpr size_t COL3_HEADER_SIZE = 120;
+        constexpr size_t COL4_HEADER_SIZE = 124;
+
+        constexpr size_t SPHERE_SIZE = 20;
+        constexpr size_t BOX_SIZE = 28;
+        constexpr size_t FACE_GROUP_SIZE = 28;
+        constexpr size_t COL1_VERTEX_SIZE = 12;
+        constexpr size_t COL1_FACE_SIZE = 16;
+        constexpr size_t VERTEX_SIZE = 6;
+        constexpr size_t FACE_SIZE = 8;
+
+        char const* const fourccs[] = { "COLL", "COL2", "COL3", "COL4" };
+
+        template<typename T>
+        T Read(uint8_t const* p) {
+            T value;
+            memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        void ReadFloats(uint8_t const* p, float* out, size_t count) {
+            memcpy(out, p, count * sizeof(float));
+        }
+
+        CollisionFile::Surface ReadSurface(uint8_t const* p) {
+            return { p[0], p[1], p[2], p[3] };
+        }
+
+        // Where the sections of one model are, found by the first pass
+        struct Block {
+            uint8_t const* data; // the fourcc
+            size_t size;
+            uint8_t const* spheres = nullptr;
+            uint8_t const* boxes = nullptr;
+            uint8_t const* vertices = nullptr;
+            uint8_t const* triangles = nullptr;
+            uint8_t const* faceGroups = nullptr;
+            uint8_t const* shadowVertices = nullptr;
+            uint8_t const* shadowTriangles = nullptr;
+            bool valid = false;
+        };
+
+        // COL1 sections follow each other, each after its count
+        struct Cursor {
+            uint8_t const* p;
+            uint8_t const* end;
+            bool valid = true;
+
+            uint8_t const* Take(size_t size) {
+                if (!valid || (size_t)(end - p) < size) {
+                    valid = false;
+                    return nullptr;
+                }
+                uint8_t const* result = p;
+                p += size;
+                return result;
+            }
+
+            uint32_t Count(size_t itemSize) {
+                uint8_t const* count = Take(4);
+                if (!count)
+                    return 0;
+                uint32_t result = Read<uint32_t>(count);
+                // enough bytes left for all of them, so the multiplication below can't overflow
+                if (result > (size_t)(end - p) / itemSize)
+                    valid = false;
+                return result;
+            }
+        };
+
+        // COL2+ offsets are from the header + 4
+        uint8_t const* Section(Block const& block, uint32_t offset, size_t count, size_t itemSize) {
+            size_t begin = (size_t)offset + 4;
+            if (begin > block.size || count > (block.size - begin) / itemSize)
+                return nullptr;
+            return block.data + begin;
+        }
+
+        // COL2+ don't store the vertex count, it's up to the highest index used
+        uint32_t CountVertices(uint8_t const* faces, size_t count) {
+            if (count == 0)
+                return 0;
+            uint32_t highest = 0;
+            for (size_t i = 0; i < count; i++) {
+                for (size_t v = 0; v < 3; v++) {
+                    uint32_t index = Read<uint16_t>(faces + i * FACE_SIZE + v * 2);
+                    if (index > highest)
+                        highest = index;
+                }
+            }
+            return highest + 1;
+        }
+
+        bool ReadLayoutVer1(Block& block, CollisionFile::Model& model) {
+            Cursor cursor{ block.data + HEADER_SIZE, block.data + block.size };
+            uint8_t const* bounds = cursor.Take(40);
+            if (!bounds)
+                return false;
+            model.radius = Read<float>(bounds);
+            ReadFloats(bounds + 4, model.center, 3);
+            ReadFloats(bounds + 16, model.min, 3);
+            ReadFloats(bounds + 28, model.max, 3);
+
+            model.spheres.count = cursor.Count(SPHERE_SIZE);
+            block.spheres = cursor.Take(model.spheres.count * SPHERE_SIZE);
+            if (cursor.Count(1) != 0) // lines
+                return false;
+            model.boxes.count = cursor.Count(BOX_SIZE);
+            block.boxes = cursor.Take(model.boxes.count * BOX_SIZE);
+            model.vertices.count = cursor.Count(COL1_VERTEX_SIZE);
+            block.vertices = cursor.Take(model.vertices.count * COL1_VERTEX_SIZE);
+            model.triangles.count = cursor.Count(COL1_FACE_SIZE);
+            block.triangles = cursor.Take(model.triangles.count * COL1_FACE_SIZE);
+            if (!cursor.valid || model.vertices.count > 0x10000)
+                return false;
+
+            for (uint32_t i = 0; i < model.triangles.count; i++) {
+                for (size_t v = 0; v < 3; v++) {
+                    if (Read<uint32_t>(block.triangles + i * COL1_FACE_SIZE + v * 4) >= model.vertices.count)
+                        return false;
+                }
+            }
+
+            model.flags = (model.spheres.count || model.boxes.count || model.triangles.count) ? (uint32_t)CollisionFile::FLAG_NOT_EMPTY : 0;
+            return true;
+        }
+
+        bool ReadLayoutVer2(Block& block, CollisionFile::Model& model) {
+            size_t headerSize = model.version == CollisionFile::COL_VERSION_2 ? COL2_HEADER_SIZE :
+                model.version == CollisionFile::COL_VERSION_3 ? COL3_HEADER_SIZE : COL4_HEADER_SIZE;
+            if (block.size < headerSize)
+                return false;
+
+            uint8_t const* header = block.data;
+            ReadFloats(header + 32, model.min, 3);
+            ReadFloats(header + 44, model.max, 3);
+            ReadFloats(header + 56, model.center, 3);
+            model.radius = Read<float>(header + 68);
+            model.spheres.count = Read<uint16_t>(header + 72);
+            model.boxes.count = Read<uint16_t>(header + 74);
+            model.triangles.count = Read<uint16_t>(header + 76);
+            if (header[78] != 0) // lines or disks
+                return false;
+            model.flags = Read<uint32_t>(header + 80);
+
+            block.spheres = Section(block, Read<uint32_t>(header + 84), model.spheres.count, SPHERE_SIZE);
+            block.boxes = Section(block, Read<uint32_t>(header + 88), model.boxes.count, BOX_SIZE);
+            uint32_t facesOffset = Read<uint32_t>(header + 100);
+            block.triangles = Section(block, facesOffset, model.triangles.count, FACE_SIZE);
+            if (!block.spheres || !block.boxes || !block.triangles)
+                return false;
+            model.vertices.count = CountVertices(block.triangles, model.triangles.count);
+            block.vertices = Section(block, Read<uint32_t>(header + 96), model.vertices.count, VERTEX_SIZE);
+            if (!block.vertices)
+                return false;
+
+            // the groups and their count are right before the faces
+            if ((model.flags & CollisionFile::FLAG_HAS_FACE_GROUPS) && model.triangles.count) {
+                size_t countPos = facesOffset; // the faces are at offset + 4
+                if (countPos < headerSize)
+                    return false;
+                model.faceGroups.count = Read<uint32_t>(header + countPos);
+                if (model.faceGroups.count > (countPos - headerSize) / FACE_GROUP_SIZE)
+                    return false;
+                block.faceGroups = header + countPos - model.faceGroups.count * FACE_GROUP_SIZE;
+            }
+
+            if (model.version >= CollisionFile::COL_VERSION_3) {
+                model.shadowTriangles.count = Read<uint32_t>(header + 108);
+                block.shadowTriangles = Section(block, Read<uint32_t>(header + 116), model.shadowTriangles.count, FACE_SIZE);
+                if (!block.shadowTriangles)
+                    return false;
+                model.shadowVertices.count = CountVertices(block.shadowTriangles, model.shadowTriangles.count);
+                block.shadowVertices = Section(block, Read<uint32_t>(header + 112), model.shadowVertices.count, VERTEX_SIZE);
+                if (!block.shadowVertices)
+                    return false;
+            }
+            if (model.version == CollisionFile::COL_VERSION_4)
+                model.col4Extra = Read<uint32_t>(header + 120);
+            return true;
+        }
+
+        bool ReadLayout(Block& block, CollisionFile::Model& model) {
+            model = {};
+            if (block.size < HEADER_SIZE)
+                return false;
+            memcpy(model.name, block.data + 8, sizeof(model.name));
+            model.name[sizeof(model.name) - 1] = '\0';
+            model.modelId = Read<uint16_t>(block.data + 30);
+            for (size_t i = 0; i < 4; i++) {
+                if (memcmp(block.data, fourccs[i], 4) == 0)
+                    model.version = (CollisionFile::eVersion)(i + 1);
+            }
+
+            if (model.version == CollisionFile::COL_VERSION_1)
+                return ReadLayoutVer1(block, model);
+            return ReadLayoutVer2(block, model);
+        }
+
+        template<typename... Vectors>
+        void Grow(size_t size, Vectors&... vectors) {
+            (vectors.resize(size), ...);
+        }
+
+        void PutBytes(std::vector<uint8_t>& out, void const* data, size_t size) {
+            uint8_t const* bytes = reinterpret_cast<uint8_t const*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        template<typename T>
+        void Put(std::vector<uint8_t>& out, T value) {
+            PutBytes(out, &value, sizeof(T));
+        }
+
+        template<typename T>
+        void PutAt(std::vector<uint8_t>& out, size_t pos, T value) {
+            memcpy(out.data() + pos, &value, sizeof(T));
+        }
+    }
+
+    void CollisionFile::DecompressVertices(void const* compressed, size_t count, float* x, float* y, float* z) {
+        uint8_t const* bytes = reinterpret_cast<uint8_t const*>(compressed);
+        size_t i = 0;
+#ifdef PLUGIN_COLLISIONFILE_SSE2
+        __m128 scale = _mm_set1_ps(1.0f / 128.0f);
+        // int16 in the high half of each int32, the arithmetic shift sign extends it
+        auto low = [scale](__m128i v) { return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale); };
+        auto high = [scale](__m128i v) { return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale); };
+        // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to x0-x3, y0-y3, z0-z3
+        auto store = [](__m128 a, __m128 b, __m128 c, float* x, float* y, float* z) {
+            __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+            __m128 s = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+            _mm_storeu_ps(x, _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0)));
+            _mm_storeu_ps(y, _mm_shuffle_ps(s, t, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(z, _mm_shuffle_ps(s, c, _MM_SHUFFLE(3, 0, 3, 1)));
+        };
+        for (; i + 8 <= count; i += 8) {
+            __m128i const* src = reinterpret_cast<__m128i const*>(bytes + i * VERTEX_SIZE);
+            __m128i v0 = _mm_loadu_si128(src);
+            __m128i v1 = _mm_loadu_si128(src + 1);
+            __m128i v2 = _mm_loadu_si128(src + 2);
+            store(low(v0), high(v0), low(v1), x + i, y + i, z + i);
+            store(high(v1), low(v2), high(v2), x + i + 4, y + i + 4, z + i + 4);
+        }
+#endif
+        for (; i < count; i++) {
+            uint8_t const* p = bytes + i * VERTEX_SIZE;
+            x[i] = (float)Read<int16_t>(p) * (1.0f / 128.0f);
+            y[i] = (float)Read<int16_t>(p + 2) * (1.0f / 128.0f);
+            z[i] = (float)Read<int16_t>(p + 4) * (1.0f / 128.0f);
+        }
+    }
+
+    void CollisionFile::CompressVertices(float const* x, float const* y, float const* z, size_t count, int16_t* compressed) {
+        auto compress = [](float value) {
+            value *= 128.0f;
+            if (value < -32768.0f)
+                value = -32768.0f;
+            else if (value > 32767.0f)
+                value = 32767.0f;
+            return (int16_t)std::lround(value);
+        };
+        for (size_t i = 0; i < count; i++) {
+            compressed[i * 3] = compress(x[i]);
+            compressed[i * 3 + 1] = compress(y[i]);
+            compressed[i * 3 + 2] = compress(z[i]);
+        }
+    }
+
+    bool CollisionFile::Load(std::string const& path) {
+        MappedFile file;
+        if (!file.Open(path)) {
+            Clear();
+            return false;
+        }
+        return Load(std::span<const uint8_t>(file.Data(), file.Size()));
+    }
+
+    bool CollisionFile::Load(std::span<const uint8_t> data) {
+        Clear();
+
+        // models follow each other, whatever comes after the last one is padding
+        std::vector<Block> blocks;
+        size_t pos = 0;
+        while (data.size() - pos >= 8) {
+            bool known = false;
+            for (auto fourcc : fourccs)
+                known |= memcmp(data.data() + pos, fourcc, 4) == 0;
+            if (!known)
+                break;
+            uint32_t size = Read<uint32_t>(data.data() + pos + 4);
+            if (size > data.size() - pos - 8)
+                return false;
+            Block block;
+            block.data = data.data() + pos;
+            block.size = (size_t)size + 8;
+            blocks.push_back(block);
+            pos += block.size;
+        }
+
+        // first pass: counts and where the sections are
+        models.resize(blocks.size());
+        ParallelFor(blocks.size(), [&](size_t i) {
+            blocks[i].valid = ReadLayout(blocks[i], models[i]);
+        });
+
+        size_t numSpheres = 0, numBoxes = 0, numVertices = 0, numTriangles = 0, numFaceGroups = 0;
+        size_t numShadowVertices = 0, numShadowTriangles = 0;
+        for (size_t i = 0; i < models.size(); i++) {
+            if (!blocks[i].valid) {
+                Clear();
+                return false;
+            }
+            Model& model = models[i];
+            auto place = [](Range& range, size_t& total) {
+                range.first = (uint32_t)total;
+                total += range.count;
+            };
+            place(model.spheres, numSpheres);
+            place(model.boxes, numBoxes);
+            place(model.vertices, numVertices);
+            place(model.triangles, numTriangles);
+            place(model.faceGroups, numFaceGroups);
+            place(model.shadowVertices, numShadowVertices);
+            place(model.shadowTriangles, numShadowTriangles);
+        }
+
+        Grow(numSpheres, spheres.x, spheres.y, spheres.z, spheres.radius, spheres.surface);
+        Grow(numBoxes, boxes.minX, boxes.minY, boxes.minZ, boxes.maxX, boxes.maxY, boxes.maxZ, boxes.surface);
+        Grow(numVertices, vertices.x, vertices.y, vertices.z);
+        Grow(numTriangles, triangles.material, triangles.light);
+        triangles.indices.resize(numTriangles * 3);
+        Grow(numFaceGroups, faceGroups.minX, faceGroups.minY, faceGroups.minZ, faceGroups.maxX, faceGroups.maxY,
+            faceGroups.maxZ, faceGroups.first, faceGroups.last);
+        Grow(numShadowVertices, shadowVertices.x, shadowVertices.y, shadowVertices.z);
+        Grow(numShadowTriangles, shadowTriangles.material, shadowTriangles.light);
+        shadowTriangles.indices.resize(numShadowTriangles * 3);
+
+        // second pass: every model decodes into its own ranges
+        ParallelFor(models.size(), [&](size_t m) {
+            Model const& model = models[m];
+            Block const& block = blocks[m];
+            bool ver1 = model.version == COL_VERSION_1;
+
+            for (uint32_t i = 0; i < model.spheres.count; i++) {
+                uint8_t const* p = block.spheres + i * SPHERE_SIZE;
+                size_t dst = model.spheres.first + i;
+                // COL1 has the radius first
+                uint8_t const* center = ver1 ? p + 4 : p;
+                spheres.x[dst] = Read<float>(center);
+                spheres.y[dst] = Read<float>(center + 4);
+                spheres.z[dst] = Read<float>(center + 8);
+                spheres.radius[dst] = Read<float>(ver1 ? p : p + 12);
+                spheres.surface[dst] = ReadSurface(p + 16);
+            }
+
+            for (uint32_t i = 0; i < model.boxes.count; i++) {
+                uint8_t const* p = block.boxes + i * BOX_SIZE;
+                size_t dst = model.boxes.first + i;
+                boxes.minX[dst] = Read<float>(p);
+                boxes.minY[dst] = Read<float>(p + 4);
+                boxes.minZ[dst] = Read<float>(p + 8);
+                boxes.maxX[dst] = Read<float>(p + 12);
+                boxes.maxY[dst] = Read<float>(p + 16);
+                boxes.maxZ[dst] = Read<float>(p + 20);
+                boxes.surface[dst] = ReadSurface(p + 24);
+            }
+
+            auto readTriangles = [ver1](uint8_t const* src, uint32_t count, Triangles& out, size_t first) {
+                for (uint32_t i = 0; i < count; i++) {
+                    size_t dst = first + i;
+                    if (ver1) {
+                        uint8_t const* p = src + i * COL1_FACE_SIZE;
+                        for (size_t v = 0; v < 3; v++)
+                            out.indices[dst * 3 + v] = (uint16_t)Read<uint32_t>(p + v * 4);
+                        out.material[dst] = p[12];
+                        out.light[dst] = p[15];
+                    }
+                    else {
+                        uint8_t const* p = src + i * FACE_SIZE;
+                        for (size_t v = 0; v < 3; v++)
+                            out.indices[dst * 3 + v] = Read<uint16_t>(p + v * 2);
+                        out.material[dst] = p[6];
+                        out.light[dst] = p[7];
+                    }
+                }
+            };
+
+            if (ver1) {
+                for (uint32_t i = 0; i < model.vertices.count; i++) {
+                    uint8_t const* p = block.vertices + i * COL1_VERTEX_SIZE;
+                    size_t dst = model.vertices.first + i;
+                    vertices.x[dst] = Read<float>(p);
+                    vertices.y[dst] = Read<float>(p + 4);
+                    vertices.z[dst] = Read<float>(p + 8);
+                }
+            }
+            else {
+                size_t first = model.vertices.first;
+                DecompressVertices(block.vertices, model.vertices.count, vertices.x.data() + first, vertices.y.data() + first, vertices.z.data() + first);
+            }
+            readTriangles(block.triangles, model.triangles.count, triangles, model.triangles.first);
+
+            for (uint32_t i = 0; i < model.faceGroups.count; i++) {
+                uint8_t const* p = block.faceGroups + i * FACE_GROUP_SIZE;
+                size_t dst = model.faceGroups.first + i;
+                faceGroups.minX[dst] = Read<float>(p);
+                faceGroups.minY[dst] = Read<float>(p + 4);
+                faceGroups.minZ[dst] = Read<float>(p + 8);
+                faceGroups.maxX[dst] = Read<float>(p + 12);
+                faceGroups.maxY[dst] = Read<float>(p + 16);
+                faceGroups.maxZ[dst] = Read<float>(p + 20);
+                faceGroups.first[dst] = Read<uint16_t>(p + 24);
+                faceGroups.last[dst] = Read<uint16_t>(p + 26);
+            }
+
+            if (model.shadowVertices.count) {
+                size_t first = model.shadowVertices.first;
+                DecompressVertices(block.shadowVertices, model.shadowVertices.count, shadowVertices.x.data() + first,
+                    shadowVertices.y.data() + first, shadowVertices.z.data() + first);
+            }
+            readTriangles(block.shadowTriangles, model.shadowTriangles.count, shadowTriangles, model.shadowTriangles.first);
+        });
+        return true;
+    }
+
+    void CollisionFile::Clear() {
+        models.clear();
+        spheres = {};
+        boxes = {};
+        vertices = {};
+        triangles = {};
+        faceGroups = {};
+        shadowVertices = {};
+        shadowTriangles = {};
+    }
+
+    int32_t CollisionFile::FindModel(std::string_view name) const {
+        for (size_t i = 0; i < models.size(); i++) {
+            std::string_view modelName(models[i].name, strnlen(models[i].name, sizeof(models[i].name)));
+            if (modelName.size() != name.size())
+                continue;
+            bool equal = true;
+            for (size_t c = 0; c < name.size() && equal; c++)
+                equal = toupper((uint8_t)modelName[c]) == toupper((uint8_t)name[c]);
+            if (equal)
+                return (int32_t)i;
+        }
+        return -1;
+    }
+
+    std::vector<uint8_t> CollisionFile::Write() const {
+        std::vector<uint8_t> out;
+        std::vector<int16_t> compressed;
+
+        for (Model const& model : models) {
+            size_t start = out.size();
+            bool ver1 = model.version == COL_VERSION_1;
+            PutBytes(out, fourccs[model.version - 1], 4);
+            Put<uint32_t>(out, 0); // size, set at the end
+            PutBytes(out, model.name, sizeof(model.name));
+            Put(out, model.modelId);
+
+            auto putSphere = [&](size_t i) {
+                if (ver1)
+                    Put(out, spheres.radius[i]);
+                Put(out, spheres.x[i]);
+                Put(out, spheres.y[i]);
+                Put(out, spheres.z[i]);
+                if (!ver1)
+                    Put(out, spheres.radius[i]);
+                Put(out, spheres.surface[i]);
+            };
+            auto putBox = [&](size_t i) {
+                float values[] = { boxes.minX[i], boxes.minY[i], boxes.minZ[i], boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i] };
+                PutBytes(out, values, sizeof(values));
+                Put(out, boxes.surface[i]);
+            };
+            auto putTriangles = [&](Triangles const& src, Range range) {
+                for (size_t i = range.first; i < range.first + range.count; i++) {
+                    if (ver1) {
+                        for (size_t v = 0; v < 3; v++)
+                            Put<uint32_t>(out, src.indices[i * 3 + v]);
+                        Put(out, Surface{ src.material[i], 0, 0, src.light[i] });
+                    }
+                    else {
+                        PutBytes(out, &src.indices[i * 3], 6);
+                        Put(out, src.material[i]);
+                        Put(out, src.light[i]);
+                    }
+                }
+            };
+            auto putCompressed = [&](Vertices const& src, Range range) {
+                compressed.resize(range.count * 3);
+                if (range.count)
+                    CompressVertices(&src.x[range.first], &src.y[range.first], &src.z[range.first], range.count, compressed.data());
+                PutBytes(out, compressed.data(), compressed.size() * sizeof(int16_t));
+                while ((out.size() - start) % 4)
+                    Put<uint8_t>(out, 0);
+            };
+
+            if (ver1) {
+                Put(out, model.radius);
+                PutBytes(out, model.center, sizeof(model.center));
+                PutBytes(out, model.min, sizeof(model.min));
+                PutBytes(out, model.max, sizeof(model.max));
+                Put(out, model.spheres.count);
+                for (size_t i = 0; i < model.spheres.count; i++)
+                    putSphere(model.spheres.first + i);
+                Put<uint32_t>(out, 0); // lines
+                Put(out, model.boxes.count);
+                for (size_t i = 0; i < model.boxes.count; i++)
+                    putBox(model.boxes.first + i);
+                Put(out, model.vertices.count);
+                for (size_t i = model.vertices.first; i < model.vertices.first + model.vertices.count; i++) {
+                    Put(out, vertices.x[i]);
+                    Put(out, vertices.y[i]);
+                    Put(out, vertices.z[i]);
+                }
+                Put(out, model.triangles.count);
+                putTriangles(triangles, model.triangles);
+            }
+            else {
+                PutBytes(out, model.min, sizeof(model.min));
+                PutBytes(out, model.max, sizeof(model.max));
+                PutBytes(out, model.center, sizeof(model.center));
+                Put(out, model.radius);
+                Put<uint16_t>(out, (uint16_t)model.spheres.count);
+                Put<uint16_t>(out, (uint16_t)model.boxes.count);
+                Put<uint16_t>(out, (uint16_t)model.triangles.count);
+                Put<uint16_t>(out, 0); // lines and padding
+
+                uint32_t flags = model.flags & ~(FLAG_NOT_EMPTY | FLAG_HAS_FACE_GROUPS | FLAG_HAS_SHADOW);
+                if (model.spheres.count || model.boxes.count || model.triangles.count)
+                    flags |= FLAG_NOT_EMPTY;
+                if (model.faceGroups.count)
+                    flags |= FLAG_HAS_FACE_GROUPS;
+                if (model.shadowTriangles.count)
+                    flags |= FLAG_HAS_SHADOW;
+                Put(out, flags);
+
+                // spheres, boxes, lines, vertices, faces, triangle planes, then for COL3+
+                // shadow face count, shadow vertices and shadow faces
+                size_t offsets = out.size();
+                for (size_t i = 0; i < 6; i++)
+                    Put<uint32_t>(out, 0);
+                if (model.version >= COL_VERSION_3) {
+                    Put(out, model.shadowTriangles.count);
+                    Put<uint32_t>(out, 0);
+                    Put<uint32_t>(out, 0);
+                }
+                if (model.version == COL_VERSION_4)
+                    Put(out, model.col4Extra);
+                auto setOffset = [&](size_t index) {
+                    PutAt<uint32_t>(out, offsets + index * 4, (uint32_t)(out.size() - start - 4));
+                };
+
+                setOffset(0);
+                for (size_t i = 0; i < model.spheres.count; i++)
+                    putSphere(model.spheres.first + i);
+                setOffset(1);
+                for (size_t i = 0; i < model.boxes.count; i++)
+                    putBox(model.boxes.first + i);
+                setOffset(2);
+                setOffset(3);
+                putCompressed(vertices, model.vertices);
+
+                if (model.faceGroups.count) {
+                    for (size_t i = model.faceGroups.first; i < model.faceGroups.first + model.faceGroups.count; i++) {
+                        float values[] = { faceGroups.minX[i], faceGroups.minY[i], faceGroups.minZ[i],
+                            faceGroups.maxX[i], faceGroups.maxY[i], faceGroups.maxZ[i] };
+                        PutBytes(out, values, sizeof(values));
+                        Put(out, faceGroups.first[i]);
+                        Put(out, faceGroups.last[i]);
+                    }
+                    Put(out, model.faceGroups.count);
+                }
+                setOffset(4);
+                putTriangles(triangles, model.triangles);
+
+                if (model.version >= COL_VERSION_3) {
+                    setOffset(7);
+                    putCompressed(shadowVertices, model.shadowVertices);
+                    setOffset(8);
+                    putTriangles(shadowTriangles, model.shadowTriangles);
+                }
+            }
+
+            PutAt<uint32_t>(out, start + 4, (uint32_t)(out.size() - start - 8));
+        }
+        return out;
+    }
+}
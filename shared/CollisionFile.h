@@ -0,0 +1,135 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+
+namespace plugin {
+    // Collision file (.col) read without the game: all models of a COLL, COL2, COL3 or COL4 stream are
+    // decoded into buffers shared by the whole file, one array per field, and a model is a set of ranges
+    // into them. Vertices are decompressed to floats. Lines and disks (unused in the game's files) aren't
+    // supported, models that have them fail to load.
+    // http://www.gtamodding.com/wiki/Collision_File
+    class CollisionFile {
+    public:
+        enum eVersion : uint8_t {
+            COL_VERSION_1 = 1, // COLL, III and VC
+            COL_VERSION_2,     // COL2, SA
+            COL_VERSION_3,     // COL3, SA with shadow mesh
+            COL_VERSION_4      // COL4
+        };
+
+        // CCollisionData::m_nFlags
+        enum eFlags : uint32_t {
+            FLAG_USES_DISKS = 1,
+            FLAG_NOT_EMPTY = 2,
+            FLAG_HAS_FACE_GROUPS = 8,
+            FLAG_HAS_SHADOW = 16
+        };
+
+        struct Surface {
+            uint8_t material;
+            uint8_t flag;
+            uint8_t brightness;
+            uint8_t light;
+        };
+
+        struct Range {
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        struct Model {
+            char name[22];
+            uint16_t modelId;
+            eVersion version;
+            uint32_t flags;
+            float min[3];
+            float max[3];
+            float center[3];
+            float radius;
+            uint32_t col4Extra; // the field COL4 adds to the header
+            Range spheres;
+            Range boxes;
+            Range vertices;
+            Range triangles;
+            Range faceGroups;
+            Range shadowVertices;
+            Range shadowTriangles;
+        };
+
+        struct Spheres {
+            std::vector<float> x, y, z, radius;
+            std::vector<Surface> surface;
+        };
+
+        struct Boxes {
+            std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+            std::vector<Surface> surface;
+        };
+
+        struct Vertices {
+            std::vector<float> x, y, z;
+        };
+
+        // Three vertex indices per triangle, relative to the model's first vertex
+        struct Triangles {
+            std::vector<uint16_t> indices;
+            std::vector<uint8_t> material;
+            std::vector<uint8_t> light;
+        };
+
+        // Bounding boxes of triangles first..last, relative to the model's first triangle
+        struct FaceGroups {
+            std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+            std::vector<uint16_t> first, last;
+        };
+
+        CollisionFile() {}
+
+        // Models are decoded several at a time on the worker threads
+        bool Load(std::span<const uint8_t> data);
+        bool Load(std::string const& path);
+        void Clear();
+
+        // The same models, same versions. Loading the result gives the same contents; the bytes
+        // can differ from the original file in padding, section order and unused surface fields.
+        std::vector<uint8_t> Write() const;
+
+        size_t GetNumModels() const { return models.size(); }
+        Model const& GetModel(size_t index) const { return models[index]; }
+        // Case insensitive, -1 if there's none
+        int32_t FindModel(std::string_view name) const;
+
+        Spheres const& GetSpheres() const { return spheres; }
+        Boxes const& GetBoxes() const { return boxes; }
+        Vertices const& GetVertices() const { return vertices; }
+        Triangles const& GetTriangles() const { return triangles; }
+        FaceGroups const& GetFaceGroups() const { return faceGroups; }
+        Vertices const& GetShadowVertices() const { return shadowVertices; }
+        Triangles const& GetShadowTriangles() const { return shadowTriangles; }
+
+        // CompressedVector (int16 x, y, z in 1/128 units) to separate float arrays, eight at a time with SSE2
+        static void DecompressVertices(void const* compressed, size_t count, float* x, float* y, float* z);
+        // Rounded to the nearest 1/128 and clamped to the int16 range
+        static void CompressVertices(float const* x, float const* y, float const* z, size_t count, int16_t* compressed);
+
+    private:
+        std::vector<Model> models;
+        Spheres spheres;
+        Boxes boxes;
+        Vertices vertices;
+        Triangles triangles;
+        FaceGroups faceGroups;
+        Vertices shadowVertices;
+        Triangles shadowTriangles;
+    };
+}
@@ -17,7 +17,10 @@
 #include <tuple>
 #include <functional>
 #include <string_view>
+#include <memory>
+#include <cstring>
 #include "Pattern.h"
+#include "EventProfiler.h"
 
 namespace plugin {
 
@@ -32,6 +35,16 @@ enum eEventPriority {
     PRIORITY_AFTER = 1
 };
 
+// Order of a subscriber within its before/after list. Higher runs first,
+// subscribers with the same order run in the order they were added.
+enum eEventOrder {
+    ORDER_LAST = -1000,
+    ORDER_LATE = -100,
+    ORDER_DEFAULT = 0,
+    ORDER_EARLY = 100,
+    ORDER_FIRST = 1000
+};
+
 // calling conventions
 struct CallingConventions {
     struct Cdecl {};
@@ -49,36 +62,58 @@ public:
 
     using CallbackType = typename SelectedArgPicker::CallbackType;
     using FnPtrType = typename SelectedArgPicker::FnPtrType;
-    using HookInfo = std::pair<CallbackType, unsigned int>;
-    using HookList = std::list<HookInfo>;
+
+    // Subscribers are kept in a contiguous array. Plain functions are called directly,
+    // everything else goes through a std::function kept aside.
+    struct HookInfo {
+        FnPtrType fn = nullptr;
+        std::unique_ptr<CallbackType> callback;
+        unsigned int id = 0;
+        int order = ORDER_DEFAULT;
+        bool removed = false;
+    };
+    using HookList = std::vector<HookInfo>;
 
     std::vector<injector::memory_pointer_tr> refAddr = {};
     uint32_t refAddrPos = 0;
+    // registered patterns of the hooked sites, they go in front of refAddr once they're looked up
+    std::vector<size_t> refPatterns;
 
-    void Add(HookList &hooks, CallbackType const &cb, unsigned int id) {
+    void Add(HookList &hooks, CallbackType const &cb, unsigned int id, int order) {
+        FnPtrType const *target = cb. template target<FnPtrType>();
         bool can_add = true;
         if (id == 0) {
-            FnPtrType const *target = cb. template target<FnPtrType>();
             if (target)
                 can_add = !HasFunctionPtr(hooks, *target);
         }
         else
             can_add = !HasFunctionId(hooks, id);
         if (can_add) {
+            HookInfo hook;
+            if (target)
+                hook.fn = *target;
+            else
+                hook.callback = std::make_unique<CallbackType>(cb);
+            hook.id = id;
+            hook.order = order;
+            // the list can't change while it's being walked, new subscribers join once the call is over
+            if (dispatchDepth > 0) {
+                (&hooks == &hooksBefore ? pendingBefore : pendingAfter).push_back(std::move(hook));
+                hasPending = true;
+            }
+            else
+                Insert(hooks, std::move(hook));
             Patch();
-            hooks.emplace_back(cb, id);
         }
     }
 
-    void AddBefore(CallbackType const &cb, unsigned int id) { Add(hooksBefore, cb, id); }
-    void AddAfter(CallbackType const &cb, unsigned int id) { Add(hooksAfter, cb, id); }
+    void AddBefore(CallbackType const &cb, unsigned int id, int order) { Add(hooksBefore, cb, id, order); }
+    void AddAfter(CallbackType const &cb, unsigned int id, int order) { Add(hooksAfter, cb, id, order); }
 
     void Remove(HookList &hooks, FnPtrType fn) {
-        auto end = std::remove_if(hooks.begin(), hooks.end(), [&fn](HookInfo &hook) {
-            FnPtrType *ptr = hook.first. template target<FnPtrType>();
-            return ptr && *ptr == fn;
+        RemoveIf(hooks, [&fn](HookInfo const &hook) {
+            return hook.fn && hook.fn == fn;
         });
-        hooks.erase(end, hooks.end());
     }
 
     void RemoveBefore(FnPtrType fn) { Remove(hooksBefore, fn); }
@@ -87,43 +122,206 @@ public:
     void RemoveById(HookList &hooks, unsigned int id) {
         if (id == 0)
             return;
-        auto end = std::remove_if(hooks.begin(), hooks.end(), [&id](HookInfo &hook) {
-            return hook.second == id;
+        RemoveIf(hooks, [&id](HookInfo const &hook) {
+            return hook.id == id;
         });
-        hooks.erase(end, hooks.end());
     }
 
     void RemoveBeforeById(unsigned int id) { RemoveById(hooksBefore, id); }
     void RemoveAfterById(unsigned int id) { RemoveById(hooksAfter, id); }
 
+    // Called from a before subscriber: the original function isn't called for this dispatch and
+    // the hooked call returns `ret` instead. Later before and all after subscribers still run.
+    // Does nothing from after subscribers or outside of the event.
+    void SkipOriginal(void *ret) {
+        if (currentCall && currentCall->inBefore) {
+            currentCall->skip = true;
+            currentCall->ret = ret;
+        }
+    }
+
+    // What the hooked call sites run: the before subscribers, the original function unless it's skipped,
+    // then the after subscribers. Tests call it directly on an event without addresses.
+    template<typename Func>
+    void *Call(Func &&func, Args... args) {
+        dispatchDepth++;
+        void* ret;
+        if (hooksBefore.empty() && hooksAfter.empty())
+            ret = func(std::forward<Args>(args)...);
+        else {
+            CallState call;
+            call.prev = currentCall;
+            currentCall = &call;
+            auto arg_tie = std::forward_as_tuple(std::forward<Args>(args)...);
+            Dispatch(hooksBefore, arg_tie);
+            call.inBefore = false;
+            if (call.skip)
+                ret = call.ret;
+            else {
+#ifdef PLUGIN_EVENT_PROFILER
+                EventProfiler::Sample sample(profilerEvent, EventProfiler::ORIGINAL_FUNCTION);
+#endif
+                ret = func(std::forward<Args>(args)...);
+            }
+            Dispatch(hooksAfter, arg_tie);
+            currentCall = call.prev;
+        }
+        if (--dispatchDepth == 0 && hasPending)
+            ApplyPending();
+        return ret;
+    }
+
+    bool IsOriginalSkipped() const {
+        return currentCall && currentCall->skip;
+    }
+
 private:
+    // state of one dispatch, lives on the stack of the hook so nested calls don't mix up
+    struct CallState {
+        CallState *prev = nullptr;
+        void *ret = nullptr;
+        bool inBefore = true;
+        bool skip = false;
+    };
+
+    // a hooked call site, kept so it can be put back to the original code while nobody listens
+    struct PatchedSite {
+        std::function<void()> restore;
+        std::function<void()> reinstall;
+        uintptr_t at = 0;
+        uint8_t code[sizeof(uintptr_t) > 5 ? sizeof(uintptr_t) : 5] = {};
+        size_t codeSize = 0;
+    };
+
     bool bPatched = false;
+    bool bInstalled = false;
     HookList hooksBefore;
     HookList hooksAfter;
+    HookList pendingBefore;
+    HookList pendingAfter;
+    bool hasPending = false;
+    unsigned int dispatchDepth = 0;
+    CallState *currentCall = nullptr;
+    std::vector<PatchedSite> sites;
+    // there without PLUGIN_EVENT_PROFILER too, the class has to be the same in every file of the plugin
+    uint32_t profilerEvent = 0;
 
     bool HasFunctionPtr(HookList &hooks, FnPtrType fn) {
-        for (auto &hook : hooks) {
-            FnPtrType const *ptr = hook.first. template target<FnPtrType>();
-            if (ptr && *ptr == fn)
-                return true;
+        HookList &pending = &hooks == &hooksBefore ? pendingBefore : pendingAfter;
+        for (HookList *list : { &hooks, &pending }) {
+            for (auto &hook : *list) {
+                if (!hook.removed && hook.fn && hook.fn == fn)
+                    return true;
+            }
         }
         return false;
     }
 
     bool HasFunctionId(HookList &hooks, unsigned int id) {
-        for (auto &hook : hooks) {
-            if (hook.second == id)
-                return true;
+        HookList &pending = &hooks == &hooksBefore ? pendingBefore : pendingAfter;
+        for (HookList *list : { &hooks, &pending }) {
+            for (auto &hook : *list) {
+                if (!hook.removed && hook.id == id)
+                    return true;
+            }
         }
         return false;
     }
 
+    template<typename Pred>
+    void RemoveIf(HookList &hooks, Pred pred) {
+        HookList &pending = &hooks == &hooksBefore ? pendingBefore : pendingAfter;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), pred), pending.end());
+        if (dispatchDepth > 0) {
+            // the subscriber may be the one running right now, only mark it
+            for (auto &hook : hooks) {
+                if (!hook.removed && pred(hook)) {
+                    hook.removed = true;
+                    hasPending = true;
+                }
+            }
+            return;
+        }
+        hooks.erase(std::remove_if(hooks.begin(), hooks.end(), pred), hooks.end());
+        UnpatchIfEmpty();
+    }
+
+    void ApplyPending() {
+        hasPending = false;
+        for (auto *list : { &hooksBefore, &hooksAfter }) {
+            list->erase(std::remove_if(list->begin(), list->end(), [](HookInfo const &hook) { return hook.removed; }), list->end());
+        }
+        for (auto &hook : pendingBefore)
+            Insert(hooksBefore, std::move(hook));
+        for (auto &hook : pendingAfter)
+            Insert(hooksAfter, std::move(hook));
+        pendingBefore.clear();
+        pendingAfter.clear();
+        // no unpatching from here, the hook is still running. An empty event stays on
+        // the cheap path until the next add/remove from outside of it.
+    }
+
+    // Keeps the list sorted by order, so dispatch is just a walk over it.
+    void Insert(HookList &hooks, HookInfo &&hook) {
+        auto it = std::find_if(hooks.begin(), hooks.end(), [&hook](HookInfo const &other) {
+            return other.order < hook.order;
+        });
+        hooks.insert(it, std::move(hook));
+    }
+
+    template<typename Tuple>
+    void Dispatch(HookList &hooks, Tuple &args) {
+        for (auto &hook : hooks) {
+            if (hook.removed)
+                continue;
+#ifdef PLUGIN_EVENT_PROFILER
+            EventProfiler::Sample sample(profilerEvent, hook.id ? hook.id :
+                hook.fn ? reinterpret_cast<uintptr_t>(hook.fn) : reinterpret_cast<uintptr_t>(hook.callback.get()));
+#endif
+            if (hook.fn)
+                SelectedArgPicker()(hook.fn, args);
+            else
+                SelectedArgPicker()(*hook.callback, args);
+        }
+    }
+
     void Patch() {
         if (bPatched == false) {
+            if (!refPatterns.empty()) {
+                std::vector<injector::memory_pointer_tr> found;
+                for (size_t index : refPatterns)
+                    found.push_back(plugin::pattern::GetAt(index, 0));
+                refAddr.insert(refAddr.begin(), found.begin(), found.end());
+                refPatterns.clear();
+            }
             refAddrPos = 0;
             bPatched = true;
+            bInstalled = true;
             PatchAll(RList());
         }
+        else if (bInstalled == false) {
+            bInstalled = true;
+            for (auto &site : sites) {
+                site.reinstall();
+                injector::ReadMemoryRaw(site.at, site.code, site.codeSize, true);
+            }
+        }
+    }
+
+    // Puts the original code back once the last subscriber is gone. Sites hooked again by
+    // someone else after us stay as they are, we'd throw their hook away otherwise.
+    void UnpatchIfEmpty() {
+        if (!bInstalled || !hooksBefore.empty() || !hooksAfter.empty() || !pendingBefore.empty() || !pendingAfter.empty())
+            return;
+        for (auto &site : sites) {
+            uint8_t code[sizeof(site.code)];
+            injector::ReadMemoryRaw(site.at, code, site.codeSize, true);
+            if (memcmp(code, site.code, site.codeSize) != 0)
+                return;
+        }
+        for (auto &site : sites)
+            site.restore();
+        bInstalled = false;
     }
 
     void PatchAll(RefList<>) {}
@@ -137,18 +335,23 @@ private:
                 std::conditional_t<RefType == H_JUMP, injector::scoped_jmp, injector::scoped_callback>>,
                 RefAddr, void* (Args...)>;
 
-            injector::make_static_hook_dyn<hook_type>([this](typename hook_type::func_type func, Args... args) {
-                auto arg_tie = std::forward_as_tuple(std::forward<Args>(args)...);
-                std::for_each(hooksBefore.begin(), hooksBefore.end(), [&](HookInfo& hook) {
-                    SelectedArgPicker()(hook.first, arg_tie);
-                });
-                void* ret = func(std::forward<Args>(args)...);
-                std::for_each(hooksAfter.begin(), hooksAfter.end(), [&](HookInfo& hook) {
-                    SelectedArgPicker()(hook.first, arg_tie);
-                });
-                return ret;
-            }, refAddr.size() > 0 ? refAddr.at(refAddrPos++).as_int() : 0);
-
+            auto dispatch = [this](typename hook_type::func_type func, Args... args) {
+                return Call(func, std::forward<Args>(args)...);
+            };
+
+            hook_type &hook = injector::make_static_hook_dyn<hook_type>(dispatch, refAddr.size() > 0 ? refAddr.at(refAddrPos++).as_int() : 0);
+
+            PatchedSite site;
+            site.restore = [&hook]() { hook.restore(); };
+            site.reinstall = [&hook, dispatch]() { hook.install(dispatch); };
+            site.at = GetGlobalAddress(hook.addr);
+            site.codeSize = RefType == H_CALLBACK ? sizeof(uintptr_t) : 5;
+            injector::ReadMemoryRaw(site.at, site.code, site.codeSize, true);
+#ifdef PLUGIN_EVENT_PROFILER
+            if (sites.empty())
+                profilerEvent = EventProfiler::RegisterEvent(site.at);
+#endif
+            sites.push_back(std::move(site));
         }
         PatchAll(RefList<MoreHooks...>());
     }
@@ -177,13 +380,13 @@ public:
     public:
         EventBefore(BaseEvent &p) : parent(p) {}
 
-        EventBefore& AddAtId(unsigned int id, CallbackType const &cb) {
-            parent.GetInstance().AddBefore(cb, id);
+        EventBefore& AddAtId(unsigned int id, CallbackType const &cb, int order = ORDER_DEFAULT) {
+            parent.GetInstance().AddBefore(cb, id, order);
             return *this;
         }
 
-        EventBefore& Add(CallbackType const &cb) {
-            return AddAtId(0, cb);
+        EventBefore& Add(CallbackType const &cb, int order = ORDER_DEFAULT) {
+            return AddAtId(0, cb, order);
         }
 
         EventBefore& Remove(FnPtrType fn) {
@@ -196,6 +399,13 @@ public:
             return *this;
         }
 
+        void SkipOriginal() { parent.SkipOriginal(); }
+
+        template<typename T>
+        void SkipOriginal(T ret) { parent.SkipOriginal(ret); }
+
+        bool IsOriginalSkipped() { return parent.IsOriginalSkipped(); }
+
         EventBefore& operator+=(CallbackType const &cb) { return Add(cb); }
         EventBefore& operator-=(FnPtrType fn) { return Remove(fn); }
     } before;
@@ -205,13 +415,13 @@ public:
     public:
         EventAfter(BaseEvent &p) : parent(p) {}
 
-        EventAfter& AddAtId(unsigned int id, CallbackType const &cb) {
-            parent.GetInstance().AddAfter(cb, id);
+        EventAfter& AddAtId(unsigned int id, CallbackType const &cb, int order = ORDER_DEFAULT) {
+            parent.GetInstance().AddAfter(cb, id, order);
             return *this;
         }
 
-        EventAfter& Add(CallbackType const &cb) {
-            return AddAtId(0, cb);
+        EventAfter& Add(CallbackType const &cb, int order = ORDER_DEFAULT) {
+            return AddAtId(0, cb, order);
         }
 
         EventAfter& Remove(FnPtrType fn) {
@@ -228,9 +438,10 @@ public:
         EventAfter& operator-=(FnPtrType fn) { return Remove(fn); }
     } after;
 
+    // The patterns are looked up when the event is patched, together with all others registered until then
     BaseEvent(std::vector<std::string_view> const& bytes) : before(*this), after(*this) {
         for (auto& it : bytes) {
-            SetRefAddr(plugin::pattern::Get(it, 0));
+            GetInstance().refPatterns.push_back(plugin::pattern::Register(it));
         }
     }
 
@@ -250,16 +461,16 @@ public:
         AddAtId(id_after, cb_after, PRIORITY_AFTER);
     }
 
-    BaseEvent& AddAtId(unsigned int id, CallbackType const &cb, int priority = Priority) {
+    BaseEvent& AddAtId(unsigned int id, CallbackType const &cb, int priority = Priority, int order = ORDER_DEFAULT) {
         if (priority == PRIORITY_BEFORE)
-            GetInstance().AddBefore(cb, id);
+            GetInstance().AddBefore(cb, id, order);
         else
-            GetInstance().AddAfter(cb, id);
+            GetInstance().AddAfter(cb, id, order);
         return *this;
     }
 
-    BaseEvent& Add(CallbackType const &cb, int priority = Priority) {
-        return AddAtId(0, cb, priority);
+    BaseEvent& Add(CallbackType const &cb, int priority = Priority, int order = ORDER_DEFAULT) {
+        return AddAtId(0, cb, priority, order);
     }
 
     BaseEvent& Remove(FnPtrType fn, int priority = Priority) {
@@ -278,13 +489,13 @@ public:
         return *this;
     }
 
-    BaseEvent& AddBeforeAtId(unsigned int id, CallbackType const &cb) {
-        GetInstance().AddBefore(cb, id);
+    BaseEvent& AddBeforeAtId(unsigned int id, CallbackType const &cb, int order = ORDER_DEFAULT) {
+        GetInstance().AddBefore(cb, id, order);
         return *this;
     }
 
-    BaseEvent& AddBefore(CallbackType const &cb) {
-        return AddBeforeAtId(0, cb);
+    BaseEvent& AddBefore(CallbackType const &cb, int order = ORDER_DEFAULT) {
+        return AddBeforeAtId(0, cb, order);
     }
 
     BaseEvent& RemoveBefore(FnPtrType fn) {
@@ -297,13 +508,13 @@ public:
         return *this;
     }
 
-    BaseEvent& AddAfterAtId(unsigned int id, CallbackType const &cb) {
-        GetInstance().AddAfter(cb, id);
+    BaseEvent& AddAfterAtId(unsigned int id, CallbackType const &cb, int order = ORDER_DEFAULT) {
+        GetInstance().AddAfter(cb, id, order);
         return *this;
     }
 
-    BaseEvent& AddAfter(CallbackType const &cb) {
-        return AddAfterAtId(0, cb);
+    BaseEvent& AddAfter(CallbackType const &cb, int order = ORDER_DEFAULT) {
+        return AddAfterAtId(0, cb, order);
     }
 
     BaseEvent& RemoveAfter(FnPtrType fn) {
@@ -320,6 +531,26 @@ public:
         GetInstance().refAddr.push_back(at);
     }
 
+    // To be called from a before subscriber, suppresses the original call of the current dispatch.
+    void SkipOriginal() {
+        GetInstance().SkipOriginal(nullptr);
+    }
+
+    // Same, with the value the hooked call returns instead. It travels through the register the
+    // hook returns with, so it has to fit into a pointer.
+    template<typename T>
+    void SkipOriginal(T ret) {
+        static_assert(sizeof(T) <= sizeof(void*) && std::is_trivially_copyable<T>::value,
+            "SkipOriginal: return value has to fit into a register");
+        void *raw = nullptr;
+        memcpy(&raw, &ret, sizeof(T));
+        GetInstance().SkipOriginal(raw);
+    }
+
+    bool IsOriginalSkipped() {
+        return GetInstance().IsOriginalSkipped();
+    }
+
     BaseEvent& operator+=(CallbackType const &cb) { return Add(cb); }
     BaseEvent& operator-=(FnPtrType fn) { return Remove(fn); }
 };
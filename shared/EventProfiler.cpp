@@ -0,0 +1,261 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "EventProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+using namespace plugin;
+
+namespace {
+
+struct SampleData {
+    uint32_t event;
+    uintptr_t subscriber;
+    uint64_t ticks;
+};
+
+// Written by its thread only, read by whoever holds the profiler lock.
+struct ThreadRing {
+    static constexpr uint32_t SIZE = 4096;
+    SampleData samples[SIZE];
+    std::atomic<uint32_t> head{ 0 };
+    std::atomic<uint32_t> tail{ 0 };
+};
+
+struct ProfilerState {
+    std::mutex lock;
+    std::vector<ThreadRing*> rings;
+    std::vector<std::string> events;
+    std::map<std::pair<uint32_t, uintptr_t>, EventProfiler::Histogram> stats;
+    bool calibrated = false;
+    uint64_t calibrationTicks = 0;
+    std::chrono::steady_clock::time_point calibrationTime;
+};
+
+// leaked on purpose, samples may still come in from other threads during shutdown
+ProfilerState& State() {
+    static ProfilerState* state = new ProfilerState;
+    return *state;
+}
+
+void Drain(ProfilerState& state, ThreadRing& ring) {
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        SampleData const& sample = ring.samples[tail % ThreadRing::SIZE];
+        state.stats[{ sample.event, sample.subscriber }].Add(sample.ticks);
+    }
+    ring.tail.store(tail, std::memory_order_release);
+}
+
+ThreadRing& LocalRing() {
+    thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        ring = new ThreadRing;
+        auto& state = State();
+        std::lock_guard<std::mutex> guard(state.lock);
+        state.rings.push_back(ring);
+    }
+    return *ring;
+}
+
+void StartCalibration(ProfilerState& state) {
+    if (!state.calibrated) {
+        state.calibrated = true;
+        state.calibrationTicks = EventProfiler::Now();
+        state.calibrationTime = std::chrono::steady_clock::now();
+    }
+}
+
+double TicksPerMs(ProfilerState& state) {
+    using namespace std::chrono;
+    double ms = duration<double, std::milli>(steady_clock::now() - state.calibrationTime).count();
+    double ticks = static_cast<double>(EventProfiler::Now() - state.calibrationTicks);
+    return ticks > 0.0 && ms > 0.0 ? ticks / ms : 1.0;
+}
+
+std::string SubscriberName(uintptr_t subscriber) {
+    if (subscriber == EventProfiler::ORIGINAL_FUNCTION)
+        return "original";
+    char buf[32];
+    snprintf(buf, sizeof(buf), "0x%llX", static_cast<unsigned long long>(subscriber));
+    return buf;
+}
+
+std::string EscapeJson(std::string const& str) {
+    std::string out;
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20)
+            continue;
+        out += c;
+    }
+    return out;
+}
+
+}
+
+uint32_t EventProfiler::Histogram::Bucket(uint64_t ticks) {
+    if (ticks < 4)
+        return static_cast<uint32_t>(ticks);
+    uint32_t msb = 63;
+    while (!(ticks >> msb))
+        msb--;
+    return msb * 4 + static_cast<uint32_t>((ticks >> (msb - 2)) & 3);
+}
+
+uint64_t EventProfiler::Histogram::BucketTop(uint32_t bucket) {
+    if (bucket < 4)
+        return bucket;
+    uint32_t msb = bucket / 4;
+    uint64_t step = uint64_t(1) << (msb - 2);
+    return (uint64_t(1) << msb) + step * (bucket % 4 + 1) - 1;
+}
+
+void EventProfiler::Histogram::Add(uint64_t ticks) {
+    calls++;
+    total += ticks;
+    min = std::min(min, ticks);
+    max = std::max(max, ticks);
+    counts[Bucket(ticks)]++;
+}
+
+uint64_t EventProfiler::Histogram::Percentile(double p) const {
+    uint64_t wanted = static_cast<uint64_t>(calls * p + 0.999999);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < SIZE; i++) {
+        seen += counts[i];
+        if (seen >= wanted)
+            return std::min(BucketTop(i), max);
+    }
+    return max;
+}
+
+void EventProfiler::SetEnabled(bool enable) {
+    if (enable) {
+        auto& state = State();
+        std::lock_guard<std::mutex> guard(state.lock);
+        StartCalibration(state);
+    }
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+uint32_t EventProfiler::RegisterEvent(std::string const& name) {
+    auto& state = State();
+    std::lock_guard<std::mutex> guard(state.lock);
+    auto it = std::find(state.events.begin(), state.events.end(), name);
+    if (it != state.events.end())
+        return static_cast<uint32_t>(it - state.events.begin());
+    state.events.push_back(name);
+    return static_cast<uint32_t>(state.events.size() - 1);
+}
+
+uint32_t EventProfiler::RegisterEvent(uintptr_t address) {
+    char name[32];
+    snprintf(name, sizeof(name), "0x%llX", static_cast<unsigned long long>(address));
+    return RegisterEvent(std::string(name));
+}
+
+void EventProfiler::Record(uint32_t event, uintptr_t subscriber, uint64_t ticks) {
+    ThreadRing& ring = LocalRing();
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) == ThreadRing::SIZE) {
+        auto& state = State();
+        std::lock_guard<std::mutex> guard(state.lock);
+        Drain(state, ring);
+    }
+    ring.samples[head % ThreadRing::SIZE] = { event, subscriber, ticks };
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<EventProfiler::Stats> EventProfiler::Snapshot() {
+    using namespace std::chrono;
+    auto& state = State();
+    steady_clock::time_point calibrated;
+    {
+        std::lock_guard<std::mutex> guard(state.lock);
+        StartCalibration(state);
+        calibrated = state.calibrationTime + milliseconds(10);
+    }
+    // the longer since calibration started the better, but take at least 10 ms. Threads whose
+    // ring fills up meanwhile need the lock to empty it.
+    std::this_thread::sleep_until(calibrated);
+
+    std::lock_guard<std::mutex> guard(state.lock);
+    for (ThreadRing* ring : state.rings)
+        Drain(state, *ring);
+
+    std::vector<Stats> result;
+    if (state.stats.empty())
+        return result;
+
+    double ticksPerMs = TicksPerMs(state);
+    result.reserve(state.stats.size());
+    for (auto const& it : state.stats) {
+        Histogram const& agg = it.second;
+        Stats stats;
+        stats.event = it.first.first < state.events.size() ? state.events[it.first.first] : std::to_string(it.first.first);
+        stats.subscriber = it.first.second;
+        stats.calls = agg.calls;
+        stats.totalMs = agg.total / ticksPerMs;
+        stats.minMs = agg.min / ticksPerMs;
+        stats.maxMs = agg.max / ticksPerMs;
+        stats.p99Ms = agg.Percentile(0.99) / ticksPerMs;
+        result.push_back(std::move(stats));
+    }
+    std::sort(result.begin(), result.end(), [](Stats const& a, Stats const& b) { return a.totalMs > b.totalMs; });
+    return result;
+}
+
+void EventProfiler::Reset() {
+    auto& state = State();
+    std::lock_guard<std::mutex> guard(state.lock);
+    for (ThreadRing* ring : state.rings)
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+    state.stats.clear();
+}
+
+std::string EventProfiler::ToCsv(std::vector<Stats> const& stats) {
+    std::string out = "event,subscriber,calls,total_ms,min_ms,max_ms,p99_ms\n";
+    char buf[160];
+    for (auto const& s : stats) {
+        snprintf(buf, sizeof(buf), ",%llu,%.6f,%.6f,%.6f,%.6f\n",
+            static_cast<unsigned long long>(s.calls), s.totalMs, s.minMs, s.maxMs, s.p99Ms);
+        out += s.event + "," + SubscriberName(s.subscriber) + buf;
+    }
+    return out;
+}
+
+std::string EventProfiler::ToJson(std::vector<Stats> const& stats) {
+    std::string out = "[";
+    char buf[200];
+    for (size_t i = 0; i < stats.size(); i++) {
+        auto const& s = stats[i];
+        snprintf(buf, sizeof(buf), "\",\"calls\":%llu,\"total_ms\":%.6f,\"min_ms\":%.6f,\"max_ms\":%.6f,\"p99_ms\":%.6f}",
+            static_cast<unsigned long long>(s.calls), s.totalMs, s.minMs, s.maxMs, s.p99Ms);
+        out += i ? ",\n" : "\n";
+        out += "{\"event\":\"" + EscapeJson(s.event) + "\",\"subscriber\":\"" + SubscriberName(s.subscriber) + buf;
+    }
+    out += "\n]\n";
+    return out;
+}
+
+bool EventProfiler::Dump(std::string const& path, bool json) {
+    auto stats = Snapshot();
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        return false;
+    file << (json ? ToJson(stats) : ToCsv(stats));
+    return file.good();
+}
@@ -0,0 +1,111 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace plugin {
+
+// Timing of event subscribers. Compiled into event dispatch only when PLUGIN_EVENT_PROFILER
+// is defined for the plugin, and recording only happens while enabled.
+// Samples go to a ring buffer of the recording thread and are folded into the stats on
+// Snapshot() or when the ring fills up.
+class EventProfiler {
+public:
+    // pseudo subscriber ids
+    static constexpr uintptr_t ORIGINAL_FUNCTION = ~uintptr_t(0);
+
+    struct Stats {
+        std::string event;
+        uintptr_t subscriber; // subscriber id, function address or ORIGINAL_FUNCTION
+        uint64_t calls;
+        double totalMs;
+        double minMs;
+        double maxMs;
+        double p99Ms;
+    };
+
+    static inline uint64_t Now() {
+#if defined(_MSC_VER) || defined(__i386__) || defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static inline bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enable);
+
+    // returns the id samples of the event are recorded under
+    static uint32_t RegisterEvent(std::string const& name);
+    // events are named after the address of their first hooked site
+    static uint32_t RegisterEvent(uintptr_t address);
+
+    static void Record(uint32_t event, uintptr_t subscriber, uint64_t ticks);
+
+    // Waits until the tick rate has been measured for at least 10 ms, without holding the lock
+    // samples are folded in under
+    static std::vector<Stats> Snapshot();
+    static void Reset();
+
+    static std::string ToCsv(std::vector<Stats> const& stats);
+    static std::string ToJson(std::vector<Stats> const& stats);
+    static bool Dump(std::string const& path, bool json = false);
+
+    // Durations of one event subscriber. Buckets are powers of two split into 4, so a percentile
+    // is off by at most a quarter of its value.
+    class Histogram {
+    public:
+        static constexpr uint32_t SIZE = 64 * 4;
+
+        uint64_t calls = 0;
+        uint64_t total = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+
+        static uint32_t Bucket(uint64_t ticks);
+        // largest duration counted in the bucket
+        static uint64_t BucketTop(uint32_t bucket);
+
+        void Add(uint64_t ticks);
+        // upper bound of the bucket holding the p-th fraction of the calls, never above max
+        uint64_t Percentile(double p) const;
+
+    private:
+        uint32_t counts[SIZE] = {};
+    };
+
+    // measures one call, does nothing while the profiler is disabled
+    class Sample {
+        uint32_t event;
+        uintptr_t subscriber;
+        uint64_t start;
+    public:
+        inline Sample(uint32_t e, uintptr_t s) : event(e), subscriber(s), start(IsEnabled() ? Now() : 0) {}
+        inline ~Sample() {
+            if (start)
+                Record(event, subscriber, Now() - start);
+        }
+        Sample(Sample const&) = delete;
+        Sample& operator=(Sample const&) = delete;
+    };
+
+private:
+    static inline std::atomic<bool> enabled{ false };
+};
+
+}
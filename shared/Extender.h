@@ -7,6 +7,9 @@
 #pragma once
 
 #include <vector>
+#include <new>
+#include <cstring>
+#include <type_traits>
 
 namespace plugin {
     template <typename T>
@@ -53,4 +56,139 @@ namespace plugin {
                 i->OnDestructor(object);
         }
     };
+
+    // Storage of extended data, blocks are built from the object if the type takes it.
+    // Default storage: every block is allocated on its own when its object is constructed.
+    template <typename T, typename E>
+    class ExtendedDataHeap {
+        T **blocks = nullptr;
+    public:
+        void Allocate(unsigned int count) {
+            blocks = new T*[count]();
+        }
+
+        void Free() {
+            delete[] blocks;
+            blocks = nullptr;
+        }
+
+        void Construct(unsigned int index, E *object) {
+            if constexpr (std::is_constructible<T, E *>::value)
+                blocks[index] = new T(object);
+            else
+                blocks[index] = new T();
+        }
+
+        void Destroy(unsigned int index) {
+            delete blocks[index];
+            blocks[index] = nullptr;
+        }
+
+        T &Get(unsigned int index) {
+            return *blocks[index];
+        }
+    };
+
+    // All blocks in one array indexed by pool slot, constructed and destroyed in place.
+    // Get is a single load and nothing is allocated when objects spawn. Several extended
+    // data of small types (one per hot field) give a structure-of-arrays layout.
+    template <typename T, typename E>
+    class ExtendedDataSlots {
+        T *blocks = nullptr;
+    public:
+        void Allocate(unsigned int count) {
+            blocks = static_cast<T *>(operator new[](sizeof(T) * count, std::align_val_t(alignof(T))));
+        }
+
+        void Free() {
+            operator delete[](blocks, std::align_val_t(alignof(T)));
+            blocks = nullptr;
+        }
+
+        void Construct(unsigned int index, E *object) {
+            if constexpr (std::is_constructible<T, E *>::value)
+                new (&blocks[index]) T(object);
+            else
+                new (&blocks[index]) T();
+        }
+
+        void Destroy(unsigned int index) {
+            blocks[index].~T();
+        }
+
+        T &Get(unsigned int index) {
+            return blocks[index];
+        }
+    };
+
+    // Blocks of one extended data, with the pool id (tPoolObjectFlags::nId) of the object each
+    // block was made for, so data of an object that's gone can be told apart.
+    template <typename T, typename E, template <typename, typename> class Storage>
+    class ExtendedDataBlocks {
+        static constexpr unsigned char NO_OBJECT = 0x80; // pool ids have 7 bits
+
+        Storage<T, E> storage;
+        unsigned char *ids = nullptr;
+        unsigned int numBlocks = 0;
+    public:
+        ~ExtendedDataBlocks() {
+            Free();
+        }
+
+        void Allocate(unsigned int count) {
+            Free();
+            storage.Allocate(count);
+            ids = new unsigned char[count];
+            memset(ids, NO_OBJECT, count);
+            numBlocks = count;
+        }
+
+        void Free() {
+            if (!ids)
+                return;
+            for (unsigned int i = 0; i < numBlocks; i++)
+                Destroy(i);
+            storage.Free();
+            delete[] ids;
+            ids = nullptr;
+            numBlocks = 0;
+        }
+
+        void Construct(unsigned int index, unsigned char id, E *object) {
+            Destroy(index);
+            storage.Construct(index, object);
+            ids[index] = id;
+        }
+
+        void Destroy(unsigned int index) {
+            if (ids[index] != NO_OBJECT) {
+                storage.Destroy(index);
+                ids[index] = NO_OBJECT;
+            }
+        }
+
+        bool IsConstructed(unsigned int index) {
+            return index < numBlocks && ids[index] != NO_OBJECT;
+        }
+
+        T &Get(unsigned int index) {
+            return storage.Get(index);
+        }
+
+        T *Find(unsigned int index, unsigned char id) {
+            return index < numBlocks && ids[index] == id ? &storage.Get(index) : nullptr;
+        }
+
+        // By the object's handle (CPool::GetRef), which keeps the id the object had: nullptr once
+        // the object is gone, also when its slot was taken by another object since.
+        T *FindRef(int ref) {
+            if (ref < 0 || (ref & NO_OBJECT))
+                return nullptr;
+            return Find(static_cast<unsigned int>(ref >> 8), static_cast<unsigned char>(ref & 0xFF));
+        }
+
+        unsigned int Size() {
+            return numBlocks;
+        }
+    };
 };
@@ -5,6 +5,7 @@
     Do not delete this comment block. Respect others' work!
 */
 #include "GameVersion.h"
+#include "AddressTable.h"
 #include "Patch.h"
 #include "Base.h"
 
@@ -61,7 +62,11 @@ unsigned int _NOINLINE_ detect_game_id() {
 }
 
 unsigned int _NOINLINE_ plugin::GetGameVersion() {
-    static unsigned int gameId = detect_game_id();
+    static unsigned int gameId = [] {
+        unsigned int id = detect_game_id();
+        AddressTable::SetGameVersion(id);
+        return id;
+    }();
     return gameId;
 }
 
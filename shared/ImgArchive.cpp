@@ -0,0 +1,288 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "ImgArchive.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace plugin {
+    namespace {
+        struct KeyTable {
+            uint32_t table[256];
+
+            KeyTable() {
+                for (uint32_t i = 0; i < 256; i++) {
+                    uint32_t crc = i;
+                    for (int32_t b = 0; b < 8; b++)
+                        crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+                    table[i] = crc;
+                }
+            }
+        };
+
+        char ToUpper(char c) {
+            return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+        }
+
+        std::string_view NameOf(ImgArchive::Entry const& entry) {
+            return std::string_view(entry.name, strnlen(entry.name, sizeof(entry.name)));
+        }
+
+        bool EqualsNoCase(std::string_view a, std::string_view b) {
+            if (a.size() != b.size())
+                return false;
+            for (size_t i = 0; i < a.size(); i++) {
+                if (ToUpper(a[i]) != ToUpper(b[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        // a name that stays in the directory it's written to: one component, nothing Windows would
+        // take as a device or strip off
+        bool IsPlainFileName(std::string_view name) {
+            if (name.empty() || name == "." || name == ".." || name.back() == '.' || name.back() == ' ')
+                return false;
+            for (char c : name) {
+                if ((uint8_t)c < 0x20 || strchr("<>:\"/\\|?*", c))
+                    return false;
+            }
+            std::string_view stem = name.substr(0, name.find('.'));
+            for (const char* device : { "CON", "PRN", "AUX", "NUL" }) {
+                if (EqualsNoCase(stem, device))
+                    return false;
+            }
+            if (stem.size() == 4 && (EqualsNoCase(stem.substr(0, 3), "COM") || EqualsNoCase(stem.substr(0, 3), "LPT"))
+                && stem[3] >= '0' && stem[3] <= '9')
+                return false;
+            return true;
+        }
+    }
+
+    uint32_t ImgArchive::GetKey(std::string_view name) {
+        static const KeyTable keyTable;
+        uint32_t key = 0xFFFFFFFF;
+        for (char c : name)
+            key = keyTable.table[(key ^ (uint8_t)ToUpper(c)) & 0xFF] ^ (key >> 8);
+        return key;
+    }
+
+    bool ImgArchive::Open(std::string const& path) {
+        Close();
+        if (!img.OpenForViews(path))
+            return false;
+
+        MappedFile::View header = img.MapView(0, 8);
+        if (!header.Empty() && memcmp(header.Data(), "VER2", 4) == 0) {
+            uint32_t count;
+            memcpy(&count, header.Data() + 4, sizeof(count));
+            if ((uint64_t)count * 32 > img.Size() - 8) {
+                Close();
+                return false;
+            }
+            version = 2;
+            if (count != 0) {
+                MappedFile::View dir = img.MapView(8, (size_t)count * 32);
+                if (dir.Empty()) {
+                    Close();
+                    return false;
+                }
+                ReadDirectory(dir.Data(), count, 32);
+            }
+        }
+        else {
+            std::filesystem::path dirPath(path);
+            dirPath.replace_extension(".dir");
+            MappedFile dir;
+            if (!dir.Open(dirPath.string())) {
+                Close();
+                return false;
+            }
+            version = 1;
+            ReadDirectory(dir.Data(), dir.Size() / 32, 32);
+        }
+
+        BuildIndex();
+        return true;
+    }
+
+    void ImgArchive::Close() {
+        img.Close();
+        version = 0;
+        entries.clear();
+        keys.clear();
+        slots.clear();
+    }
+
+    void ImgArchive::ReadDirectory(uint8_t const* dir, size_t count, size_t entrySize) {
+        entries.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            uint8_t const* p = dir + i * entrySize;
+            Entry& entry = entries[i];
+            memcpy(&entry.offset, p, 4);
+            if (version == 2) {
+                // streaming size, the size in archive is only set by some tools
+                uint16_t streamingSize, sizeInArchive;
+                memcpy(&streamingSize, p + 4, 2);
+                memcpy(&sizeInArchive, p + 6, 2);
+                entry.size = streamingSize ? streamingSize : sizeInArchive;
+            }
+            else
+                memcpy(&entry.size, p + 4, 4);
+            memcpy(entry.name, p + 8, sizeof(entry.name));
+            entry.name[sizeof(entry.name) - 1] = '\0';
+        }
+    }
+
+    void ImgArchive::BuildIndex() {
+        size_t capacity = 16;
+        while (capacity < entries.size() * 2)
+            capacity *= 2;
+        slots.assign(capacity, EMPTY);
+
+        keys.resize(entries.size());
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < entries.size(); i++) {
+            std::string_view name = NameOf(entries[i]);
+            uint32_t key = GetKey(name);
+            keys[i] = key;
+            size_t slot = key & mask;
+            bool duplicate = false;
+            while (slots[slot] != EMPTY) {
+                int32_t other = slots[slot];
+                if (keys[other] == key && EqualsNoCase(NameOf(entries[other]), name)) {
+                    duplicate = true;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+            if (!duplicate)
+                slots[slot] = (int32_t)i;
+        }
+    }
+
+    int32_t ImgArchive::Find(std::string_view name) const {
+        if (slots.empty())
+            return NOT_FOUND;
+
+        uint32_t key = GetKey(name);
+        size_t mask = slots.size() - 1;
+        for (size_t slot = key & mask; slots[slot] != EMPTY; slot = (slot + 1) & mask) {
+            int32_t index = slots[slot];
+            if (keys[index] == key && EqualsNoCase(NameOf(entries[index]), name))
+                return index;
+        }
+        return NOT_FOUND;
+    }
+
+    bool ImgArchive::IsInside(Entry const& entry) const {
+        return ((uint64_t)entry.offset + entry.size) * SECTOR_SIZE <= img.Size();
+    }
+
+    MappedFile::View ImgArchive::GetData(size_t index) const {
+        Entry const& entry = entries[index];
+        if (!IsInside(entry))
+            return {};
+        return img.MapView((uint64_t)entry.offset * SECTOR_SIZE, (size_t)entry.size * SECTOR_SIZE);
+    }
+
+    MappedFile::View ImgArchive::GetData(std::string_view name) const {
+        int32_t index = Find(name);
+        if (index == NOT_FOUND)
+            return {};
+        return GetData(index);
+    }
+
+    void ImgArchive::ForEachParallel(std::function<void(size_t index, std::span<const uint8_t> data)> const& fn) const {
+        // a few hundred entries per call, so small ones don't cost a handoff each. Entries usually
+        // follow each other in the archive, then a chunk is mapped with one view of a few MB.
+        constexpr size_t CHUNK_SIZE = 256;
+        constexpr uint64_t MAX_CHUNK_VIEW = 64 * 1024 * 1024;
+        size_t chunks = (entries.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        ParallelFor(chunks, [this, &fn](size_t chunk) {
+            size_t first = chunk * CHUNK_SIZE;
+            size_t end = (std::min)(entries.size(), first + CHUNK_SIZE);
+            uint64_t begin = UINT64_MAX, last = 0;
+            for (size_t i = first; i < end; i++) {
+                Entry const& entry = entries[i];
+                if (entry.size != 0 && IsInside(entry)) {
+                    begin = (std::min)(begin, (uint64_t)entry.offset);
+                    last = (std::max)(last, (uint64_t)entry.offset + entry.size);
+                }
+            }
+
+            MappedFile::View view;
+            if (begin < last && (last - begin) * SECTOR_SIZE <= MAX_CHUNK_VIEW)
+                view = img.MapView(begin * SECTOR_SIZE, (size_t)((last - begin) * SECTOR_SIZE));
+            for (size_t i = first; i < end; i++) {
+                Entry const& entry = entries[i];
+                if (!view.Empty() && entry.size != 0 && IsInside(entry))
+                    fn(i, view.Span().subspan((size_t)((entry.offset - begin) * SECTOR_SIZE), (size_t)entry.size * SECTOR_SIZE));
+                else
+                    fn(i, GetData(i));
+            }
+        });
+    }
+
+    std::vector<size_t> ImgArchive::Verify() const {
+        std::vector<size_t> bad;
+        std::vector<size_t> order;
+        order.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            Entry const& entry = entries[i];
+            if (entry.name[0] == '\0' || !IsInside(entry))
+                bad.push_back(i);
+            else if (entry.size != 0)
+                order.push_back(i);
+        }
+
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return entries[a].offset < entries[b].offset;
+        });
+        uint64_t end = 0;
+        size_t last = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            Entry const& entry = entries[order[i]];
+            if (i > 0 && entry.offset < end) {
+                bad.push_back(order[i]);
+                bad.push_back(last);
+            }
+            if ((uint64_t)entry.offset + entry.size > end) {
+                end = (uint64_t)entry.offset + entry.size;
+                last = order[i];
+            }
+        }
+
+        std::sort(bad.begin(), bad.end());
+        bad.erase(std::unique(bad.begin(), bad.end()), bad.end());
+        return bad;
+    }
+
+    size_t ImgArchive::ExtractAll(std::string const& directory) const {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        std::atomic<size_t> written(0);
+        ForEachParallel([&](size_t index, std::span<const uint8_t> data) {
+            if (data.empty() && entries[index].size != 0)
+                return;
+            // only the first entry of a name is written, so no two threads write the same file
+            std::string_view name = NameOf(entries[index]);
+            if (!IsPlainFileName(name) || Find(name) != (int32_t)index)
+                return;
+
+            std::ofstream file(std::filesystem::path(directory) / std::string(name), std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<char const*>(data.data()), data.size());
+            if (file)
+                written++;
+        });
+        return written;
+    }
+}
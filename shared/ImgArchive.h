@@ -0,0 +1,77 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <functional>
+#include "MappedFile.h"
+
+namespace plugin {
+    // IMG archive read from a mapped file, without the game: VER2 (SA) or version 1 (III/VC, the
+    // directory is in a .dir file next to the .img). Entries are found through a hash index keyed
+    // like CKeyGen::GetUppercaseKey. The archive is never mapped as a whole (gta3.img doesn't fit
+    // the address space of the game reliably), the data of entries is mapped as it's asked for.
+    // http://www.gtamodding.com/wiki/IMG_archive
+    class ImgArchive {
+    public:
+        static constexpr uint32_t SECTOR_SIZE = 2048;
+        static constexpr int32_t NOT_FOUND = -1;
+
+        // Offset and size in sectors
+        struct Entry {
+            uint32_t offset;
+            uint32_t size;
+            char name[24];
+        };
+
+        ImgArchive() {}
+
+        // Opens path.img, for version 1 archives path.dir is read as well
+        bool Open(std::string const& path);
+        void Close();
+        bool IsOpen() const { return img.IsOpen(); }
+        // 1 or 2
+        uint32_t GetVersion() const { return version; }
+
+        size_t GetNumEntries() const { return entries.size(); }
+        Entry const& GetEntry(size_t index) const { return entries[index]; }
+        // Case insensitive, the first entry of a name if there are more. NOT_FOUND if there's none.
+        int32_t Find(std::string_view name) const;
+        // Data of the entry mapped for as long as the view is kept, empty if it isn't inside the archive
+        MappedFile::View GetData(size_t index) const;
+        MappedFile::View GetData(std::string_view name) const;
+
+        // Calls fn for every entry, chunks of entries are handed to ParallelFor
+        void ForEachParallel(std::function<void(size_t index, std::span<const uint8_t> data)> const& fn) const;
+        // Entries that aren't inside the archive, have no name or share sectors with another
+        std::vector<size_t> Verify() const;
+        // Writes every entry that's inside the archive to directory, returns how many were written.
+        // Names that aren't a plain file name (paths, drive letters, device names) are skipped, as are
+        // entries named like an earlier one, which Find never returns.
+        size_t ExtractAll(std::string const& directory) const;
+
+        // CKeyGen::GetUppercaseKey
+        static uint32_t GetKey(std::string_view name);
+
+    private:
+        static constexpr int32_t EMPTY = -1;
+
+        MappedFile img;
+        uint32_t version = 0;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> keys;
+        std::vector<int32_t> slots; // entry indices, power of two, at most half full
+
+        void ReadDirectory(uint8_t const* dir, size_t count, size_t entrySize);
+        bool IsInside(Entry const& entry) const;
+        void BuildIndex();
+    };
+}
@@ -0,0 +1,390 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "MapDataFile.h"
+#include "ThreadPool.h"
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#ifdef GTASA
+#include "CFileObjectInstance.h"
+#include "CFileCarGenerator.h"
+#endif
+
+namespace plugin {
+    namespace {
+        // text sections are split into pieces of about this many bytes for the threads
+        constexpr size_t CHUNK_SIZE = 64 * 1024;
+        constexpr size_t BINARY_HEADER_SIZE = 0x4C;
+        constexpr size_t MAX_FIELDS = 16;
+
+        enum eSection {
+            SECTION_NONE,
+            SECTION_SKIPPED,
+            SECTION_INST,
+            SECTION_CARS,
+            SECTION_OBJS,
+            SECTION_TOBJ,
+            SECTION_ANIM
+        };
+
+        struct Chunk {
+            eSection section;
+            size_t begin, end;
+            uint32_t firstLine;
+        };
+
+        struct ChunkResult {
+            std::vector<MapDataFile::Instance> instances;
+            std::vector<std::string_view> instanceNames;
+            std::vector<MapDataFile::CarGenerator> carGenerators;
+            std::vector<MapDataFile::ObjectDefinition> objects;
+            std::vector<uint32_t> badLines;
+        };
+
+        bool IsSeparator(char c) {
+            return c == ' ' || c == '\t' || c == ',' || c == '\r';
+        }
+
+        bool EqualsNoCase(std::string_view a, char const* b) {
+            size_t length = strlen(b);
+            if (a.size() != length)
+                return false;
+            for (size_t i = 0; i < length; i++) {
+                char c = a[i] >= 'A' && a[i] <= 'Z' ? a[i] - 'A' + 'a' : a[i];
+                if (c != b[i])
+                    return false;
+            }
+            return true;
+        }
+
+        // The first field of a line, enough to find the sections
+        std::string_view FirstField(std::string_view line) {
+            size_t i = 0;
+            while (i < line.size() && IsSeparator(line[i]))
+                i++;
+            size_t start = i;
+            while (i < line.size() && !IsSeparator(line[i]) && line[i] != '#')
+                i++;
+            return line.substr(start, i - start);
+        }
+
+        // Fields split by commas and spaces, a # comments out the rest of the line
+        struct Fields {
+            std::string_view field[MAX_FIELDS];
+            size_t count = 0;
+
+            explicit Fields(std::string_view line) {
+                size_t i = 0;
+                while (i < line.size()) {
+                    while (i < line.size() && IsSeparator(line[i]))
+                        i++;
+                    if (i == line.size() || line[i] == '#')
+                        break;
+                    size_t start = i;
+                    while (i < line.size() && !IsSeparator(line[i]) && line[i] != '#')
+                        i++;
+                    if (count == MAX_FIELDS) {
+                        count++; // too many for any section, the line is bad
+                        break;
+                    }
+                    field[count++] = line.substr(start, i - start);
+                }
+            }
+        };
+
+        template<typename T>
+        bool Parse(std::string_view text, T& value) {
+            return std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+        }
+
+        template<typename T>
+        bool ParseAll(Fields const& fields, size_t first, T* values, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                if (!Parse(fields.field[first + i], values[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        eSection GetSection(std::string_view name, MapDataFile::eFileType type) {
+            if (type == MapDataFile::FILE_IPL) {
+                if (EqualsNoCase(name, "inst"))
+                    return SECTION_INST;
+                if (EqualsNoCase(name, "cars"))
+                    return SECTION_CARS;
+            }
+            else {
+                if (EqualsNoCase(name, "objs"))
+                    return SECTION_OBJS;
+                if (EqualsNoCase(name, "tobj"))
+                    return SECTION_TOBJ;
+                if (EqualsNoCase(name, "anim"))
+                    return SECTION_ANIM;
+            }
+            return SECTION_SKIPPED;
+        }
+
+        // SA: id, model, interior, position, rotation, lod
+        // III: id, model, position, scale, rotation. VC: id, model, interior, position, scale, rotation
+        bool ParseInstance(Fields const& f, MapDataFile::Instance& instance) {
+            instance.flags = 0;
+            instance.lod = -1;
+            if (!Parse(f.field[0], instance.modelId))
+                return false;
+            switch (f.count) {
+            case 11:
+                return Parse(f.field[2], instance.flags) && ParseAll(f, 3, instance.position, 3) &&
+                    ParseAll(f, 6, instance.rotation, 4) && Parse(f.field[10], instance.lod);
+            case 12:
+                return ParseAll(f, 2, instance.position, 3) && ParseAll(f, 8, instance.rotation, 4);
+            case 13:
+                return Parse(f.field[2], instance.flags) && ParseAll(f, 3, instance.position, 3) &&
+                    ParseAll(f, 9, instance.rotation, 4);
+            }
+            return false;
+        }
+
+        bool ParseCarGenerator(Fields const& f, MapDataFile::CarGenerator& car) {
+            int32_t values[8];
+            if (f.count != 12 || !ParseAll(f, 0, car.position, 3) || !Parse(f.field[3], car.angle) || !ParseAll(f, 4, values, 8))
+                return false;
+            car.modelId = values[0];
+            car.color1 = values[1];
+            car.color2 = values[2];
+            car.flags = values[3];
+            car.alarm = values[4];
+            car.doorLock = values[5];
+            car.minDelay = values[6];
+            car.maxDelay = values[7];
+            return true;
+        }
+
+        // objs: id, model, txd, [mesh count,] draw distance(s), flags
+        // tobj: the same, then time on and time off
+        // anim: id, model, txd, animation, draw distance, flags
+        bool ParseObject(Fields const& f, eSection section, MapDataFile::ObjectDefinition& object) {
+            object = {};
+            size_t count = f.count;
+            if (section == SECTION_TOBJ) {
+                if (count < 7 || !Parse(f.field[count - 2], object.timeOn) || !Parse(f.field[count - 1], object.timeOff))
+                    return false;
+                count -= 2;
+                object.type = MapDataFile::OBJECT_TOBJ;
+            }
+            else if (section == SECTION_ANIM) {
+                if (count != 6)
+                    return false;
+                object.type = MapDataFile::OBJECT_ANIM;
+                object.animation = f.field[3];
+            }
+            else
+                object.type = MapDataFile::OBJECT_OBJS;
+            if (count < 5 || count > 8)
+                return false;
+
+            object.model = f.field[1];
+            object.txd = f.field[2];
+            size_t drawDistance = (section == SECTION_ANIM || count > 5) ? 4 : 3;
+            return Parse(f.field[0], object.id) && Parse(f.field[drawDistance], object.drawDistance) &&
+                Parse(f.field[count - 1], object.flags);
+        }
+
+        void ParseChunk(uint8_t const* data, Chunk const& chunk, ChunkResult& result) {
+            uint32_t line = chunk.firstLine;
+            size_t pos = chunk.begin;
+            while (pos < chunk.end) {
+                void const* found = memchr(data + pos, '\n', chunk.end - pos);
+                size_t end = found ? (size_t)(reinterpret_cast<uint8_t const*>(found) - data) : chunk.end;
+                Fields fields(std::string_view(reinterpret_cast<char const*>(data + pos), end - pos));
+
+                if (fields.count > 0) {
+                    bool parsed = false;
+                    if (fields.count <= MAX_FIELDS) {
+                        if (chunk.section == SECTION_INST) {
+                            MapDataFile::Instance instance;
+                            parsed = ParseInstance(fields, instance);
+                            if (parsed) {
+                                result.instances.push_back(instance);
+                                result.instanceNames.push_back(fields.field[1]);
+                            }
+                        }
+                        else if (chunk.section == SECTION_CARS) {
+                            MapDataFile::CarGenerator car;
+                            parsed = ParseCarGenerator(fields, car);
+                            if (parsed)
+                                result.carGenerators.push_back(car);
+                        }
+                        else {
+                            MapDataFile::ObjectDefinition object;
+                            parsed = ParseObject(fields, chunk.section, object);
+                            if (parsed)
+                                result.objects.push_back(object);
+                        }
+                    }
+                    if (!parsed)
+                        result.badLines.push_back(line);
+                }
+                pos = end + 1;
+                line++;
+            }
+        }
+
+        template<typename T>
+        void Append(std::vector<T>& to, std::vector<T> const& from) {
+            to.insert(to.end(), from.begin(), from.end());
+        }
+    }
+
+    bool MapDataFile::Load(std::string const& path) {
+        Clear();
+        if (!file.Open(path))
+            return false;
+
+        if (file.Size() >= 4 && memcmp(file.Data(), "bnry", 4) == 0)
+            type = FILE_BINARY_IPL;
+        else {
+            std::string extension = std::filesystem::path(path).extension().string();
+            type = EqualsNoCase(extension, ".ide") ? FILE_IDE : FILE_IPL;
+        }
+        bool loaded = type == FILE_BINARY_IPL ? LoadBinary() : LoadText();
+        if (!loaded)
+            Clear();
+        return loaded;
+    }
+
+    bool MapDataFile::Load(std::string const& path, eFileType fileType) {
+        Clear();
+        if (!file.Open(path))
+            return false;
+
+        type = fileType;
+        bool loaded = type == FILE_BINARY_IPL ? LoadBinary() : LoadText();
+        if (!loaded)
+            Clear();
+        return loaded;
+    }
+
+    void MapDataFile::Clear() {
+        file.Close();
+        type = FILE_IPL;
+        instances = {};
+        carGenerators = {};
+        instanceStorage.clear();
+        carGeneratorStorage.clear();
+        instanceNames.clear();
+        objects.clear();
+        badLines.clear();
+    }
+
+    bool MapDataFile::LoadText() {
+        uint8_t const* data = file.Data();
+        size_t size = file.Size();
+
+        // sections and where they're cut into chunks, a quick look at the first word of each line
+        std::vector<Chunk> chunks;
+        eSection section = SECTION_NONE;
+        Chunk chunk = {};
+        auto close = [&](size_t end) {
+            chunk.end = end;
+            if (section != SECTION_SKIPPED && chunk.end > chunk.begin)
+                chunks.push_back(chunk);
+        };
+
+        uint32_t line = 1;
+        size_t pos = 0;
+        while (pos < size) {
+            void const* found = memchr(data + pos, '\n', size - pos);
+            size_t end = found ? (size_t)(reinterpret_cast<uint8_t const*>(found) - data) : size;
+            std::string_view first = FirstField(std::string_view(reinterpret_cast<char const*>(data + pos), end - pos));
+
+            if (section == SECTION_NONE) {
+                if (!first.empty()) {
+                    section = GetSection(first, type);
+                    chunk = { section, end + 1, end + 1, line + 1 };
+                }
+            }
+            else if (EqualsNoCase(first, "end")) {
+                close(pos);
+                section = SECTION_NONE;
+            }
+            else if (pos - chunk.begin >= CHUNK_SIZE) {
+                close(pos);
+                chunk = { section, pos, pos, line };
+            }
+            pos = end + 1;
+            line++;
+        }
+        if (section != SECTION_NONE)
+            close(size);
+
+        std::vector<ChunkResult> results(chunks.size());
+        ParallelFor(chunks.size(), [&](size_t i) {
+            ParseChunk(data, chunks[i], results[i]);
+        });
+
+        // in file order, lod indices count instances from the start of the file
+        for (auto& result : results) {
+            Append(instanceStorage, result.instances);
+            Append(instanceNames, result.instanceNames);
+            Append(carGeneratorStorage, result.carGenerators);
+            Append(objects, result.objects);
+            Append(badLines, result.badLines);
+        }
+        instances = instanceStorage;
+        carGenerators = carGeneratorStorage;
+        return true;
+    }
+
+    bool MapDataFile::LoadBinary() {
+        uint8_t const* data = file.Data();
+        size_t size = file.Size();
+        if (size < BINARY_HEADER_SIZE || memcmp(data, "bnry", 4) != 0)
+            return false;
+
+        int32_t numInstances, numCarGenerators;
+        uint32_t instancesOffset, carGeneratorsOffset;
+        memcpy(&numInstances, data + 0x04, 4);
+        memcpy(&numCarGenerators, data + 0x14, 4);
+        memcpy(&instancesOffset, data + 0x1C, 4);
+        memcpy(&carGeneratorsOffset, data + 0x3C, 4);
+        if (numInstances < 0 || numCarGenerators < 0 ||
+            (uint64_t)instancesOffset + (uint64_t)numInstances * sizeof(Instance) > size ||
+            (uint64_t)carGeneratorsOffset + (uint64_t)numCarGenerators * sizeof(CarGenerator) > size)
+            return false;
+
+        // the mapping starts on a page, so the arrays can be used in place unless the offsets are odd
+        auto place = [data](uint32_t offset, int32_t count, auto& span, auto& storage) {
+            using T = typename std::remove_reference_t<decltype(storage)>::value_type;
+            if (offset % alignof(T) == 0)
+                span = { reinterpret_cast<T const*>(data + offset), (size_t)count };
+            else {
+                storage.resize(count);
+                if (count)
+                    memcpy(storage.data(), data + offset, count * sizeof(T));
+                span = storage;
+            }
+        };
+        place(instancesOffset, numInstances, instances, instanceStorage);
+        place(carGeneratorsOffset, numCarGenerators, carGenerators, carGeneratorStorage);
+        return true;
+    }
+
+#ifdef GTASA
+    static_assert(sizeof(CFileObjectInstance) == sizeof(MapDataFile::Instance), "Instance must match CFileObjectInstance");
+    static_assert(sizeof(CFileCarGenerator) == sizeof(MapDataFile::CarGenerator), "CarGenerator must match CFileCarGenerator");
+
+    CFileObjectInstance const* MapDataFile::GetFileObjectInstances() const {
+        return reinterpret_cast<CFileObjectInstance const*>(instances.data());
+    }
+
+    CFileCarGenerator const* MapDataFile::GetFileCarGenerators() const {
+        return reinterpret_cast<CFileCarGenerator const*>(carGenerators.data());
+    }
+#endif
+}
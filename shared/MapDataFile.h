@@ -0,0 +1,117 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include "MappedFile.h"
+
+#ifdef GTASA
+class CFileObjectInstance;
+class CFileCarGenerator;
+#endif
+
+namespace plugin {
+    // Map data file read without the game: a text IPL or IDE, or a binary ("bnry") IPL. The file is mapped,
+    // text sections are split into chunks of lines that are parsed at the same time, and binary instances
+    // and car generators are used straight from the mapping.
+    // Read sections: inst and cars of IPLs, objs, tobj and anim of IDEs. Others are skipped.
+    // http://www.gtamodding.com/wiki/Item_Placement http://www.gtamodding.com/wiki/Item_Definition
+    class MapDataFile {
+    public:
+        enum eFileType {
+            FILE_IPL,
+            FILE_IDE,
+            FILE_BINARY_IPL
+        };
+
+        enum eObjectType : uint8_t {
+            OBJECT_OBJS,
+            OBJECT_TOBJ,
+            OBJECT_ANIM
+        };
+
+        // Same layout as CFileObjectInstance and the binary IPL instances
+        struct Instance {
+            float position[3];
+            float rotation[4]; // x, y, z, w
+            int32_t modelId;
+            uint32_t flags;    // interior in the lowest 8 bits
+            int32_t lod;       // -1 if there's none
+        };
+
+        // Same layout as CFileCarGenerator and the binary IPL car generators
+        struct CarGenerator {
+            float position[3];
+            float angle;
+            int32_t modelId;
+            int32_t color1;
+            int32_t color2;
+            int32_t flags;
+            int32_t alarm;
+            int32_t doorLock;
+            int32_t minDelay;
+            int32_t maxDelay;
+        };
+
+        // Names are views into the mapped file
+        struct ObjectDefinition {
+            int32_t id;
+            eObjectType type;
+            std::string_view model;
+            std::string_view txd;
+            std::string_view animation; // anim only
+            float drawDistance;
+            uint32_t flags;
+            int32_t timeOn;  // tobj only
+            int32_t timeOff; // tobj only
+        };
+
+        MapDataFile() {}
+
+        // The type is from the first bytes and the extension, .ide or else IPL
+        bool Load(std::string const& path);
+        bool Load(std::string const& path, eFileType type);
+        void Clear();
+        bool IsLoaded() const { return file.IsOpen(); }
+        eFileType GetType() const { return type; }
+
+        // Text IPLs: III (12 fields, the scale isn't kept), VC (13) and SA (11) lines. Binary ones
+        // point into the mapping.
+        std::span<const Instance> GetInstances() const { return instances; }
+        // Model names of text instances, views into the mapped file. Empty for binary IPLs.
+        std::vector<std::string_view> const& GetInstanceNames() const { return instanceNames; }
+        std::span<const CarGenerator> GetCarGenerators() const { return carGenerators; }
+        std::vector<ObjectDefinition> const& GetObjectDefinitions() const { return objects; }
+
+        // Lines of read sections that couldn't be parsed, from 1
+        std::vector<uint32_t> const& GetBadLines() const { return badLines; }
+
+#ifdef GTASA
+        CFileObjectInstance const* GetFileObjectInstances() const;
+        CFileCarGenerator const* GetFileCarGenerators() const;
+#endif
+
+    private:
+        MappedFile file;
+        eFileType type = FILE_IPL;
+        std::span<const Instance> instances;
+        std::span<const CarGenerator> carGenerators;
+        // text files and binary ones that aren't aligned, the spans point here then
+        std::vector<Instance> instanceStorage;
+        std::vector<CarGenerator> carGeneratorStorage;
+        std::vector<std::string_view> instanceNames;
+        std::vector<ObjectDefinition> objects;
+        std::vector<uint32_t> badLines;
+
+        bool LoadText();
+        bool LoadBinary();
+    };
+}
@@ -0,0 +1,184 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "MappedFile.h"
+#include <cstdint>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace plugin {
+    namespace {
+        // views start at multiples of this
+        size_t GetGranularity() {
+#ifdef _WIN32
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+#else
+            return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+        }
+    }
+
+    MappedFile::View::View(View&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile::View& MappedFile::View::operator=(View&& other) noexcept {
+        if (this != &other) {
+            Unmap();
+            std::swap(base, other.base);
+            std::swap(baseSize, other.baseSize);
+            std::swap(data, other.data);
+            std::swap(size, other.size);
+        }
+        return *this;
+    }
+
+    void MappedFile::View::Unmap() {
+        if (base) {
+#ifdef _WIN32
+            UnmapViewOfFile(base);
+#else
+            munmap(base, baseSize);
+#endif
+        }
+        base = nullptr;
+        baseSize = 0;
+        data = nullptr;
+        size = 0;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            std::swap(whole, other.whole);
+            std::swap(size, other.size);
+            std::swap(opened, other.opened);
+#ifdef _WIN32
+            std::swap(mapping, other.mapping);
+#else
+            std::swap(file, other.file);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(std::string const& path) {
+        if (!OpenForViews(path))
+            return false;
+        if (size == 0)
+            return true;
+        whole = MapView(0, size);
+        if (whole.Empty()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool MappedFile::OpenForViews(std::string const& path) {
+        Close();
+        if (!OpenFile(path))
+            return false;
+        opened = true;
+        return true;
+    }
+
+    bool MappedFile::OpenFile(std::string const& path) {
+#ifdef _WIN32
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(handle, &fileSize) || (uint64_t)fileSize.QuadPart > SIZE_MAX) {
+            CloseHandle(handle);
+            return false;
+        }
+        size = (size_t)fileSize.QuadPart;
+        if (size == 0) {
+            CloseHandle(handle);
+            return true;
+        }
+
+        // the mapping keeps the file open by itself
+        mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(handle);
+        if (!mapping) {
+            size = 0;
+            return false;
+        }
+#else
+        file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || (uint64_t)info.st_size > SIZE_MAX) {
+            close(file);
+            file = -1;
+            return false;
+        }
+        size = (size_t)info.st_size;
+#endif
+        return true;
+    }
+
+    MappedFile::View MappedFile::MapView(uint64_t offset, size_t viewSize) const {
+        View view;
+        if (!opened || viewSize == 0 || offset > size || viewSize > size - offset)
+            return view;
+
+        static const size_t granularity = GetGranularity();
+        uint64_t aligned = offset - offset % granularity;
+        size_t lead = (size_t)(offset - aligned);
+        if (viewSize > SIZE_MAX - lead)
+            return view;
+
+#ifdef _WIN32
+        void* base = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(aligned >> 32), (DWORD)aligned, lead + viewSize);
+        if (!base)
+            return view;
+#else
+        void* base = mmap(nullptr, lead + viewSize, PROT_READ, MAP_PRIVATE, file, (off_t)aligned);
+        if (base == MAP_FAILED)
+            return view;
+#endif
+        view.base = base;
+        view.baseSize = lead + viewSize;
+        view.data = static_cast<uint8_t const*>(base) + lead;
+        view.size = viewSize;
+        return view;
+    }
+
+    void MappedFile::Close() {
+        whole.Unmap();
+#ifdef _WIN32
+        if (mapping)
+            CloseHandle(mapping);
+        mapping = nullptr;
+#else
+        if (file >= 0)
+            close(file);
+        file = -1;
+#endif
+        size = 0;
+        opened = false;
+    }
+}
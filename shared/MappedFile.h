@@ -0,0 +1,81 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <span>
+
+namespace plugin {
+    // Read-only file mapped into memory: the whole file in one view (Open), or only the parts asked
+    // for (OpenForViews and MapView), for files too large for the address space of a 32-bit process
+    class MappedFile {
+    public:
+        // Part of a file mapped on its own, unmapped when destroyed. The MappedFile can be closed first.
+        class View {
+        public:
+            View() {}
+            ~View() {
+                Unmap();
+            }
+
+            View(View const&) = delete;
+            View& operator=(View const&) = delete;
+            View(View&& other) noexcept;
+            View& operator=(View&& other) noexcept;
+
+            uint8_t const* Data() const { return data; }
+            size_t Size() const { return size; }
+            bool Empty() const { return size == 0; }
+            std::span<const uint8_t> Span() const { return std::span<const uint8_t>(data, size); }
+            operator std::span<const uint8_t>() const { return Span(); }
+
+        private:
+            friend class MappedFile;
+
+            void* base = nullptr; // as mapped, from an offset aligned to the allocation granularity
+            size_t baseSize = 0;
+            uint8_t const* data = nullptr;
+            size_t size = 0;
+
+            void Unmap();
+        };
+
+        MappedFile() {}
+        ~MappedFile() {
+            Close();
+        }
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool Open(std::string const& path);
+        // Maps nothing yet, Data() stays null
+        bool OpenForViews(std::string const& path);
+        void Close();
+
+        bool IsOpen() const { return opened; }
+        uint8_t const* Data() const { return whole.Data(); }
+        size_t Size() const { return size; }
+        // size bytes from offset, empty if that isn't inside the file or can't be mapped
+        View MapView(uint64_t offset, size_t size) const;
+
+    private:
+        View whole;
+        size_t size = 0;
+        bool opened = false; // empty files have nothing to map
+#ifdef _WIN32
+        void* mapping = nullptr;
+#else
+        int file = -1; // kept open for views
+#endif
+
+        bool OpenFile(std::string const& path);
+    };
+}
@@ -11,6 +11,7 @@
 #include <sys/stat.h>
 #include <random>
 #include <limits>
+#include "Random.h"
 
 #ifdef _WIN32
 extern "C" {
@@ -38,21 +39,10 @@ namespace plugin {
 #endif
     }
 
+    // Integers in [min, max], floating point in [min, max), from the thread's generator in Random.h
     template<typename T = int32_t>
     static T RandomNumberInRange(T min, T max) {
-        static_assert(std::is_arithmetic<T>::value, "Type T must be numeric");
-
-        std::random_device rd;
-        std::mt19937 gen(rd());
-
-        if constexpr (std::is_integral<T>::value) {
-            std::uniform_int_distribution<T> dis(min, max);
-            return dis(gen);
-        }
-        else {
-            std::uniform_real_distribution<T> dis(min, max);
-            return dis(gen);
-        }
+        return random::InRange<T>(min, max);
     }
 
     template<typename T = int32_t>
@@ -6,6 +6,46 @@
 */
 #include "Patch.h"
 
+namespace {
+
+class VirtualMemoryProtection : public plugin::MemoryProtection {
+public:
+    size_t GetPageSize() override {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+    }
+
+    bool Query(uintptr_t address, uint32_t &protection) override {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (!VirtualQuery(reinterpret_cast<void *>(address), &mbi, sizeof(mbi)) || mbi.State != MEM_COMMIT)
+            return false;
+        protection = mbi.Protect;
+        return true;
+    }
+
+    bool Unprotect(uintptr_t address, size_t size) override {
+        DWORD old;
+        return VirtualProtect(reinterpret_cast<void *>(address), size, PAGE_EXECUTE_READWRITE, &old) != FALSE;
+    }
+
+    bool Protect(uintptr_t address, size_t size, uint32_t protection) override {
+        DWORD old;
+        return VirtualProtect(reinterpret_cast<void *>(address), size, protection, &old) != FALSE;
+    }
+
+    void FlushInstructionCache(uintptr_t address, size_t size) override {
+        ::FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<void *>(address), size);
+    }
+};
+
+}
+
+plugin::MemoryProtection &plugin::patch::GetMemoryProtection() {
+    static VirtualMemoryProtection protection;
+    return protection;
+}
+
 void plugin::patch::NopRestore(uintptr_t address, bool vp) {
     if (m_NopBytesMap == nullptr) {
         m_NopBytesMap = std::make_unique<std::unordered_map<uintptr_t, std::vector<uint8_t>>>();
@@ -11,6 +11,7 @@
 #include "../injector/assembly.hpp"
 #include "../injector/injector.hpp"
 #include "DynAddress.h"
+#include "PatchTransaction.h"
 #include <vector>
 #include <memory>
 
@@ -21,6 +22,11 @@ public:
     static inline std::unique_ptr<std::unordered_map<uintptr_t, std::vector<uint8_t>>> m_NopBytesMap = nullptr;
 
 public:
+    class Transaction;
+
+    // VirtualProtect based protection used by patch::Transaction
+    static MemoryProtection &GetMemoryProtection();
+
     static void NopRestore(uintptr_t address, bool vp = true);
     static void Nop(uintptr_t address, size_t size, bool vp = true);
     static void RedirectCall(uintptr_t address, injector::memory_pointer_raw func, bool vp = true);
@@ -153,6 +159,56 @@ public:
     }
 };
 
+// Patches queued and applied at once with one protection change per range of pages, see
+// PatchTransaction. Addresses are the same as for the other patch functions.
+class patch::Transaction : public PatchTransaction {
+public:
+    Transaction() : PatchTransaction(patch::GetMemoryProtection()) {}
+
+    template <typename T>
+    Transaction &Set(uintptr_t address, T value) {
+        Write(GetGlobalAddress(address), value);
+        return *this;
+    }
+
+    Transaction &SetRaw(uintptr_t address, void const *value, size_t size) {
+        WriteRaw(GetGlobalAddress(address), value, size);
+        return *this;
+    }
+
+    Transaction &SetPointer(uintptr_t address, injector::memory_pointer_raw value) {
+        Write<void *>(GetGlobalAddress(address), value.get());
+        return *this;
+    }
+
+    Transaction &Nop(uintptr_t address, size_t size) {
+        Fill(GetGlobalAddress(address), 0x90, size);
+        return *this;
+    }
+
+    Transaction &RedirectCall(uintptr_t address, injector::memory_pointer_raw func) {
+        Branch(0xE8, GetGlobalAddress(address), func);
+        return *this;
+    }
+
+    Transaction &RedirectJump(uintptr_t address, injector::memory_pointer_raw func) {
+        Branch(0xE9, GetGlobalAddress(address), func);
+        return *this;
+    }
+
+private:
+    void Branch(uint8_t opcode, uintptr_t at, injector::memory_pointer_raw dest) {
+#if !(defined (_M_IX86) || defined (_X86_))
+        dest = plugin::MakeTrampoline(at, dest.get());
+#endif
+        uint8_t code[5];
+        code[0] = opcode;
+        int32_t offset = static_cast<int32_t>(dest.as_int() - (at + 5));
+        memcpy(&code[1], &offset, sizeof(offset));
+        WriteRaw(at, code, sizeof(code));
+    }
+};
+
 }
 
 #define _override(index, classname, func) \
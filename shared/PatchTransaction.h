@@ -0,0 +1,225 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace plugin {
+
+// Page protection of the running process, behind an interface so the patching logic
+// doesn't depend on the OS. patch::Transaction uses VirtualProtect (see Patch.cpp).
+class MemoryProtection {
+public:
+    virtual ~MemoryProtection() = default;
+
+    virtual size_t GetPageSize() = 0;
+    // Current protection of the page holding address
+    virtual bool Query(uintptr_t address, uint32_t &protection) = 0;
+    // Makes the range writable (and executable, code is patched too)
+    virtual bool Unprotect(uintptr_t address, size_t size) = 0;
+    virtual bool Protect(uintptr_t address, size_t size, uint32_t protection) = 0;
+    virtual void FlushInstructionCache(uintptr_t address, size_t size) = 0;
+};
+
+// Writes queued in memory and applied together. The pages they touch are grouped into ranges
+// of equal protection, so every range is unprotected and protected again only once, and the
+// instruction cache is flushed once for the whole batch.
+// The bytes a write replaces are kept: a failing Commit puts everything back, and Rollback
+// undoes a committed batch. Writes queued after a Commit are applied by the next one and
+// rolled back together with the earlier ones. Addresses are absolute.
+class PatchTransaction {
+public:
+    explicit PatchTransaction(MemoryProtection &protection) : protection(protection) {}
+
+    PatchTransaction(PatchTransaction const &) = delete;
+    PatchTransaction &operator=(PatchTransaction const &) = delete;
+
+    void WriteRaw(uintptr_t address, void const *data, size_t size) {
+        if (size == 0)
+            return;
+        Entry entry;
+        entry.address = address;
+        entry.bytes.assign(static_cast<uint8_t const *>(data), static_cast<uint8_t const *>(data) + size);
+        writes.push_back(std::move(entry));
+        committed = false;
+    }
+
+    template <typename T>
+    void Write(uintptr_t address, T value) {
+        WriteRaw(address, &value, sizeof(T));
+    }
+
+    void Fill(uintptr_t address, uint8_t value, size_t size) {
+        std::vector<uint8_t> bytes(size, value);
+        WriteRaw(address, bytes.data(), size);
+    }
+
+    // Applies the writes queued since the last Commit. On failure false is returned and the bytes they
+    // replaced are put back, writes of earlier commits stay applied. If the pages can't be made writable
+    // again for that, the new bytes stay in memory: the writes then count as applied (see GetNumApplied)
+    // and a later Rollback undoes them.
+    bool Commit() {
+        if (committed)
+            return true;
+        size_t first = applied, last = writes.size();
+        std::vector<Range> ranges;
+        if (!Unprotect(ranges, first, last))
+            return false;
+        for (size_t i = first; i < last; i++) {
+            // saved right before writing, so overlapping writes are undone in the right order
+            Entry &write = writes[i];
+            write.original.resize(write.bytes.size());
+            memcpy(write.original.data(), reinterpret_cast<void *>(write.address), write.bytes.size());
+            memcpy(reinterpret_cast<void *>(write.address), write.bytes.data(), write.bytes.size());
+        }
+        if (!Protect(ranges)) {
+            // some ranges may be protected again already
+            bool writable = true;
+            for (auto &range : ranges) {
+                if (!protection.Unprotect(range.begin, range.end - range.begin))
+                    writable = false;
+            }
+            if (writable)
+                RestoreOriginals(first, last);
+            Protect(ranges);
+            Flush(first, last);
+            if (!writable)
+                applied = last;
+            return false;
+        }
+        Flush(first, last);
+        applied = last;
+        committed = true;
+        return true;
+    }
+
+    // Puts back the bytes all committed writes replaced, queued ones stay queued
+    bool Rollback() {
+        if (applied == 0) {
+            committed = false;
+            return true;
+        }
+        std::vector<Range> ranges;
+        if (!Unprotect(ranges, 0, applied))
+            return false;
+        RestoreOriginals(0, applied);
+        bool ok = Protect(ranges);
+        Flush(0, applied);
+        applied = 0;
+        committed = false;
+        return ok;
+    }
+
+    // Drops the queued writes, committed ones can't be rolled back after that
+    void Clear() {
+        writes.clear();
+        applied = 0;
+        committed = false;
+    }
+
+    bool IsCommitted() const {
+        return committed;
+    }
+
+    size_t GetNumWrites() const {
+        return writes.size();
+    }
+
+    // Writes that are in memory, the first ones in the order they were queued
+    size_t GetNumApplied() const {
+        return applied;
+    }
+
+private:
+    struct Entry {
+        uintptr_t address = 0;
+        std::vector<uint8_t> bytes;
+        std::vector<uint8_t> original;
+    };
+
+    struct Range {
+        uintptr_t begin = 0;
+        uintptr_t end = 0;
+        uint32_t protection = 0;
+    };
+
+    MemoryProtection &protection;
+    std::vector<Entry> writes;
+    size_t applied = 0;     // writes[0, applied) are in memory
+    bool committed = false; // and nothing was queued since
+
+    void RestoreOriginals(size_t first, size_t last) {
+        for (size_t i = last; i-- > first;) {
+            Entry &write = writes[i];
+            if (!write.original.empty())
+                memcpy(reinterpret_cast<void *>(write.address), write.original.data(), write.original.size());
+        }
+    }
+
+    // Pages touched by writes[first, last), adjacent pages of the same protection merged into one range
+    bool CollectRanges(std::vector<Range> &ranges, size_t first, size_t last) {
+        size_t pageSize = protection.GetPageSize();
+        std::vector<uintptr_t> pages;
+        for (size_t i = first; i < last; i++) {
+            Entry &write = writes[i];
+            uintptr_t firstPage = write.address / pageSize * pageSize;
+            uintptr_t lastPage = (write.address + write.bytes.size() - 1) / pageSize * pageSize;
+            for (uintptr_t page = firstPage; page <= lastPage; page += pageSize)
+                pages.push_back(page);
+        }
+        std::sort(pages.begin(), pages.end());
+        pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+        for (uintptr_t page : pages) {
+            uint32_t current;
+            if (!protection.Query(page, current))
+                return false;
+            if (!ranges.empty() && ranges.back().end == page && ranges.back().protection == current)
+                ranges.back().end += pageSize;
+            else
+                ranges.push_back({ page, page + pageSize, current });
+        }
+        return true;
+    }
+
+    bool Unprotect(std::vector<Range> &ranges, size_t first, size_t last) {
+        if (!CollectRanges(ranges, first, last))
+            return false;
+        for (size_t i = 0; i < ranges.size(); i++) {
+            if (!protection.Unprotect(ranges[i].begin, ranges[i].end - ranges[i].begin)) {
+                ranges.resize(i);
+                Protect(ranges);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Protect(std::vector<Range> const &ranges) {
+        bool ok = true;
+        for (auto &range : ranges) {
+            if (!protection.Protect(range.begin, range.end - range.begin, range.protection))
+                ok = false;
+        }
+        return ok;
+    }
+
+    void Flush(size_t first, size_t last) {
+        if (first >= last)
+            return;
+        uintptr_t begin = UINTPTR_MAX, end = 0;
+        for (size_t i = first; i < last; i++) {
+            begin = std::min(begin, writes[i].address);
+            end = std::max(end, writes[i].address + writes[i].bytes.size());
+        }
+        protection.FlushInstructionCache(begin, end - begin);
+    }
+};
+
+}
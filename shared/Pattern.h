@@ -11,34 +11,91 @@
 #include "../injector/injector.hpp"
 #include "../hooking/Hooking.Patterns.h"
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
 
 namespace plugin {
+    // Patterns of the executable are registered first and looked up together: the first lookup scans for
+    // every pattern registered until then in one pattern_batch pass, instead of one pass per pattern.
+    // gpattern / gpatternaddr / gpatternt register their pattern while the plugin is loaded, the events
+    // when they're constructed. Patterns registered after a batch are scanned by the next one.
     class pattern {
     private:
-        static inline std::unique_ptr<std::unordered_map<std::string_view, uintptr_t>> patternMap;
+        struct entry {
+            std::string_view bytes;
+            uintptr_t address; // first match in the process, 0 until it's found
+        };
+
+        // pattern text -> index in registry, the text has to stay alive (it's a literal everywhere)
+        static inline std::unique_ptr<std::unordered_map<std::string_view, size_t>> patternMap;
+        static inline std::unique_ptr<std::vector<entry>> registry;
+        // registry[firstPending...] haven't been scanned for yet
+        static inline size_t firstPending = 0;
         static inline std::unique_ptr<std::unordered_map<std::string_view, uintptr_t>> modulePatternMap;
 
+        // Address of the first match in the process
+        static inline uintptr_t Find(size_t index) {
+            if ((*registry)[index].address)
+                return (*registry)[index].address;
+            if (index >= firstPending)
+                Resolve();
+            else {
+                // scanned before without a match, the code may not have been unpacked yet
+                auto p = hook::pattern((*registry)[index].bytes);
+                (*registry)[index].address = p.empty() ? 0x0 : (uintptr_t)p.get_first(0);
+            }
+            return (*registry)[index].address;
+        }
+
     public:
-        static inline uintptr_t Get(std::string_view const& bytes, int32_t offset = 0) {
+        // Index of the pattern for GetAt / GetGlobalAt / ReadAt, it's scanned for with the next batch
+        static inline size_t Register(std::string_view const& bytes) {
             if (!patternMap) {
-                patternMap = std::make_unique<std::unordered_map<std::string_view, uintptr_t>>();
+                patternMap = std::make_unique<std::unordered_map<std::string_view, size_t>>();
                 patternMap->reserve(1024);
+                registry = std::make_unique<std::vector<entry>>();
+                registry->reserve(1024);
             }
-            uintptr_t a = 0x0;
             auto it = patternMap->find(bytes);
-            if (it != patternMap->end()) {
-                a = it->second;
-                goto return_addr;
-            }
-            {
-                auto p = hook::pattern(bytes);
-                a = p.empty() ? 0x0 : (uintptr_t)p.get_first(0);
+            if (it != patternMap->end())
+                return it->second;
+            registry->push_back({ bytes, 0x0 });
+            patternMap->emplace(bytes, registry->size() - 1);
+            return registry->size() - 1;
+        }
+
+        // Scans for all registered patterns that weren't scanned for yet, in one pass over the executable.
+        // The first lookup of such a pattern does it anyway.
+        static inline void Resolve() {
+            if (!registry || firstPending == registry->size())
+                return;
+            hook::pattern_batch batch;
+            for (size_t i = firstPending; i < registry->size(); i++)
+                batch.add((*registry)[i].bytes);
+            batch.scan();
+            for (size_t i = 0; i < batch.size(); i++) {
+                auto& matches = batch.matches(i);
+                if (!matches.empty())
+                    (*registry)[firstPending + i].address = (uintptr_t)matches[0].get<void>();
             }
-            patternMap->emplace(bytes, a);
-        return_addr:
+            firstPending = registry->size();
+#if PATTERNS_USE_HINT_CACHE
+            hook::save_hint_cache();
+#endif
+        }
+
+        static inline uintptr_t GetAt(size_t index, int32_t offset = 0) {
+            uintptr_t a = Find(index);
+            if (!a)
+                return 0x0;
             a -= GetBaseAddress();
             a += STARTING_ADDRESS;
-            return a ? a + offset : 0x0;
+            return a + offset;
+        }
+
+        static inline uintptr_t Get(std::string_view const& bytes, int32_t offset = 0) {
+            return GetAt(Register(bytes), offset);
         }
 
         static inline uintptr_t GetExternal(void* module, std::string_view const& bytes, int32_t offset = 0) {
@@ -63,9 +120,24 @@ return_addr:
             return a ? a + offset : 0x0;
         }
 
+        // Address of the match in the running process, for the Call*DynGlobal wrappers
+        static inline uintptr_t GetGlobalAt(size_t index, int32_t offset = 0) {
+            uintptr_t a = GetAt(index, offset);
+            return a ? GetGlobalAddress(a) : 0x0;
+        }
+
+        static inline uintptr_t GetGlobal(std::string_view const& bytes, int32_t offset = 0) {
+            return GetGlobalAt(Register(bytes), offset);
+        }
+
         template<typename T = void*>
         static inline auto Read(std::string_view const& bytes, int32_t offset = 0) {
-            uintptr_t const& a = Get(bytes, offset);
+            return ReadAt<T>(Register(bytes), offset);
+        }
+
+        template<typename T = void*>
+        static inline auto ReadAt(size_t index, int32_t offset = 0) {
+            uintptr_t const& a = GetAt(index, offset);
 
 #if (defined (_M_IX86) || defined (_X86_))
             return a ? injector::ReadMemory<T>(GetGlobalAddress(a), true) : 0x0;
@@ -85,7 +157,60 @@ return_addr:
 #endif
         }
     };
+
+    // Pattern text as a template argument. Only a string literal (or a constexpr char array) converts to
+    // it, so the text is known at compile time.
+    template<size_t N>
+    struct pattern_literal {
+        char text[N];
+
+        consteval pattern_literal(const char (&bytes)[N]) {
+            for (size_t i = 0; i < N; i++)
+                text[i] = bytes[i];
+        }
+
+        constexpr std::string_view view() const {
+            return std::string_view(text, N - 1);
+        }
+    };
+
+    // Addresses of one pattern text, shared by every gpattern / gpatternaddr / gpatternt that uses it.
+    // The pattern is registered while the plugin is loaded, so it's part of the first batch. Addresses
+    // are kept once found, a pattern that wasn't found is looked up again on the next call.
+    template<pattern_literal Bytes>
+    class pattern_site {
+    public:
+        static uintptr_t Get() {
+            if (!address)
+                address = pattern::GetAt(Index(), 0);
+            return address;
+        }
+
+        static uintptr_t GetGlobal() {
+            if (!globalAddress)
+                globalAddress = pattern::GetGlobalAt(Index(), 0);
+            return globalAddress;
+        }
+
+        template<typename T>
+        static auto Read(int32_t offset) {
+            return pattern::ReadAt<T>(Index(), offset);
+        }
+
+    private:
+        // index + 1, 0 while the static initializer didn't run yet
+        static inline const size_t registered = pattern::Register(Bytes.view()) + 1;
+        static inline uintptr_t address = 0;
+        static inline uintptr_t globalAddress = 0;
+
+        static size_t Index() {
+            return registered ? registered - 1 : pattern::Register(Bytes.view());
+        }
+    };
 }
 
-#define gpattern(bytes) plugin::pattern::Get(bytes, 0)
-#define gpatternt(t, bytes, offset) plugin::pattern::Read<t*>(bytes, offset)
\ No newline at end of file
+// The bytes have to be a string literal, anything else doesn't compile. Every pattern text keeps its
+// address in a pattern_site of its own, so it's looked up once instead of being hashed again on each call.
+#define gpattern(bytes) plugin::pattern_site<bytes>::Get()
+#define gpatternaddr(bytes) plugin::pattern_site<bytes>::GetGlobal()
+#define gpatternt(t, bytes, offset) plugin::pattern_site<bytes>::Read<t*>(offset)
\ No newline at end of file
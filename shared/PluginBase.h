@@ -21,6 +21,7 @@
 #include "Pattern.h"
 #include "EventList.h" // TODO: decide if we need it here
 #include "DynAddress.h"
+#include "AddressTable.h"
 #include "Maths.h"
 
 namespace plugin {
@@ -235,6 +236,16 @@ Ret CallAndReturnDynGlobal(uintptr_t address, Args... args) {
     return reinterpret_cast<Ret(__cdecl *)(Args...)>(address)(args...);
 }
 
+template <typename... Args>
+void CallStdDynGlobal(uintptr_t address, Args... args) {
+    reinterpret_cast<void(__stdcall*)(Args...)>(address)(args...);
+}
+
+template <typename Ret, typename... Args>
+Ret CallStdAndReturnDynGlobal(uintptr_t address, Args... args) {
+    return reinterpret_cast<Ret(__stdcall*)(Args...)>(address)(args...);
+}
+
 template <typename C, typename... Args>
 void CallMethodDynGlobal(uintptr_t address, C _this, Args... args) {
     reinterpret_cast<void(__thiscall *)(C, Args...)>(address)(_this, args...);
@@ -412,10 +423,13 @@ template<> struct vtable_meta<className> {\
         __debugbreak(); \
     } while (false)
 
-// get global address for current exe version
+// get global address for current exe version (looked up in the AddressTable, the values must be constants)
 #ifdef GTASA
-#define GLOBAL_ADDRESS_BY_VERSION(a,b,c,d,e,f) (plugin::GetGlobalAddress(plugin::by_version_dyn(a,b,c,d,e,f)))
-#define ADDRESS_BY_VERSION(a,b,c,d,e,f) (plugin::by_version_dyn(a,b,c,d,e,f))
+#define GLOBAL_ADDRESS_BY_VERSION(a,b,c,d,e,f) (plugin::address_site<true, a,b,c,d,e,f>::Get())
+#define ADDRESS_BY_VERSION(a,b,c,d,e,f) (static_cast<int>(plugin::address_site<false, a,b,c,d,e,f>::Get()))
+#elif defined(GTA3) || defined(GTAVC)
+#define GLOBAL_ADDRESS_BY_VERSION(a,b,c) (plugin::address_site<true, a,b,c>::Get())
+#define ADDRESS_BY_VERSION(a,b,c) (static_cast<int>(plugin::address_site<false, a,b,c>::Get()))
 #else
 #define GLOBAL_ADDRESS_BY_VERSION(a,b,c) (plugin::GetGlobalAddress(plugin::by_version_dyn(a,b,c)))
 #define ADDRESS_BY_VERSION(a,b,c) (plugin::by_version_dyn(a,b,c))
@@ -0,0 +1,129 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+namespace plugin {
+
+// Free list, live count and high-water mark kept next to a game pool (CPool<A, B>), so allocating
+// and counting don't have to walk the whole byte map.
+// The pool's byte map stays the only authority: slots are taken and released exactly like CPool
+// does it (bEmpty flag, nId bumped on allocation), so handles from GetRef/GetAtRef stay valid and
+// the game keeps working with the pool as usual.
+// Allocations the game makes on its own are noticed when their slot comes up in the free list,
+// slots the game releases on its own are picked up by the next Sync(). New() syncs by itself before
+// it reports the pool as full.
+template<class Pool>
+class PoolSlots {
+public:
+    using ObjectType = std::remove_pointer_t<decltype(std::declval<Pool &>().GetAt(0))>;
+
+    explicit PoolSlots(Pool &pool) : pool(pool) {
+        Sync();
+    }
+
+    // Rebuilds everything from the byte map
+    void Sync() {
+        int size = pool.m_nSize;
+        next.assign(size, NOT_LINKED);
+        firstFree = -1;
+        used = 0;
+        highWater = 0;
+        // lowest slots first, same as the game's allocator prefers them
+        for (int i = size - 1; i >= 0; --i) {
+            if (pool.IsFreeSlotAtIndex(i)) {
+                next[i] = firstFree;
+                firstFree = i;
+            }
+            else {
+                ++used;
+                if (highWater == 0)
+                    highWater = i + 1;
+            }
+        }
+    }
+
+    // Allocates object, nullptr if the pool is full
+    ObjectType *New() {
+        int idx = PopFree();
+        if (idx < 0) {
+            Sync();
+            idx = PopFree();
+            if (idx < 0)
+                return nullptr;
+        }
+        pool.SetFreeAt(idx, false);
+        pool.SetIdAt(idx, (pool.GetIdAt(idx) + 1) & 0x7F);
+        MarkUsed(idx);
+        return pool.GetAt(idx);
+    }
+
+    // Deallocates object
+    void Delete(ObjectType *object) {
+        int idx = pool.GetIndex(object);
+        if (idx < 0 || idx >= static_cast<int>(next.size()) || pool.IsFreeSlotAtIndex(idx))
+            return;
+        pool.SetFreeAt(idx, true);
+        if (next[idx] != NOT_LINKED) {
+            // the game took it while it was still in the list, so it was never counted
+            return;
+        }
+        next[idx] = firstFree;
+        firstFree = idx;
+        --used;
+        if (idx + 1 == highWater) {
+            while (highWater > 0 && pool.IsFreeSlotAtIndex(highWater - 1))
+                --highWater;
+        }
+    }
+
+    unsigned int GetNoOfUsedSpaces() const {
+        return used;
+    }
+
+    unsigned int GetNoOfFreeSpaces() const {
+        return static_cast<unsigned int>(next.size()) - used;
+    }
+
+    // All slots from here on are free, loops over the pool can stop there
+    int GetHighWaterMark() const {
+        return highWater;
+    }
+
+private:
+    static constexpr int NOT_LINKED = -2;
+
+    Pool &pool;
+    std::vector<int> next; // next free slot for every free slot, -1 ends the list, NOT_LINKED for used slots
+    int firstFree = -1;
+    unsigned int used = 0;
+    int highWater = 0;
+
+    int PopFree() {
+        while (firstFree >= 0) {
+            int idx = firstFree;
+            firstFree = next[idx];
+            next[idx] = NOT_LINKED;
+            if (pool.IsFreeSlotAtIndex(idx))
+                return idx;
+            // taken by the game behind our back
+            MarkUsed(idx);
+        }
+        return -1;
+    }
+
+    void MarkUsed(int idx) {
+        ++used;
+        if (idx >= highWater)
+            highWater = idx + 1;
+    }
+};
+
+}
@@ -0,0 +1,192 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "Random.h"
+#include <cstring>
+#include <random>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_RANDOM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+namespace random {
+    namespace detail {
+        // starts above the 0 of a new thread, so every thread seeds itself on first use
+        std::atomic<uint64_t> seedEpoch(1);
+        static std::atomic<uint64_t> fixedSeed(0);
+        static std::atomic<bool> seeded(false);
+        static std::atomic<uint32_t> nextSequence(0);
+
+        void Reseed(ThreadState& state) {
+            state.epoch = seedEpoch.load(std::memory_order_acquire);
+            if (seeded.load(std::memory_order_relaxed)) {
+                state.gen.Seed(fixedSeed.load(std::memory_order_relaxed));
+                // a sequence 2^128 numbers further on for each thread
+                uint32_t sequence = nextSequence.fetch_add(1);
+                for (uint32_t i = 0; i < sequence; i++)
+                    state.gen.Jump();
+            }
+            else {
+                std::random_device device;
+                state.gen.Seed(((uint64_t)device() << 32) | device());
+            }
+
+            // all zero would stay zero
+            for (uint32_t i = 0; i < 16; i++)
+                state.lanes[i] = (uint32_t)(state.gen() >> 32) | (i < 4 ? 1 : 0);
+        }
+
+        // xoshiro128** on four lanes: lanes holds s0, s1, s2 and s3 of each
+        static void NextBlock(uint32_t* lanes, uint32_t* out) {
+#ifdef PLUGIN_RANDOM_SSE2
+            __m128i s0 = _mm_load_si128(reinterpret_cast<__m128i*>(lanes));
+            __m128i s1 = _mm_load_si128(reinterpret_cast<__m128i*>(lanes + 4));
+            __m128i s2 = _mm_load_si128(reinterpret_cast<__m128i*>(lanes + 8));
+            __m128i s3 = _mm_load_si128(reinterpret_cast<__m128i*>(lanes + 12));
+
+            // s1 * 5, rotl 7, * 9 without a 32-bit multiply
+            __m128i x = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+            x = _mm_or_si128(_mm_slli_epi32(x, 7), _mm_srli_epi32(x, 25));
+            x = _mm_add_epi32(_mm_slli_epi32(x, 3), x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+
+            __m128i t = _mm_slli_epi32(s1, 9);
+            s2 = _mm_xor_si128(s2, s0);
+            s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2);
+            s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), s0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 4), s1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 8), s2);
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 12), s3);
+#else
+            for (uint32_t i = 0; i < 4; i++) {
+                uint32_t& s0 = lanes[i];
+                uint32_t& s1 = lanes[4 + i];
+                uint32_t& s2 = lanes[8 + i];
+                uint32_t& s3 = lanes[12 + i];
+
+                uint32_t x = s1 * 5;
+                x = (x << 7) | (x >> 25);
+                out[i] = x * 9;
+
+                uint32_t t = s1 << 9;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = (s3 << 11) | (s3 >> 21);
+            }
+#endif
+        }
+    }
+
+    void Xoshiro256::Jump() {
+        static const uint64_t jump[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+
+        uint64_t t[4] = {};
+        for (uint64_t word : jump) {
+            for (int32_t b = 0; b < 64; b++) {
+                if (word & (1ull << b)) {
+                    for (int32_t i = 0; i < 4; i++)
+                        t[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        memcpy(s, t, sizeof(s));
+    }
+
+    void Fill(uint32_t* out, size_t count) {
+        uint32_t* lanes = detail::GetThreadState().lanes;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            detail::NextBlock(lanes, out + i);
+
+        if (i < count) {
+            uint32_t block[4];
+            detail::NextBlock(lanes, block);
+            memcpy(out + i, block, (count - i) * sizeof(uint32_t));
+        }
+    }
+
+    void FillInRange(float* out, size_t count, float min, float max) {
+        float scale = (max - min) * (1.0f / 16777216.0f);
+        uint32_t bits[64];
+        while (count > 0) {
+            size_t n = count < 64 ? count : 64;
+            Fill(bits, n);
+
+            size_t i = 0;
+#ifdef PLUGIN_RANDOM_SSE2
+            __m128 vScale = _mm_set1_ps(scale);
+            __m128 vMin = _mm_set1_ps(min);
+            for (; i + 4 <= n; i += 4) {
+                __m128i v = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(bits + i)), 8);
+                _mm_storeu_ps(out + i, _mm_add_ps(vMin, _mm_mul_ps(_mm_cvtepi32_ps(v), vScale)));
+            }
+#endif
+            for (; i < n; i++)
+                out[i] = min + (float)(bits[i] >> 8) * scale;
+
+            out += n;
+            count -= n;
+        }
+    }
+
+    void FillUnit(float* out, size_t count) {
+        FillInRange(out, count, 0.0f, 1.0f);
+    }
+
+    void FillInRange(int32_t* out, size_t count, int32_t min, int32_t max) {
+        if (max <= min) {
+            for (size_t i = 0; i < count; i++)
+                out[i] = min;
+            return;
+        }
+
+        uint32_t* bits = reinterpret_cast<uint32_t*>(out);
+        Fill(bits, count);
+
+        uint32_t range = (uint32_t)max - (uint32_t)min + 1;
+        if (range == 0) // the whole int32 range
+            return;
+
+        // same multiply and reject as Below, the few rejected values are drawn again one by one
+        uint32_t threshold = (0u - range) % range;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t m = (uint64_t)bits[i] * range;
+            if ((uint32_t)m < threshold)
+                m = (uint64_t)Below(Generator(), range) << 32;
+            out[i] = (int32_t)((uint32_t)min + (uint32_t)(m >> 32));
+        }
+    }
+
+    void SetSeed(uint64_t seed) {
+        detail::fixedSeed.store(seed, std::memory_order_relaxed);
+        detail::seeded.store(true, std::memory_order_relaxed);
+        detail::nextSequence.store(0);
+        detail::seedEpoch.fetch_add(1, std::memory_order_release);
+        // takes the first sequence
+        detail::GetThreadState();
+    }
+
+    void ClearSeed() {
+        detail::seeded.store(false, std::memory_order_relaxed);
+        detail::seedEpoch.fetch_add(1, std::memory_order_release);
+    }
+
+    bool IsSeeded() {
+        return detail::seeded.load(std::memory_order_relaxed);
+    }
+}
+}
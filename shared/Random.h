@@ -0,0 +1,243 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <type_traits>
+
+namespace plugin {
+namespace random {
+    // min()/max() are in parentheses because of the windows.h macros
+
+    // xoshiro256** (Blackman, Vigna), the generator behind the functions below
+    class Xoshiro256 {
+    public:
+        using result_type = uint64_t;
+
+        static constexpr result_type (min)() { return 0; }
+        static constexpr result_type (max)() { return ~result_type(0); }
+
+        explicit Xoshiro256(uint64_t seed = 0) {
+            Seed(seed);
+        }
+
+        void Seed(uint64_t seed) {
+            for (auto& it : s)
+                it = SplitMix64(seed);
+        }
+
+        result_type operator()() {
+            uint64_t result = Rotl(s[1] * 5, 7) * 9;
+            uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = Rotl(s[3], 45);
+            return result;
+        }
+
+        // Same as 2^128 calls, gives sequences that don't overlap from one seed
+        void Jump();
+
+        static uint64_t SplitMix64(uint64_t& state) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        uint64_t s[4];
+
+        static uint64_t Rotl(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+
+    // PCG32 XSH-RR (O'Neill), 32-bit output from 64-bit state, for generators kept per object
+    class Pcg32 {
+    public:
+        using result_type = uint32_t;
+
+        static constexpr result_type (min)() { return 0; }
+        static constexpr result_type (max)() { return ~result_type(0); }
+
+        explicit Pcg32(uint64_t seed = 0, uint64_t stream = 0xDA3E39CB94B95BDBull) {
+            Seed(seed, stream);
+        }
+
+        void Seed(uint64_t seed, uint64_t stream = 0xDA3E39CB94B95BDBull) {
+            state = 0;
+            inc = (stream << 1) | 1;
+            (*this)();
+            state += seed;
+            (*this)();
+        }
+
+        result_type operator()() {
+            uint64_t old = state;
+            state = old * 6364136223846793005ull + inc;
+            uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+            uint32_t rot = (uint32_t)(old >> 59);
+            return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+        }
+
+    private:
+        uint64_t state;
+        uint64_t inc;
+    };
+
+    // Helpers for any of the generators (or a std one with 32 or 64 bit results)
+
+    template<class Gen>
+    uint32_t Next32(Gen& gen) {
+        if constexpr (sizeof(typename Gen::result_type) > 4)
+            return (uint32_t)(gen() >> 32); // the high bits are the better ones
+        else
+            return (uint32_t)gen();
+    }
+
+    template<class Gen>
+    uint64_t Next64(Gen& gen) {
+        if constexpr (sizeof(typename Gen::result_type) > 4)
+            return (uint64_t)gen();
+        else {
+            uint64_t high = (uint32_t)gen();
+            return (high << 32) | (uint32_t)gen();
+        }
+    }
+
+    // Unbiased value in [0, range), Lemire's multiply and reject. range 0 is the full 32 bits.
+    template<class Gen>
+    uint32_t Below(Gen& gen, uint32_t range) {
+        if (range == 0)
+            return Next32(gen);
+        uint64_t m = (uint64_t)Next32(gen) * range;
+        uint32_t low = (uint32_t)m;
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                m = (uint64_t)Next32(gen) * range;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    template<class Gen>
+    uint64_t Below64(Gen& gen, uint64_t range) {
+        if (range <= 0xFFFFFFFFull && range != 0)
+            return Below(gen, (uint32_t)range);
+        if (range == 0)
+            return Next64(gen);
+
+        uint64_t mask = range - 1;
+        mask |= mask >> 1; mask |= mask >> 2; mask |= mask >> 4;
+        mask |= mask >> 8; mask |= mask >> 16; mask |= mask >> 32;
+        uint64_t value;
+        do {
+            value = Next64(gen) & mask;
+        } while (value >= range);
+        return value;
+    }
+
+    // [0, 1)
+    template<typename T = float, class Gen>
+    T Unit(Gen& gen) {
+        static_assert(std::is_floating_point<T>::value, "Type T must be floating point");
+        if constexpr (sizeof(T) > 4)
+            return (T)(Next64(gen) >> 11) * (T)(1.0 / 9007199254740992.0);
+        else
+            return (T)(Next32(gen) >> 8) * (T)(1.0f / 16777216.0f);
+    }
+
+    // Integers in [min, max], floating point in [min, max) - same as RandomNumberInRange
+    template<typename T, class Gen>
+    T InRange(Gen& gen, T min, T max) {
+        static_assert(std::is_arithmetic<T>::value, "Type T must be numeric");
+        if constexpr (std::is_integral<T>::value) {
+            if (max <= min)
+                return min;
+            // wraps around for signed types, that's fine for the distance
+            uint64_t range = (uint64_t)max - (uint64_t)min + 1;
+            return (T)((uint64_t)min + Below64(gen, range));
+        }
+        else
+            return min + (max - min) * Unit<T>(gen);
+    }
+
+    template<class Gen>
+    bool Chance(Gen& gen, float probability) {
+        return Unit<float>(gen) < probability;
+    }
+
+    namespace detail {
+        struct ThreadState {
+            Xoshiro256 gen;
+            // four xoshiro128** generators next to each other for the Fill functions
+            alignas(16) uint32_t lanes[16];
+            uint64_t epoch = 0;
+        };
+
+        // bumped by SetSeed/ClearSeed, every thread reseeds when it sees a new one
+        extern std::atomic<uint64_t> seedEpoch;
+        void Reseed(ThreadState& state);
+
+        inline ThreadState& GetThreadState() {
+            thread_local ThreadState state;
+            if (state.epoch != seedEpoch.load(std::memory_order_relaxed))
+                Reseed(state);
+            return state;
+        }
+    }
+
+    // Generator of the calling thread, seeded from std::random_device on first use,
+    // unless SetSeed was called
+    inline Xoshiro256& Generator() {
+        return detail::GetThreadState().gen;
+    }
+
+    inline uint32_t Next32() {
+        return Next32(Generator());
+    }
+
+    inline uint64_t Next64() {
+        return Generator()();
+    }
+
+    template<typename T = int32_t>
+    T InRange(T min, T max) {
+        return InRange(Generator(), min, max);
+    }
+
+    template<typename T = float>
+    T Unit() {
+        return Unit<T>(Generator());
+    }
+
+    inline bool Chance(float probability) {
+        return Chance(Generator(), probability);
+    }
+
+    // Many values at once from the calling thread's generators, four at a time with SSE2
+    void Fill(uint32_t* out, size_t count);
+    void FillUnit(float* out, size_t count);
+    void FillInRange(float* out, size_t count, float min, float max);
+    void FillInRange(int32_t* out, size_t count, int32_t min, int32_t max);
+
+    // Deterministic replay: all threads restart from seed. The calling thread is always the first
+    // sequence, the other threads get theirs in the order they next draw a number, so for the
+    // same results they should draw in the same order.
+    void SetSeed(uint64_t seed);
+    // Back to seeding every thread from std::random_device
+    void ClearSeed();
+    bool IsSeeded();
+}
+}
@@ -0,0 +1,219 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "SpriteDecoder.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_SPRITE_DECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+    void SwizzleRGBA(uint8_t* pixels, size_t count) {
+        size_t i = 0;
+#ifdef PLUGIN_SPRITE_DECODER_SSE2
+        const __m128i maskAG = _mm_set1_epi32(0xFF00FF00);
+        const __m128i maskLow = _mm_set1_epi32(0x000000FF);
+        for (; i + 4 <= count; i += 4) {
+            __m128i* p = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i v = _mm_loadu_si128(p);
+            __m128i r = _mm_slli_epi32(_mm_and_si128(v, maskLow), 16);
+            __m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), maskLow);
+            _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(v, maskAG), _mm_or_si128(r, b)));
+        }
+#endif
+        for (; i < count; i++) {
+            uint8_t* p = pixels + i * 4;
+            std::swap(p[0], p[2]);
+        }
+    }
+
+    void DownsampleLevel(uint8_t const* src, int32_t width, int32_t height, uint8_t* dst) {
+        int32_t w = std::max(width / 2, 1);
+        int32_t h = std::max(height / 2, 1);
+        // odd or 1 pixel wide sides repeat their last row/column
+        for (int32_t y = 0; y < h; y++) {
+            uint8_t const* row0 = src + (size_t)std::min(y * 2, height - 1) * width * 4;
+            uint8_t const* row1 = src + (size_t)std::min(y * 2 + 1, height - 1) * width * 4;
+            for (int32_t x = 0; x < w; x++) {
+                size_t x0 = (size_t)std::min(x * 2, width - 1) * 4;
+                size_t x1 = (size_t)std::min(x * 2 + 1, width - 1) * 4;
+                for (int32_t c = 0; c < 4; c++)
+                    *dst++ = (uint8_t)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+            }
+        }
+    }
+
+    size_t GetMipChainSize(int32_t width, int32_t height, uint32_t& numLevels) {
+        size_t size = 0;
+        numLevels = 0;
+        while (true) {
+            size += (size_t)width * height * 4;
+            numLevels++;
+            if (width == 1 && height == 1)
+                break;
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+        return size;
+    }
+
+    SpriteDecoder::SpriteDecoder(DecodeFunc decode, unsigned int numThreads) : decode(std::move(decode)) {
+        if (numThreads == 0)
+            numThreads = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+        this->numThreads = numThreads;
+    }
+
+    SpriteDecoder::~SpriteDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        jobAdded.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    void SpriteDecoder::Enqueue(std::string file, std::string name, uint32_t id, bool mipMaps, bool compress, std::string cacheDir) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({ std::move(file), std::move(name), id, mipMaps, compress, std::move(cacheDir) });
+            // started with the first sprite, so a loader that's never used async costs nothing
+            if (threads.empty()) {
+                for (unsigned int i = 0; i < numThreads; i++)
+                    threads.emplace_back(&SpriteDecoder::Run, this);
+            }
+        }
+        jobAdded.notify_one();
+    }
+
+    size_t SpriteDecoder::Collect(std::vector<DecodedSprite>& out, size_t maxCount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = std::min(maxCount, done.size());
+        for (size_t i = 0; i < count; i++) {
+            out.push_back(std::move(done.front()));
+            done.pop_front();
+        }
+        return count;
+    }
+
+    size_t SpriteDecoder::GetNumPending() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs.size() + running + done.size();
+    }
+
+    void SpriteDecoder::Cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.clear();
+        done.clear();
+        generation++;
+    }
+
+    DecodedSprite SpriteDecoder::Decode(DecodeFunc const& decode, std::string const& file, bool mipMaps, bool compress, std::string const& cacheDir) {
+        DecodedSprite sprite;
+        TextureCache::SourceKey key;
+        std::string cacheFile;
+        if (compress && !cacheDir.empty() && TextureCache::GetSourceKey(file, key)) {
+            cacheFile = TextureCache::GetCacheFileName(cacheDir, file);
+            TextureCache::Entry entry;
+            // a cache made with the other mipmap setting is made again
+            if (TextureCache::Read(cacheFile, key, entry) && (entry.numLevels > 1) == mipMaps) {
+                sprite.width = entry.width;
+                sprite.height = entry.height;
+                sprite.numLevels = entry.numLevels;
+                sprite.blockFormat = entry.format;
+                sprite.pixels = std::move(entry.blocks);
+                sprite.ok = true;
+                return sprite;
+            }
+        }
+
+        if (!decode(file, sprite.pixels, sprite.width, sprite.height) || sprite.width <= 0 || sprite.height <= 0
+            || sprite.pixels.size() < (size_t)sprite.width * sprite.height * 4) {
+            sprite.pixels.clear();
+            return sprite;
+        }
+        SwizzleRGBA(sprite.pixels.data(), (size_t)sprite.width * sprite.height);
+        if (mipMaps) {
+            sprite.pixels.resize(GetMipChainSize(sprite.width, sprite.height, sprite.numLevels));
+            uint8_t* level = sprite.pixels.data();
+            int32_t w = sprite.width, h = sprite.height;
+            for (uint32_t i = 1; i < sprite.numLevels; i++) {
+                uint8_t* next = level + (size_t)w * h * 4;
+                DownsampleLevel(level, w, h, next);
+                level = next;
+                w = std::max(w / 2, 1);
+                h = std::max(h / 2, 1);
+            }
+        }
+        else
+            sprite.numLevels = 1;
+        sprite.ok = true;
+
+        if (compress && sprite.width % 4 == 0 && sprite.height % 4 == 0) {
+            TextureCache::Entry entry;
+            entry.format = HasTransparency(sprite.pixels.data(), (size_t)sprite.width * sprite.height) ? BLOCK_BC3 : BLOCK_BC1;
+            entry.width = sprite.width;
+            entry.height = sprite.height;
+            entry.numLevels = sprite.numLevels;
+
+            size_t size = 0;
+            int32_t w = sprite.width, h = sprite.height;
+            for (uint32_t i = 0; i < sprite.numLevels; i++) {
+                size += GetBlockLevelSize(w, h, entry.format);
+                w = std::max(w / 2, 1);
+                h = std::max(h / 2, 1);
+            }
+            entry.blocks.resize(size);
+
+            uint8_t const* level = sprite.pixels.data();
+            uint8_t* out = entry.blocks.data();
+            w = sprite.width;
+            h = sprite.height;
+            for (uint32_t i = 0; i < sprite.numLevels; i++) {
+                CompressLevel(level, w, h, entry.format, out);
+                level += (size_t)w * h * 4;
+                out += GetBlockLevelSize(w, h, entry.format);
+                w = std::max(w / 2, 1);
+                h = std::max(h / 2, 1);
+            }
+
+            if (!cacheFile.empty())
+                TextureCache::Write(cacheFile, key, entry);
+            sprite.blockFormat = entry.format;
+            sprite.pixels = std::move(entry.blocks);
+        }
+        return sprite;
+    }
+
+    void SpriteDecoder::Run() {
+        while (true) {
+            Job job;
+            uint32_t jobGeneration;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                jobAdded.wait(lock, [this] { return stop || !jobs.empty(); });
+                if (stop)
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                jobGeneration = generation;
+                running++;
+            }
+
+            DecodedSprite sprite = Decode(decode, job.file, job.mipMaps, job.compress, job.cacheDir);
+            sprite.name = std::move(job.name);
+            sprite.id = job.id;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            running--;
+            if (jobGeneration == generation)
+                done.push_back(std::move(sprite));
+        }
+    }
+}
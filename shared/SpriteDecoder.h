@@ -0,0 +1,88 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "TextureCompressor.h"
+
+namespace plugin {
+    // Sprite decoded by SpriteDecoder: 32-bit BGRA, or DXT blocks if blockFormat is set.
+    // The mip levels follow each other, each one half the size of the one before (at least 1x1)
+    struct DecodedSprite {
+        std::string name;
+        uint32_t id = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+        uint32_t numLevels = 0;
+        eBlockFormat blockFormat = BLOCK_NONE;
+        std::vector<uint8_t> pixels;
+        bool ok = false;
+    };
+
+    // Swaps R and B of 32-bit pixels in place, RGBA <-> BGRA
+    void SwizzleRGBA(uint8_t* pixels, size_t count);
+    // Box filtered level of half the size of a 32-bit image
+    void DownsampleLevel(uint8_t const* src, int32_t width, int32_t height, uint8_t* dst);
+    // Bytes of a 32-bit image with all its mip levels
+    size_t GetMipChainSize(int32_t width, int32_t height, uint32_t& numLevels);
+
+    // Reads and decodes image files on worker threads: decode, R/B swizzle and mipmaps.
+    // The results are picked up with Collect, usually a few per frame from the render thread.
+    class SpriteDecoder {
+    public:
+        // Decodes the file into 32-bit RGBA
+        using DecodeFunc = std::function<bool(std::string const& file, std::vector<uint8_t>& rgba, int32_t& width, int32_t& height)>;
+
+        // numThreads 0 picks one per core but one, at most 4
+        explicit SpriteDecoder(DecodeFunc decode, unsigned int numThreads = 0);
+        ~SpriteDecoder();
+
+        SpriteDecoder(SpriteDecoder const&) = delete;
+        SpriteDecoder& operator=(SpriteDecoder const&) = delete;
+
+        // compress turns sprites with sides that are a multiple of 4 into DXT1/DXT5, cached in cacheDir if it's set
+        void Enqueue(std::string file, std::string name, uint32_t id, bool mipMaps, bool compress = false, std::string cacheDir = {});
+        // Moves up to maxCount finished sprites to out, returns how many
+        size_t Collect(std::vector<DecodedSprite>& out, size_t maxCount);
+        // Queued, decoding and not yet collected
+        size_t GetNumPending();
+        // Drops everything that's queued or not collected, sprites being decoded are dropped when they're done
+        void Cancel();
+
+        static DecodedSprite Decode(DecodeFunc const& decode, std::string const& file, bool mipMaps, bool compress = false, std::string const& cacheDir = {});
+
+    private:
+        struct Job {
+            std::string file;
+            std::string name;
+            uint32_t id;
+            bool mipMaps;
+            bool compress;
+            std::string cacheDir;
+        };
+
+        DecodeFunc decode;
+        unsigned int numThreads;
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable jobAdded;
+        std::deque<Job> jobs;
+        std::deque<DecodedSprite> done;
+        size_t running = 0;
+        uint32_t generation = 0;
+        bool stop = false;
+
+        void Run();
+    };
+}
@@ -5,6 +5,7 @@
     Do not delete this comment block. Respect others' work!
 */
 #include "SpriteLoader.h"
+#include <algorithm>
 
 #if defined(GTA3) || defined(GTAVC) || defined(GTASA)
 #include "CFileLoader.h"
@@ -18,6 +19,15 @@ namespace plugin {
     static int32_t Index = 0;
 
     void SpriteLoader::Clear() {
+#ifdef RW
+        if (decoder)
+            decoder->Cancel();
+#else
+        pendingFiles.clear();
+#endif
+        pendingSprites.clear();
+        pendingIds.clear();
+
         if (istxd) {
 #ifdef RAGE
             for (auto& it : spritesMap) {
@@ -61,6 +71,8 @@ namespace plugin {
         extension = "png";
 #endif
         memUsed = 0;
+        compress = false;
+        cacheDir.clear();
     }
 
     bool SpriteLoader::LoadAllSpritesFromTxd(std::string const& path) {
@@ -133,61 +145,208 @@ make_slot:
     }
 
 
-    texClass* SpriteLoader::LoadSpriteFromFolder(std::string const& file) {
-        std::string fileNoExt = RemovePath(file);
-        fileNoExt = RemoveExtension(fileNoExt);
-
-        texClass* tex = nullptr;
 #ifdef RW
+    static bool DecodeImageFile(std::string const& file, std::vector<uint8_t>& rgba, int32_t& width, int32_t& height) {
         Image* img = nullptr;
         if (!CreateImageFromFile(file, img))
-            return nullptr;
+            return false;
 
-        uint32_t w = img->width;
-        uint32_t h = img->height;
-        uint8_t* p = img->pixels;
+        width = img->width;
+        height = img->height;
+        rgba.assign(img->pixels, img->pixels + (size_t)width * height * 4);
+        img->Release();
+        return true;
+    }
 
+    texClass* SpriteLoader::CreateTexture(std::string const& name, int32_t w, int32_t h, uint32_t numLevels, uint8_t const* p) {
         int32_t flags = rwRASTERTYPETEXTURE | rwRASTERFORMAT8888;
 
-        if (mipMap)
+        // levels that come with the pixels are uploaded as they are, otherwise RW makes them
+        if (numLevels > 1)
+            flags |= rwRASTERFORMATMIPMAP;
+        else if (mipMap)
             flags |= rwRASTERFORMATMIPMAP | rwRASTERFORMATAUTOMIPMAP;
 
         RwRaster* raster = RwRasterCreate(w, h, 0, flags);
-        RwUInt32* pixels = (RwUInt32*)RwRasterLock(raster, 0, rwRASTERLOCKWRITE);
-
-        for (uint32_t i = 0; i < w * h * 4; i += 4) {
-            uint8_t r = p[i + 2];
-            uint8_t g = p[i + 1];
-            uint8_t b = p[i];
+        if (!raster)
+            return nullptr;
 
-            p[i + 2] = b;
-            p[i + 1] = g;
-            p[i] = r;
+        uint32_t levels = numLevels > 1 ? std::min<uint32_t>(numLevels, RwRasterGetNumLevels(raster)) : 1;
+        for (uint32_t level = 0; level < levels; level++) {
+            RwUInt8* pixels = RwRasterLock(raster, (RwUInt8)level, rwRASTERLOCKWRITE);
+            if (!pixels)
+                break;
+            int32_t lw = std::max(w >> level, 1);
+            int32_t lh = std::max(h >> level, 1);
+            int32_t stride = RwRasterGetStride(raster);
+            if (stride == lw * 4)
+                memcpy(pixels, p, (size_t)lw * lh * 4);
+            else {
+                for (int32_t y = 0; y < lh; y++)
+                    memcpy(pixels + (size_t)y * stride, p + (size_t)y * lw * 4, (size_t)lw * 4);
+            }
+            RwRasterUnlock(raster);
+            p += (size_t)lw * lh * 4;
+            memUsed += lw * lh * 4;
         }
 
-        memcpy(pixels, p, w * h * 4);
-        RwRasterUnlock(raster);
-
-        tex = RwTextureCreate(raster);
+        texClass* tex = RwTextureCreate(raster);
         RwTextureSetFilterMode(tex, rwFILTERLINEAR);
 
         RwTextureSetMipmapping(mipMap);
         RwTextureSetAutoMipmapping(mipMap);
 
         memset(tex->name, 0, 32);
-        fileNoExt.copy(tex->name, 32);
+        name.copy(tex->name, 32);
 
-        img->Release();
+        return tex;
+    }
+#endif
+
+#ifdef GTASA
+    namespace {
+        // RW binary stream built in memory, chunk sizes are filled in when a chunk ends
+        class ChunkWriter {
+        public:
+            std::vector<uint8_t> data;
+            RwUInt32 libraryId;
+
+            explicit ChunkWriter(RwUInt32 version) {
+                libraryId = (((version - 0x30000) & 0x3FF00) << 14) | ((version & 0x3F) << 16) | 0xFFFF;
+            }
 
-        memUsed += w * h * 4;
+            size_t Begin(RwUInt32 type) {
+                Put(type);
+                Put<RwUInt32>(0);
+                Put(libraryId);
+                return data.size();
+            }
+
+            void End(size_t start) {
+                RwUInt32 size = (RwUInt32)(data.size() - start);
+                memcpy(data.data() + start - 8, &size, sizeof(size));
+            }
+
+            template<typename T>
+            void Put(T value) {
+                Put(&value, sizeof(value));
+            }
+
+            void Put(void const* p, size_t size) {
+                data.insert(data.end(), static_cast<uint8_t const*>(p), static_cast<uint8_t const*>(p) + size);
+            }
+        };
+    }
+
+    // RW can't create DXT rasters from outside, so the blocks are put in a D3D9 native texture
+    // dictionary and read back the way a TXD is loaded
+    texClass* SpriteLoader::CreateCompressedTexture(std::string const& name, int32_t w, int32_t h, uint32_t numLevels, eBlockFormat format, uint8_t const* blocks) {
+        ChunkWriter writer(RwEngineGetVersion());
+        size_t dict = writer.Begin(rwID_TEXDICTIONARY);
+        size_t dictStruct = writer.Begin(rwID_STRUCT);
+        writer.Put<RwUInt16>(1); // textures
+        writer.Put<RwUInt16>(2); // device, D3D9
+        writer.End(dictStruct);
+
+        size_t native = writer.Begin(rwID_TEXTURENATIVE);
+        size_t nativeStruct = writer.Begin(rwID_STRUCT);
+        writer.Put<RwUInt32>(9); // platform, D3D9
+        RwUInt32 filter = numLevels > 1 ? rwFILTERLINEARMIPLINEAR : rwFILTERLINEAR;
+        writer.Put<RwUInt32>(filter | (rwTEXTUREADDRESSWRAP << 8) | (rwTEXTUREADDRESSWRAP << 12));
+        char texName[32] = {}, mask[32] = {};
+        name.copy(texName, sizeof(texName) - 1);
+        writer.Put(texName, sizeof(texName));
+        writer.Put(mask, sizeof(mask));
+        RwUInt32 rasterFormat = format == BLOCK_BC3 ? rwRASTERFORMAT4444 : rwRASTERFORMAT565;
+        if (numLevels > 1)
+            rasterFormat |= rwRASTERFORMATMIPMAP;
+        writer.Put(rasterFormat);
+        writer.Put<RwUInt32>(format == BLOCK_BC3 ? 0x35545844 : 0x31545844); // D3DFMT_DXT5/D3DFMT_DXT1
+        writer.Put((RwUInt16)w);
+        writer.Put((RwUInt16)h);
+        writer.Put<RwUInt8>(16); // depth
+        writer.Put((RwUInt8)numLevels);
+        writer.Put<RwUInt8>(rwRASTERTYPETEXTURE);
+        writer.Put<RwUInt8>((format == BLOCK_BC3 ? 1 : 0) | 8); // alpha, compressed
+        for (uint32_t level = 0; level < numLevels; level++) {
+            RwUInt32 size = (RwUInt32)GetBlockLevelSize(std::max(w >> level, 1), std::max(h >> level, 1), format);
+            writer.Put(size);
+            writer.Put(blocks, size);
+            blocks += size;
+            memUsed += size;
+        }
+        writer.End(nativeStruct);
+        writer.End(writer.Begin(rwID_EXTENSION));
+        writer.End(native);
+        writer.End(writer.Begin(rwID_EXTENSION));
+        writer.End(dict);
+
+        RwMemory memory = { writer.data.data(), (RwUInt32)writer.data.size() };
+        RwStream* stream = RwStreamOpen(rwSTREAMMEMORY, rwSTREAMREAD, &memory);
+        if (!stream)
+            return nullptr;
+
+        RwTexDictionary* txd = nullptr;
+        if (RwStreamFindChunk(stream, rwID_TEXDICTIONARY, nullptr, nullptr))
+            txd = RwTexDictionaryStreamRead(stream);
+        RwStreamClose(stream, nullptr);
+        if (!txd)
+            return nullptr;
+
+        texClass* tex = nullptr;
+        RwTexDictionaryForAllTextures(txd, [](RwTexture* t, void* data) {
+            *(RwTexture**)data = t;
+            return t;
+            }, &tex);
+        if (tex)
+            RwTexDictionaryRemoveTexture(tex);
+        RwTexDictionaryDestroy(txd);
+        return tex;
+    }
+#endif
+
+    texClass* SpriteLoader::LoadSpriteFromFile(std::string const& file, std::string const& name) {
+        texClass* tex = nullptr;
+#ifdef GTASA
+        if (compress) {
+            DecodedSprite sprite = SpriteDecoder::Decode(DecodeImageFile, file, mipMap, true, cacheDir);
+            if (!sprite.ok)
+                return nullptr;
+            if (sprite.blockFormat != BLOCK_NONE)
+                return CreateCompressedTexture(name, sprite.width, sprite.height, sprite.numLevels, sprite.blockFormat, sprite.pixels.data());
+            return CreateTexture(name, sprite.width, sprite.height, sprite.numLevels, sprite.pixels.data());
+        }
+#endif
+#ifdef RW
+        Image* img = nullptr;
+        if (!CreateImageFromFile(file, img))
+            return nullptr;
+
+        SwizzleRGBA(img->pixels, (size_t)img->width * img->height);
+        tex = CreateTexture(name, img->width, img->height, 1, img->pixels);
+
+        img->Release();
 #else
         tex = rage::grcTextureFactoryPC::GetInstance()->CreateFromFile(file.c_str(), nullptr);
 
-        memUsed += tex->m_Width, tex->m_Height * 4;
+        if (tex)
+            memUsed += tex->m_Width * tex->m_Height * 4;
 #endif
+        return tex;
+    }
 
-        spritesMap.insert({ fileNoExt, tex });
-        spritesMapIndex.insert({ Index++, tex });
+    void SpriteLoader::AddSprite(std::string const& name, uint32_t id, texClass* tex) {
+        spritesMap.insert({ name, tex });
+        spritesMapIndex.insert({ id, tex });
+    }
+
+    texClass* SpriteLoader::LoadSpriteFromFolder(std::string const& file) {
+        std::string fileNoExt = RemovePath(file);
+        fileNoExt = RemoveExtension(fileNoExt);
+
+        texClass* tex = LoadSpriteFromFile(file, fileNoExt);
+        if (tex)
+            AddSprite(fileNoExt, Index++, tex);
 
         return tex;
     }
@@ -203,11 +362,103 @@ make_slot:
         return true;
     }
 
+    bool SpriteLoader::LoadAllSpritesFromFolderAsync(std::string const& path) {
+        auto files = GetAllFilesInFolder(path, "." + extension);
+#ifdef RW
+        if (!decoder)
+            decoder = std::make_unique<SpriteDecoder>(DecodeImageFile);
+#endif
+        for (auto& file : files) {
+            std::string name = RemoveExtension(file);
+            if (spritesMap.count(name) || pendingSprites.count(name))
+                continue;
+            // the id is taken now, so it's the same as with LoadAllSpritesFromFolder
+            uint32_t id = Index++;
+            pendingSprites.insert({ name, id });
+            pendingIds.insert(id);
+#ifdef RW
+            decoder->Enqueue(path + "\\" + file, name, id, mipMap, compress, cacheDir);
+#else
+            pendingFiles.push_back({ path + "\\" + file, id });
+#endif
+        }
+
+        istxd = false;
+
+        return true;
+    }
+
+    void SpriteLoader::Update() {
+        if (pendingSprites.empty())
+            return;
+#ifdef RW
+        decoded.clear();
+        decoder->Collect(decoded, uploadBudget);
+        for (auto& sprite : decoded) {
+            pendingSprites.erase(sprite.name);
+            pendingIds.erase(sprite.id);
+            if (!sprite.ok)
+                continue;
+            texClass* tex;
+#ifdef GTASA
+            if (sprite.blockFormat != BLOCK_NONE)
+                tex = CreateCompressedTexture(sprite.name, sprite.width, sprite.height, sprite.numLevels, sprite.blockFormat, sprite.pixels.data());
+            else
+#endif
+                tex = CreateTexture(sprite.name, sprite.width, sprite.height, sprite.numLevels, sprite.pixels.data());
+            if (tex)
+                AddSprite(sprite.name, sprite.id, tex);
+        }
+#else
+        for (uint32_t i = 0; i < uploadBudget && !pendingFiles.empty(); i++) {
+            auto [file, id] = pendingFiles.front();
+            pendingFiles.pop_front();
+            std::string name = RemoveExtension(RemovePath(file));
+            pendingSprites.erase(name);
+            pendingIds.erase(id);
+            texClass* tex = LoadSpriteFromFile(file, name);
+            if (tex)
+                AddSprite(name, id, tex);
+        }
+#endif
+    }
+
+    bool SpriteLoader::IsReady(std::string const& name) {
+        return spritesMap.find(name) != spritesMap.end();
+    }
+
+    bool SpriteLoader::IsLoading() {
+        return !pendingSprites.empty();
+    }
+
+    void SpriteLoader::SetPlaceholder(texClass* tex) {
+        placeholder = tex;
+    }
+
+    void SpriteLoader::SetUploadBudget(uint32_t spritesPerFrame) {
+        uploadBudget = spritesPerFrame;
+    }
+
+    bool SpriteLoader::SetCompression(bool on, std::string const& dir) {
+#ifdef GTASA
+        if (on && !RwD3D9DeviceSupportsDXTTexture())
+            return false;
+
+        compress = on;
+        cacheDir = dir;
+        return true;
+#else
+        return !on;
+#endif
+    }
+
     CSprite2d SpriteLoader::GetSprite(std::string const& name) {
         CSprite2d sprite = {};
         auto s = spritesMap.find(name);
         if (s != spritesMap.end())
             sprite.m_pTexture = s->second;
+        else if (pendingSprites.count(name))
+            sprite.m_pTexture = placeholder;
         
         return sprite;
     }
@@ -218,6 +469,8 @@ make_slot:
         auto s = spritesMapIndex.find(id);
         if (s != spritesMapIndex.end())
             sprite.m_pTexture = s->second;
+        else if (pendingIds.count(id))
+            sprite.m_pTexture = placeholder;
 
         return sprite;
     }
@@ -226,6 +479,8 @@ make_slot:
         auto s = spritesMap.find(name);
         if (s != spritesMap.end())
             return s->second;
+        if (pendingSprites.count(name))
+            return placeholder;
         return nullptr;
     }
 
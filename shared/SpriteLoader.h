@@ -8,11 +8,15 @@
 #include "PluginBase.h"
 #include "Other.h"
 #include "Image.h"
+#include "SpriteDecoder.h"
 
 #if defined(GTA3) || defined(GTAVC) || defined(GTASA) || defined(GTAIV)
 #include "CSprite2d.h"
 
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <deque>
 
 namespace plugin {
 
@@ -39,6 +43,29 @@ namespace plugin {
 
         int32_t memUsed;
 
+        // sprites queued by LoadAllSpritesFromFolderAsync, created by Update
+        std::unordered_map<std::string, uint32_t, CaseInsensitiveUnorderedMap::Hash, CaseInsensitiveUnorderedMap::Comp> pendingSprites;
+        std::unordered_set<uint32_t> pendingIds;
+#ifdef RW
+        std::unique_ptr<SpriteDecoder> decoder;
+        std::vector<DecodedSprite> decoded;
+#else
+        std::deque<std::pair<std::string, uint32_t>> pendingFiles;
+#endif
+        texClass* placeholder;
+        uint32_t uploadBudget;
+        bool compress;
+        std::string cacheDir;
+
+        texClass* LoadSpriteFromFile(std::string const& file, std::string const& name);
+#ifdef RW
+        texClass* CreateTexture(std::string const& name, int32_t w, int32_t h, uint32_t numLevels, uint8_t const* pixels);
+#endif
+#ifdef GTASA
+        texClass* CreateCompressedTexture(std::string const& name, int32_t w, int32_t h, uint32_t numLevels, eBlockFormat format, uint8_t const* blocks);
+#endif
+        void AddSprite(std::string const& name, uint32_t id, texClass* tex);
+
     public:
         inline SpriteLoader() {
 #ifdef RW
@@ -55,11 +82,27 @@ namespace plugin {
             extension = "png";
 #endif
             memUsed = 0;
+            placeholder = nullptr;
+            uploadBudget = 8;
+            compress = false;
         }
         void Clear();
         bool LoadAllSpritesFromTxd(std::string const& path);
         texClass* LoadSpriteFromFolder(std::string const& file);
         bool LoadAllSpritesFromFolder(std::string const& path);
+        // Queues the sprites of the folder: they're read, decoded and mipmapped on worker threads and
+        // created by Update. Until then GetSprite/GetTex return the placeholder.
+        bool LoadAllSpritesFromFolderAsync(std::string const& path);
+        // Creates up to the upload budget of loaded sprites, call it once per frame from the render thread
+        void Update();
+        bool IsReady(std::string const& name);
+        bool IsLoading();
+        void SetPlaceholder(texClass* tex);
+        void SetUploadBudget(uint32_t spritesPerFrame);
+        // Folder sprites with sides that are a multiple of 4 are stored as DXT1, or DXT5 if they have alpha.
+        // The compressed levels are kept in cacheDir (if not empty) and read from there next time.
+        // Returns false if it can't be turned on: only GTA SA with a device that supports DXT.
+        bool SetCompression(bool on, std::string const& cacheDir = {});
         CSprite2d GetSprite(std::string const& name);
         CSprite2d GetSprite(uint32_t id);
         texClass* GetTex(std::string const& name);
@@ -11,6 +11,9 @@
 #include <codecvt>
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
 
 #include "CText.h"
 
@@ -156,7 +159,57 @@ namespace plugin {
         #endif
     };
 
+    namespace {
+        std::vector<char_t> tableLookup;
+        bool tableLookupReady = false;
+
+        using uchar_t = std::make_unsigned_t<char_t>;
+
+        uint32_t TableHash() {
+            uint32_t hash = 0xFFFFFFFF;
+            for (auto& [from, to] : table) {
+                char bytes[sizeof(char_t) * 2];
+                memcpy(bytes, &from, sizeof(char_t));
+                memcpy(bytes + sizeof(char_t), &to, sizeof(char_t));
+                hash = TextLoader::Hash(std::string_view(bytes, sizeof(bytes))) ^ (hash * 31);
+            }
+            return hash;
+        }
+
+        struct CacheHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t charSize;
+            uint32_t tableHash;
+            uint64_t sourceSize;
+            int64_t sourceTime;
+            uint32_t numSlots;
+            uint32_t count;
+            uint32_t keysSize;
+            uint32_t valuesSize;
+        };
+
+        constexpr char CACHE_MAGIC[4] = { 'P', 'T', 'X', 'T' };
+        constexpr uint32_t CACHE_VERSION = 1;
+    }
+
+    void UpdateTableLookup() {
+        size_t size = 0;
+        for (auto& [from, to] : table)
+            size = std::max(size, static_cast<size_t>(static_cast<uchar_t>(from)) + 1);
+        tableLookup.resize(size);
+        for (size_t i = 0; i < size; i++)
+            tableLookup[i] = static_cast<char_t>(i);
+        for (auto& [from, to] : table)
+            tableLookup[static_cast<uchar_t>(from)] = to;
+        tableLookupReady = true;
+    }
+
     void ApplyTable(string_t& str) {
+        if (!tableLookupReady)
+            UpdateTableLookup();
+        char_t const* lookup = tableLookup.data();
+        size_t size = tableLookup.size();
         bool tag = false;
         for (auto& c : str) {
             if (c == '~')
@@ -165,14 +218,38 @@ namespace plugin {
             if (tag)
                 continue;
 
-            auto it = table.find(c);
-            if (it != table.end()) {
-                c = it->second;
-            }
+            auto index = static_cast<uchar_t>(c);
+            if (index < size)
+                c = lookup[index];
         }
     }
 
     bool TextLoader::Load(const std::string& fileName) {
+        return Parse(fileName);
+    }
+
+    bool TextLoader::Load(const std::string& fileName, const std::string& cacheFileName) {
+        std::error_code error;
+        uint64_t sourceSize = std::filesystem::file_size(fileName, error);
+        if (error)
+            return false;
+        int64_t sourceTime = std::filesystem::last_write_time(fileName, error).time_since_epoch().count();
+        if (error)
+            return false;
+
+        if (ReadCache(cacheFileName, sourceSize, sourceTime))
+            return true;
+
+        // parsed on its own, so the cache holds only this file
+        TextLoader compiled;
+        if (!compiled.Parse(fileName))
+            return false;
+        compiled.WriteCache(cacheFileName, sourceSize, sourceTime);
+        Merge(std::move(compiled));
+        return true;
+    }
+
+    bool TextLoader::Parse(const std::string& fileName) {
         ifstream_t file(fileName);
         file.imbue(std::locale(file.getloc(), new std::codecvt_utf8_utf16<char_t, 0x10ffff, std::little_endian>));
 
@@ -201,7 +278,7 @@ namespace plugin {
 
                 if (!currentKey.empty() && !currentValue.empty()) {
                     ApplyTable(currentValue);
-                    stringMap[currentKey] = currentValue;
+                    Set(currentKey, currentValue);
                 }
             }
         }
@@ -211,11 +288,143 @@ namespace plugin {
         return true;
     }
 
-    const char_t* TextLoader::Get(const char* key) {
-        auto iter = stringMap.find(key);
+    TextLoader::Slot const* TextLoader::Find(std::string_view key, uint32_t hash) const {
+        if (slots.empty())
+            return nullptr;
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            Slot const& slot = slots[i];
+            if (slot.value == EMPTY)
+                return nullptr;
+            if (slot.hash == hash && key == std::string_view(&keys[slot.key]))
+                return &slot;
+        }
+    }
+
+    void TextLoader::Set(std::string_view key, string_t const& value) {
+        if ((count + 1) * 2 > slots.size())
+            Grow();
+        uint32_t hash = Hash(key);
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        for (; ; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.value == EMPTY) {
+                slot.hash = hash;
+                slot.key = static_cast<uint32_t>(keys.size());
+                keys.insert(keys.end(), key.begin(), key.end());
+                keys.push_back('\0');
+                count++;
+                break;
+            }
+            if (slot.hash == hash && key == std::string_view(&keys[slot.key]))
+                break;
+        }
+        // a replaced value stays in the arena until Clear
+        slots[i].value = static_cast<uint32_t>(values.size());
+        values.insert(values.end(), value.begin(), value.end());
+        values.push_back('\0');
+    }
+
+    void TextLoader::Grow() {
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(std::max<size_t>(old.size() * 2, 64), Slot{ 0, 0, EMPTY });
+        size_t mask = slots.size() - 1;
+        for (Slot const& slot : old) {
+            if (slot.value == EMPTY)
+                continue;
+            size_t i = slot.hash & mask;
+            while (slots[i].value != EMPTY)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
 
-        if (iter != stringMap.end()) {
-            return iter->second.c_str();
+    void TextLoader::Merge(TextLoader&& other) {
+        if (count == 0) {
+            *this = std::move(other);
+            return;
+        }
+        for (Slot const& slot : other.slots) {
+            if (slot.value != EMPTY)
+                Set(&other.keys[slot.key], &other.values[slot.value]);
+        }
+    }
+
+    bool TextLoader::ReadCache(const std::string& cacheFileName, uint64_t sourceSize, int64_t sourceTime) {
+        std::ifstream file(cacheFileName, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            return false;
+        uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+        CacheHeader header;
+        if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+        if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) || header.version != CACHE_VERSION || header.charSize != sizeof(char_t)
+            || header.sourceSize != sourceSize || header.sourceTime != sourceTime || header.tableHash != TableHash())
+            return false;
+
+        // the file is only a cache, anything that doesn't add up means it's parsed again. Find relies on
+        // a free slot to stop and on terminated strings, so those are checked before the table is used.
+        if (header.numSlots == 0 || (header.numSlots & (header.numSlots - 1)) || header.count > header.numSlots / 2)
+            return false;
+        if (fileSize != sizeof(header) + static_cast<uint64_t>(header.numSlots) * sizeof(Slot) + header.keysSize
+            + static_cast<uint64_t>(header.valuesSize) * sizeof(char_t))
+            return false;
+
+        TextLoader cached;
+        cached.slots.resize(header.numSlots);
+        cached.keys.resize(header.keysSize);
+        cached.values.resize(header.valuesSize);
+        cached.count = header.count;
+        if (!file.read(reinterpret_cast<char*>(cached.slots.data()), cached.slots.size() * sizeof(Slot))
+            || !file.read(cached.keys.data(), cached.keys.size())
+            || !file.read(reinterpret_cast<char*>(cached.values.data()), cached.values.size() * sizeof(char_t)))
+            return false;
+
+        if ((!cached.keys.empty() && cached.keys.back() != '\0') || (!cached.values.empty() && cached.values.back() != '\0'))
+            return false;
+        size_t used = 0;
+        for (Slot const& slot : cached.slots) {
+            if (slot.value == EMPTY)
+                continue;
+            if (slot.key >= cached.keys.size() || slot.value >= cached.values.size()
+                || slot.hash != Hash(&cached.keys[slot.key]))
+                return false;
+            used++;
+        }
+        if (used != cached.count)
+            return false;
+
+        Merge(std::move(cached));
+        return true;
+    }
+
+    void TextLoader::WriteCache(const std::string& cacheFileName, uint64_t sourceSize, int64_t sourceTime) const {
+        std::ofstream file(cacheFileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return;
+        CacheHeader header = {};
+        memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.charSize = sizeof(char_t);
+        header.tableHash = TableHash();
+        header.sourceSize = sourceSize;
+        header.sourceTime = sourceTime;
+        header.numSlots = static_cast<uint32_t>(slots.size());
+        header.count = static_cast<uint32_t>(count);
+        header.keysSize = static_cast<uint32_t>(keys.size());
+        header.valuesSize = static_cast<uint32_t>(values.size());
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(slots.data()), slots.size() * sizeof(Slot));
+        file.write(keys.data(), keys.size());
+        file.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(char_t));
+    }
+
+    const char_t* TextLoader::Get(const char* key) {
+        Slot const* slot = Find(key, Hash(key));
+        if (slot) {
+            return &values[slot->value];
         }
 
 #ifdef GTA2
@@ -225,8 +434,35 @@ namespace plugin {
 #endif
     }
 
+    const char_t* TextLoader::Get(std::string_view key) {
+        Slot const* slot = Find(key, Hash(key));
+        if (slot)
+            return &values[slot->value];
+
+        // the game wants a terminated key, GXT keys are short
+        char buffer[64];
+        size_t size = std::min(key.size(), sizeof(buffer) - 1);
+        memcpy(buffer, key.data(), size);
+        buffer[size] = '\0';
+        return Get(static_cast<const char*>(buffer));
+    }
+
+    const char_t* TextLoader::GetByHash(uint32_t hash) const {
+        if (slots.empty())
+            return nullptr;
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; slots[i].value != EMPTY; i = (i + 1) & mask) {
+            if (slots[i].hash == hash)
+                return &values[slots[i].value];
+        }
+        return nullptr;
+    }
+
     void TextLoader::Clear() {
-        stringMap.clear();
+        slots.clear();
+        keys.clear();
+        values.clear();
+        count = 0;
     }
 
 }
@@ -7,8 +7,10 @@
 #pragma once
 #ifndef UNREAL
 #include "PluginBase.h"
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 #include <map>
 
 namespace plugin {
@@ -22,22 +24,62 @@ namespace plugin {
     using ifstream_t = std::wifstream;
 #endif
 
+    // Text entries in one open-addressed table over contiguous key and value arenas. Keys are hashed the
+    // same way as CKeyGen::GetKey (CRC32 without the final xor), lookups don't allocate.
+    // The compiled table can be cached in a binary file next to the source, see Load.
     class TextLoader {
-    private:
-        std::unordered_map<std::string, string_t> stringMap;
-
     public:
-        TextLoader() {
-            stringMap = {};
+        // Same as CKeyGen::GetKey, usable at compile time
+        static constexpr uint32_t Hash(std::string_view key) {
+            uint32_t hash = 0xFFFFFFFF;
+            for (char c : key) {
+                hash ^= static_cast<uint8_t>(c);
+                for (int i = 0; i < 8; i++)
+                    hash = (hash >> 1) ^ (0xEDB88320 & (0 - (hash & 1)));
+            }
+            return hash;
         }
 
+        TextLoader() {}
+
         bool Load(const std::string& fileName);
+        // Loads the compiled table from cacheFileName if it was made from the current fileName,
+        // otherwise parses fileName and writes the cache
+        bool Load(const std::string& fileName, const std::string& cacheFileName);
         const char_t* Get(const char* key);
+        const char_t* Get(std::string_view key);
+        // Entry by precomputed Hash(), nullptr if there is none. Keys aren't compared.
+        const char_t* GetByHash(uint32_t hash) const;
+        size_t Count() const { return count; }
 
         void Clear();
+
+    private:
+        static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+        struct Slot {
+            uint32_t hash;
+            uint32_t key;   // offset in keys
+            uint32_t value; // offset in values, EMPTY for free slots
+        };
+
+        std::vector<Slot> slots; // power of two, at most half full
+        std::vector<char> keys;
+        std::vector<char_t> values;
+        size_t count = 0;
+
+        Slot const *Find(std::string_view key, uint32_t hash) const;
+        void Set(std::string_view key, string_t const &value);
+        void Grow();
+        void Merge(TextLoader&& other);
+        bool Parse(const std::string& fileName);
+        bool ReadCache(const std::string& cacheFileName, uint64_t sourceSize, int64_t sourceTime);
+        void WriteCache(const std::string& cacheFileName, uint64_t sourceSize, int64_t sourceTime) const;
     };
 
     extern void ApplyTable(string_t& str);
+    // ApplyTable goes through a flat array made from this map, call it after changing the map
+    extern void UpdateTableLookup();
     extern std::map<char_t, char_t> table;
 
 }
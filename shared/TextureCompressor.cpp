@@ -0,0 +1,379 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "TextureCompressor.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_TEXTURE_COMPRESSOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace plugin {
+    namespace {
+        size_t BlockSize(eBlockFormat format) {
+            return format == BLOCK_BC1 ? 8 : 16;
+        }
+
+        uint16_t To565(int32_t r, int32_t g, int32_t b) {
+            return (uint16_t)((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+        }
+
+        void From565(uint16_t c, int32_t rgb[3]) {
+            int32_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        // Per channel minimum and maximum of a 4x4 block of BGRA pixels
+        void GetBounds(uint8_t const* block, uint8_t mn[4], uint8_t mx[4]) {
+#ifdef PLUGIN_TEXTURE_COMPRESSOR_SSE2
+            __m128i r0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+            __m128i r1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 16));
+            __m128i r2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 32));
+            __m128i r3 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 48));
+            __m128i lo = _mm_min_epu8(_mm_min_epu8(r0, r1), _mm_min_epu8(r2, r3));
+            __m128i hi = _mm_max_epu8(_mm_max_epu8(r0, r1), _mm_max_epu8(r2, r3));
+            lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+            hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+            lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+            hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+            uint32_t l = (uint32_t)_mm_cvtsi128_si32(lo);
+            uint32_t h = (uint32_t)_mm_cvtsi128_si32(hi);
+            memcpy(mn, &l, 4);
+            memcpy(mx, &h, 4);
+#else
+            for (int32_t c = 0; c < 4; c++) {
+                mn[c] = 255;
+                mx[c] = 0;
+            }
+            for (int32_t i = 0; i < 16; i++) {
+                for (int32_t c = 0; c < 4; c++) {
+                    mn[c] = std::min(mn[c], block[i * 4 + c]);
+                    mx[c] = std::max(mx[c], block[i * 4 + c]);
+                }
+            }
+#endif
+        }
+
+        // Bounding box of the colors, inset a bit so the endpoints aren't pulled by outliers
+        void CompressColorBlock(uint8_t const* block, uint8_t const mn[4], uint8_t const mx[4], uint8_t* out) {
+            int32_t lo[3], hi[3];
+            for (int32_t c = 0; c < 3; c++) {
+                int32_t inset = (mx[c] - mn[c]) >> 4;
+                lo[c] = mn[c] + inset;
+                hi[c] = mx[c] - inset;
+            }
+
+            // the box has four diagonals, channels that go against the widest one are flipped
+            int32_t main = 0;
+            for (int32_t c = 1; c < 3; c++) {
+                if (mx[c] - mn[c] > mx[main] - mn[main])
+                    main = c;
+            }
+            int32_t center[3];
+            for (int32_t c = 0; c < 3; c++)
+                center[c] = (mn[c] + mx[c] + 1) / 2;
+            int32_t covariance[3] = {};
+            for (int32_t i = 0; i < 16; i++) {
+                int32_t d = block[i * 4 + main] - center[main];
+                for (int32_t c = 0; c < 3; c++)
+                    covariance[c] += d * (block[i * 4 + c] - center[c]);
+            }
+            for (int32_t c = 0; c < 3; c++) {
+                if (covariance[c] < 0)
+                    std::swap(lo[c], hi[c]);
+            }
+            uint16_t c0 = To565(hi[2], hi[1], hi[0]);
+            uint16_t c1 = To565(lo[2], lo[1], lo[0]);
+            // c0 > c1 picks the four color mode
+            if (c0 < c1)
+                std::swap(c0, c1);
+            out[0] = (uint8_t)c0;
+            out[1] = (uint8_t)(c0 >> 8);
+            out[2] = (uint8_t)c1;
+            out[3] = (uint8_t)(c1 >> 8);
+
+            uint32_t indices = 0;
+            if (c0 != c1) {
+                int32_t e0[3], e1[3];
+                From565(c0, e0);
+                From565(c1, e1);
+                // rgb order, the pixels are bgra
+                int32_t axis[3] = { e0[0] - e1[0], e0[1] - e1[1], e0[2] - e1[2] };
+                int32_t length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+                // position along the axis 0..3 to the index of that palette entry
+                static const uint32_t remap[4] = { 1, 3, 2, 0 };
+                for (int32_t i = 0; i < 16; i++) {
+                    uint8_t const* p = block + i * 4;
+                    int32_t t = (p[2] - e1[0]) * axis[0] + (p[1] - e1[1]) * axis[1] + (p[0] - e1[2]) * axis[2];
+                    int32_t step = std::clamp((t * 3 + length / 2) / length, 0, 3);
+                    indices |= remap[step] << (i * 2);
+                }
+            }
+            memcpy(out + 4, &indices, 4);
+        }
+
+        void CompressAlphaBlock(uint8_t const* block, uint8_t amin, uint8_t amax, uint8_t* out) {
+            out[0] = amax;
+            out[1] = amin;
+            uint64_t indices = 0;
+            int32_t range = amax - amin;
+            if (range) {
+                for (int32_t i = 0; i < 16; i++) {
+                    int32_t t = ((block[i * 4 + 3] - amin) * 7 + range / 2) / range;
+                    // a0 is the maximum, a1 the minimum, 2..7 go from a0 to a1
+                    uint64_t index = t == 7 ? 0 : (t == 0 ? 1 : 8 - t);
+                    indices |= index << (i * 3);
+                }
+            }
+            for (int32_t i = 0; i < 6; i++)
+                out[2 + i] = (uint8_t)(indices >> (i * 8));
+        }
+
+        void DecompressColorBlock(uint8_t const* in, bool allowTransparent, uint8_t* block) {
+            uint16_t c0 = (uint16_t)(in[0] | (in[1] << 8));
+            uint16_t c1 = (uint16_t)(in[2] | (in[3] << 8));
+            int32_t palette[4][4];
+            From565(c0, palette[0]);
+            From565(c1, palette[1]);
+            palette[0][3] = palette[1][3] = 255;
+            for (int32_t c = 0; c < 3; c++) {
+                if (c0 > c1 || !allowTransparent) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+                else {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = (c0 > c1 || !allowTransparent) ? 255 : 0;
+            uint32_t indices;
+            memcpy(&indices, in + 4, 4);
+            for (int32_t i = 0; i < 16; i++) {
+                int32_t const* color = palette[(indices >> (i * 2)) & 3];
+                block[i * 4 + 0] = (uint8_t)color[2];
+                block[i * 4 + 1] = (uint8_t)color[1];
+                block[i * 4 + 2] = (uint8_t)color[0];
+                block[i * 4 + 3] = (uint8_t)color[3];
+            }
+        }
+
+        void DecompressAlphaBlock(uint8_t const* in, uint8_t* block) {
+            int32_t palette[8];
+            palette[0] = in[0];
+            palette[1] = in[1];
+            if (palette[0] > palette[1]) {
+                for (int32_t i = 1; i < 7; i++)
+                    palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7;
+            }
+            else {
+                for (int32_t i = 1; i < 5; i++)
+                    palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+            uint64_t indices = 0;
+            for (int32_t i = 0; i < 6; i++)
+                indices |= (uint64_t)in[2 + i] << (i * 8);
+            for (int32_t i = 0; i < 16; i++)
+                block[i * 4 + 3] = (uint8_t)palette[(indices >> (i * 3)) & 7];
+        }
+
+        uint64_t HashBytes(uint64_t hash, void const* data, size_t size) {
+            // FNV-1a
+            auto bytes = static_cast<uint8_t const*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 0x100000001B3ull;
+            }
+            return hash;
+        }
+
+        constexpr uint64_t HASH_BASIS = 0xCBF29CE484222325ull;
+
+        struct CacheHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceSize;
+            int64_t sourceTime;
+            uint64_t sourceHash;
+            uint32_t format;
+            int32_t width;
+            int32_t height;
+            uint32_t numLevels;
+            uint64_t dataSize;
+        };
+
+        constexpr char CACHE_MAGIC[4] = { 'P', 'D', 'X', 'C' };
+    }
+
+    size_t GetBlockLevelSize(int32_t width, int32_t height, eBlockFormat format) {
+        size_t blocksX = std::max((width + 3) / 4, 1);
+        size_t blocksY = std::max((height + 3) / 4, 1);
+        return blocksX * blocksY * BlockSize(format);
+    }
+
+    bool HasTransparency(uint8_t const* bgra, size_t count) {
+        size_t i = 0;
+#ifdef PLUGIN_TEXTURE_COMPRESSOR_SSE2
+        __m128i all = _mm_set1_epi8(-1);
+        for (; i + 4 <= count; i += 4)
+            all = _mm_and_si128(all, _mm_loadu_si128(reinterpret_cast<__m128i const*>(bgra + i * 4)));
+        // alpha is the top byte of every pixel
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(all, _mm_set1_epi8(-1))) & 0x8888) != 0x8888)
+            return true;
+#endif
+        for (; i < count; i++) {
+            if (bgra[i * 4 + 3] != 255)
+                return true;
+        }
+        return false;
+    }
+
+    void CompressLevel(uint8_t const* bgra, int32_t width, int32_t height, eBlockFormat format, uint8_t* out) {
+        uint8_t block[64];
+        for (int32_t by = 0; by < std::max(height, 1); by += 4) {
+            for (int32_t bx = 0; bx < std::max(width, 1); bx += 4) {
+                for (int32_t y = 0; y < 4; y++) {
+                    int32_t sy = std::min(by + y, height - 1);
+                    for (int32_t x = 0; x < 4; x++) {
+                        int32_t sx = std::min(bx + x, width - 1);
+                        memcpy(block + (y * 4 + x) * 4, bgra + ((size_t)sy * width + sx) * 4, 4);
+                    }
+                }
+                uint8_t mn[4], mx[4];
+                GetBounds(block, mn, mx);
+                if (format == BLOCK_BC3) {
+                    CompressAlphaBlock(block, mn[3], mx[3], out);
+                    out += 8;
+                }
+                CompressColorBlock(block, mn, mx, out);
+                out += 8;
+            }
+        }
+    }
+
+    void DecompressLevel(uint8_t const* blocks, int32_t width, int32_t height, eBlockFormat format, uint8_t* bgra) {
+        uint8_t block[64];
+        for (int32_t by = 0; by < std::max(height, 1); by += 4) {
+            for (int32_t bx = 0; bx < std::max(width, 1); bx += 4) {
+                if (format == BLOCK_BC3) {
+                    DecompressColorBlock(blocks + 8, false, block);
+                    DecompressAlphaBlock(blocks, block);
+                    blocks += 16;
+                }
+                else {
+                    DecompressColorBlock(blocks, true, block);
+                    blocks += 8;
+                }
+                for (int32_t y = 0; y < 4 && by + y < height; y++) {
+                    for (int32_t x = 0; x < 4 && bx + x < width; x++)
+                        memcpy(bgra + ((size_t)(by + y) * width + bx + x) * 4, block + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+
+    bool TextureCache::GetSourceKey(std::string const& sourceFile, SourceKey& key) {
+        std::error_code error;
+        key.size = std::filesystem::file_size(sourceFile, error);
+        if (error)
+            return false;
+        key.time = std::filesystem::last_write_time(sourceFile, error).time_since_epoch().count();
+        if (error)
+            return false;
+        std::ifstream file(sourceFile, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        key.hash = HASH_BASIS;
+        char buffer[65536];
+        while (file) {
+            file.read(buffer, sizeof(buffer));
+            key.hash = HashBytes(key.hash, buffer, (size_t)file.gcount());
+        }
+        return true;
+    }
+
+    std::string TextureCache::GetCacheFileName(std::string const& cacheDir, std::string const& sourceFile) {
+        // the path hash keeps files of the same name from different folders apart
+        std::string path = std::filesystem::absolute(sourceFile).lexically_normal().string();
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), ".%016llx.dxc", (unsigned long long)HashBytes(HASH_BASIS, path.data(), path.size()));
+        return (std::filesystem::path(cacheDir) / (std::filesystem::path(sourceFile).filename().string() + suffix)).string();
+    }
+
+    bool TextureCache::Read(std::string const& cacheFile, SourceKey const& key, Entry& entry) {
+        std::ifstream file(cacheFile, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        CacheHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+        if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) || header.version != VERSION
+            || header.sourceSize != key.size || header.sourceTime != key.time || header.sourceHash != key.hash)
+            return false;
+        if ((header.format != BLOCK_BC1 && header.format != BLOCK_BC3) || header.width <= 0 || header.height <= 0 || header.numLevels == 0)
+            return false;
+
+        size_t expected = 0;
+        int32_t w = header.width, h = header.height;
+        for (uint32_t i = 0; i < header.numLevels; i++) {
+            expected += GetBlockLevelSize(w, h, (eBlockFormat)header.format);
+            w = std::max(w / 2, 1);
+            h = std::max(h / 2, 1);
+        }
+        if (header.dataSize != expected)
+            return false;
+
+        entry.format = (eBlockFormat)header.format;
+        entry.width = header.width;
+        entry.height = header.height;
+        entry.numLevels = header.numLevels;
+        entry.blocks.resize((size_t)header.dataSize);
+        return (bool)file.read(reinterpret_cast<char*>(entry.blocks.data()), entry.blocks.size());
+    }
+
+    bool TextureCache::Write(std::string const& cacheFile, SourceKey const& key, Entry const& entry) {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(cacheFile).parent_path(), error);
+        // written next to it and renamed, so a reader never sees half a file
+        std::string tempFile = cacheFile + ".tmp";
+        {
+            std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                return false;
+            CacheHeader header = {};
+            memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            header.version = VERSION;
+            header.sourceSize = key.size;
+            header.sourceTime = key.time;
+            header.sourceHash = key.hash;
+            header.format = entry.format;
+            header.width = entry.width;
+            header.height = entry.height;
+            header.numLevels = entry.numLevels;
+            header.dataSize = entry.blocks.size();
+            file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            file.write(reinterpret_cast<char const*>(entry.blocks.data()), entry.blocks.size());
+            if (!file)
+                return false;
+        }
+        std::filesystem::rename(tempFile, cacheFile, error);
+        if (error) {
+            std::filesystem::remove(tempFile, error);
+            return false;
+        }
+        return true;
+    }
+}
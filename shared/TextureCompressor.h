@@ -0,0 +1,55 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace plugin {
+    enum eBlockFormat : uint32_t {
+        BLOCK_NONE = 0, // 32-bit BGRA
+        BLOCK_BC1 = 1,  // DXT1, opaque
+        BLOCK_BC3 = 3   // DXT5
+    };
+
+    // Bytes of one level in the block format, at least one block per side
+    size_t GetBlockLevelSize(int32_t width, int32_t height, eBlockFormat format);
+    // Whether any pixel of the 32-bit image isn't fully opaque
+    bool HasTransparency(uint8_t const* bgra, size_t count);
+    // Compresses one level of a 32-bit BGRA image, out must hold GetBlockLevelSize bytes.
+    // Sides that aren't a multiple of 4 repeat their last row/column.
+    void CompressLevel(uint8_t const* bgra, int32_t width, int32_t height, eBlockFormat format, uint8_t* out);
+    void DecompressLevel(uint8_t const* blocks, int32_t width, int32_t height, eBlockFormat format, uint8_t* bgra);
+
+    // Compressed sprites kept on disk, one file per source image. A cache file is only used while
+    // the source has the same size, modification time and content hash.
+    class TextureCache {
+    public:
+        struct SourceKey {
+            uint64_t size = 0;
+            int64_t time = 0;
+            uint64_t hash = 0;
+        };
+
+        struct Entry {
+            eBlockFormat format = BLOCK_NONE;
+            int32_t width = 0;
+            int32_t height = 0;
+            uint32_t numLevels = 0;
+            std::vector<uint8_t> blocks; // levels one after another
+        };
+
+        static constexpr uint32_t VERSION = 1;
+
+        // Reads size, time and hash of the source file
+        static bool GetSourceKey(std::string const& sourceFile, SourceKey& key);
+        static std::string GetCacheFileName(std::string const& cacheDir, std::string const& sourceFile);
+        static bool Read(std::string const& cacheFile, SourceKey const& key, Entry& entry);
+        static bool Write(std::string const& cacheFile, SourceKey const& key, Entry const& entry);
+    };
+}
@@ -0,0 +1,149 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plugin {
+    struct ThreadPool::Impl {
+        struct Job {
+            std::function<void(size_t)> const* fn = nullptr;
+            size_t count = 0;
+            std::atomic<size_t> next{ 0 };
+            std::atomic<size_t> done{ 0 };
+            std::exception_ptr error;
+        };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::deque<std::shared_ptr<Job>> jobs;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+
+        bool RunOne(Job& job) {
+            size_t index = job.next++;
+            if (index >= job.count)
+                return false;
+
+            try {
+                (*job.fn)(index);
+            }
+            catch (...) {
+                // counted as done all the same, the caller would wait for it forever otherwise
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+
+            if (++job.done == job.count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+            return true;
+        }
+
+        void Worker() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+
+                auto job = jobs.front();
+                lock.unlock();
+                while (RunOne(*job));
+                lock.lock();
+
+                if (!jobs.empty() && jobs.front() == job)
+                    jobs.pop_front();
+            }
+        }
+    };
+
+    ThreadPool::ThreadPool() : impl(new Impl) {}
+
+    ThreadPool& ThreadPool::Get() {
+        static ThreadPool* pool = new ThreadPool;
+        return *pool;
+    }
+
+    void ThreadPool::Run(size_t count, unsigned threads, std::function<void(size_t)> const& fn) {
+        auto job = std::make_shared<Impl::Job>();
+        job->fn = &fn;
+        job->count = count;
+
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            if (!impl->stopping) {
+                impl->jobs.push_back(job);
+                while (impl->workers.size() + 1 < threads)
+                    impl->workers.emplace_back(&Impl::Worker, impl);
+            }
+        }
+        impl->wake.notify_all();
+
+        while (impl->RunOne(*job));
+
+        // the workers may still be inside fn, which lives on the caller's stack
+        std::unique_lock<std::mutex> lock(impl->mutex);
+        impl->jobs.erase(std::remove(impl->jobs.begin(), impl->jobs.end(), job), impl->jobs.end());
+        impl->finished.wait(lock, [&] { return job->done == job->count; });
+
+        if (job->error)
+            std::rethrow_exception(job->error);
+    }
+
+    void ThreadPool::Shutdown() {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            impl->stopping = true;
+            workers.swap(impl->workers);
+        }
+        impl->wake.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    unsigned ThreadPool::GetNumWorkers() {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        return (unsigned)impl->workers.size();
+    }
+
+    static std::atomic<unsigned> workerThreads{ 0 };
+
+    void SetWorkerThreads(unsigned count) {
+        workerThreads = count;
+    }
+
+    unsigned GetWorkerThreads() {
+        unsigned count = workerThreads;
+        if (count == 0)
+            count = std::min(std::max(std::thread::hardware_concurrency(), 1u), 8u);
+        return count;
+    }
+
+    void ParallelFor(size_t count, std::function<void(size_t)> const& fn) {
+        unsigned threads = GetWorkerThreads();
+        if (threads <= 1 || count <= 1) {
+            for (size_t i = 0; i < count; i++)
+                fn(i);
+            return;
+        }
+
+        ThreadPool::Get().Run(count, threads, fn);
+    }
+}
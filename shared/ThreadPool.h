@@ -0,0 +1,51 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace plugin {
+    // Worker threads shared by the pattern scanner and the file loaders, started when work is first split
+    // between more threads than there are. The calling thread always works on its own job as well, so a job
+    // completes even if the workers can't start yet, as it happens while the loader lock is held during
+    // static initialization of a plugin.
+    // The workers stay until Shutdown. Call it when the plugin shuts down, e.g. from Events::shutdownRwEvent,
+    // and never from DllMain or a static destructor: a worker can't exit while the loader lock is held, so
+    // joining it there would hang. Without a Shutdown they are ended with the process.
+    class ThreadPool {
+    public:
+        // Never destroyed, destroying threads that are still running would terminate the process
+        static ThreadPool& Get();
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        // Calls fn(0) ... fn(count - 1) on up to 'threads' threads, the calling one included, and waits for
+        // all of them. The calls may run in any order and at the same time. If calls throw, the rest still
+        // run and the first exception is rethrown here once all are done.
+        void Run(size_t count, unsigned threads, std::function<void(size_t)> const& fn);
+
+        // Wakes and joins the workers, jobs still running are finished first. Later jobs run on the calling thread.
+        void Shutdown();
+
+        unsigned GetNumWorkers();
+
+    private:
+        struct Impl;
+        Impl* impl;
+
+        ThreadPool();
+    };
+
+    // Threads ParallelFor splits work between, the calling thread included. 0 picks one per hardware thread,
+    // at most 8 (the default), 1 runs everything on the calling thread.
+    void SetWorkerThreads(unsigned count);
+    unsigned GetWorkerThreads();
+
+    // ThreadPool::Run with GetWorkerThreads() threads, runs on the calling thread alone if it's only one call
+    void ParallelFor(size_t count, std::function<void(size_t)> const& fn);
+}
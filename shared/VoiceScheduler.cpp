@@ -0,0 +1,345 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "VoiceScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace plugin {
+    // Where a voice is once it has moved on to offset: past the loop end it goes back to the loop start,
+    // negative when a one-shot has reached the end of its sample
+    static float Wrap(VoiceParams const& params, float length, float offset) {
+        if (length <= 0.0f)
+            return offset;
+
+        float end = params.loop && params.loopEnd > 0.0f ? std::min(params.loopEnd, length) : length;
+        if (offset < end)
+            return offset;
+        if (!params.loop)
+            return -1.0f;
+
+        float start = params.loopStart < end ? params.loopStart : 0.0f;
+        return start + std::fmod(offset - start, end - start);
+    }
+
+    void NullVoiceBackend::Advance(float seconds) {
+        for (auto& it : channels) {
+            if (!it.playing || it.paused)
+                continue;
+
+            it.offset = Wrap(it.params, GetSampleLength(it.params.sample), it.offset + seconds * it.params.pitch);
+            if (it.offset < 0.0f)
+                it.playing = false;
+        }
+    }
+
+    uint32_t NullVoiceBackend::GetNumChannels() {
+        return (uint32_t)channels.size();
+    }
+
+    float NullVoiceBackend::GetSampleLength(int32_t sample) {
+        if (sample < 0 || (size_t)sample >= sampleLengths.size())
+            return 0.0f;
+        return sampleLengths[sample];
+    }
+
+    bool NullVoiceBackend::Start(uint32_t channel, VoiceParams const& params, float volume, float offset) {
+        auto& it = channels[channel];
+        it.playing = true;
+        it.paused = false;
+        it.params = params;
+        it.volume = volume;
+        it.offset = offset;
+        numStarts++;
+        return true;
+    }
+
+    void NullVoiceBackend::Stop(uint32_t channel) {
+        channels[channel].playing = false;
+        numStops++;
+    }
+
+    void NullVoiceBackend::SetPaused(uint32_t channel, bool paused) {
+        channels[channel].paused = paused;
+    }
+
+    void NullVoiceBackend::Update(uint32_t channel, VoiceParams const& params, float volume) {
+        channels[channel].params = params;
+        channels[channel].volume = volume;
+    }
+
+    float NullVoiceBackend::GetOffset(uint32_t channel) {
+        return channels[channel].playing ? channels[channel].offset : -1.0f;
+    }
+
+    VoiceScheduler::VoiceScheduler(VoiceBackend& backend) : backend(backend) {
+        // lowest channels are handed out first
+        for (uint32_t i = backend.GetNumChannels(); i > 0; i--)
+            freeChannels.push_back(i - 1);
+    }
+
+    VoiceScheduler::~VoiceScheduler() {
+        StopAll();
+    }
+
+    VoiceScheduler::Handle VoiceScheduler::Play(VoiceParams const& params) {
+        uint32_t index;
+        if (!freeVoices.empty()) {
+            index = freeVoices.back();
+            freeVoices.pop_back();
+        }
+        else {
+            if (voices.size() > 0xFFFF)
+                return INVALID_HANDLE;
+            index = (uint32_t)voices.size();
+            voices.emplace_back();
+        }
+
+        Voice& voice = voices[index];
+        voice.params = params;
+        voice.offset = 0.0f;
+        voice.length = backend.GetSampleLength(params.sample);
+        voice.channel = NO_CHANNEL;
+        voice.active = true;
+        voice.dirty = false;
+        voice.activeIndex = (uint32_t)active.size();
+        active.push_back(index);
+        return ((Handle)voice.generation << 16) | index;
+    }
+
+    void VoiceScheduler::Stop(Handle handle) {
+        if (Voice* voice = Get(handle)) {
+            if (voice->channel != NO_CHANNEL) {
+                backend.Stop(voice->channel);
+                freeChannels.push_back(voice->channel);
+                voice->channel = NO_CHANNEL;
+                numReal--;
+            }
+            Release(handle & 0xFFFF);
+        }
+    }
+
+    void VoiceScheduler::StopAll() {
+        while (!active.empty()) {
+            uint32_t index = active.back();
+            Stop(((Handle)voices[index].generation << 16) | index);
+        }
+    }
+
+    bool VoiceScheduler::IsPlaying(Handle handle) const {
+        return Get(handle) != nullptr;
+    }
+
+    bool VoiceScheduler::IsVirtual(Handle handle) const {
+        Voice const* voice = Get(handle);
+        return voice && voice->channel == NO_CHANNEL;
+    }
+
+    float VoiceScheduler::GetOffset(Handle handle) const {
+        Voice const* voice = Get(handle);
+        return voice ? voice->offset : 0.0f;
+    }
+
+    VoiceParams const* VoiceScheduler::GetParams(Handle handle) const {
+        Voice const* voice = Get(handle);
+        return voice ? &voice->params : nullptr;
+    }
+
+    void VoiceScheduler::SetParams(Handle handle, VoiceParams const& params) {
+        if (Voice* voice = Get(handle)) {
+            if (params.sample != voice->params.sample) {
+                // a different sample can't just be updated, it starts over once the channel is gone
+                if (voice->channel != NO_CHANNEL)
+                    Virtualize(*voice);
+                voice->length = backend.GetSampleLength(params.sample);
+                voice->offset = 0.0f;
+            }
+            voice->params = params;
+            voice->dirty = true;
+        }
+    }
+
+    void VoiceScheduler::SetVolume(Handle handle, float volume) {
+        if (Voice* voice = Get(handle)) {
+            voice->params.volume = volume;
+            voice->dirty = true;
+        }
+    }
+
+    void VoiceScheduler::SetPosition(Handle handle, float x, float y, float z) {
+        if (Voice* voice = Get(handle)) {
+            voice->params.x = x;
+            voice->params.y = y;
+            voice->params.z = z;
+            voice->dirty = true;
+        }
+    }
+
+    void VoiceScheduler::SetListener(float x, float y, float z) {
+        listener[0] = x;
+        listener[1] = y;
+        listener[2] = z;
+    }
+
+    void VoiceScheduler::SetMasterVolume(float volume) {
+        if (volume == masterVolume)
+            return;
+
+        masterVolume = volume;
+        for (uint32_t index : active)
+            voices[index].dirty = true;
+    }
+
+    void VoiceScheduler::SetPaused(bool on) {
+        if (on == paused)
+            return;
+
+        paused = on;
+        for (uint32_t index : active) {
+            if (voices[index].channel != NO_CHANNEL)
+                backend.SetPaused(voices[index].channel, on);
+        }
+    }
+
+    void VoiceScheduler::Update(float timeStep) {
+        if (paused)
+            return;
+
+        ranked.clear();
+        for (size_t i = 0; i < active.size();) {
+            uint32_t index = active[i];
+            Voice& voice = voices[index];
+            if (voice.channel != NO_CHANNEL) {
+                float offset = backend.GetOffset(voice.channel);
+                if (offset < 0.0f) {
+                    // finished on its own
+                    freeChannels.push_back(voice.channel);
+                    voice.channel = NO_CHANNEL;
+                    numReal--;
+                    Release(index);
+                    continue;
+                }
+                voice.offset = offset;
+            }
+            else {
+                voice.offset = Wrap(voice.params, voice.length, voice.offset + timeStep * voice.params.pitch);
+                if (voice.offset < 0.0f) {
+                    Release(index);
+                    continue;
+                }
+            }
+
+            voice.rank = GetAudibility(voice.params);
+            if (voice.rank > 0.0f) {
+                if (voice.channel != NO_CHANNEL)
+                    voice.rank *= REAL_BONUS;
+                ranked.push_back(index);
+            }
+            else if (voice.channel != NO_CHANNEL)
+                Virtualize(voice);
+            i++;
+        }
+
+        size_t numChannels = backend.GetNumChannels();
+        size_t count = std::min(ranked.size(), numChannels);
+        if (ranked.size() > count) {
+            std::nth_element(ranked.begin(), ranked.begin() + count, ranked.end(), [this](uint32_t a, uint32_t b) {
+                Voice const& va = voices[a];
+                Voice const& vb = voices[b];
+                if (va.params.priority != vb.params.priority)
+                    return va.params.priority > vb.params.priority;
+                return va.rank > vb.rank;
+            });
+            // channels of the voices that lost are needed by the ones that won
+            for (size_t i = count; i < ranked.size(); i++) {
+                if (voices[ranked[i]].channel != NO_CHANNEL)
+                    Virtualize(voices[ranked[i]]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            Voice& voice = voices[ranked[i]];
+            float volume = voice.params.volume * masterVolume;
+            if (voice.channel == NO_CHANNEL) {
+                if (freeChannels.empty())
+                    break;
+                uint32_t channel = freeChannels.back();
+                if (!backend.Start(channel, voice.params, volume, voice.offset))
+                    continue;
+                freeChannels.pop_back();
+                voice.channel = channel;
+                numReal++;
+            }
+            else if (voice.dirty)
+                backend.Update(voice.channel, voice.params, volume);
+            voice.dirty = false;
+        }
+    }
+
+    size_t VoiceScheduler::GetNumVoices() const {
+        return active.size();
+    }
+
+    size_t VoiceScheduler::GetNumReal() const {
+        return numReal;
+    }
+
+    float VoiceScheduler::GetAudibility(VoiceParams const& params) const {
+        if (params.volume <= 0.0f)
+            return 0.0f;
+        if (!params.is3d)
+            return params.volume;
+
+        float dx = params.x - listener[0];
+        float dy = params.y - listener[1];
+        float dz = params.z - listener[2];
+        float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (distance >= params.maxDistance)
+            return 0.0f;
+        if (distance <= params.minDistance)
+            return params.volume;
+        return params.volume * params.minDistance / distance;
+    }
+
+    VoiceScheduler::Voice* VoiceScheduler::Get(Handle handle) {
+        return const_cast<Voice*>(static_cast<VoiceScheduler const*>(this)->Get(handle));
+    }
+
+    VoiceScheduler::Voice const* VoiceScheduler::Get(Handle handle) const {
+        uint32_t index = handle & 0xFFFF;
+        if (handle == INVALID_HANDLE || index >= voices.size())
+            return nullptr;
+        Voice const& voice = voices[index];
+        if (!voice.active || voice.generation != (handle >> 16))
+            return nullptr;
+        return &voice;
+    }
+
+    void VoiceScheduler::Release(uint32_t index) {
+        Voice& voice = voices[index];
+        uint32_t last = active.back();
+        active[voice.activeIndex] = last;
+        voices[last].activeIndex = voice.activeIndex;
+        active.pop_back();
+
+        voice.active = false;
+        // 0 would make the first handle of the slot look invalid
+        if (++voice.generation == 0)
+            voice.generation = 1;
+        freeVoices.push_back(index);
+    }
+
+    void VoiceScheduler::Virtualize(Voice& voice) {
+        float offset = backend.GetOffset(voice.channel);
+        if (offset >= 0.0f)
+            voice.offset = offset;
+        backend.Stop(voice.channel);
+        freeChannels.push_back(voice.channel);
+        voice.channel = NO_CHANNEL;
+        voice.dirty = true;
+        numReal--;
+    }
+}
@@ -0,0 +1,154 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+namespace plugin {
+    // What a voice plays and how loud, volume and pitch are linear (1.0 is as sampled)
+    struct VoiceParams {
+        int32_t sample = -1;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        int32_t priority = 0; // higher priorities always win over more audible voices
+        bool loop = false;
+        // part of the sample that loops, in seconds, a loopEnd of 0 is the end of the sample
+        float loopStart = 0.0f;
+        float loopEnd = 0.0f;
+        bool is3d = true;
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        float minDistance = 10.0f; // full volume up to here, then falls off with 1/distance
+        float maxDistance = 100.0f; // silent beyond
+    };
+
+    // Where the voices really play, one channel for each voice that's audible.
+    // Offsets are in seconds of the sample at pitch 1.
+    class VoiceBackend {
+    public:
+        virtual ~VoiceBackend() {}
+
+        virtual uint32_t GetNumChannels() = 0;
+        // 0 for samples without a known end, they're never finished while virtual
+        virtual float GetSampleLength(int32_t sample) = 0;
+        // Plays the voice on the channel from offset and loops it between the params' loop points, false if it can't
+        virtual bool Start(uint32_t channel, VoiceParams const& params, float volume, float offset) = 0;
+        virtual void Stop(uint32_t channel) = 0;
+        virtual void SetPaused(uint32_t channel, bool paused) = 0;
+        // Volume, pitch and position changed
+        virtual void Update(uint32_t channel, VoiceParams const& params, float volume) = 0;
+        // Where the channel is, negative once it has finished
+        virtual float GetOffset(uint32_t channel) = 0;
+    };
+
+    // Backend that plays nothing, offsets move on with Advance. For tests and benchmarks.
+    class NullVoiceBackend : public VoiceBackend {
+    public:
+        struct Channel {
+            bool playing = false;
+            bool paused = false;
+            VoiceParams params;
+            float volume = 0.0f;
+            float offset = 0.0f;
+        };
+
+        std::vector<Channel> channels;
+        std::vector<float> sampleLengths;
+        uint32_t numStarts = 0;
+        uint32_t numStops = 0;
+
+        NullVoiceBackend(uint32_t numChannels, std::vector<float> sampleLengths)
+            : channels(numChannels), sampleLengths(std::move(sampleLengths)) {}
+
+        void Advance(float seconds);
+
+        uint32_t GetNumChannels() override;
+        float GetSampleLength(int32_t sample) override;
+        bool Start(uint32_t channel, VoiceParams const& params, float volume, float offset) override;
+        void Stop(uint32_t channel) override;
+        void SetPaused(uint32_t channel, bool paused) override;
+        void Update(uint32_t channel, VoiceParams const& params, float volume) override;
+        float GetOffset(uint32_t channel) override;
+    };
+
+    // Keeps many more voices than the backend has channels. Every Update the voices are ranked by
+    // priority and how loud they are at the listener, the most audible ones play on a channel and the
+    // rest are virtual: they only keep track of where they'd be, so when one comes back it continues
+    // from there instead of starting over. Taking a channel from a quieter voice is just a stop and a start.
+    class VoiceScheduler {
+    public:
+        // Index and generation, a stopped voice's handle doesn't match the slot's next voice
+        using Handle = uint32_t;
+        static constexpr Handle INVALID_HANDLE = 0;
+
+        explicit VoiceScheduler(VoiceBackend& backend);
+        ~VoiceScheduler();
+
+        VoiceScheduler(VoiceScheduler const&) = delete;
+        VoiceScheduler& operator=(VoiceScheduler const&) = delete;
+
+        // The voice starts virtual and gets its channel with the next Update
+        Handle Play(VoiceParams const& params);
+        void Stop(Handle voice);
+        void StopAll();
+        // Still playing, really or virtually
+        bool IsPlaying(Handle voice) const;
+        bool IsVirtual(Handle voice) const;
+        float GetOffset(Handle voice) const;
+        VoiceParams const* GetParams(Handle voice) const;
+        // Changes are sent to the backend by the next Update
+        void SetParams(Handle voice, VoiceParams const& params);
+        void SetVolume(Handle voice, float volume);
+        void SetPosition(Handle voice, float x, float y, float z);
+
+        void SetListener(float x, float y, float z);
+        void SetMasterVolume(float volume);
+        void SetPaused(bool paused);
+
+        // Moves the voices on by timeStep seconds, drops finished ones and hands out the channels
+        void Update(float timeStep);
+
+        size_t GetNumVoices() const;
+        size_t GetNumReal() const;
+        // Volume at the listener, 0 if it can't be heard
+        float GetAudibility(VoiceParams const& params) const;
+
+    private:
+        static constexpr uint32_t NO_CHANNEL = 0xFFFFFFFF;
+        // so voices of about the same loudness don't keep swapping channels
+        static constexpr float REAL_BONUS = 1.25f;
+
+        struct Voice {
+            VoiceParams params;
+            float offset = 0.0f;
+            float length = 0.0f;
+            float rank = 0.0f;
+            uint32_t channel = NO_CHANNEL;
+            uint32_t activeIndex = 0;
+            uint16_t generation = 1;
+            bool active = false;
+            bool dirty = false;
+        };
+
+        VoiceBackend& backend;
+        std::vector<Voice> voices;
+        std::vector<uint32_t> freeVoices;
+        std::vector<uint32_t> active;
+        std::vector<uint32_t> freeChannels;
+        std::vector<uint32_t> ranked;
+        float listener[3] = {};
+        float masterVolume = 1.0f;
+        size_t numReal = 0;
+        bool paused = false;
+
+        Voice* Get(Handle voice);
+        Voice const* Get(Handle voice) const;
+        void Release(uint32_t index);
+        void Virtualize(Voice& voice);
+    };
+}
@@ -29,39 +29,55 @@ namespace plugin {
         }
     };
 
-    template <typename T> class ObjectExtendedData : public ExtenderInterface<CObject> {
-        T **blocks;
-        unsigned int numBlocks;
+    // Storage is ExtendedDataHeap (a block allocated per object) or ExtendedDataSlots (one array
+    // indexed by pool slot, see Extender.h).
+    template <typename T, template <typename, typename> class Storage = ExtendedDataHeap>
+    class ObjectExtendedData : public ExtenderInterface<CObject> {
+        ExtendedDataBlocks<T, CObject, Storage> blocks;
 
         void AllocateBlocks() {
-            numBlocks = CPools::ms_pObjectPool->m_nSize;
-            blocks = new T*[numBlocks];
-            for (unsigned int i = 0; i < numBlocks; i++)
-                blocks[i] = 0;
+            blocks.Allocate(CPools::ms_pObjectPool->m_nSize);
         }
 
         void OnConstructor(CObject *object) {
-            blocks[CPools::ms_pObjectPool->GetIndex(object)] = new T(object);
+            int index = CPools::ms_pObjectPool->GetIndex(object);
+            blocks.Construct(index, CPools::ms_pObjectPool->GetIdAt(index), object);
         }
 
         void OnDestructor(CObject *object) {
-            delete blocks[CPools::ms_pObjectPool->GetIndex(object)];
-            blocks[CPools::ms_pObjectPool->GetIndex(object)] = 0;
+            blocks.Destroy(CPools::ms_pObjectPool->GetIndex(object));
         }
     public:
         ObjectExtendedData() {
-            blocks = 0;
             ObjectExtendersHandler::Add(this);
         }
 
-        ~ObjectExtendedData() {
-            for (unsigned int i = 0; i < numBlocks; i++)
-                delete blocks[i];
-            delete[] blocks;
+        T &Get(CObject *object) {
+            return blocks.Get(CPools::ms_pObjectPool->GetIndex(object));
         }
 
-        T &Get(CObject *object) {
-            return *blocks[CPools::ms_pObjectPool->GetIndex(object)];
+        // Returns nullptr if there's no data for this object. The id checked is the one the slot has
+        // now, so a pointer kept from a object that's gone finds the data of the object that took its slot.
+        T *Find(CObject *object) {
+            int index = CPools::ms_pObjectPool->GetIndex(object);
+            if (index < 0 || index >= CPools::ms_pObjectPool->m_nSize)
+                return nullptr;
+            return blocks.Find(index, CPools::ms_pObjectPool->GetIdAt(index));
+        }
+
+        // Stale-safe lookup by handle (CPools::GetObjectRef): returns nullptr if there's no data for
+        // the object, also once the object is gone and its slot is used by another one.
+        T *Find(int ref) {
+            return blocks.FindRef(ref);
+        }
+
+        // Calls fn(CObject *, T &) for every object that has data, in pool order
+        template <typename Fn>
+        void ForEach(Fn fn) {
+            for (unsigned int i = 0; i < blocks.Size(); i++) {
+                if (blocks.IsConstructed(i))
+                    fn(reinterpret_cast<CObject *>(&CPools::ms_pObjectPool->m_pObjects[i]), blocks.Get(i));
+            }
         }
     };
 }
@@ -29,39 +29,55 @@ namespace plugin {
         }
     };
 
-    template <typename T> class PedExtendedData : public ExtenderInterface<CPed> {
-        T **blocks;
-        unsigned int numBlocks;
+    // Storage is ExtendedDataHeap (a block allocated per ped) or ExtendedDataSlots (one array
+    // indexed by pool slot, see Extender.h).
+    template <typename T, template <typename, typename> class Storage = ExtendedDataHeap>
+    class PedExtendedData : public ExtenderInterface<CPed> {
+        ExtendedDataBlocks<T, CPed, Storage> blocks;
 
         void AllocateBlocks() {
-            numBlocks = CPools::ms_pPedPool->m_nSize;
-            blocks = new T*[numBlocks];
-            for (unsigned int i = 0; i < numBlocks; i++)
-                blocks[i] = 0;
+            blocks.Allocate(CPools::ms_pPedPool->m_nSize);
         }
 
         void OnConstructor(CPed *ped) {
-            blocks[CPools::ms_pPedPool->GetIndex(ped)] = new T(ped);
+            int index = CPools::ms_pPedPool->GetIndex(ped);
+            blocks.Construct(index, CPools::ms_pPedPool->GetIdAt(index), ped);
         }
 
         void OnDestructor(CPed *ped) {
-            delete blocks[CPools::ms_pPedPool->GetIndex(ped)];
-            blocks[CPools::ms_pPedPool->GetIndex(ped)] = 0;
+            blocks.Destroy(CPools::ms_pPedPool->GetIndex(ped));
         }
     public:
         PedExtendedData() {
-            blocks = 0;
             PedExtendersHandler::Add(this);
         }
 
-        ~PedExtendedData() {
-            for (unsigned int i = 0; i < numBlocks; i++)
-                delete blocks[i];
-            delete[] blocks;
+        T &Get(CPed *ped) {
+            return blocks.Get(CPools::ms_pPedPool->GetIndex(ped));
         }
 
-        T &Get(CPed *ped) {
-            return *blocks[CPools::ms_pPedPool->GetIndex(ped)];
+        // Returns nullptr if there's no data for this ped. The id checked is the one the slot has
+        // now, so a pointer kept from a ped that's gone finds the data of the ped that took its slot.
+        T *Find(CPed *ped) {
+            int index = CPools::ms_pPedPool->GetIndex(ped);
+            if (index < 0 || index >= CPools::ms_pPedPool->m_nSize)
+                return nullptr;
+            return blocks.Find(index, CPools::ms_pPedPool->GetIdAt(index));
+        }
+
+        // Stale-safe lookup by handle (CPools::GetPedRef): returns nullptr if there's no data for
+        // the ped, also once the ped is gone and its slot is used by another one.
+        T *Find(int ref) {
+            return blocks.FindRef(ref);
+        }
+
+        // Calls fn(CPed *, T &) for every ped that has data, in pool order
+        template <typename Fn>
+        void ForEach(Fn fn) {
+            for (unsigned int i = 0; i < blocks.Size(); i++) {
+                if (blocks.IsConstructed(i))
+                    fn(reinterpret_cast<CPed *>(&CPools::ms_pPedPool->m_pObjects[i]), blocks.Get(i));
+            }
         }
     };
 }
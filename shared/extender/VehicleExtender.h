@@ -29,39 +29,55 @@ namespace plugin {
         }
     };
 
-    template <typename T> class VehicleExtendedData : public ExtenderInterface<CVehicle> {
-        T **blocks;
-        unsigned int numBlocks;
+    // Storage is ExtendedDataHeap (a block allocated per vehicle) or ExtendedDataSlots (one array
+    // indexed by pool slot, see Extender.h).
+    template <typename T, template <typename, typename> class Storage = ExtendedDataHeap>
+    class VehicleExtendedData : public ExtenderInterface<CVehicle> {
+        ExtendedDataBlocks<T, CVehicle, Storage> blocks;
 
         void AllocateBlocks() {
-            numBlocks = CPools::ms_pVehiclePool->m_nSize;
-            blocks = new T*[numBlocks];
-            for (unsigned int i = 0; i < numBlocks; i++)
-                blocks[i] = 0;
+            blocks.Allocate(CPools::ms_pVehiclePool->m_nSize);
         }
 
         void OnConstructor(CVehicle *vehicle) {
-            blocks[CPools::ms_pVehiclePool->GetIndex(vehicle)] = new T(vehicle);
+            int index = CPools::ms_pVehiclePool->GetIndex(vehicle);
+            blocks.Construct(index, CPools::ms_pVehiclePool->GetIdAt(index), vehicle);
         }
 
         void OnDestructor(CVehicle *vehicle) {
-            delete blocks[CPools::ms_pVehiclePool->GetIndex(vehicle)];
-            blocks[CPools::ms_pVehiclePool->GetIndex(vehicle)] = 0;
+            blocks.Destroy(CPools::ms_pVehiclePool->GetIndex(vehicle));
         }
     public:
         VehicleExtendedData() {
-            blocks = 0;
             VehicleExtendersHandler::Add(this);
         }
 
-        ~VehicleExtendedData() {
-            for (unsigned int i = 0; i < numBlocks; i++)
-                delete blocks[i];
-            delete[] blocks;
+        T &Get(CVehicle *vehicle) {
+            return blocks.Get(CPools::ms_pVehiclePool->GetIndex(vehicle));
         }
 
-        T &Get(CVehicle *vehicle) {
-            return *blocks[CPools::ms_pVehiclePool->GetIndex(vehicle)];
+        // Returns nullptr if there's no data for this vehicle. The id checked is the one the slot has
+        // now, so a pointer kept from a vehicle that's gone finds the data of the vehicle that took its slot.
+        T *Find(CVehicle *vehicle) {
+            int index = CPools::ms_pVehiclePool->GetIndex(vehicle);
+            if (index < 0 || index >= CPools::ms_pVehiclePool->m_nSize)
+                return nullptr;
+            return blocks.Find(index, CPools::ms_pVehiclePool->GetIdAt(index));
+        }
+
+        // Stale-safe lookup by handle (CPools::GetVehicleRef): returns nullptr if there's no data for
+        // the vehicle, also once the vehicle is gone and its slot is used by another one.
+        T *Find(int ref) {
+            return blocks.FindRef(ref);
+        }
+
+        // Calls fn(CVehicle *, T &) for every vehicle that has data, in pool order
+        template <typename Fn>
+        void ForEach(Fn fn) {
+            for (unsigned int i = 0; i < blocks.Size(); i++) {
+                if (blocks.IsConstructed(i))
+                    fn(reinterpret_cast<CVehicle *>(&CPools::ms_pVehiclePool->m_pObjects[i]), blocks.Get(i));
+            }
         }
     };
 }
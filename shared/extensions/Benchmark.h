@@ -0,0 +1,61 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+#include "Paths.h"
+#include <chrono>
+#include <cstdio>
+
+namespace plugin {
+    namespace benchmark {
+        // Nanoseconds per call, fn called 'calls' times in a row
+        template<typename Fn>
+        double Measure(int calls, Fn&& fn) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < calls; ++i)
+                fn();
+            std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+            return time.count() / calls;
+        }
+
+        // Nanoseconds of the fastest of 'runs' calls, leaves out runs slowed down by the rest of the system
+        template<typename Fn>
+        double MeasureBest(int runs, Fn&& fn) {
+            double best = 0.0;
+            for (int i = 0; i < runs; ++i) {
+                double time = Measure(1, fn);
+                if (i == 0 || time < best)
+                    best = time;
+            }
+            return best;
+        }
+
+        // Text file in the plugin's directory the results are written to with fprintf, closed when it goes
+        // out of scope. Converts to a null FILE* if it couldn't be created.
+        class Report {
+        public:
+            explicit Report(const char* fileName) {
+                if (fopen_s(&file, paths::GetPluginDirRelativePathA(fileName), "w") != 0)
+                    file = nullptr;
+            }
+
+            ~Report() {
+                if (file)
+                    fclose(file);
+            }
+
+            Report(Report const&) = delete;
+            Report& operator=(Report const&) = delete;
+
+            operator FILE*() const {
+                return file;
+            }
+
+        private:
+            FILE* file = nullptr;
+        };
+    }
+}
@@ -6,9 +6,67 @@
 */
 #include "Config.h"
 #include <iomanip>
+#include <charconv>
 
 using namespace plugin;
 
+namespace {
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    }
+
+    bool isCommentChar(char c) {
+        return c == '#' || c == ';';
+    }
+
+    // Same as reading one number with operator>>: leading blanks and '+' are skipped
+    template <typename T>
+    bool parseNumber(const char *&first, const char *last, T &value) {
+        while (first != last && isBlank(*first))
+            ++first;
+        if (first != last && *first == '+' && first + 1 != last && first[1] != '-' && first[1] != '+')
+            ++first;
+        T result;
+        auto [ptr, ec] = std::from_chars(first, last, result);
+        if (ec != std::errc())
+            return false;
+        // written by setUsePrecision()
+        if constexpr (std::is_floating_point_v<T>) {
+            if (ptr != last && (*ptr == 'f' || *ptr == 'F'))
+                ++ptr;
+        }
+        first = ptr;
+        value = result;
+        return true;
+    }
+
+    template <typename T>
+    bool parseOne(std::string const &strinput, T &value) {
+        const char *first = strinput.data();
+        return parseNumber(first, first + strinput.size(), value);
+    }
+
+    template <typename T>
+    size_t parseArray(std::string const &strinput, std::vector<T> &arr) {
+        const char *first = strinput.data();
+        const char *last = first + strinput.size();
+        T val;
+        while (parseNumber(first, last, val))
+            arr.push_back(val);
+        return arr.size();
+    }
+
+    template <typename T>
+    unsigned int parseValues(std::string const &strinput, T *values, unsigned int maxValues) {
+        const char *first = strinput.data();
+        const char *last = first + strinput.size();
+        unsigned int count = 0;
+        while (count < maxValues && parseNumber(first, last, values[count]))
+            count++;
+        return count;
+    }
+}
+
 bool config_helper::config_extract_one_value(std::string const &strinput, bool &value) {
     if (!strinput.empty()) {
         if (!strinput.compare("0") || !strinput.compare("false") || !strinput.compare("FALSE") || !strinput.compare("no") || !strinput.compare("NO"))
@@ -32,6 +90,30 @@ size_t config_helper::config_extract_values_array(std::string const &strinput, s
     return arr.size();
 }
 
+bool config_helper::config_extract_one_value(std::string const &strinput, int &value) {
+    return parseOne(strinput, value);
+}
+
+bool config_helper::config_extract_one_value(std::string const &strinput, float &value) {
+    return parseOne(strinput, value);
+}
+
+size_t config_helper::config_extract_values_array(std::string const &strinput, std::vector<int> &arr) {
+    return parseArray(strinput, arr);
+}
+
+size_t config_helper::config_extract_values_array(std::string const &strinput, std::vector<float> &arr) {
+    return parseArray(strinput, arr);
+}
+
+unsigned int config_helper::config_extract_values(std::string const &strinput, int *values, unsigned int maxValues) {
+    return parseValues(strinput, values, maxValues);
+}
+
+unsigned int config_helper::config_extract_values(std::string const &strinput, float *values, unsigned int maxValues) {
+    return parseValues(strinput, values, maxValues);
+}
+
 config_parameter::config_parameter() {
     _notInitialised = true;
     _quotes = true;
@@ -47,20 +129,62 @@ bool config_parameter::isEmpty() {
     return _notInitialised;
 }
 
+void config_parameter::resetCache() {
+    _cached = 0;
+    _valid = 0;
+}
+
+void config_parameter::validateCache() {
+    if (_cached == 0)
+        _cachedValue = _value;
+    else if (_cachedValue != _value) {
+        resetCache();
+        _cachedValue = _value;
+    }
+}
+
+unsigned int config_parameter::cachedInts() {
+    validateCache();
+    if (!(_cached & CACHED_INTS)) {
+        _numInts = (unsigned char)config_helper::config_extract_values(_value, _ints, 4);
+        _cached |= CACHED_INTS;
+    }
+    return _numInts;
+}
+
+unsigned int config_parameter::cachedFloats() {
+    validateCache();
+    if (!(_cached & CACHED_FLOATS)) {
+        _numFloats = (unsigned char)config_helper::config_extract_values(_value, _floats, 4);
+        _cached |= CACHED_FLOATS;
+    }
+    return _numFloats;
+}
+
 float config_parameter::asFloat(float defaultVal) {
-    float fval;
-    if (_notInitialised || !config_helper::config_extract_one_value(_value, fval))
+    if (_notInitialised)
         return defaultVal;
-    return fval;
+    validateCache();
+    if (!(_cached & CACHED_FLOAT)) {
+        if (config_helper::config_extract_one_value(_value, _float))
+            _valid |= CACHED_FLOAT;
+        _cached |= CACHED_FLOAT;
+    }
+    return (_valid & CACHED_FLOAT) ? _float : defaultVal;
 }
 
 float config_parameter::asFloat() { return asFloat(0.0f); }
 
 unsigned int config_parameter::asInt(int defaultVal) {
-    int ival;
-    if (_notInitialised || !config_helper::config_extract_one_value(_value, ival))
+    if (_notInitialised)
         return defaultVal;
-    return ival;
+    validateCache();
+    if (!(_cached & CACHED_INT)) {
+        if (config_helper::config_extract_one_value(_value, _int))
+            _valid |= CACHED_INT;
+        _cached |= CACHED_INT;
+    }
+    return (_valid & CACHED_INT) ? _int : defaultVal;
 }
 
 unsigned int config_parameter::asInt() { return asInt(0); }
@@ -76,10 +200,15 @@ std::string config_parameter::asString(std::string defaultVal) {
 std::string config_parameter::asString() { return asString(std::string()); }
 
 bool config_parameter::asBool(bool defaultVal) {
-    bool bval;
-    if (_notInitialised || !config_helper::config_extract_one_value(_value, bval))
+    if (_notInitialised)
         return defaultVal;
-    return bval;
+    validateCache();
+    if (!(_cached & CACHED_BOOL)) {
+        if (config_helper::config_extract_one_value(_value, _bool))
+            _valid |= CACHED_BOOL;
+        _cached |= CACHED_BOOL;
+    }
+    return (_valid & CACHED_BOOL) ? _bool : defaultVal;
 }
 
 bool config_parameter::asBool() { return asBool(false); }
@@ -103,9 +232,9 @@ std::vector<bool> config_parameter::asBoolArray() {
 }
 
 CRect config_parameter::asRect(CRect defaultVal) {
-    std::vector<float> valArr = asFloatArray();
     CRect rect = defaultVal;
-    auto arrSize = valArr.size();
+    auto arrSize = cachedFloats();
+    float *valArr = _floats;
     if (arrSize > 0) {
         rect.left = valArr[0];
         if (arrSize > 1) {
@@ -123,9 +252,9 @@ CRect config_parameter::asRect(CRect defaultVal) {
 CRect config_parameter::asRect() { return asRect(CRect(0.0f, 0.0f, 0.0f, 0.0f)); }
 
 CVector2D config_parameter::asVec2d(CVector2D defaultVal) {
-    std::vector<float> valArr = asFloatArray();
     CVector2D vec = defaultVal;
-    auto arrSize = valArr.size();
+    auto arrSize = cachedFloats();
+    float *valArr = _floats;
     if (arrSize > 0) {
         vec.x = valArr[0];
         if (arrSize > 1)
@@ -137,9 +266,9 @@ CVector2D config_parameter::asVec2d(CVector2D defaultVal) {
 CVector2D config_parameter::asVec2d() { return asVec2d(CVector2D(0.0f, 0.0f)); }
 
 CVector config_parameter::asVec3d(CVector defaultVal) {
-    std::vector<float> valArr = asFloatArray();
     CVector vec = defaultVal;
-    auto arrSize = valArr.size();
+    auto arrSize = cachedFloats();
+    float *valArr = _floats;
     if (arrSize > 0) {
         vec.x = valArr[0];
         if (arrSize > 1) {
@@ -154,9 +283,9 @@ CVector config_parameter::asVec3d(CVector defaultVal) {
 CVector config_parameter::asVec3d() { return asVec3d(CVector(0.0f, 0.0f, 0.0f)); }
 
 CRGBA config_parameter::asRGBA(CRGBA defaultVal) {
-    std::vector<int> valArr = asIntArray();
     CRGBA rgba = defaultVal;
-    auto arrSize = valArr.size();
+    auto arrSize = cachedInts();
+    int *valArr = _ints;
     if (arrSize > 0) {
         rgba.r = valArr[0];
         if (arrSize > 1) {
@@ -177,6 +306,7 @@ config_parameter &config_parameter::operator=(float n) {
     _value = std::to_string(n);
     _quotes = false;
     _notInitialised = false;
+    resetCache();
     return *this;
 }
 
@@ -184,6 +314,7 @@ config_parameter &config_parameter::operator=(int n) {
     _value = std::to_string(n);
     _quotes = false;
     _notInitialised = false;
+    resetCache();
     return *this;
 }
 
@@ -191,6 +322,7 @@ config_parameter &config_parameter::operator=(std::string s) {
     _value = s;
     _quotes = true;
     _notInitialised = false;
+    resetCache();
     return *this;
 }
 
@@ -200,6 +332,7 @@ config_parameter &config_parameter::operator=(const char *s) {
     _value.push_back('"');
     _quotes = true;
     _notInitialised = false;
+    resetCache();
     return *this;
 }
 
@@ -210,6 +343,7 @@ config_parameter &config_parameter::operator=(bool v) {
         _value = "FALSE";
     _quotes = false;
     _notInitialised = false;
+    resetCache();
     return *this;
 }
 
@@ -218,18 +352,12 @@ config_param_line::config_param_line::config_param_line(std::string paramName) {
     commentOffset = 0;
 }
 
-config_param_line::config_param_line(std::string paramName, std::string value, bool useQuotes) {
-    _value = value;
-    _notInitialised = false;
-    _quotes = useQuotes;
+config_param_line::config_param_line(std::string paramName, std::string value, bool useQuotes) : config_parameter(value, useQuotes) {
     name = paramName;
     commentOffset = 0;
 }
 
-config_param_line::config_param_line(std::string paramName, std::string value, bool useQuotes, std::string paramComment) {
-    _value = value;
-    _notInitialised = false;
-    _quotes = useQuotes;
+config_param_line::config_param_line(std::string paramName, std::string value, bool useQuotes, std::string paramComment) : config_parameter(value, useQuotes) {
     name = paramName;
     comment = paramComment;
     commentOffset = 0;
@@ -250,110 +378,120 @@ void config_file::prepareData() {
     std::ifstream in;
 #ifdef _MSC_VER
     if (_bWidePath)
-        in.open(_widePath);
+        in.open(_widePath, std::ios::binary);
     else
 #endif
-        in.open(_path);
+        in.open(_path, std::ios::binary);
     if (in.is_open()) {
-        unsigned int lineId = 0;
-        for (std::string line; getline(in, line); ) {
-            if (line.empty()) {
-                emptyLines.push_back(lineId++);
-                continue;
-            }
-            bool usesQuotes = false;
-            std::string name;
-            std::string value;
-            std::string comment;
-            unsigned int commentOffset = 0;
-
-            bool scanBeforeName = true;
-            bool scanName = false;
-            bool scanAfterName = false;
-            bool scanValue = false;
-            bool scanAfterValue = false;
-            bool isCommentLine = false;
-
-            for (unsigned int i = 0; i < line.size(); i++) {
-                if (scanBeforeName) {
-                    if (line[i] == '#' || line[i] == ';' || line[i] == '[') {
-                        isCommentLine = true;
-                        break;
-                    }
-                    if (line[i] == '=') {
-                        // incorrect line
-                        continue;
-                    }
-                    if (line[i] != ' ' && line[i] != '\t') {
-                        name.push_back(line[i]);
-                        scanBeforeName = false;
-                        scanName = true;
-                    }
-                }
-                else if (scanName) {
-                    if (line[i] == '#' || line[i] == ';' || line[i] == '[') {
-                        commentOffset = i;
-                        comment = line.substr(i);
-                        break;
-                    }
-                    if (line[i] == ' ' || line[i] == '\t' || line[i] == '=') {
-                        scanName = false;
-                        scanAfterName = true;
-                    }
-                    else
-                        name.push_back(line[i]);
-                }
-                else if (scanAfterName) {
-                    if (line[i] == '#' || line[i] == ';') {
-                        commentOffset = i;
-                        comment = line.substr(i);
-                        break;
-                    }
-                    if (line[i] == '=') {
-                        _useEqualitySign = true;
-                        continue;
-                    }
-                    else if (line[i] != ' ' && line[i] != '\t') {
-                        scanAfterName = false;
-                        scanValue = true;
-                        value.push_back(line[i]);
-                    }
-                }
-                else if (scanValue) {
-                    if (line[i] == '#' || line[i] == ';') {
-                        commentOffset = i;
-                        comment = line.substr(i);
-                        break;
-                    }
-                    value.push_back(line[i]);
-                }
-            }
+        // whole file in one buffer, lines are parsed as views into it
+        std::string buffer;
+        in.seekg(0, std::ios::end);
+        std::streamoff size = in.tellg();
+        if (size > 0) {
+            buffer.resize((size_t)size);
+            in.seekg(0, std::ios::beg);
+            in.read(&buffer[0], size);
+            buffer.resize((size_t)in.gcount());
+        }
+        parseData(buffer);
+    }
+    _dataRead = true;
+}
 
-            if (isCommentLine) {
-                comments.push_back(std::make_pair(lineId, line));
-                continue;
+void config_file::parseData(std::string_view data) {
+    unsigned int lineId = 0;
+    std::string_view section;
+    std::string_view sectionHeader;
+    size_t lineStart = 0;
+    while (lineStart < data.size()) {
+        size_t lineEnd = data.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+            lineEnd = data.size();
+        std::string_view line = data.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty()) {
+            emptyLines.push_back(lineId++);
+            continue;
+        }
+        bool usesQuotes = false;
+        std::string_view name;
+        std::string_view value;
+        std::string_view comment;
+
+        size_t i = 0;
+        size_t size = line.size();
+        // before name, '=' in front of the name is ignored (incorrect line)
+        while (i < size && (line[i] == ' ' || line[i] == '\t' || line[i] == '='))
+            i++;
+        if (i < size && (isCommentChar(line[i]) || line[i] == '[')) {
+            if (line[i] == '[') {
+                std::string_view header = line.substr(i + 1);
+                header = header.substr(0, header.find(']'));
+                size_t first = header.find_first_not_of(" \t");
+                section = first == std::string_view::npos ? std::string_view() : header.substr(first, header.find_last_not_of(" \t") - first + 1);
+                sectionHeader = line;
             }
+            comments.push_back(std::make_pair(lineId, std::string(line)));
+            continue;
+        }
 
-            if (value.size() > 0) {
-                size_t l = value.find_last_not_of(" \t");
-                if (l != std::string::npos) {
-                    value = value.substr(0, l + 1);
-                    size_t valSize = value.size();
-                    if (valSize > 1 && value[0] == '"' && value[valSize - 1] == '"')
-                        usesQuotes = true;
+        // name
+        size_t nameStart = i;
+        bool hasValue = true;
+        while (i < size && line[i] != ' ' && line[i] != '\t' && line[i] != '=') {
+            if (isCommentChar(line[i]) || line[i] == '[') {
+                comment = line.substr(i);
+                hasValue = false;
+                break;
+            }
+            i++;
+        }
+        name = line.substr(nameStart, i - nameStart);
+
+        if (hasValue && i < size) {
+            // after name, the separator that ended the name is skipped
+            for (i++; i < size; i++) {
+                if (isCommentChar(line[i])) {
+                    comment = line.substr(i);
+                    hasValue = false;
+                    break;
                 }
-                else
-                    value.clear();
+                if (line[i] == '=')
+                    _useEqualitySign = true;
+                else if (line[i] != ' ' && line[i] != '\t')
+                    break;
             }
+            // value
+            if (hasValue && i < size) {
+                size_t valueStart = i;
+                while (i < size && !isCommentChar(line[i]))
+                    i++;
+                value = line.substr(valueStart, i - valueStart);
+                if (i < size)
+                    comment = line.substr(i);
+            }
+        }
 
-            paramLines.emplace_back(name, value, usesQuotes, comment);
+        size_t l = value.find_last_not_of(" \t");
+        if (l != std::string_view::npos) {
+            value = value.substr(0, l + 1);
+            size_t valSize = value.size();
+            if (valSize > 1 && value[0] == '"' && value[valSize - 1] == '"')
+                usesQuotes = true;
+        }
+        else
+            value = std::string_view();
 
-            //printf("%s \"%s\"\n", param.name.c_str(), param._value.c_str());
+        paramLines.emplace_back(std::string(name), std::string(value), usesQuotes, std::string(comment));
+        paramLines.back().section = section;
+        paramLines.back().sectionHeader = sectionHeader;
 
-            lineId++;
-        }
+        lineId++;
     }
-    _dataRead = true;
+    buildIndex();
 }
 
 void config_file::writeData() {
@@ -376,7 +514,18 @@ void config_file::writeData() {
             }
         }
 
+        std::string const *section = nullptr;
         for (config_param_line &param : paramLines) {
+            if (!param.isEmpty() && !param.name.empty()) {
+                if (section ? *section != param.section : !param.section.empty()) {
+                    if (param.sectionHeader.empty())
+                        out << '[' << param.section << "]\n";
+                    else
+                        out << param.sectionHeader << '\n';
+                }
+                section = &param.section;
+            }
+
             if (!param.isEmpty() && !param.comment.empty()) {
                 out << param.comment << '\n';
             }
@@ -483,13 +632,115 @@ void config_file::save() {
     writeData();
 }
 
-config_parameter &config_file::operator[](std::string name) {
-    for (config_param_line &param : paramLines) {
-        if (!param.name.compare(name))
-            return param;
+void config_file::indexLine(unsigned int lineId) {
+    config_param_line const &param = paramLines[lineId];
+    if (param.name.empty())
+        return;
+    _index.emplace(param.name, lineId);
+    _sectionIndex.emplace(config_key{ param.section, param.name }, lineId);
+}
+
+void config_file::buildIndex() {
+    _index.clear();
+    _sectionIndex.clear();
+    _index.reserve(paramLines.size());
+    _sectionIndex.reserve(paramLines.size());
+    for (unsigned int i = 0; i < paramLines.size(); i++)
+        indexLine(i);
+    _indexedData = paramLines.data();
+    _indexedSize = paramLines.size();
+}
+
+bool config_file::indexValid() const {
+    return _indexedData == paramLines.data() && _indexedSize == paramLines.size();
+}
+
+void config_file::updateIndex() {
+    if (!indexValid())
+        buildIndex();
+}
+
+config_param_line &config_file::addLine(size_t position, config_param_line line) {
+    config_param_line const *data = paramLines.data();
+    bool append = position == paramLines.size();
+    paramLines.insert(paramLines.begin() + position, std::move(line));
+    if (append && data == paramLines.data()) {
+        indexLine((unsigned int)position);
+        _indexedSize = paramLines.size();
+    }
+    else
+        buildIndex();
+    return paramLines[position];
+}
+
+config_parameter &config_file::operator[](std::string_view name) {
+    updateIndex();
+    auto it = _index.find(name);
+    if (it != _index.end())
+        return paramLines[it->second];
+    // new lines go to the end of the file, so they stay in the last section
+    config_param_line line{ std::string(name) };
+    if (!paramLines.empty()) {
+        line.section = paramLines.back().section;
+        line.sectionHeader = paramLines.back().sectionHeader;
+    }
+    return addLine(paramLines.size(), std::move(line));
+}
+
+config_parameter &config_file::operator()(std::string_view section, std::string_view name) {
+    updateIndex();
+    auto it = _sectionIndex.find(config_key{ section, name });
+    if (it != _sectionIndex.end())
+        return paramLines[it->second];
+    // after the last line of the section, a new section goes to the end (lines without one to the top)
+    size_t position = section.empty() ? 0 : paramLines.size();
+    config_param_line line{ std::string(name) };
+    line.section = section;
+    for (size_t i = paramLines.size(); i > 0; i--) {
+        if (paramLines[i - 1].section == section) {
+            position = i;
+            line.sectionHeader = paramLines[i - 1].sectionHeader;
+            break;
+        }
+    }
+    return addLine(position, std::move(line));
+}
+
+config_parameter *config_file::find(std::string_view name) {
+    updateIndex();
+    auto it = _index.find(name);
+    return it != _index.end() ? &paramLines[it->second] : nullptr;
+}
+
+config_parameter *config_file::find(std::string_view section, std::string_view name) {
+    updateIndex();
+    auto it = _sectionIndex.find(config_key{ section, name });
+    return it != _sectionIndex.end() ? &paramLines[it->second] : nullptr;
+}
+
+config_parameter const *config_file::find(std::string_view name) const {
+    if (indexValid()) {
+        auto it = _index.find(name);
+        return it != _index.end() ? &paramLines[it->second] : nullptr;
+    }
+    // a copy, the index still points into the lines of the original
+    for (config_param_line const &line : paramLines) {
+        if (!line.name.empty() && line.name == name)
+            return &line;
+    }
+    return nullptr;
+}
+
+config_parameter const *config_file::find(std::string_view section, std::string_view name) const {
+    if (indexValid()) {
+        auto it = _sectionIndex.find(config_key{ section, name });
+        return it != _sectionIndex.end() ? &paramLines[it->second] : nullptr;
+    }
+    for (config_param_line const &line : paramLines) {
+        if (!line.name.empty() && line.section == section && line.name == name)
+            return &line;
     }
-    paramLines.emplace_back(name);
-    return paramLines.back();
+    return nullptr;
 }
 
 void config_file::setUseEqualitySign(bool enable) {
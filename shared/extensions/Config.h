@@ -7,7 +7,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
 #include <fstream>
 #include <sstream>
 
@@ -25,6 +27,14 @@ namespace plugin {
         static bool config_extract_one_value(std::string const &strinput, bool &value);
         static size_t config_extract_values_array(std::string const &strinput, std::vector<bool> &arr);
 
+        // numbers are read with std::from_chars, no stream is created
+        static bool config_extract_one_value(std::string const &strinput, int &value);
+        static bool config_extract_one_value(std::string const &strinput, float &value);
+        static size_t config_extract_values_array(std::string const &strinput, std::vector<int> &arr);
+        static size_t config_extract_values_array(std::string const &strinput, std::vector<float> &arr);
+        static unsigned int config_extract_values(std::string const &strinput, int *values, unsigned int maxValues);
+        static unsigned int config_extract_values(std::string const &strinput, float *values, unsigned int maxValues);
+
         template <typename T> static bool config_extract_one_value(std::istringstream &iss, T &value) {
             iss >> value;
             return !iss.fail();
@@ -77,11 +87,43 @@ namespace plugin {
         config_parameter &operator=(std::string s);
         config_parameter &operator=(const char *s);
         config_parameter &operator=(bool v);
+
+    protected:
+        // Typed values are parsed on first request and kept while _value is the text they were parsed from,
+        // so code that changes _value directly never reads stale ones
+        enum eCachedValue : unsigned char {
+            CACHED_INT = 1,
+            CACHED_FLOAT = 2,
+            CACHED_BOOL = 4,
+            CACHED_INTS = 8,
+            CACHED_FLOATS = 16
+        };
+
+        unsigned char _cached = 0;
+        unsigned char _valid = 0;
+        unsigned char _numInts = 0;
+        unsigned char _numFloats = 0;
+        bool _bool = false;
+        int _int = 0;
+        float _float = 0.0f;
+        int _ints[4] = {};
+        float _floats[4] = {};
+        std::string _cachedValue;
+
+        void validateCache();
+        unsigned int cachedInts();
+        unsigned int cachedFloats();
+
+    public:
+        void resetCache();
     };
 
     class config_param_line : public config_parameter {
     public:
         std::string name;
+        std::string section;
+        // [section] line as it was read, written back unchanged
+        std::string sectionHeader;
         std::string comment;
         unsigned int commentOffset;
 
@@ -109,9 +151,38 @@ namespace plugin {
         std::vector<std::pair<unsigned int, std::string>> comments;
         std::vector<unsigned int> emptyLines;
 
+        struct config_key {
+            std::string_view section;
+            std::string_view name;
+
+            bool operator==(config_key const &rhs) const {
+                return section == rhs.section && name == rhs.name;
+            }
+        };
+
+        struct config_key_hash {
+            size_t operator()(config_key const &key) const {
+                size_t h = std::hash<std::string_view>()(key.section);
+                return h ^ (std::hash<std::string_view>()(key.name) + 0x9E3779B9 + (h << 6) + (h >> 2));
+            }
+        };
+
+        // Keys are views into the names of paramLines, the first line with a name wins.
+        // The index is rebuilt when paramLines was reallocated or changed in size behind our back.
+        std::unordered_map<std::string_view, unsigned int> _index;
+        std::unordered_map<config_key, unsigned int, config_key_hash> _sectionIndex;
+        config_param_line const *_indexedData = nullptr;
+        size_t _indexedSize = 0;
+
         bool pathEmpty();
         void prepareData();
+        void parseData(std::string_view data);
         void writeData();
+        void buildIndex();
+        void indexLine(unsigned int lineId);
+        void updateIndex();
+        bool indexValid() const;
+        config_param_line &addLine(size_t position, config_param_line line);
 
         config_file &operator<<(std::string comment) {
             if (paramLines.empty())
@@ -164,7 +235,16 @@ namespace plugin {
         config_file(std::wstring fileName);
 #endif
         void save();
-        config_parameter &operator[](std::string name);
+        config_parameter &operator[](std::string_view name);
+        // Parameter in the given [section], "" for the lines before the first section
+        config_parameter &operator()(std::string_view section, std::string_view name);
+        // Same lookups without adding the parameter, nullptr if it's not there
+        config_parameter *find(std::string_view name);
+        config_parameter *find(std::string_view section, std::string_view name);
+        // Read-only lookups that change nothing, for a file shared between threads. Values are parsed
+        // from a copy of the parameter.
+        config_parameter const *find(std::string_view name) const;
+        config_parameter const *find(std::string_view section, std::string_view name) const;
         void setUseEqualitySign(bool enable);
         void setUseAlignment(bool enable);
         void setUsePrecision(bool enable);
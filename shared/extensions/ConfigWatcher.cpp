@@ -0,0 +1,180 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "ConfigWatcher.h"
+#include "FileWatcher.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+using namespace plugin;
+
+namespace {
+    // One thread for all watched config files, started with the first one and running until stop()
+    class config_watch_service {
+    public:
+        // Never destroyed, the thread may still be running when static destructors are called
+        static config_watch_service &instance() {
+            static config_watch_service *service = new config_watch_service;
+            return *service;
+        }
+
+        // Returns false if the file isn't watched
+        bool add(config_watcher *watcher) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stop)
+                return false;
+            if (!_fileWatcher) {
+                _fileWatcher = FileWatcher::Create();
+                if (!_fileWatcher)
+                    return false;
+            }
+            if (!_fileWatcher->Watch(watcher->path()))
+                return false;
+            _watchers.push_back(watcher);
+            if (!_thread.joinable())
+                _thread = std::thread(&config_watch_service::run, this);
+            return true;
+        }
+
+        void stop() {
+            std::thread thread;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+                thread = std::move(_thread);
+            }
+            if (thread.joinable())
+                thread.join();
+        }
+
+        void remove(config_watcher *watcher) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = std::find(_watchers.begin(), _watchers.end(), watcher);
+            if (it == _watchers.end())
+                return;
+            _watchers.erase(it);
+            bool watched = std::any_of(_watchers.begin(), _watchers.end(), [watcher](config_watcher *other) {
+                return other->path() == watcher->path();
+            });
+            if (!watched)
+                _fileWatcher->Unwatch(watcher->path());
+        }
+
+    private:
+        std::mutex _mutex;
+        std::unique_ptr<FileWatcher> _fileWatcher;
+        std::vector<config_watcher *> _watchers;
+        std::thread _thread;
+        std::atomic<bool> _stop = false;
+
+        void run() {
+            std::vector<std::filesystem::path> changed;
+            std::vector<std::filesystem::path> more;
+            while (!_stop) {
+                changed.clear();
+                _fileWatcher->Poll(100, changed);
+                // editors often save in several steps, wait until the files settle
+                do {
+                    more.clear();
+                    if (!changed.empty())
+                        _fileWatcher->Poll(50, more);
+                    for (auto &file : more) {
+                        if (std::find(changed.begin(), changed.end(), file) == changed.end())
+                            changed.push_back(file);
+                    }
+                } while (!more.empty() && !_stop);
+
+                if (changed.empty())
+                    continue;
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (config_watcher *watcher : _watchers) {
+                    if (std::find(changed.begin(), changed.end(), watcher->path()) != changed.end())
+                        watcher->reload();
+                }
+            }
+        }
+    };
+
+    bool parameterChanged(config_parameter *before, config_parameter *after) {
+        bool hadValue = before && !before->isEmpty();
+        bool hasValue = after && !after->isEmpty();
+        if (hadValue != hasValue)
+            return true;
+        return hasValue && before->_value != after->_value;
+    }
+}
+
+config_watcher::config_watcher(std::filesystem::path const &fileName) : _pending(nullptr) {
+    std::error_code error;
+    _path = std::filesystem::absolute(fileName, error).lexically_normal();
+    if (error)
+        _path = fileName;
+    publish(load(_path));
+    _watched = config_watch_service::instance().add(this);
+}
+
+void config_watcher::stopWatching() {
+    config_watch_service::instance().stop();
+}
+
+config_watcher::~config_watcher() {
+    config_watch_service::instance().remove(this);
+    delete _pending.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void config_watcher::onChange(std::string_view name, change_callback callback) {
+    _callbacks.push_back({ std::string(), std::string(name), true, std::move(callback) });
+}
+
+void config_watcher::onChange(std::string_view section, std::string_view name, change_callback callback) {
+    _callbacks.push_back({ std::string(section), std::string(name), false, std::move(callback) });
+}
+
+bool config_watcher::update() {
+    std::unique_ptr<config_file> next(_pending.exchange(nullptr, std::memory_order_acq_rel));
+    if (!next)
+        return false;
+    std::unique_ptr<config_file> previous = publish(std::move(next));
+    config_file &current = get();
+
+    // callbacks may add callbacks
+    for (size_t i = 0, count = _callbacks.size(); i < count; i++) {
+        key_callback &key = _callbacks[i];
+        config_parameter *before = key.anySection ? previous->find(key.name) : previous->find(key.section, key.name);
+        config_parameter *after = key.anySection ? current.find(key.name) : current.find(key.section, key.name);
+        if (parameterChanged(before, after)) {
+            change_callback callback = key.callback;
+            callback(after ? *after : current._emptyParameter);
+        }
+    }
+    return true;
+}
+
+void config_watcher::reload() {
+    std::error_code error;
+    // saved by renaming a new file over it, the rename is reported separately
+    if (!std::filesystem::exists(_path, error))
+        return;
+    delete _pending.exchange(load(_path).release(), std::memory_order_acq_rel);
+}
+
+std::unique_ptr<config_file> config_watcher::publish(std::unique_ptr<config_file> config) {
+    std::unique_ptr<config_file> previous = std::move(_current);
+    _current = std::make_unique<config_file>(*config);
+    _shared.store(std::shared_ptr<const config_file>(std::move(config)), std::memory_order_release);
+    return previous;
+}
+
+std::unique_ptr<config_file> config_watcher::load(std::filesystem::path const &fileName) {
+    auto config = std::make_unique<config_file>();
+#ifdef _MSC_VER
+    config->open(fileName.wstring());
+#else
+    config->open(fileName.string());
+#endif
+    return config;
+}
@@ -0,0 +1,106 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Config.h"
+
+namespace plugin {
+
+    // Config file that is reloaded when it changes on disk, so values can be tuned while the game runs.
+    // One background thread watches all files (see FileWatcher) and parses the ones that changed into a
+    // new config_file. update() swaps that snapshot in on the game thread and calls the callbacks of the
+    // keys whose value changed. The game thread reads its own copy of the snapshot through get() and
+    // operator[], other threads take the read-only one from snapshot(), which stays alive as long as it's
+    // held. Neither waits for a reload.
+    // Call stopWatching() when the plugin shuts down (e.g. from Events::shutdownRwEvent) to end the thread.
+    class config_watcher {
+    public:
+        using change_callback = std::function<void(config_parameter &param)>;
+
+        explicit config_watcher(std::filesystem::path const &fileName);
+        ~config_watcher();
+
+        config_watcher(config_watcher const &) = delete;
+        config_watcher &operator=(config_watcher const &) = delete;
+
+        // Current snapshot, game thread only. Missing keys are added to it and parsed values are cached,
+        // other threads never see this copy.
+        config_file &get() {
+            return *_current;
+        }
+
+        // Can be taken from any thread. It's shared, so only its const find() is used on it.
+        std::shared_ptr<const config_file> snapshot() const {
+            return _shared.load(std::memory_order_acquire);
+        }
+
+        config_parameter &operator[](std::string_view name) {
+            return get()[name];
+        }
+
+        config_parameter &operator()(std::string_view section, std::string_view name) {
+            return get()(section, name);
+        }
+
+        std::filesystem::path const &path() const {
+            return _path;
+        }
+
+        // Called by update() with the new value, an empty parameter if the key was removed
+        void onChange(std::string_view name, change_callback callback);
+        void onChange(std::string_view section, std::string_view name, change_callback callback);
+
+        // Swaps in a reloaded snapshot and calls the change callbacks. Call it once per frame from the
+        // game thread, e.g. from Events::gameProcessEvent. Returns true if there was a reload.
+        bool update();
+
+        // Parses the file on the calling thread and queues it for update(), the background thread uses it too
+        void reload();
+
+        bool isReloadPending() const {
+            return _pending.load(std::memory_order_acquire) != nullptr;
+        }
+
+        // False if changes of the file aren't noticed, e.g. its directory doesn't exist or stopWatching()
+        // was called before. reload() still works.
+        bool isWatched() const {
+            return _watched;
+        }
+
+        // Ends the background thread and waits for it, files aren't watched after that. Not from DllMain
+        // or a static destructor, the thread can't exit while the loader lock is held.
+        static void stopWatching();
+
+    private:
+        struct key_callback {
+            std::string section;
+            std::string name;
+            bool anySection;
+            change_callback callback;
+        };
+
+        std::filesystem::path _path;
+        std::unique_ptr<config_file> _current;
+        std::atomic<std::shared_ptr<const config_file>> _shared;
+        std::atomic<config_file *> _pending;
+        bool _watched = false;
+        std::vector<key_callback> _callbacks;
+
+        // Shares the new snapshot and gives the game thread a copy of it, returns the game thread's old one
+        std::unique_ptr<config_file> publish(std::unique_ptr<config_file> config);
+
+        static std::unique_ptr<config_file> load(std::filesystem::path const &fileName);
+    };
+}
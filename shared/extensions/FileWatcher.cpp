@@ -0,0 +1,254 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED source file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#include "FileWatcher.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace plugin;
+
+namespace {
+    std::filesystem::path DirectoryOf(std::filesystem::path const &file) {
+        std::filesystem::path dir = file.parent_path();
+        return dir.empty() ? std::filesystem::path(".") : dir;
+    }
+
+    void AddUnique(std::vector<std::filesystem::path> &changed, std::filesystem::path const &file) {
+        if (std::find(changed.begin(), changed.end(), file) == changed.end())
+            changed.push_back(file);
+    }
+
+#ifdef _WIN32
+    class WindowsFileWatcher : public FileWatcher {
+    public:
+        ~WindowsFileWatcher() override {
+            for (auto &[path, dir] : dirs)
+                Close(*dir);
+        }
+
+        bool Watch(std::filesystem::path const &file) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto &dir = dirs[DirectoryOf(file)];
+            if (!dir) {
+                dir = std::make_unique<Directory>();
+                dir->handle = CreateFileW(DirectoryOf(file).c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                    nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+                dir->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+                if (dir->handle == INVALID_HANDLE_VALUE || !dir->overlapped.hEvent || !Read(*dir)) {
+                    Close(*dir);
+                    dirs.erase(DirectoryOf(file));
+                    return false;
+                }
+            }
+            if (std::find(dir->files.begin(), dir->files.end(), file) == dir->files.end())
+                dir->files.push_back(file);
+            return true;
+        }
+
+        void Unwatch(std::filesystem::path const &file) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = dirs.find(DirectoryOf(file));
+            if (it != dirs.end()) {
+                auto &files = it->second->files;
+                files.erase(std::remove(files.begin(), files.end(), file), files.end());
+                // the handle is closed by Poll, it may be waiting on it right now
+            }
+        }
+
+        void Poll(unsigned int timeoutMs, std::vector<std::filesystem::path> &changed) override {
+            std::vector<HANDLE> events;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto it = dirs.begin(); it != dirs.end(); ) {
+                    if (it->second->files.empty()) {
+                        Close(*it->second);
+                        it = dirs.erase(it);
+                    }
+                    else {
+                        if (events.size() < MAXIMUM_WAIT_OBJECTS)
+                            events.push_back(it->second->overlapped.hEvent);
+                        ++it;
+                    }
+                }
+            }
+            if (events.empty()) {
+                Sleep(timeoutMs);
+                return;
+            }
+            DWORD result = WaitForMultipleObjects((DWORD)events.size(), events.data(), FALSE, timeoutMs);
+            if (result >= WAIT_OBJECT_0 + events.size())
+                return;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &[path, dir] : dirs) {
+                if (WaitForSingleObject(dir->overlapped.hEvent, 0) != WAIT_OBJECT_0)
+                    continue;
+                DWORD bytes = 0;
+                if (!GetOverlappedResult(dir->handle, &dir->overlapped, &bytes, FALSE) || bytes == 0) {
+                    // buffer overflow, anything could have changed
+                    for (auto &file : dir->files)
+                        AddUnique(changed, file);
+                }
+                else {
+                    auto info = reinterpret_cast<FILE_NOTIFY_INFORMATION const *>(dir->buffer);
+                    while (true) {
+                        std::wstring name(info->FileName, info->FileNameLength / sizeof(wchar_t));
+                        for (auto &file : dir->files) {
+                            if (!_wcsicmp(name.c_str(), file.filename().c_str()))
+                                AddUnique(changed, file);
+                        }
+                        if (!info->NextEntryOffset)
+                            break;
+                        info = reinterpret_cast<FILE_NOTIFY_INFORMATION const *>(reinterpret_cast<BYTE const *>(info) + info->NextEntryOffset);
+                    }
+                }
+                Read(*dir);
+            }
+        }
+
+    private:
+        struct Directory {
+            HANDLE handle = INVALID_HANDLE_VALUE;
+            OVERLAPPED overlapped = {};
+            alignas(DWORD) BYTE buffer[16384];
+            std::vector<std::filesystem::path> files;
+        };
+
+        std::mutex mutex;
+        std::map<std::filesystem::path, std::unique_ptr<Directory>> dirs;
+
+        static bool Read(Directory &dir) {
+            ResetEvent(dir.overlapped.hEvent);
+            return ReadDirectoryChangesW(dir.handle, dir.buffer, sizeof(dir.buffer), FALSE,
+                FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE, nullptr, &dir.overlapped, nullptr) != FALSE;
+        }
+
+        static void Close(Directory &dir) {
+            if (dir.handle != INVALID_HANDLE_VALUE) {
+                // the buffer must not go away while the read is still running
+                DWORD bytes;
+                if (CancelIoEx(dir.handle, &dir.overlapped) || GetLastError() != ERROR_NOT_FOUND)
+                    GetOverlappedResult(dir.handle, &dir.overlapped, &bytes, TRUE);
+                CloseHandle(dir.handle);
+                dir.handle = INVALID_HANDLE_VALUE;
+            }
+            if (dir.overlapped.hEvent) {
+                CloseHandle(dir.overlapped.hEvent);
+                dir.overlapped.hEvent = nullptr;
+            }
+        }
+    };
+#elif defined(__linux__)
+    class InotifyFileWatcher : public FileWatcher {
+    public:
+        InotifyFileWatcher() {
+            fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        }
+
+        ~InotifyFileWatcher() override {
+            if (fd >= 0)
+                close(fd);
+        }
+
+        bool Watch(std::filesystem::path const &file) override {
+            if (fd < 0)
+                return false;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = dirs.find(DirectoryOf(file));
+            if (it == dirs.end()) {
+                // editors either write the file in place or rename a new one over it
+                int wd = inotify_add_watch(fd, DirectoryOf(file).c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                if (wd < 0)
+                    return false;
+                it = dirs.emplace(DirectoryOf(file), Directory{ wd, {} }).first;
+            }
+            auto &files = it->second.files;
+            if (std::find(files.begin(), files.end(), file) == files.end())
+                files.push_back(file);
+            return true;
+        }
+
+        void Unwatch(std::filesystem::path const &file) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = dirs.find(DirectoryOf(file));
+            if (it == dirs.end())
+                return;
+            auto &files = it->second.files;
+            files.erase(std::remove(files.begin(), files.end(), file), files.end());
+            if (files.empty()) {
+                int wd = it->second.wd;
+                dirs.erase(it);
+                // the same directory may be watched under another spelling
+                bool shared = std::any_of(dirs.begin(), dirs.end(), [wd](auto const &dir) { return dir.second.wd == wd; });
+                if (!shared)
+                    inotify_rm_watch(fd, wd);
+            }
+        }
+
+        void Poll(unsigned int timeoutMs, std::vector<std::filesystem::path> &changed) override {
+            if (fd < 0)
+                return;
+            pollfd pfd = { fd, POLLIN, 0 };
+            if (poll(&pfd, 1, (int)timeoutMs) <= 0)
+                return;
+            alignas(inotify_event) char buffer[16384];
+            while (true) {
+                ssize_t size = read(fd, buffer, sizeof(buffer));
+                if (size <= 0)
+                    break;
+                std::lock_guard<std::mutex> lock(mutex);
+                for (char *p = buffer; p < buffer + size; ) {
+                    auto event = reinterpret_cast<inotify_event const *>(p);
+                    for (auto &[path, dir] : dirs) {
+                        if (event->mask & IN_Q_OVERFLOW) {
+                            // events were lost, anything could have changed
+                            for (auto &file : dir.files)
+                                AddUnique(changed, file);
+                        }
+                        else if (dir.wd == event->wd && event->len) {
+                            for (auto &file : dir.files) {
+                                if (file.filename() == event->name)
+                                    AddUnique(changed, file);
+                            }
+                        }
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+
+    private:
+        struct Directory {
+            int wd;
+            std::vector<std::filesystem::path> files;
+        };
+
+        int fd = -1;
+        std::mutex mutex;
+        std::map<std::filesystem::path, Directory> dirs;
+    };
+#endif
+}
+
+std::unique_ptr<FileWatcher> FileWatcher::Create() {
+#ifdef _WIN32
+    return std::make_unique<WindowsFileWatcher>();
+#elif defined(__linux__)
+    return std::make_unique<InotifyFileWatcher>();
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,35 @@
+/*
+    Plugin-SDK (Grand Theft Auto) SHARED header file
+    Authors: GTA Community. See more here
+    https://github.com/DK22Pac/plugin-sdk
+    Do not delete this comment block. Respect others' work!
+*/
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace plugin {
+
+// Change notifications for single files, watched through their directory so files that are saved
+// by writing a new file and renaming it over the old one are noticed too.
+// ReadDirectoryChangesW on Windows, inotify on Linux.
+// Watch and Unwatch can be called from any thread while another thread is inside Poll.
+class FileWatcher {
+public:
+    virtual ~FileWatcher() = default;
+
+    // The directory of the file has to exist, the file itself doesn't
+    virtual bool Watch(std::filesystem::path const &file) = 0;
+    virtual void Unwatch(std::filesystem::path const &file) = 0;
+
+    // Waits up to timeoutMs for changes and appends the watched files that changed,
+    // exactly as they were passed to Watch. Every file is reported once per call.
+    virtual void Poll(unsigned int timeoutMs, std::vector<std::filesystem::path> &changed) = 0;
+
+    // Watcher for this platform, nullptr if there is none
+    static std::unique_ptr<FileWatcher> Create();
+};
+
+}
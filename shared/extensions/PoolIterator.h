@@ -8,6 +8,17 @@
 
 #if defined(GTA3) || defined(GTAVC) || defined(GTASA)
 #include "CPool.h"
+#include "../ThreadPool.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLUGIN_POOL_ITERATOR_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace plugin {
 
@@ -15,16 +26,66 @@ template <typename T1, typename T2>
 class PoolIterator {
     CPool<T1, T2> *pool;
     int poolSlotIndex;
+
+    static unsigned CountTrailingZeros(uint32_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+
 public:
-    static int FindNextActiveSlotInPool(CPool<T1, T2> *_Pool, int _CurrentSlot) {
-        for (int i = _CurrentSlot; i < _Pool->m_nSize; ++i) {
-            if (!_Pool->IsFreeSlotAtIndex(i)) {
+    // slots handed to one thread by ForEachParallel
+    static constexpr int PARALLEL_CHUNK_SIZE = 4096;
+
+    // First used slot in [_From, _To), -1 if there's none. bEmpty is the top bit of every
+    // byte map entry, so whole blocks of entries are tested at once.
+    static int FindNextActiveSlotInRange(CPool<T1, T2> *_Pool, int _From, int _To) {
+        const unsigned char *map = reinterpret_cast<const unsigned char *>(_Pool->m_byteMap);
+        int i = _From;
+#ifdef PLUGIN_POOL_ITERATOR_SSE2
+        for (; i + 16 <= _To; i += 16) {
+            uint32_t used = ~_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(map + i))) & 0xFFFF;
+            if (used)
+                return i + CountTrailingZeros(used);
+        }
+#endif
+        for (; i + 4 <= _To; i += 4) {
+            uint32_t word;
+            memcpy(&word, map + i, sizeof(word));
+            uint32_t used = ~word & 0x80808080;
+            if (used)
+                return i + CountTrailingZeros(used) / 8;
+        }
+        for (; i < _To; ++i) {
+            if (!(map[i] & 0x80))
                 return i;
-            }
         }
         return -1;
     }
 
+    static int FindNextActiveSlotInPool(CPool<T1, T2> *_Pool, int _CurrentSlot) {
+        return FindNextActiveSlotInRange(_Pool, _CurrentSlot, _Pool->m_nSize);
+    }
+
+    // Calls fn(T1*) for every object in the pool, a chunk of slots per plugin::ParallelFor call.
+    // Meant for read-only scans: fn runs concurrently and must not add or remove objects.
+    // Pools smaller than PARALLEL_CHUNK_SIZE are walked on the calling thread.
+    template <typename Fn>
+    static void ForEachParallel(CPool<T1, T2> *_Pool, Fn const &fn) {
+        int size = _Pool->m_nSize;
+        size_t chunks = (size + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+        plugin::ParallelFor(chunks, [_Pool, size, &fn](size_t chunk) {
+            int from = static_cast<int>(chunk) * PARALLEL_CHUNK_SIZE;
+            int to = from + PARALLEL_CHUNK_SIZE < size ? from + PARALLEL_CHUNK_SIZE : size;
+            for (int i = FindNextActiveSlotInRange(_Pool, from, to); i != -1; i = FindNextActiveSlotInRange(_Pool, i + 1, to))
+                fn(reinterpret_cast<T1 *>(&_Pool->m_pObjects[i]));
+        });
+    }
+
     PoolIterator(CPool<T1, T2> *_Pool, int _Index) {
         pool = _Pool;
         poolSlotIndex = _Index;
@@ -44,6 +105,16 @@ public:
     }
 };
 
+template <typename T1, typename T2, typename Fn>
+void ForEachParallel(CPool<T1, T2> &pool, Fn const &fn) {
+    PoolIterator<T1, T2>::ForEachParallel(&pool, fn);
+}
+
+template <typename T1, typename T2, typename Fn>
+void ForEachParallel(CPool<T1, T2> *pool, Fn const &fn) {
+    PoolIterator<T1, T2>::ForEachParallel(pool, fn);
+}
+
 }
 
 template <typename T1, typename T2>